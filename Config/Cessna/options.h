@@ -361,15 +361,37 @@
 // could be confusing and/or dangerous.
 #define FAILSAFE_HOLD                       0
 
+// Set USE_GEOFENCE to 1 to keep the plane inside a fence zone, outside of any number of
+// no-fly zones, and between an altitude floor and ceiling.  The zones are uploaded from
+// the ground station with the MAVLink fence protocol (FENCE_POINT messages), and kept
+// in NV memory.  The first zone is the one to stay inside, and any others are no-fly zones.
+// On a breach the plane enters the return to launch state, as for a loss of signal, and
+// stays in it until the mode switch is moved.
+// The fence is checked at where the plane will be GEOFENCE_LOOKAHEAD seconds from now,
+// as well as where it is, so that a breach is acted upon before it happens.
+// GEOFENCE_MIN_ALT and GEOFENCE_MAX_ALT are the floor and ceiling, in meters above the
+// origin, or 0 for none.  The floor only applies once the plane has climbed above it.
+// These and the action on a breach can be changed with the FENCE_ parameters.
+// GEOFENCE_MAX_POINTS is the most points in a fence, including the zones' closing points
+// and the return point.  It can be at most 254.
+#ifndef USE_GEOFENCE
+#define USE_GEOFENCE                        0
+#endif
+#define GEOFENCE_LOOKAHEAD                  2
+#define GEOFENCE_MIN_ALT                    0
+#define GEOFENCE_MAX_ALT                    0
+#define GEOFENCE_MAX_POINTS                 64
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Serial Output Format (Can be SERIAL_NONE, SERIAL_DEBUG, SERIAL_ARDUSTATION,
-// SERIAL_UDB_EXTRA, SERIAL_MAVLINK, SERIAL_CAM_TRACK, SERIAL_OSD_REMZIBI, SERIAL_MAGNETOMETER)
+// SERIAL_UDB_EXTRA, SERIAL_UDB_BINARY, SERIAL_MAVLINK, SERIAL_CAM_TRACK, SERIAL_OSD_REMZIBI, SERIAL_MAGNETOMETER)
 // This determines the format of the output sent out the spare serial port.
 // Note that SERIAL_OSD_REMZIBI only works with a ublox GPS.
 // SERIAL_UDB_EXTRA will add additional telemetry fields to those of SERIAL_UDB.
 // SERIAL_UDB_EXTRA can be used with the OpenLog without characters being dropped.
 // SERIAL_UDB_EXTRA may result in dropped characters if used with the XBEE wireless transmitter.
+// SERIAL_UDB_BINARY sends the same content as SERIAL_UDB_EXTRA in compact, CRC checked binary frames.
 // SERIAL_CAM_TRACK is used to output location data to a 2nd UDB, which will target its camera at this plane.
 // SERIAL_MAVLINK is a bi-directional binary format for use with QgroundControl, HKGCS or MAVProxy (Ground Control Stations.)
 // SERIAL_MAGNETOMETER outputs the automatically calculated offsets and raw magnetometer data.
@@ -579,6 +601,30 @@
 #define MANUAL_AILERON_RUDDER_MIX           0.20
 #define RUDDER_BOOST                        0.8
 
+// Gain Scheduling
+// Set GAIN_SCHEDULING to 1 to scale the roll, pitch, yaw and navigation gains
+// above with airspeed. Each loop's scale is interpolated between the scales
+// given at the GAIN_SCHEDULE_AIRSPEEDS (in meters/second, in increasing order),
+// and held at the end values below the first and above the last airspeed.
+// The gains above are used unchanged at the airspeed where the scale is 1.0.
+// Scales are from 0.0 to 1.99. The tables may be changed over MAVLink, as the
+// parameters GS_ASPD0-3, GS_ROLL0-3, GS_PITCH0-3, GS_YAW0-3 and GS_NAV0-3.
+// Set GAIN_SCHEDULE_DENSITY to 1 to index the tables by equivalent airspeed, which
+// corrects the airspeed for air density. The density is measured by the barometer
+// when USE_BAROMETER_ALTITUDE is 1, otherwise it is taken from the standard
+// atmosphere at the GPS altitude.
+#ifndef GAIN_SCHEDULING
+#define GAIN_SCHEDULING                     0
+#endif
+#ifndef GAIN_SCHEDULE_DENSITY
+#define GAIN_SCHEDULE_DENSITY               0
+#endif
+#define GAIN_SCHEDULE_AIRSPEEDS             { 7.0, 12.0, 16.0, 20.0 }
+#define GAIN_SCHEDULE_ROLL                  { 1.5, 1.0, 0.75, 0.6 }
+#define GAIN_SCHEDULE_PITCH                 { 1.5, 1.0, 0.75, 0.6 }
+#define GAIN_SCHEDULE_YAW                   { 1.5, 1.0, 0.75, 0.6 }
+#define GAIN_SCHEDULE_NAV                   { 1.0, 1.0, 1.0, 1.0 }
+
 // Gains for Hovering
 // These are still here from the previous version of the controls, because the new controls have not yet been set up for hovering.
 // Gains are named based on plane's frame of reference (roll means ailerons)
@@ -668,7 +714,32 @@
 // Set this to 1 to ignore camera target data from the flightplan, and instead use camera target data coming in on the serial port.
 // This data can be generated by another UDB running MatrixPilot, using SERIAL_CAM_TRACK.
 // NOTE: When using camera tracking, both UDBs must be set to use the same fixed origin location.
+#ifndef CAM_USE_EXTERNAL_TARGET_DATA
 #define CAM_USE_EXTERNAL_TARGET_DATA        0
+#endif
+
+// Set CAM_TARGET_PREDICTION to 1 to aim the camera at where the target will be by the time the
+// servos have moved, from its position and velocity, rather than at where it was last reported.
+// The velocity of a target on the serial port is sent by SERIAL_CAM_TRACK, when the UDB sending it
+// has CAM_TRACK_SEND_VELOCITY set to 1, or else it is estimated from the positions received.
+// The camera servos are fed forward from the gyros between the 10Hz updates of their positions,
+// so the camera stays on target through turns, and are moved no faster than the rates below.
+// CAM_TARGET_LATENCY is the delay of the target's position on the serial link, in seconds.
+// CAM_SERVO_LATENCY is the time the camera servos take to respond, in seconds.
+#ifndef CAM_TARGET_PREDICTION
+#define CAM_TARGET_PREDICTION               0
+#endif
+#define CAM_TARGET_LATENCY                  0.25
+#define CAM_SERVO_LATENCY                   0.1
+#define CAM_PITCH_SERVO_RATE                360     // Fastest camera pitch movement, in degrees per second.
+#define CAM_YAW_SERVO_RATE                  360     // Fastest camera yaw movement, in degrees per second.
+
+// Set CAM_TRACK_SEND_VELOCITY to 1 for SERIAL_CAM_TRACK to send this plane's velocity after its
+// location. UDBs built before the velocity was added drop these messages, so leave it at 0
+// unless the receiving UDB has been updated. A receiver without CAM_TARGET_PREDICTION ignores it.
+#ifndef CAM_TRACK_SEND_VELOCITY
+#define CAM_TRACK_SEND_VELOCITY             0
+#endif
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -741,6 +812,15 @@
 // Move on to the next waypoint when getting within this distance of the current goal (in meters)
 #define WAYPOINT_PROXIMITY_RADIUS	25
 
+// Set TURN_ANTICIPATION to 1 to move on to the next waypoint where the turn onto the next
+// leg has to start for the plane to roll out on its track, rather than at
+// WAYPOINT_PROXIMITY_RADIUS. This is worked out from the air speed, the estimated wind,
+// and TURN_RATE_NAV, so the plane does not overshoot the corners of the flight plan.
+// Loiter and altitude waypoints, and LOGO flight plans, still use WAYPOINT_PROXIMITY_RADIUS.
+#ifndef TURN_ANTICIPATION
+#define TURN_ANTICIPATION                   0
+#endif
+
 // Origin Location
 // When using relative waypoints, the default is to interpret those waypoints as relative to the
 // plane's power-up location.  Here you can choose to use any specific, fixed 3D location as the
@@ -890,6 +970,30 @@
 #define USE_TELELOG                         1
 #endif
 
+// Number of 512 byte blocks queued between telemetry output and the log file.
+// More blocks ride out longer pauses while the SD card is busy.
+#ifndef TELELOG_BLOCKS
+#define TELELOG_BLOCKS                      4
+#endif
+
+// Logs are named log00000.txt, log00001.txt.. in sequence. When a log is closed
+// the oldest logs are removed until there are fewer than TELELOG_MAX_FILES,
+// together using no more than TELELOG_SPACE_KB kilobytes.
+#ifndef TELELOG_MAX_FILES
+#define TELELOG_MAX_FILES                   20
+#endif
+#ifndef TELELOG_SPACE_KB
+#define TELELOG_SPACE_KB                    65536UL
+#endif
+
+// Set this to 1 to time the flight control code sections every frame, and keep
+// a histogram of each. The results are printed by the 'prof' console command,
+// and sent over MAVLink as DEBUG_VECT messages at MAVLINK_RATE_PROFILE.
+// The histograms take about 1KB of RAM.
+#ifndef USE_PROFILING
+#define USE_PROFILING                       0
+#endif
+
 // Set this to 1 to enable the USB stack on AUAV3
 #ifndef USE_USB
 #define USE_USB                             0
@@ -49,6 +49,34 @@
 #define MANUAL_ERASE_TABLE              0
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Store data areas in NV memory as an append-only log of versioned records
+// Each save writes a new copy of the area, so writes are spread over the whole
+// device and a save interrupted by a reset leaves the previous copy intact.
+// Set to 0 to use the original layout, with a table of areas rewritten in place.
+// NOTE: Changing this setting loses the settings stored in NV memory, so the
+// original layout stays the default.
+#ifndef USE_DATA_STORAGE_LOG
+#define USE_DATA_STORAGE_LOG            0
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Automatically save parameters changed by the ground station
+// 0 - Only save when the ground station sends MAV_CMD_PREFLIGHT_STORAGE
+// 1 - Save the storage areas holding changed parameters, once no parameter
+//     has changed for PARAM_SAVE_QUIET_TIME seconds
+// 2 - As 1, but only while disarmed, when the aircraft is not moving and the
+//     throttle is at its trim, so that there are no writes during flight
+#ifndef PARAM_AUTO_SAVE
+#define PARAM_AUTO_SAVE                 2
+#endif
+
+#ifndef PARAM_SAVE_QUIET_TIME
+#define PARAM_SAVE_QUIET_TIME           5
+#endif
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Use variable data width in HILSIM for output channels
 //  This is used to support NUM_OUTPUTS > 8
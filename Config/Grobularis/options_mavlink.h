@@ -56,13 +56,40 @@
 // Matrixpilot specific data rates
 #define MAVLINK_RATE_SUE                    8   // SERIAL_UDB_EXTRA data rate on channel EXTRA1
 #define MAVLINK_RATE_POSITION_SENSORS       0   // Using channel EXTRA2
+#define MAVLINK_RATE_PROFILE                4   // DEBUG_VECT code section timings, one section per message (USE_PROFILING)
 
 // Send VFR_HUD message at position rate, 1=yes, 0=no.  Needed for correct mavproxy state
 #define MSG_VFR_HUD_WITH_POSITION           1
 
+// Each MAVLink channel has its own transmit queue (of MAVLINK_TX_QUEUE_SIZE bytes)
+// and its own stream rates, which the GCS may change with REQUEST_DATA_STREAM.
+// The queue must hold at least two of the largest (263 byte) MAVLink packets.
+#define MAVLINK_TX_QUEUE_SIZE               640
+
+// Run a second MAVLink channel over the USB CDC serial port, 1=yes, 0=no.
+// Requires USE_USB and USE_CDC.
+#define MAVLINK_USB_CHANNEL                 0
+
+// Serve the on-board file system to the GCS with MAVLink FTP, 1=yes, 0=no.
+// Requires USE_FILESYS. A burst read keeps MAVLINK_FTP_WINDOW replies (of 256 bytes each)
+// queued ahead of the link, and up to MAVLINK_FTP_SESSIONS files may be open at once.
+#define MAVLINK_FTP                         0
+#define MAVLINK_FTP_WINDOW                  4
+#define MAVLINK_FTP_SESSIONS                2
+
+// Stream rates for the on-board telemetry log channel (used when USE_TELELOG is 1)
+#define MAVLINK_LOG_RATE_RAW_SENSORS        4
+#define MAVLINK_LOG_RATE_POSITION           8
+#define MAVLINK_LOG_RATE_SUE                8
+
 #define MAVLINK_FRAME_FREQUENCY             40
 #define MAVLINK_WAYPOINT_TIMEOUT            120 // Dependent on frequency of calling mavlink_output_40hz. 120 is 3 second timeout.
 
+// Mission uploads keep MAVLINK_MISSION_WINDOW item requests in flight, and request
+// an item again if it has not arrived after MAVLINK_MISSION_RETRY frames (20 is 0.5 seconds).
+#define MAVLINK_MISSION_WINDOW              4
+#define MAVLINK_MISSION_RETRY               20
+
 // 19200,38400,57600,115200,230400,460800,921600
 // Fixed 19200 for non free running clock
 //#define MAVLINK_BAUD                        19200   // now using SERIAL_BAUDRATE in options.h
@@ -25,23 +25,600 @@
 #if (USE_MAVLINK == 1)
 
 #include "../MatrixPilot/MAVLink.h"
+
+#if (MAVLINK_FTP == 1)
+
 #include "MAVFTP.h"
+#if (WIN == 1 || NIX == 1 || PX4 == 1)
+#include "../Tools/MatrixPilot-SIL/SIL-filesystem.h"
+#else
+#include "MDD-File-System/FSIO.h"
+#define FindClose(rec)  // an FSIO search holds nothing open
+#endif
+#include "../libFlashFS/filesys.h"
+#include <string.h>
 #include <stdio.h>
 
+#define MAVFTP_PACKET_LEN       (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN)
+#define MAVFTP_PATH_MAX         64
+#define MAVFTP_CRC_CHUNK        512     // bytes checksummed each time through the main loop
+
+// A reply waiting to be sent, with where it is to go
+typedef struct mavftp_reply {
+	mavftp_payload_t payload;
+	mavlink_channel_t chan;
+	uint8_t sysid;
+	uint8_t compid;
+} mavftp_reply_t;
+
+typedef struct mavftp_session {
+	FSFILE* fp;
+	boolean writing;
+} mavftp_session_t;
+
+// The request being carried out. Written at event priority only while
+// request_pending is false, and read at background priority while it is true.
+static mavftp_reply_t request;
+static volatile boolean request_pending = false;
+
+// Replies queued for MAVFTPOutput_40hz(). head is only moved at background
+// priority and tail only at interrupt priority.
+static mavftp_reply_t replies[MAVLINK_FTP_WINDOW];
+static volatile uint8_t reply_head = 0;
+static volatile uint8_t reply_tail = 0;
+
+// The last reply to a request other than a read, so that it can be sent again
+// if the reply was lost and the client repeats the request.
+static mavftp_payload_t last_reply;
+static boolean last_reply_valid = false;
+
+static mavftp_session_t sessions[MAVLINK_FTP_SESSIONS];
+
+static struct {
+	boolean active;
+	uint8_t session;
+	uint8_t size;
+	uint16_t seq;
+	uint32_t offset;
+	mavlink_channel_t chan;
+	uint8_t sysid;
+	uint8_t compid;
+} burst;
+
+static struct {
+	boolean active;
+	FSFILE* fp;
+	uint32_t value;
+} crc;
+
 
 boolean MAVFTPHandleMessage(mavlink_message_t* handle_msg)
 {
-	if (handle_msg->msgid == MAVLINK_MSG_ID_ENCAPSULATED_DATA)
+	mavlink_file_transfer_protocol_t packet;
+
+	if (handle_msg->msgid != MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL)
+	{
+		return false;
+	}
+	mavlink_msg_file_transfer_protocol_decode(handle_msg, &packet);
+	if (packet.target_system != mavlink_system.sysid && packet.target_system != 0)
 	{
-		mavlink_encapsulated_data_t packet;
-		mavlink_msg_encapsulated_data_decode(handle_msg, &packet);
 		return true;
 	}
-	return false;
+	if (!request_pending)
+	{
+		// the payload in the message is not aligned, so is copied out of it
+		memcpy(&request.payload, packet.payload, MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN);
+		request.chan = mavlink_gcs_chan;
+		request.sysid = handle_msg->sysid;
+		request.compid = handle_msg->compid;
+		request_pending = true;
+	}
+	return true;
 }
 
 void MAVFTPOutput_40hz(void)
 {
+	mavftp_reply_t* r;
+
+	while (reply_tail != reply_head)
+	{
+		r = &replies[reply_tail];
+		if (!mavlink_chan_tx_room(r->chan, MAVFTP_PACKET_LEN))
+		{
+			break;  // try again when the link has drained
+		}
+		mavlink_msg_file_transfer_protocol_send(r->chan, 0, r->sysid, r->compid, (const uint8_t*)&r->payload);
+		reply_tail = (reply_tail + 1) % MAVLINK_FTP_WINDOW;
+	}
+}
+
+static boolean reply_queue_full(void)
+{
+	return ((reply_head + 1) % MAVLINK_FTP_WINDOW) == reply_tail;
+}
+
+// Start a reply to the current request in the next free slot of the queue
+static mavftp_payload_t* reply_begin(uint8_t opcode, uint8_t size)
+{
+	mavftp_reply_t* r = &replies[reply_head];
+
+	r->chan = request.chan;
+	r->sysid = request.sysid;
+	r->compid = request.compid;
+	r->payload.seq = request.payload.seq + 1;
+	r->payload.session = request.payload.session;
+	r->payload.opcode = opcode;
+	r->payload.size = size;
+	r->payload.req_opcode = request.payload.opcode;
+	r->payload.burst_complete = 0;
+	r->payload.padding = 0;
+	r->payload.offset = request.payload.offset;
+	return &r->payload;
+}
+
+static void reply_send(void)
+{
+	reply_head = (reply_head + 1) % MAVLINK_FTP_WINDOW;
+}
+
+static void reply_nak(uint8_t error)
+{
+	mavftp_payload_t* p = reply_begin(MAVFTP_OP_NAK, 1);
+
+	p->data[0] = error;
+}
+
+static void reply_ack_u32(uint32_t value)
+{
+	mavftp_payload_t* p = reply_begin(MAVFTP_OP_ACK, sizeof(uint32_t));
+
+	memcpy(p->data, &value, sizeof(uint32_t));
+}
+
+// CRC-32 (polynomial 0xEDB88320, no inversion) as calculated by other MAVLink FTP servers
+static uint32_t crc32_update(uint32_t value, const uint8_t* buf, uint16_t len)
+{
+	uint8_t i;
+
+	while (len--)
+	{
+		value ^= *buf++;
+		for (i = 0; i < 8; i++)
+		{
+			value = (value >> 1) ^ ((value & 1) ? 0xEDB88320UL : 0);
+		}
+	}
+	return value;
+}
+
+static void session_close(uint8_t id)
+{
+	if (sessions[id].fp != NULL)
+	{
+		filesys_fclose(sessions[id].fp);
+		sessions[id].fp = NULL;
+	}
+	if (burst.active && burst.session == id)
+	{
+		burst.active = false;
+	}
+}
+
+static int16_t session_open(const char* path, const char* mode, boolean writing)
+{
+	uint8_t id;
+
+	for (id = 0; id < MAVLINK_FTP_SESSIONS; id++)
+	{
+		if (sessions[id].fp == NULL)
+		{
+			sessions[id].fp = FSfopen(path, mode);
+			if (sessions[id].fp == NULL)
+			{
+				return -2;
+			}
+			sessions[id].writing = writing;
+			return id;
+		}
+	}
+	return -1;
 }
 
+static boolean session_seek(uint8_t id, uint32_t offset)
+{
+	FSFILE* fp = sessions[id].fp;
+
+	if ((uint32_t)FSftell(fp) == offset)
+	{
+		return true;
+	}
+	return FSfseek(fp, (long)offset, SEEK_SET) == 0;
+}
+
+// Copy the path out of the request. There are no directories, so a leading
+// '/' is ignored, and any other path separator refused.
+static boolean request_path(char* path, uint8_t index)
+{
+	const char* name = (const char*)request.payload.data;
+	uint8_t len = request.payload.size;
+	uint8_t i;
+
+	while (index--)
+	{
+		// skip to the next of several NUL separated paths
+		while (len && *name) { name++; len--; }
+		if (len) { name++; len--; }
+	}
+	if (len && *name == '/')
+	{
+		name++;
+		len--;
+	}
+	for (i = 0; i < len && name[i] != '\0'; i++)
+	{
+		if (i >= MAVFTP_PATH_MAX - 1 || name[i] == '/' || name[i] == '\\')
+		{
+			return false;
+		}
+		path[i] = name[i];
+	}
+	path[i] = '\0';
+	return true;
+}
+
+static void op_list(void)
+{
+	char path[MAVFTP_PATH_MAX];
+	SearchRec rec;
+	mavftp_payload_t* p;
+	uint32_t entry = 0;
+	int16_t len;
+
+	if (!request_path(path, 0) || (path[0] != '\0' && strcmp(path, ".") != 0))
+	{
+		reply_nak(MAVFTP_ERR_FILE_NOT_FOUND);
+		return;
+	}
+	p = reply_begin(MAVFTP_OP_ACK, 0);
+	if (FindFirst("*.*", ATTR_MASK, &rec) == 0)
+	{
+		do {
+			if (rec.attributes & (ATTR_VOLUME | ATTR_HIDDEN | ATTR_SYSTEM))
+			{
+				continue;
+			}
+			if (entry++ < request.payload.offset)
+			{
+				continue;
+			}
+			if (rec.attributes & ATTR_DIRECTORY)
+			{
+				len = snprintf((char*)&p->data[p->size], MAVFTP_DATA_MAX - p->size, "D%s", rec.filename);
+			}
+			else
+			{
+				len = snprintf((char*)&p->data[p->size], MAVFTP_DATA_MAX - p->size, "F%s\t%lu", rec.filename, (unsigned long)rec.filesize);
+			}
+			if (len < 0 || p->size + len + 1 > MAVFTP_DATA_MAX)
+			{
+				FindClose(&rec);
+				break;  // the client asks again for the rest, from this entry
+			}
+			p->size += len + 1;
+		} while (FindNext(&rec) == 0);
+	}
+	if (p->size == 0)
+	{
+		reply_nak(MAVFTP_ERR_EOF);
+	}
+}
+
+static void op_open(uint8_t opcode)
+{
+	char path[MAVFTP_PATH_MAX];
+	int16_t id;
+	uint32_t size = 0;
+
+	if (!request_path(path, 0))
+	{
+		reply_nak(MAVFTP_ERR_FILE_NOT_FOUND);
+		return;
+	}
+	switch (opcode)
+	{
+		case MAVFTP_OP_CREATE:
+			id = session_open(path, FS_WRITE, true);
+			break;
+		case MAVFTP_OP_OPEN_WO:
+			id = session_open(path, FS_READPLUS, true);
+			break;
+		default:
+			id = session_open(path, FS_READ, false);
+			if (id >= 0 && FSfseek(sessions[id].fp, 0, SEEK_END) == 0)
+			{
+				size = FSftell(sessions[id].fp);
+				FSfseek(sessions[id].fp, 0, SEEK_SET);
+			}
+			break;
+	}
+	if (id == -1)
+	{
+		reply_nak(MAVFTP_ERR_NO_SESSIONS_AVAILABLE);
+		return;
+	}
+	if (id < 0)
+	{
+		reply_nak(MAVFTP_ERR_FILE_NOT_FOUND);
+		return;
+	}
+	request.payload.session = (uint8_t)id;
+	if (opcode == MAVFTP_OP_OPEN_RO)
+	{
+		reply_ack_u32(size);
+	}
+	else
+	{
+		reply_begin(MAVFTP_OP_ACK, 0);
+	}
+}
+
+// Read up to size bytes at offset in a session into a reply, returning the number read
+static uint8_t session_read(uint8_t id, uint32_t offset, uint8_t size, mavftp_payload_t* p)
+{
+	if (size > MAVFTP_DATA_MAX)
+	{
+		size = MAVFTP_DATA_MAX;
+	}
+	if (!session_seek(id, offset))
+	{
+		return 0;
+	}
+	return (uint8_t)FSfread(p->data, 1, size, sessions[id].fp);
+}
+
+static boolean valid_session(boolean writing)
+{
+	uint8_t id = request.payload.session;
+
+	if (id >= MAVLINK_FTP_SESSIONS || sessions[id].fp == NULL || sessions[id].writing != writing)
+	{
+		reply_nak(MAVFTP_ERR_INVALID_SESSION);
+		return false;
+	}
+	return true;
+}
+
+static void op_read(void)
+{
+	mavftp_payload_t* p;
+
+	if (!valid_session(false))
+	{
+		return;
+	}
+	p = reply_begin(MAVFTP_OP_ACK, 0);
+	p->size = session_read(request.payload.session, request.payload.offset, request.payload.size, p);
+	if (p->size == 0)
+	{
+		reply_nak(MAVFTP_ERR_EOF);
+	}
+}
+
+static void op_write(void)
+{
+	uint8_t id = request.payload.session;
+	size_t wrote;
+
+	if (!valid_session(true))
+	{
+		return;
+	}
+	if (!session_seek(id, request.payload.offset))
+	{
+		reply_nak(MAVFTP_ERR_FAIL);
+		return;
+	}
+	wrote = FSfwrite(request.payload.data, 1, request.payload.size, sessions[id].fp);
+	if (wrote != request.payload.size)
+	{
+		reply_nak(MAVFTP_ERR_FAIL);
+		return;
+	}
+	reply_ack_u32(wrote);
+}
+
+static void op_remove(void)
+{
+	char path[MAVFTP_PATH_MAX];
+
+	if (!request_path(path, 0) || filesys_remove(path) != 0)
+	{
+		reply_nak(MAVFTP_ERR_FILE_NOT_FOUND);
+		return;
+	}
+	reply_begin(MAVFTP_OP_ACK, 0);
+}
+
+// Returns false until the whole file has been checksummed
+static boolean op_crc32(void)
+{
+	char path[MAVFTP_PATH_MAX];
+	uint8_t buf[64];
+	uint16_t done = 0;
+	size_t n;
+
+	if (!crc.active)
+	{
+		if (!request_path(path, 0) || (crc.fp = FSfopen(path, FS_READ)) == NULL)
+		{
+			reply_nak(MAVFTP_ERR_FILE_NOT_FOUND);
+			return true;
+		}
+		crc.value = 0;
+		crc.active = true;
+	}
+	while (done < MAVFTP_CRC_CHUNK)
+	{
+		n = FSfread(buf, 1, sizeof(buf), crc.fp);
+		if (n == 0)
+		{
+			FSfclose(crc.fp);
+			crc.active = false;
+			reply_ack_u32(crc.value);
+			return true;
+		}
+		crc.value = crc32_update(crc.value, buf, (uint16_t)n);
+		done += n;
+	}
+	return false;
+}
+
+// Returns false if the request needs more time, and should be called again
+static boolean process_request(void)
+{
+	uint8_t i;
+
+	if (request.payload.size > MAVFTP_DATA_MAX)
+	{
+		reply_nak(MAVFTP_ERR_INVALID_DATA_SIZE);
+		return true;
+	}
+	switch (request.payload.opcode)
+	{
+		case MAVFTP_OP_NONE:
+			reply_begin(MAVFTP_OP_ACK, 0);
+			break;
+		case MAVFTP_OP_TERMINATE:
+			if (request.payload.session >= MAVLINK_FTP_SESSIONS || sessions[request.payload.session].fp == NULL)
+			{
+				reply_nak(MAVFTP_ERR_INVALID_SESSION);
+				break;
+			}
+			session_close(request.payload.session);
+			reply_begin(MAVFTP_OP_ACK, 0);
+			break;
+		case MAVFTP_OP_RESET:
+			for (i = 0; i < MAVLINK_FTP_SESSIONS; i++)
+			{
+				session_close(i);
+			}
+			reply_begin(MAVFTP_OP_ACK, 0);
+			break;
+		case MAVFTP_OP_LIST:
+			op_list();
+			break;
+		case MAVFTP_OP_OPEN_RO:
+		case MAVFTP_OP_OPEN_WO:
+		case MAVFTP_OP_CREATE:
+			op_open(request.payload.opcode);
+			break;
+		case MAVFTP_OP_READ:
+			op_read();
+			break;
+		case MAVFTP_OP_WRITE:
+			op_write();
+			break;
+		case MAVFTP_OP_REMOVE:
+			op_remove();
+			break;
+		case MAVFTP_OP_CRC32:
+			return op_crc32();
+		default:
+			reply_nak(MAVFTP_ERR_UNKNOWN_COMMAND);
+			break;
+	}
+	return true;
+}
+
+// Queue the next reply of a burst read
+static void burst_next(void)
+{
+	mavftp_reply_t* r = &replies[reply_head];
+	mavftp_payload_t* p = &r->payload;
+
+	r->chan = burst.chan;
+	r->sysid = burst.sysid;
+	r->compid = burst.compid;
+	p->seq = burst.seq++;
+	p->session = burst.session;
+	p->req_opcode = MAVFTP_OP_BURST_READ;
+	p->padding = 0;
+	p->offset = burst.offset;
+	p->size = session_read(burst.session, burst.offset, burst.size, p);
+	if (p->size == 0)
+	{
+		p->opcode = MAVFTP_OP_NAK;
+		p->size = 1;
+		p->data[0] = MAVFTP_ERR_EOF;
+		p->burst_complete = 1;
+		burst.active = false;
+	}
+	else
+	{
+		p->opcode = MAVFTP_OP_ACK;
+		// a short read is the end of the file, and the client knows it as such
+		p->burst_complete = (p->size < burst.size) ? 1 : 0;
+		burst.active = !p->burst_complete;
+		burst.offset += p->size;
+	}
+	reply_send();
+}
+
+void MAVFTPService(void)
+{
+	if (request_pending)
+	{
+		if (reply_queue_full())
+		{
+			return;
+		}
+		burst.active = false;   // any new request ends a burst
+		if (request.payload.opcode == MAVFTP_OP_BURST_READ)
+		{
+			if (valid_session(false))
+			{
+				burst.session = request.payload.session;
+				burst.offset = request.payload.offset;
+				burst.size = (request.payload.size && request.payload.size < MAVFTP_DATA_MAX) ? request.payload.size : MAVFTP_DATA_MAX;
+				burst.seq = request.payload.seq + 1;
+				burst.chan = request.chan;
+				burst.sysid = request.sysid;
+				burst.compid = request.compid;
+				burst.active = true;
+			}
+			else
+			{
+				reply_send();
+			}
+			request_pending = false;
+			return;
+		}
+		if (last_reply_valid && request.payload.seq == (uint16_t)(last_reply.seq - 1) && request.payload.opcode == last_reply.req_opcode)
+		{
+			// our reply was lost, as the client has repeated its request
+			reply_begin(MAVFTP_OP_ACK, 0);  // for its destination
+			replies[reply_head].payload = last_reply;
+			reply_send();
+			request_pending = false;
+			return;
+		}
+		if (!process_request())
+		{
+			return;
+		}
+		last_reply = replies[reply_head].payload;
+		last_reply_valid = (request.payload.opcode != MAVFTP_OP_READ);
+		reply_send();
+		request_pending = false;
+		return;
+	}
+	while (burst.active && !reply_queue_full())
+	{
+		burst_next();
+	}
+}
+
+#endif // (MAVLINK_FTP == 1)
+
 #endif // (USE_MAVLINK == 1)
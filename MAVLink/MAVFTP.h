@@ -22,125 +22,76 @@
 #ifndef MAVFTP_H
 #define MAVFTP_H
 
-/*
-*
-* MAVLink remote file server.
-*
-* Messages are wrapped in ENCAPSULATED_DATA messages. Every message includes
-* a session ID and sequence number.
-*
-* A limited number of requests (currently 2) may be outstanding at a time.
-* Additional messages will be discarded.
-*
-* Messages consist of a fixed header, followed by a data area.
-*
-*/
-//#include <dirent.h>
-//#include <queue.h>
-
-//#include <nuttx/wqueue.h>
-//#include <systemlib/err.h>
-
-//#include "mavlink_messages.h"
-
-//class MavlinkFTP
-//{
-//public:
-//MavlinkFTP();
-typedef struct tag_Mavlink
-{
-//	len = mavlink_msg_encapsulated_data_pack_chan(_mavlink->get_system_id(), _mavlink->get_component_id(), _mavlink->get_channel(), &msg, sequence(), rawData());
-	int get_system_id;
-	int get_component_id;
-	int get_channel;
-} Mavlink;
-
-typedef struct tag_MavlinkFTP
-{
-	int bar;
-} MavlinkFTP;
-
-MavlinkFTP* getServer(void);
-
-// static interface
-void handle_message(Mavlink* mavlink, mavlink_message_t *msg);
-
-//private:
-
-enum Opcode //: uint8_t
-{
-	kCmdNone,	// ignored, always acked
-	kCmdTerminate,	// releases sessionID, closes file
-	kCmdReset,	// terminates all sessions
-	kCmdList,	// list files in <path> from <offset>
-	kCmdOpen,	// opens <path> for reading, returns <session>
-	kCmdRead,	// reads <size> bytes from <offset> in <session>
-	kCmdCreate,	// creates <path> for writing, returns <session>
-	kCmdWrite,	// appends <size> bytes at <offset> in <session>
-	kCmdRemove,	// remove file (only if created by server?)
-
-	kRspAck,
-	kRspNak
-};
-
-enum ErrorCode //: uint8_t
-{
-	kErrNone,
-	kErrNoRequest,
-	kErrNoSession,
-	kErrSequence,
-	kErrNotDir,
-	kErrNotFile,
-	kErrEOF,
-	kErrNotAppend,
-	kErrTooBig,
-	kErrIO,
-	kErrPerm
+// MAVLink FTP server.
+//
+// Serves the on-board file system to the ground station using the MAVLink FTP
+// protocol, carried in FILE_TRANSFER_PROTOCOL messages. Every request carries a
+// sequence number, and every reply the request's sequence number plus one.
+// One request is handled at a time; any others which arrive meanwhile are
+// discarded, and will be sent again by the client.
+//
+// Requests are taken from the link by MAVFTPHandleMessage(), carried out at
+// background priority by MAVFTPService() as file access is slow, and the
+// replies sent by MAVFTPOutput_40hz(). A burst read keeps MAVLINK_FTP_WINDOW
+// replies queued ahead of the link, and the transmit queue is refilled as
+// fast as the link drains it.
+
+#define MAVFTP_DATA_MAX         239     // MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN less the header
+
+// The payload of a FILE_TRANSFER_PROTOCOL message
+typedef struct mavftp_payload {
+	uint16_t seq;               // sequence number of the message
+	uint8_t  session;           // session id of an open file
+	uint8_t  opcode;            // one of MAVFTP_OP_*
+	uint8_t  size;              // number of bytes used in data
+	uint8_t  req_opcode;        // in replies, the opcode of the request
+	uint8_t  burst_complete;    // in burst replies, set on the last of the burst
+	uint8_t  padding;
+	uint32_t offset;            // file offset, or directory entry for a listing
+	uint8_t  data[MAVFTP_DATA_MAX];
+} mavftp_payload_t;
+
+enum mavftp_opcode {
+	MAVFTP_OP_NONE = 0,         // ignored, always acked
+	MAVFTP_OP_TERMINATE,        // releases <session>, closing its file
+	MAVFTP_OP_RESET,            // terminates all sessions
+	MAVFTP_OP_LIST,             // lists files in <path> from entry <offset>
+	MAVFTP_OP_OPEN_RO,          // opens <path> for reading, returns <session> and the file size
+	MAVFTP_OP_READ,             // reads <size> bytes from <offset> in <session>
+	MAVFTP_OP_CREATE,           // creates <path> for writing, returns <session>
+	MAVFTP_OP_WRITE,            // writes <size> bytes at <offset> in <session>
+	MAVFTP_OP_REMOVE,           // removes the file <path>
+	MAVFTP_OP_MKDIR,
+	MAVFTP_OP_RMDIR,
+	MAVFTP_OP_OPEN_WO,          // opens <path> for writing, returns <session>
+	MAVFTP_OP_TRUNCATE,
+	MAVFTP_OP_RENAME,
+	MAVFTP_OP_CRC32,            // returns the CRC32 of the file <path>
+	MAVFTP_OP_BURST_READ,       // reads <session> from <offset> to the end, in a burst of replies
+	MAVFTP_OP_ACK = 128,
+	MAVFTP_OP_NAK
 };
 
-typedef struct tag_RequestHeader
-{
-	uint8_t	magic;
-	uint8_t	session;
-	uint8_t	opcode;
-	uint8_t	size;
-	uint32_t crc32;
-	uint32_t offset;
-	uint8_t	data[];
-} RequestHeader;
-
-//class Request
-typedef struct tag_Request
-{
-	int rawData;
-	int dataSize;
-//	public:
-	union {
-		//dq_entry_t entry;
-		//work_s     work;
-		int entry;
-		int work;
-	};
-	Mavlink* _mavlink;
-	mavlink_encapsulated_data_t _message;
-} Request;
-
-struct dirent {
-	int d_type;
-	char d_name[13];
+// The first data byte of a NAK
+enum mavftp_error {
+	MAVFTP_ERR_NONE = 0,
+	MAVFTP_ERR_FAIL,
+	MAVFTP_ERR_FAIL_ERRNO,
+	MAVFTP_ERR_INVALID_DATA_SIZE,
+	MAVFTP_ERR_INVALID_SESSION,
+	MAVFTP_ERR_NO_SESSIONS_AVAILABLE,
+	MAVFTP_ERR_EOF,
+	MAVFTP_ERR_UNKNOWN_COMMAND,
+	MAVFTP_ERR_FILE_EXISTS,
+	MAVFTP_ERR_FILE_PROTECTED,
+	MAVFTP_ERR_FILE_NOT_FOUND
 };
 
-#define ErrorCode int
-
-#define DIR int
-#define DTYPE_FILE      1
-#define DTYPE_DIRECTORY 2
-
-
-//boolean decode(Mavlink* mavlink, mavlink_message_t* fromMessage);
-
 boolean MAVFTPHandleMessage(mavlink_message_t* handle_msg);
 void MAVFTPOutput_40hz(void);
 
+// called from mainloop at background priority to carry out file operations
+void MAVFTPService(void);
+
 
 #endif // MAVFTP_H
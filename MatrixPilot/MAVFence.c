@@ -0,0 +1,106 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009, 2010 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "../MatrixPilot/defines.h"
+#include "options_mavlink.h"
+
+#if (USE_MAVLINK == 1) && (USE_GEOFENCE == 1)
+
+#include "MAVLink.h"
+#include "MAVFence.h"
+#include "geofence.h"
+
+#define FENCE_POINT_PACKET_LEN  (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_FENCE_POINT_LEN)
+
+// The point last asked for, which is sent by MAVFenceOutput_40hz()
+static volatile boolean fetch_pending = false;
+static uint8_t fetch_idx;
+static mavlink_channel_t fetch_chan;
+static uint8_t fetch_sysid;
+static uint8_t fetch_compid;
+
+static inline void FencePoint(mavlink_message_t* handle_msg)
+{
+	mavlink_fence_point_t packet;
+
+	mavlink_msg_fence_point_decode(handle_msg, &packet);
+	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
+	if (!geofence_set_point(packet.idx, packet.count,
+	                        (int32_t)(packet.lat * 10000000.0), (int32_t)(packet.lng * 10000000.0)))
+	{
+		DPRINT("fence point %u of %u rejected, FENCE_TOTAL is %i\r\n", packet.idx, packet.count, geofence_total);
+	}
+}
+
+static inline void FenceFetchPoint(mavlink_message_t* handle_msg)
+{
+	mavlink_fence_fetch_point_t packet;
+
+	mavlink_msg_fence_fetch_point_decode(handle_msg, &packet);
+	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
+	if (!fetch_pending)
+	{
+		fetch_idx = packet.idx;
+		fetch_chan = mavlink_gcs_chan;
+		fetch_sysid = handle_msg->sysid;
+		fetch_compid = handle_msg->compid;
+		fetch_pending = true;
+	}
+}
+
+boolean MAVFenceHandleMessage(mavlink_message_t* handle_msg)
+{
+	switch (handle_msg->msgid)
+	{
+		case MAVLINK_MSG_ID_FENCE_POINT:
+			FencePoint(handle_msg);
+			break;
+		case MAVLINK_MSG_ID_FENCE_FETCH_POINT:
+			FenceFetchPoint(handle_msg);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+void MAVFenceOutput_40hz(void)
+{
+	int32_t lat;
+	int32_t lon;
+
+	if (!fetch_pending || !mavlink_chan_tx_room(fetch_chan, FENCE_POINT_PACKET_LEN))
+	{
+		return;
+	}
+	if (geofence_get_point(fetch_idx, &lat, &lon))
+	{
+		mavlink_msg_fence_point_send(fetch_chan, fetch_sysid, fetch_compid, fetch_idx,
+		                             geofence_point_count(), lat / 10000000.0, lon / 10000000.0);
+	}
+	else
+	{
+		DPRINT("fence point %u requested, only %u points\r\n", fetch_idx, geofence_point_count());
+	}
+	fetch_pending = false;
+}
+
+#endif // (USE_MAVLINK == 1) && (USE_GEOFENCE == 1)
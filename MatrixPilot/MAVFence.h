@@ -0,0 +1,33 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef MAVFENCE_H
+#define MAVFENCE_H
+
+// MAVLink fence protocol. The ground station sets the FENCE_TOTAL parameter,
+// and then sends each point with FENCE_POINT. It reads the fence back one
+// point at a time with FENCE_FETCH_POINT, to which the reply is a FENCE_POINT.
+
+boolean MAVFenceHandleMessage(mavlink_message_t* handle_msg);
+void MAVFenceOutput_40hz(void);
+
+
+#endif // MAVFENCE_H
@@ -99,19 +99,19 @@ void MAVFlexiFunctionsOutput_40hz(void)
 	switch (flexiFunctionState)
 	{
 		case FLEXIFUNCTION_BUFFER_FUNCTION_ACKNOWLEDGE:
-			mavlink_msg_flexifunction_buffer_function_ack_send(MAVLINK_COMM_0, 0, 0, flexifunction_ref_index, flexifunction_ref_result);
+			mavlink_msg_flexifunction_buffer_function_ack_send(mavlink_gcs_chan, 0, 0, flexifunction_ref_index, flexifunction_ref_result);
 			flexiFunctionState = FLEXIFUNCTION_WAITING;
 			break;
 		case FLEXIFUNCTION_INPUT_DIRECTORY_ACKNOWLEDGE:
-			mavlink_msg_flexifunction_directory_ack_send(MAVLINK_COMM_0, 0, 0, 1, 0, 32, flexifunction_ref_result);
+			mavlink_msg_flexifunction_directory_ack_send(mavlink_gcs_chan, 0, 0, 1, 0, 32, flexifunction_ref_result);
 			flexiFunctionState = FLEXIFUNCTION_WAITING;
 			break;
 		case FLEXIFUNCTION_OUTPUT_DIRECTORY_ACKNOWLEDGE:
-			mavlink_msg_flexifunction_directory_ack_send(MAVLINK_COMM_0, 0, 0, 0, 0, 32, flexifunction_ref_result);
+			mavlink_msg_flexifunction_directory_ack_send(mavlink_gcs_chan, 0, 0, 0, 0, 32, flexifunction_ref_result);
 			flexiFunctionState = FLEXIFUNCTION_WAITING;
 			break;
 		case FLEXIFUNCTION_COMMAND_ACKNOWLEDGE:
-			mavlink_msg_flexifunction_command_ack_send(MAVLINK_COMM_0, flexifunction_ref_command, flexifunction_ref_result);
+			mavlink_msg_flexifunction_command_ack_send(mavlink_gcs_chan, flexifunction_ref_command, flexifunction_ref_result);
 			flexiFunctionState = FLEXIFUNCTION_WAITING;
 			break;
 
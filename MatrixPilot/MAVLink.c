@@ -58,6 +58,7 @@
 #include "MAVMission.h"
 #include "MAVFlexiFunctions.h"
 #include "MAVUDBExtra.h"
+#include "MAVFence.h"
 #include "../MAVLink/MAVFTP.h"
 
 //#if (SILSIM != 1)
@@ -74,7 +75,11 @@
 #include "../libUDB/serialIO.h"
 #include "../libUDB/ADchannel.h"
 #include "../libUDB/events.h"
+#include "../libUDB/interrupt.h"
 #include "telemetry_log.h"
+#include "profile.h"
+#include "geofence.h"
+#include "ring_buffer.h"
 #include "euler_angles.h"
 #include "config.h"
 #include <string.h>
@@ -113,25 +118,54 @@ mavlink_status_t r_mavlink_status;
 
 mavlink_status_t m_mavlink_status[MAVLINK_COMM_NUM_BUFFERS];
 
-#define SERIAL_BUFFER_SIZE  MAVLINK_MAX_PACKET_LEN
 #define BYTE_CIR_16_TO_RAD  ((2.0 * 3.14159265) / 65536.0) // Convert 16 bit byte circular to radians
 
 mavlink_flags_t mavlink_flags;
 mavlink_system_t mavlink_system;
 
 static uint16_t mavlink_process_message_handle = INVALID_HANDLE;
-static uint8_t handling_of_message_completed = true;
 
 static uint8_t mavlink_counter_40hz = 0;
 static uint64_t usec = 0; // A measure of time in microseconds (should be from Unix Epoch).
 static uint32_t msec = 0; // A measure of time in microseconds (should be from Unix Epoch).
 
-static int16_t sb_index = 0;
-static int16_t end_index = 0;
-static char serial_interrupt_stopped = 1;
-static uint8_t serial_buffer[SERIAL_BUFFER_SIZE];
+// A reservation may have to skip the end of a ring, so each must be able
+// to hold two packets for one to always fit once the ring has drained.
+#if (MAVLINK_TX_QUEUE_SIZE <= 2 * MAVLINK_MAX_PACKET_LEN)
+#error "MAVLINK_TX_QUEUE_SIZE must be more than twice MAVLINK_MAX_PACKET_LEN"
+#endif
+
+// Each MAVLink channel has its own transmit ring and stream rate table.
+// Packets are encoded by the MAVLink helpers straight into a reservation in
+// the ring (see mavlink_start_uart_send), which the transmitter then drains
+// in place. The log channel has no ring, its packets are encoded straight
+// into the telemetry log's queue instead.
+typedef struct mavlink_channel_state {
+	boolean active;
+	boolean to_log;
+	ring_t tx;
+	uint8_t* tx_packet;             // open reservation, NULL if the packet is being dropped
+	uint16_t tx_packet_len;
+	boolean tx_packet_open;
+	uint16_t tx_saved_ipl;          // priority to return to when the packet is committed
+	volatile boolean tx_stopped;
+	void (*start_sending)(void);    // NULL for polled transports
+	uint8_t streamRates[MAV_DATA_STREAM_ENUM_END];
+	float previous_earth_pitch;
+	float previous_earth_roll;
+	float previous_earth_yaw;
+	uint8_t profile_section;        // the next code section timing to send
+	mavlink_status_t rx_status;
+} mavlink_channel_state_t;
+
+static mavlink_channel_state_t mavlink_channels[MAVLINK_NUM_CHANNELS];
+static uint8_t telemetry_tx_queue[MAVLINK_TX_QUEUE_SIZE];
+#if (MAVLINK_USB_CHANNEL == 1)
+static uint8_t usb_tx_queue[MAVLINK_TX_QUEUE_SIZE];
+#endif
+
+mavlink_channel_t mavlink_gcs_chan = MAVLINK_COMM_TELEMETRY;
 
-static uint8_t streamRates[MAV_DATA_STREAM_ENUM_END];
 static uint16_t mavlink_command_ack_command = 0;
 static boolean mavlink_send_command_ack = false;
 static uint16_t mavlink_command_ack_result = 0;
@@ -143,26 +177,62 @@ static inline void preflight_storage_complete_callback(boolean success);
 #endif // (USE_NV_MEMORY == 1)
 
 
-void mavlink_init(void)
+static void mavlink_telemetry_start_sending(void)
+{
+#if (SILSIM == 1)
+	mavlink_start_sending_data();
+#else
+	udb_serial_start_sending_data();
+#endif
+}
+
+static void mavlink_chan_init(mavlink_channel_t chan, uint8_t* tx_buffer, uint16_t tx_size, void (*start_sending)(void))
 {
+	mavlink_channel_state_t* c = &mavlink_channels[chan];
 	int16_t index;
 
+	c->active = true;
+	c->to_log = false;
+	ring_init(&c->tx, tx_buffer, tx_size);
+	c->tx_packet = NULL;
+	c->tx_packet_open = false;
+	c->tx_stopped = true;
+	c->start_sending = start_sending;
+
+	// Fill stream rates array with zeros to default all streams off;
+	for (index = 0; index < MAV_DATA_STREAM_ENUM_END; index++)
+		c->streamRates[index] = 0;
+
+	// QGroundControl GCS lets user send message to increase stream rate
+	c->streamRates[MAV_DATA_STREAM_RC_CHANNELS] = MAVLINK_RATE_RC_CHAN;
+	c->streamRates[MAV_DATA_STREAM_RAW_SENSORS] = MAVLINK_RATE_RAW_SENSORS;
+	c->streamRates[MAV_DATA_STREAM_POSITION]    = MAVLINK_RATE_POSITION;
+	c->streamRates[MAV_DATA_STREAM_EXTRA1]      = MAVLINK_RATE_SUE;
+	c->streamRates[MAV_DATA_STREAM_EXTRA2]      = MAVLINK_RATE_POSITION_SENSORS;
+}
+
+void mavlink_init(void)
+{
 	udb_init_USART(&mavlink_callback_get_byte_to_send, &mavlink_callback_received_byte);
 	udb_serial_set_rate(MAVLINK_BAUD);
 	mavlink_process_message_handle = register_event_p(&handleMessage, EVENT_PRIORITY_MEDIUM);
 	mavlink_system.sysid = MAVLINK_SYSID; // System ID, 1-255, ID of your Plane for GCS
 	mavlink_system.compid = 1; // Component/Subsystem ID,  (1-255) MatrixPilot on UDB is component 1.
 
-	// Fill stream rates array with zeros to default all streams off;
-	for (index = 0; index < MAV_DATA_STREAM_ENUM_END; index++)
-		streamRates[index] = 0;
-
-	// QGroundControl GCS lets user send message to increase stream rate
-	streamRates[MAV_DATA_STREAM_RC_CHANNELS] = MAVLINK_RATE_RC_CHAN;
-	streamRates[MAV_DATA_STREAM_RAW_SENSORS] = MAVLINK_RATE_RAW_SENSORS;
-	streamRates[MAV_DATA_STREAM_POSITION]    = MAVLINK_RATE_POSITION;
-	streamRates[MAV_DATA_STREAM_EXTRA1]      = MAVLINK_RATE_SUE;
-	streamRates[MAV_DATA_STREAM_EXTRA2]      = MAVLINK_RATE_POSITION_SENSORS;
+	mavlink_chan_init(MAVLINK_COMM_TELEMETRY, telemetry_tx_queue, sizeof(telemetry_tx_queue), &mavlink_telemetry_start_sending);
+	ring_attach(&mavlink_channels[MAVLINK_COMM_TELEMETRY].tx, RING_READER_TX, true);
+#if (MAVLINK_USB_CHANNEL == 1)
+	mavlink_chan_init(MAVLINK_COMM_USB, usb_tx_queue, sizeof(usb_tx_queue), NULL); // polled from CDCTasks()
+	ring_attach(&mavlink_channels[MAVLINK_COMM_USB].tx, RING_READER_TX, true);
+#endif
+#if (USE_TELELOG == 1)
+	// The log channel's packets are only queued while a log file is open
+	mavlink_chan_init(MAVLINK_COMM_LOG, NULL, 0, NULL);
+	mavlink_channels[MAVLINK_COMM_LOG].to_log = true;
+	mavlink_channels[MAVLINK_COMM_LOG].streamRates[MAV_DATA_STREAM_RAW_SENSORS] = MAVLINK_LOG_RATE_RAW_SENSORS;
+	mavlink_channels[MAVLINK_COMM_LOG].streamRates[MAV_DATA_STREAM_POSITION]    = MAVLINK_LOG_RATE_POSITION;
+	mavlink_channels[MAVLINK_COMM_LOG].streamRates[MAV_DATA_STREAM_EXTRA1]      = MAVLINK_LOG_RATE_SUE;
+#endif
 }
 
 //void init_serial(void)
@@ -181,64 +251,157 @@ void mavlink_init(void)
 //
 //}
 
-int16_t mavlink_callback_get_byte_to_send(void)
+// called by the transmitter of a channel (UART TX interrupt, USB CDC task) for its next byte
+int16_t mavlink_chan_get_byte_to_send(mavlink_channel_t chan)
 {
-	if (sb_index < end_index && sb_index < SERIAL_BUFFER_SIZE) // ensure never end up racing thru memory.
+	mavlink_channel_state_t* c = &mavlink_channels[chan];
+	int16_t txchar = ring_get(&c->tx, RING_READER_TX);
+
+	if (txchar == -1)
 	{
-		uint8_t txchar = serial_buffer[sb_index++];
-		return txchar;
+		c->tx_stopped = true;
 	}
-	else
+	return txchar;
+}
+
+int16_t mavlink_callback_get_byte_to_send(void)
+{
+	return mavlink_chan_get_byte_to_send(MAVLINK_COMM_TELEMETRY);
+}
+
+// packets refused because the channel's transmit ring was full
+uint16_t mavlink_chan_tx_dropped(mavlink_channel_t chan)
+{
+	return mavlink_channels[chan].tx.overflows;
+}
+
+// true if a packet of len bytes can be queued on the channel now
+boolean mavlink_chan_tx_room(mavlink_channel_t chan, uint16_t len)
+{
+	if (chan >= MAVLINK_NUM_CHANNELS || !mavlink_channels[chan].active)
 	{
-		serial_interrupt_stopped = 1;
+		return false;
 	}
-	return -1;
+	return ring_has_room(&mavlink_channels[chan].tx, len);
 }
 
-//int16_t mavlink_serial_send(mavlink_channel_t UNUSED(chan), uint8_t buf[], uint16_t len)
-int16_t mavlink_serial_send(mavlink_channel_t UNUSED(chan), const uint8_t buf[], uint16_t len) // RobD
-// Note: Channel Number, chan, is currently ignored.
+static uint8_t* mavlink_chan_reserve(mavlink_channel_state_t* c, uint16_t len)
 {
-	int16_t start_index;
-	int16_t remaining;
+#if (USE_TELELOG == 1)
+	if (c->to_log)
+	{
+		return log_reserve(len);
+	}
+#endif
+	return ring_reserve(&c->tx, len);
+}
 
+static void mavlink_chan_commit(mavlink_channel_state_t* c, uint16_t len)
+{
 #if (USE_TELELOG == 1)
-//printf("calling log_telemetry with %u bytes\r\n", len);
-	log_telemetry((const char*)buf, len);
-#endif // USE_TELELOG
+	if (c->to_log)
+	{
+		log_commit(len);
+		return;
+	}
+#endif
+	ring_commit(&c->tx, len);
+	if (c->tx_stopped)
+	{
+		c->tx_stopped = false;
+		if (c->start_sending)
+		{
+			c->start_sending();
+		}
+	}
+}
 
-	// Note at the moment, all channels lead to the one serial port
-	if (serial_interrupt_stopped == 1)
+// Packets are written both by mavlink_output_40hz() from the heartbeat and by
+// the replies made from handleMessage() at the lower EVENTM priority. The ring
+// has a single writer, so a writer holds the heartbeat priority from its
+// reservation to its commit, which is no more than the encoding of one packet.
+#if (SILSIM != 1 && PX4 != 1)
+#define MAVLINK_TX_LOCK(saved)                  \
+	{                                           \
+		saved = SRbits.IPL;                     \
+		if (saved < INT_PRI_T6)                 \
+		{                                       \
+			SRbits.IPL = INT_PRI_T6;            \
+		}                                       \
+	}
+#define MAVLINK_TX_UNLOCK(saved)    { SRbits.IPL = saved; }
+#else
+#define MAVLINK_TX_LOCK(saved)      { saved = 0; }
+#define MAVLINK_TX_UNLOCK(saved)    { (void)saved; }
+#endif
+
+// Called by the MAVLink helpers before the pieces of a packet are sent.
+// Reserve room for the whole packet, or for none of it, as sending a partial
+// packet will break MAVLink CRC checks and the receiver will throw it away anyway.
+void mavlink_start_uart_send(mavlink_channel_t chan, uint16_t len)
+{
+	mavlink_channel_state_t* c;
+
+	if (chan >= MAVLINK_NUM_CHANNELS || !mavlink_channels[chan].active)
 	{
-		sb_index = 0;
-		end_index = 0;
+		return;
 	}
-	start_index = end_index;
-	remaining = SERIAL_BUFFER_SIZE - start_index;
+	c = &mavlink_channels[chan];
+	MAVLINK_TX_LOCK(c->tx_saved_ipl);
+	c->tx_packet = mavlink_chan_reserve(c, len);
+	c->tx_packet_len = 0;
+	c->tx_packet_open = true;
+}
 
-//	printf("%u\r\n", remaining);
+void mavlink_end_uart_send(mavlink_channel_t chan, uint16_t len)
+{
+	mavlink_channel_state_t* c;
 
-	if (len > remaining)
+	if (chan >= MAVLINK_NUM_CHANNELS || !mavlink_channels[chan].active)
+	{
+		return;
+	}
+	c = &mavlink_channels[chan];
+	if (c->tx_packet)
+	{
+		mavlink_chan_commit(c, c->tx_packet_len);
+		c->tx_packet = NULL;
+	}
+	c->tx_packet_open = false;
+	MAVLINK_TX_UNLOCK(c->tx_saved_ipl);
+}
+
+int16_t mavlink_serial_send(mavlink_channel_t chan, const uint8_t buf[], uint16_t len)
+{
+	mavlink_channel_state_t* c;
+	uint16_t saved_ipl;
+	uint8_t* p;
+
+	if (chan >= MAVLINK_NUM_CHANNELS || !mavlink_channels[chan].active)
 	{
-		// Chuck away the entire packet, as sending partial packet
-		// will break MAVLink CRC checks, and so receiver will throw it away anyway.
 		return (-1);
 	}
-	if (remaining > 1)
+	c = &mavlink_channels[chan];
+	if (c->tx_packet_open)
 	{
-		memcpy(&serial_buffer[start_index], buf, len);
-		end_index = start_index + len;
+		// part of a packet, encoded straight into its reservation
+		if (c->tx_packet == NULL)
+		{
+			return (-1);
+		}
+		memcpy(&c->tx_packet[c->tx_packet_len], buf, len);
+		c->tx_packet_len += len;
+		return (1);
 	}
-	if (serial_interrupt_stopped == 1)
+	MAVLINK_TX_LOCK(saved_ipl);
+	p = mavlink_chan_reserve(c, len);
+	if (p != NULL)
 	{
-		serial_interrupt_stopped = 0;
-#if (SILSIM == 1)
-		mavlink_start_sending_data();
-#else
-		udb_serial_start_sending_data();
-#endif
+		memcpy(p, buf, len);
+		mavlink_chan_commit(c, len);
 	}
-	return (1);
+	MAVLINK_TX_UNLOCK(saved_ipl);
+	return (p != NULL ? 1 : -1);
 }
 
 void mav_printf(const char* format, ...)
@@ -250,7 +413,7 @@ void mav_printf(const char* format, ...)
 	vsnprintf(buf, sizeof(buf), format, arglist);
 	// mavlink_msg_statustext_send(MAVLINK_COMM_1, severity, text);
 	// severity: Severity of status, 0 = info message, 255 = critical fault (uint8_t)
-	mavlink_msg_statustext_send(MAVLINK_COMM_0, 0, buf);
+	mavlink_msg_statustext_send(mavlink_gcs_chan, 0, buf);
 	va_end(arglist);
 }
 
@@ -302,7 +465,7 @@ void send_text(uint8_t text[])
 		; // Do nothing, just measuring the length of the text
 	}
 //printf("send_text(%s) %u\r\n", text, index);
-	mavlink_serial_send(MAVLINK_COMM_0, text, index - 1);
+	mavlink_serial_send(MAVLINK_COMM_TELEMETRY, text, index - 1);
 }
 
 // A simple routine for sending a uint8_t number as 2 bytes of hexadecimal text
@@ -335,29 +498,48 @@ void send_text(uint8_t text[])
 // MAIN MATRIXPILOT MAVLINK CODE FOR RECEIVING COMMANDS FROM THE GROUND CONTROL STATION
 //
 
-static mavlink_message_t msg[2];
-static uint8_t mavlink_message_index = 0;
-static mavlink_status_t r_mavlink_status;
+// The telemetry UART is parsed in its receive interrupt, and the USB port in
+// the USB task at background level, so each receiving channel has a pair of
+// message buffers of its own: one being parsed into, the other holding the
+// last message for handleMessage(). A channel's messages are dropped while
+// its last one is still waiting to be handled.
+typedef struct mavlink_rx_state {
+	mavlink_message_t msg[2];
+	uint8_t index;                  // the buffer being parsed into
+	volatile boolean pending;       // the other buffer holds a message to handle
+} mavlink_rx_state_t;
 
-//void udb_serial_callback_received_byte(uint8_t rxchar)
-void mavlink_callback_received_byte(uint8_t rxchar)
+#define MAVLINK_NUM_RX_CHANNELS (1 + MAVLINK_USB_CHANNEL)
+
+static mavlink_rx_state_t mavlink_rx[MAVLINK_NUM_RX_CHANNELS];
+
+void mavlink_chan_received_byte(mavlink_channel_t chan, uint8_t rxchar)
 {
+	mavlink_rx_state_t* rx;
+
 //	DPRINT("%u \r\n", rxchar);
 
-	if (mavlink_parse_char(0, rxchar, &msg[mavlink_message_index], &r_mavlink_status))
+	if (chan >= MAVLINK_NUM_RX_CHANNELS) return;
+	rx = &mavlink_rx[chan];
+	if (mavlink_parse_char(chan, rxchar, &rx->msg[rx->index], &mavlink_channels[chan].rx_status))
 	{
 		// Check that handling of previous message has completed before calling again
-		if (handling_of_message_completed == true)
+		if (rx->pending == false)
 		{
 			// Switch between incoming message buffers
-			if (mavlink_message_index == 0) mavlink_message_index = 1;
-			else mavlink_message_index = 0;
-			handling_of_message_completed = false;
+			rx->index ^= 1;
+			rx->pending = true;
 			trigger_event(mavlink_process_message_handle);
 		}
 	}
 }
 
+//void udb_serial_callback_received_byte(uint8_t rxchar)
+void mavlink_callback_received_byte(uint8_t rxchar)
+{
+	mavlink_chan_received_byte(MAVLINK_COMM_TELEMETRY, rxchar);
+}
+
 boolean mavlink_check_target(uint8_t target_system, uint8_t target_component)
 {
 	if ((target_system == mavlink_system.sysid)
@@ -387,6 +569,8 @@ static void command_ack(uint16_t command, uint16_t result)
 
 static void MAVLinkRequestDataStream(mavlink_message_t* handle_msg) // MAVLINK_MSG_ID_REQUEST_DATA_STREAM
 {
+	// stream rates are set for the channel on which the request arrived
+	uint8_t* streamRates = mavlink_channels[mavlink_gcs_chan].streamRates;
 	int16_t freq = 0; // packet frequency
 	mavlink_request_data_stream_t packet;
 	mavlink_msg_request_data_stream_decode(handle_msg, &packet);
@@ -632,27 +816,23 @@ void MAVLinkSetMode(mavlink_message_t* handle_msg) // MAVLINK_MSG_ID_SET_MODE:
 // of that code.
 
 // This is the main routine for taking action against a parsed message from the GCS
-static void handleMessage(void)
+static void handleChannelMessage(mavlink_message_t* handle_msg)
 {
-	mavlink_message_t* handle_msg;
-
-	if (mavlink_message_index == 0)
-	{
-		handle_msg = &msg[1];
-	}
-	else
-	{
-		handle_msg = &msg[0];
-	}
+	boolean handled = false;
 
 //	DPRINT("MAV MSG 0x%x\r\n", handle_msg->msgid);
 
-	handling_of_message_completed |= MAVParamsHandleMessage(handle_msg);
-	handling_of_message_completed |= MAVMissionHandleMessage(handle_msg);
-	handling_of_message_completed |= MAVFlexiFunctionsHandleMessage(handle_msg);
-//	handling_of_message_completed |= MAVFTPHandleMessage(handle_msg); // WIP - RobD
+	handled |= MAVParamsHandleMessage(handle_msg);
+	handled |= MAVMissionHandleMessage(handle_msg);
+	handled |= MAVFlexiFunctionsHandleMessage(handle_msg);
+#if (MAVLINK_FTP == 1)
+	handled |= MAVFTPHandleMessage(handle_msg);
+#endif
+#if (USE_GEOFENCE == 1)
+	handled |= MAVFenceHandleMessage(handle_msg);
+#endif
 
-	if (handling_of_message_completed != false)
+	if (handled != false)
 	{
 		return;
 	}
@@ -678,7 +858,25 @@ static void handleMessage(void)
 //			DPRINT("handle_msg->msgid %u NOT HANDLED\r\n", handle_msg->msgid);
 			break;
 	}
-	handling_of_message_completed = true;
+}
+
+// Handle the message waiting on each channel. Replies go out on the channel
+// the message came in on.
+static void handleMessage(void)
+{
+	mavlink_rx_state_t* rx;
+	uint8_t chan;
+
+	for (chan = 0; chan < MAVLINK_NUM_RX_CHANNELS; chan++)
+	{
+		rx = &mavlink_rx[chan];
+		if (rx->pending)
+		{
+			mavlink_gcs_chan = (mavlink_channel_t)chan;
+			handleChannelMessage(&rx->msg[rx->index ^ 1]);
+			rx->pending = false;
+		}
+	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -751,28 +949,12 @@ static boolean mavlink_frequency_send(uint8_t frequency, uint8_t counter)
 	}
 	return false;
 }
-#endif // (MAVLINK_TEST_ENCODE_DECODE != 1)
 
-void mavlink_output_40hz(void)
-#if (MAVLINK_TEST_ENCODE_DECODE == 1)
+// Send the telemetry streams that are due this frame on one channel
+static void mavlink_output_streams(mavlink_channel_t chan)
 {
-	if (mavlink_test_first_pass_flag == 1)
-	{
-		serial_output("\r\nRunning MAVLink encode / decode Tests.\r\n");
-		// reset serial buffer in preparation for testing against buffer
-		mavlink_tests_pass = 0;
-		mavlink_tests_fail = 0;
-		mavlink_test_all(mavlink_system.sysid, mavlink_system.compid, &last_msg);
-		serial_output("\r\nMAVLink Tests Pass: %d\r\nMAVLink Tests Fail: %d\r\n", mavlink_tests_pass, mavlink_tests_fail);
-		mavlink_test_first_pass_flag = 0;
-	}
-}
-#else
-{
-	static float previous_earth_pitch = 0.0;
-	static float previous_earth_roll = 0.0;
-	static float previous_earth_yaw = 0.0;
-
+	mavlink_channel_state_t* c = &mavlink_channels[chan];
+	uint8_t* streamRates = c->streamRates;
 	struct relative2D matrix_accum;
 	float earth_pitch;              // pitch in radians with respect to earth
 	float earth_roll;               // roll in radians of the plane with respect to earth frame
@@ -798,11 +980,6 @@ void mavlink_output_40hz(void)
 
 	uint8_t spread_transmission_load = 0;   // Used to spread sending of different message types over a period of 1 second.
 
-	if (++mavlink_counter_40hz >= 40) mavlink_counter_40hz = 0;
-
-	usec += 25000;  // Frequency sensitive code
-	msec += 25;     // Frequency sensitive code
-
 	// Note that message types are arranged in order of importance so that if the serial buffer fills up,
 	// critical message types are more likely to still be transmitted.
 
@@ -835,7 +1012,7 @@ void mavlink_output_40hz(void)
 			mavlink_base_mode = MAV_MODE_TEST_ARMED; // Unknown state
 			mavlink_custom_mode = MAV_CUSTOM_UDB_MODE_MANUAL;
 		}
-		mavlink_msg_heartbeat_send(MAVLINK_COMM_0, MAV_TYPE_FIXED_WING, MAV_AUTOPILOT_UDB, mavlink_base_mode, mavlink_custom_mode, MAV_STATE_ACTIVE);
+		mavlink_msg_heartbeat_send(chan, MAV_TYPE_FIXED_WING, MAV_AUTOPILOT_UDB, mavlink_base_mode, mavlink_custom_mode, MAV_STATE_ACTIVE);
 		//mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t type, uint8_t autopilot, uint8_t base_mode, uint32_t custom_mode, uint8_t system_status)
 	}
 	// GPS RAW INT - Data from GPS Sensor sent as raw integers.
@@ -847,7 +1024,7 @@ void mavlink_output_40hz(void)
 			gps_fix_type = 3;
 		else
 			gps_fix_type = 0;
-		mavlink_msg_gps_raw_int_send(MAVLINK_COMM_0, usec, gps_fix_type, lat_gps.WW, lon_gps.WW, alt_sl_gps.WW, hdop, 65535, sog_gps.BB, cog_gps.BB, svs);
+		mavlink_msg_gps_raw_int_send(chan, usec, gps_fix_type, lat_gps.WW, lon_gps.WW, alt_sl_gps.WW, hdop, 65535, sog_gps.BB, cog_gps.BB, svs);
 	}
 
 	// GLOBAL POSITION INT - derived from fused sensors
@@ -874,7 +1051,7 @@ void mavlink_output_40hz(void)
 		alt = relative_alt + (alt_origin.WW * 10);          // In millimeters; more accurate if used IMUlocationz._.W0
 
 		mavlink_heading = get_geo_heading_angle() * 100;    // mavlink global position expects heading value x 100
-		mavlink_msg_global_position_int_send(MAVLINK_COMM_0, msec, lat, lon, alt, relative_alt,
+		mavlink_msg_global_position_int_send(chan, msec, lat, lon, alt, relative_alt,
 		    IMUvelocityy._.W1, IMUvelocityx._.W1, -IMUvelocityz._.W1, //  IMUVelocity upper word gives V in cm / second
 		        // MAVLink is using North,East,Down Frame (NED). MatrixPilot IMUVelocity is in earth frame (X is East, Y is North, Z is Up)
 		    mavlink_heading); // heading should be from 0 to 35999 meaning 0 to 359.99 degrees.
@@ -907,25 +1084,25 @@ void mavlink_output_40hz(void)
 		earth_yaw = (-accum) * BYTE_CIR_16_TO_RAD;  // Convert to Radians
 
 		// Beginning of frequency sensitive code
-		earth_pitch_velocity = (earth_pitch - previous_earth_pitch) * streamRates[MAV_DATA_STREAM_POSITION];
-		earth_roll_velocity  = (earth_roll  - previous_earth_roll)  * streamRates[MAV_DATA_STREAM_POSITION];
-		earth_yaw_velocity   = (earth_yaw   - previous_earth_yaw)   * streamRates[MAV_DATA_STREAM_POSITION];
+		earth_pitch_velocity = (earth_pitch - c->previous_earth_pitch) * streamRates[MAV_DATA_STREAM_POSITION];
+		earth_roll_velocity  = (earth_roll  - c->previous_earth_roll)  * streamRates[MAV_DATA_STREAM_POSITION];
+		earth_yaw_velocity   = (earth_yaw   - c->previous_earth_yaw)   * streamRates[MAV_DATA_STREAM_POSITION];
 		// End of frequency sensitive code
 
 // TODO: investigate why earth_yaw_velocity occasionally spikes with a value of over 50 or below 50..
 //		if (earth_yaw_velocity > 40.0 || earth_yaw_velocity < -40.0) {
 //			time_t ltime;
 //			time(&ltime);
-//			DPRINT("earth_yaw_velocity %f earth_yaw %f  previous_earth_yaw %f ", earth_yaw_velocity, earth_yaw, previous_earth_yaw);
+//			DPRINT("earth_yaw_velocity %f earth_yaw %f  previous_earth_yaw %f ", earth_yaw_velocity, earth_yaw, c->previous_earth_yaw);
 //			DPRINT("streamRates %u ", (unsigned int)streamRates[MAV_DATA_STREAM_POSITION]);
 //			DPRINT("%s\r\n", ctime(&ltime));
 //		}
 
-		previous_earth_pitch = earth_pitch;
-		previous_earth_roll  = earth_roll;
-		previous_earth_yaw   = earth_yaw;
+		c->previous_earth_pitch = earth_pitch;
+		c->previous_earth_roll  = earth_roll;
+		c->previous_earth_yaw   = earth_yaw;
 
-		mavlink_msg_attitude_send(MAVLINK_COMM_0,msec, earth_roll, earth_pitch, earth_yaw,
+		mavlink_msg_attitude_send(chan,msec, earth_roll, earth_pitch, earth_yaw,
 		    earth_roll_velocity, earth_pitch_velocity, earth_yaw_velocity);
 		//    mavlink_msg_attitude_send(mavlink_channel_t chan, uint32_t time_boot_ms, float roll, float pitch, float yaw,
 		//    float rollspeed, float pitchspeed, float yawspeed)
@@ -940,7 +1117,7 @@ void mavlink_output_40hz(void)
 		int16_t pwOut_max = 4000;
 		mavlink_heading = get_geo_heading_angle();
 		if (THROTTLE_CHANNEL_REVERSED == 1) pwOut_max = 2000;
-		mavlink_msg_vfr_hud_send(MAVLINK_COMM_0,
+		mavlink_msg_vfr_hud_send(chan,
 		    (float)(air_speed_3DIMU / 100.0),
 		    (float)(ground_velocity_magnitudeXY / 100.0),
 		    (int16_t)mavlink_heading,
@@ -955,7 +1132,7 @@ void mavlink_output_40hz(void)
 	spread_transmission_load = 18;
 	if (mavlink_frequency_send(MAVLINK_RATE_SYSTEM_STATUS, mavlink_counter_40hz + spread_transmission_load))
 	{
-		mavlink_msg_sys_status_send(MAVLINK_COMM_0,
+		mavlink_msg_sys_status_send(chan,
 		    0,              // Sensors fitted
 		    0,              // Sensors enabled
 		    0,              // Sensor health
@@ -971,11 +1148,20 @@ void mavlink_output_40hz(void)
 		        (int16_t)0,
 		    #endif
 		    100,                               // Remaining battery energy: (0%: 0, 100%: 100), -1: autopilot estimate the remaining battery
-		    r_mavlink_status.packet_rx_drop_count,
-		    0,              // errors_comm
+		    c->rx_status.packet_rx_drop_count,
+		    c->tx.overflows,    // errors_comm: packets dropped as the transmit queue was full
+#if (USE_TELELOG == 1)
+		    (uint16_t)((log_dropped_bytes() > 0xFFFF) ? 0xFFFF : log_dropped_bytes()), // errors_count1: bytes dropped by the telemetry log
+		    log_queue_high_water(), // errors_count2: most telemetry log blocks ever waiting to be written
+#else
 		    0,              // errors_count1
 		    0,              // errors_count2
+#endif
+#if (USE_PROFILING == 1)
+		    profile_frame_overruns(), // errors_count3: flight control frames which took longer than a heartbeat
+#else
 		    0,              // errors_count3
+#endif
 		    0);             // errors_count4
 
 		//mavlink_msg_sys_status_send(mavlink_channel_t chan, uint32_t onboard_control_sensors_present, uint32_t onboard_control_sensors_enabled,
@@ -983,8 +1169,37 @@ void mavlink_output_40hz(void)
 		//    uint16_t drop_rate_comm, uint16_t errors_comm, uint16_t errors_count1, uint16_t errors_count2, uint16_t errors_count3, uint16_t errors_count4)
 
 		// Sensor Indices: 0: 3D gyro, 1: 3D acc, 2: 3D mag, 3: absolute pressure, 4: differential pressure, 5: GPS, 6: optical flow, 7: computer vision position, 8: laser based position, 9: external ground-truth (Vicon or Leica). Controllers: 10: 3D angular rate control 11: attitude stabilization, 12: yaw position, 13: z/altitude control, 14: x/y position control, 15: motor outputs / control
+
+#if (USE_GEOFENCE == 1)
+		if (geofence_action != GEOFENCE_ACTION_NONE)
+		{
+			struct geofence_status fence;
+
+			geofence_get_status(&fence);
+			mavlink_msg_fence_status_send(chan, fence.breached, fence.breach_count, fence.breach_type, fence.breach_time);
+		}
+#endif // (USE_GEOFENCE == 1)
 	}
 
+#if (USE_PROFILING == 1)
+	// CODE SECTION TIMINGS - one section in each DEBUG_VECT, named after the section,
+	// with x = 50th percentile, y = 99th percentile and z = maximum, in microseconds
+	spread_transmission_load = 20;
+	if (mavlink_frequency_send(MAVLINK_RATE_PROFILE, mavlink_counter_40hz + spread_transmission_load))
+	{
+		struct profile_summary s;
+		char name[10];
+
+		profile_summarise((profile_section_t)c->profile_section, &s);
+		strncpy(name, s.name, sizeof(name));
+		mavlink_msg_debug_vect_send(chan, name, usec, s.p50_us, s.p99_us, s.max_us);
+		if (++c->profile_section >= PROFILE_SECTIONS)
+		{
+			c->profile_section = 0;
+		}
+	}
+#endif // (USE_PROFILING == 1)
+
 	// RC CHANNELS
 	// Channel values shifted left by 1, to divide by two, so values reflect PWM pulses in microseconds.
 	// mavlink_msg_rc_channels_raw_send(mavlink_channel_t chan, uint16_t chan1_raw, uint16_t chan2_raw,
@@ -993,7 +1208,7 @@ void mavlink_output_40hz(void)
 	spread_transmission_load = 24;
 	if (mavlink_frequency_send(streamRates[MAV_DATA_STREAM_RAW_SENSORS], mavlink_counter_40hz + spread_transmission_load))
 	{
-		mavlink_msg_rc_channels_raw_send(MAVLINK_COMM_0, msec,
+		mavlink_msg_rc_channels_raw_send(chan, msec,
 		    (uint16_t)((udb_pwIn[0]) >> 1),
 		    (uint16_t)((udb_pwIn[1]) >> 1),
 		    (uint16_t)((udb_pwIn[2]) >> 1),
@@ -1022,12 +1237,12 @@ void mavlink_output_40hz(void)
 	{
 #if (MAG_YAW_DRIFT == 1)    // Magnetometer is connected
 		extern int16_t magFieldRaw[];
-		mavlink_msg_raw_imu_send(MAVLINK_COMM_0, usec,
+		mavlink_msg_raw_imu_send(chan, usec,
 		    (int16_t)   udb_xaccel.value, (int16_t)   udb_yaccel.value, (int16_t) - udb_zaccel.value,
 		    (int16_t) - udb_xrate.value,  (int16_t) - udb_yrate.value,  (int16_t) - udb_zrate.value,
 		    (int16_t)   magFieldRaw[0],   (int16_t)   magFieldRaw[1],   (int16_t)   magFieldRaw[2]);
 #else // magnetometer is not connected
-		mavlink_msg_raw_imu_send(MAVLINK_COMM_0, usec,
+		mavlink_msg_raw_imu_send(chan, usec,
 		    (int16_t)   udb_xaccel.value, (int16_t)   udb_yaccel.value, (int16_t) - udb_zaccel.value,
 		    (int16_t) - udb_xrate.value,  (int16_t) - udb_yrate.value,  (int16_t) - udb_zrate.value,
 		    (int16_t)   0,                (int16_t)   0,                (int16_t)   0); // zero as mag not connected.
@@ -1040,14 +1255,14 @@ void mavlink_output_40hz(void)
 	spread_transmission_load = 36;
 	if (mavlink_frequency_send(streamRates[MAV_DATA_STREAM_EXTRA2], mavlink_counter_40hz + spread_transmission_load))
 	{
-		mavlink_msg_altitudes_send(MAVLINK_COMM_0, msec, alt_sl_gps.WW, relative_alt, 0, 0, 0, 0);
+		mavlink_msg_altitudes_send(chan, msec, alt_sl_gps.WW, relative_alt, 0, 0, 0, 0);
 		//mavlink_msg_altitudes_send(mavlink_channel_t chan, uint32_t time_boot_ms, int32_t alt_gps, int32_t alt_imu, int32_t alt_barometric, int32_t alt_optical_flow, int32_t alt_range_finder, int32_t alt_extra)
 	}
 
 	spread_transmission_load = 40;
 	if (mavlink_frequency_send(streamRates[MAV_DATA_STREAM_EXTRA2], mavlink_counter_40hz + spread_transmission_load))
 	{
-		mavlink_msg_airspeeds_send(MAVLINK_COMM_0, msec, 0, 0, 0, 0, 0, 0);
+		mavlink_msg_airspeeds_send(chan, msec, 0, 0, 0, 0, 0, 0);
 		//mavlink_msg_airspeeds_send(mavlink_channel_t chan, uint32_t time_boot_ms, int16_t airspeed_imu, int16_t airspeed_pitot, int16_t airspeed_hot_wire, int16_t airspeed_ultrasonic, int16_t aoa, int16_t aoy)
 	}
 
@@ -1056,22 +1271,59 @@ void mavlink_output_40hz(void)
 	spread_transmission_load = 10;
 	if (mavlink_frequency_send(streamRates[MAV_DATA_STREAM_EXTRA1], mavlink_counter_40hz + spread_transmission_load)) // SUE code historically ran at 8HZ
 	{
-		MAVUDBExtraOutput(); // Designed to be called at 8Hz.
+		MAVUDBExtraOutput(chan); // Designed to be called at 8Hz.
+	}
+}
+#endif // (MAVLINK_TEST_ENCODE_DECODE != 1)
+
+void mavlink_output_40hz(void)
+#if (MAVLINK_TEST_ENCODE_DECODE == 1)
+{
+	if (mavlink_test_first_pass_flag == 1)
+	{
+		serial_output("\r\nRunning MAVLink encode / decode Tests.\r\n");
+		// reset serial buffer in preparation for testing against buffer
+		mavlink_tests_pass = 0;
+		mavlink_tests_fail = 0;
+		mavlink_test_all(mavlink_system.sysid, mavlink_system.compid, &last_msg);
+		serial_output("\r\nMAVLink Tests Pass: %d\r\nMAVLink Tests Fail: %d\r\n", mavlink_tests_pass, mavlink_tests_fail);
+		mavlink_test_first_pass_flag = 0;
+	}
+}
+#else
+{
+	int16_t chan;
+
+	if (++mavlink_counter_40hz >= 40) mavlink_counter_40hz = 0;
+
+	usec += 25000;  // Frequency sensitive code
+	msec += 25;     // Frequency sensitive code
+
+	// Each channel is scheduled against its own stream rate table
+	for (chan = 0; chan < MAVLINK_NUM_CHANNELS; chan++)
+	{
+		if (mavlink_channels[chan].active)
+		{
+			mavlink_output_streams((mavlink_channel_t)chan);
+		}
 	}
+
 	MAVParamsOutput_40hz();
 	MAVMissionOutput_40hz();
 	MAVFlexiFunctionsOutput_40hz();
-//	MAVFTPOutput_40hz(); // WIP - RobD
+#if (MAVLINK_FTP == 1)
+	MAVFTPOutput_40hz();
+#endif
+#if (USE_GEOFENCE == 1)
+	MAVFenceOutput_40hz();
+#endif
 
 	// Acknowledge a command if flaged to do so.
 	if (mavlink_send_command_ack == true)
 	{
-		mavlink_msg_command_ack_send(MAVLINK_COMM_0, mavlink_command_ack_command, mavlink_command_ack_result);
+		mavlink_msg_command_ack_send(mavlink_gcs_chan, mavlink_command_ack_command, mavlink_command_ack_result);
 		mavlink_send_command_ack = false;
 	}
-#if (USE_TELELOG == 1)
-	log_swapbuf();
-#endif
 }
 #endif // (MAVLINK_TEST_ENCODE_DECODE == 1)
 
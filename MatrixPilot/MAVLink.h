@@ -45,10 +45,53 @@
 #define MAVLINK_SEND_UART_BYTES mavlink_serial_send
 //int16_t mavlink_serial_send(mavlink_channel_t chan, uint8_t buf[], uint16_t len);
 int16_t mavlink_serial_send(mavlink_channel_t chan, const uint8_t buf[], uint16_t len); // RobD
+// and to be encoded directly into the channel's transmit ring
+#define MAVLINK_START_UART_SEND mavlink_start_uart_send
+#define MAVLINK_END_UART_SEND mavlink_end_uart_send
+void mavlink_start_uart_send(mavlink_channel_t chan, uint16_t len);
+void mavlink_end_uart_send(mavlink_channel_t chan, uint16_t len);
 #endif
 
 #include "../MAVLink/include/matrixpilot/mavlink.h"
 
+// MAVLink channel assignments. Each channel in use has its own transmit queue
+// and stream rate table, so that a slow link does not throttle the others.
+#define MAVLINK_COMM_TELEMETRY              MAVLINK_COMM_0  // telemetry UART (radio modem)
+#define MAVLINK_COMM_USB                    MAVLINK_COMM_1  // USB CDC virtual serial port
+#define MAVLINK_COMM_LOG                    MAVLINK_COMM_2  // on-board telemetry log
+#define MAVLINK_NUM_CHANNELS                3
+
+#ifndef MAVLINK_TX_QUEUE_SIZE
+#define MAVLINK_TX_QUEUE_SIZE               640
+#endif
+#ifndef MAVLINK_USB_CHANNEL
+#define MAVLINK_USB_CHANNEL                 0
+#endif
+#ifndef MAVLINK_LOG_RATE_RAW_SENSORS
+#define MAVLINK_LOG_RATE_RAW_SENSORS        MAVLINK_RATE_RAW_SENSORS
+#endif
+#ifndef MAVLINK_LOG_RATE_POSITION
+#define MAVLINK_LOG_RATE_POSITION           MAVLINK_RATE_POSITION
+#endif
+#ifndef MAVLINK_LOG_RATE_SUE
+#define MAVLINK_LOG_RATE_SUE                MAVLINK_RATE_SUE
+#endif
+#ifndef MAVLINK_FTP
+#define MAVLINK_FTP                         0
+#endif
+#ifndef MAVLINK_FTP_WINDOW
+#define MAVLINK_FTP_WINDOW                  4
+#endif
+#ifndef MAVLINK_FTP_SESSIONS
+#define MAVLINK_FTP_SESSIONS                2
+#endif
+#ifndef MAVLINK_MISSION_WINDOW
+#define MAVLINK_MISSION_WINDOW              4
+#endif
+#ifndef MAVLINK_MISSION_RETRY
+#define MAVLINK_MISSION_RETRY               20
+#endif
+
 typedef struct mavlink_flag_bits {
 //	uint16_t unused                         : 2;
 	uint16_t mavlink_send_specific_variable : 1;
@@ -56,14 +99,17 @@ typedef struct mavlink_flag_bits {
 	uint16_t mavlink_send_waypoint_count    : 1;
 	uint16_t mavlink_sending_waypoints      : 1;
 	uint16_t mavlink_receiving_waypoints    : 1;
-	uint16_t mavlink_send_specific_waypoint : 1;
-	uint16_t mavlink_request_specific_waypoint : 1;
+	uint16_t mavlink_send_mission_ack       : 1;
 	uint16_t mavlink_send_waypoint_reached  : 1;
 	uint16_t mavlink_send_waypoint_changed  : 1;
 } mavlink_flags_t;
 
 extern mavlink_flags_t mavlink_flags;
 
+// The channel on which the ground control station last sent us a message.
+// Replies to parameter, mission and command requests are sent on this channel.
+extern mavlink_channel_t mavlink_gcs_chan;
+
 boolean mavlink_check_target(uint8_t target_system, uint8_t target_component);
 void mavlink_input_byte(uint8_t byte);
 void mavlink_output_40hz(void);
@@ -71,4 +117,11 @@ void mavlink_init(void);
 int16_t mavlink_callback_get_byte_to_send(void);
 void mavlink_callback_received_byte(uint8_t rxchar);
 
+// Per channel transmit queue and receive parser entry points,
+// for use by transports other than the telemetry UART (eg. USB CDC).
+int16_t mavlink_chan_get_byte_to_send(mavlink_channel_t chan);
+void mavlink_chan_received_byte(mavlink_channel_t chan, uint8_t rxchar);
+uint16_t mavlink_chan_tx_dropped(mavlink_channel_t chan);
+boolean mavlink_chan_tx_room(mavlink_channel_t chan, uint16_t len);
+
 #endif // _MAVLINK_H_
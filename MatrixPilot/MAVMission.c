@@ -30,17 +30,35 @@
 #include "../MatrixPilot/flightplan.h"
 #include "../MatrixPilot/flightplan_waypoints.h"
 #include "../libDCM/gpsParseCommon.h"
+#include <string.h>
 
-uint16_t waypoint_request_i;
 uint16_t mav_waypoint_reached;
 uint16_t mav_waypoint_changed;
-uint16_t mavlink_waypoint_requested_sequence_number;
 uint8_t  mavlink_waypoint_dest_sysid;
 uint8_t  mavlink_waypoint_dest_compid;
 uint16_t mavlink_waypoint_timeout = 0;
-uint8_t  number_of_waypoint_retries = 2;
 uint8_t  mavlink_waypoint_frame = MAV_FRAME_GLOBAL;
-boolean  mavlink_waypoint_current = true;
+
+// Mission transfers are windowed. During an upload up to MAVLINK_MISSION_WINDOW
+// items are requested ahead of those received, and an item which has not
+// arrived within MAVLINK_MISSION_RETRY ticks is requested again on its own.
+// The items are staged in the shadow flight plan, which only replaces the
+// current one once every item has arrived. During a download each item the
+// GCS asks for is queued, and as many are sent each tick as the link has room.
+#define MISSION_BITMAP_SIZE         ((MAX_WAYPOINTS + 7) / 8)
+#define MISSION_SEND_QUEUE_SIZE     (MAVLINK_MISSION_WINDOW + 1)
+#define MISSION_REQUEST_PACKET_LEN  (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_MISSION_REQUEST_LEN)
+#define MISSION_ITEM_PACKET_LEN     (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_MISSION_ITEM_LEN)
+
+static uint16_t mission_upload_count = 0;               // items in the current or last upload
+static uint16_t mission_received_count;
+static uint8_t  mission_received[MISSION_BITMAP_SIZE];  // written by the message handlers
+static uint8_t  mission_retry[MAX_WAYPOINTS];           // ticks until an item is requested again
+static uint8_t  mission_ack_type = MAV_MISSION_ACCEPTED;
+
+static uint16_t mission_send_queue[MISSION_SEND_QUEUE_SIZE];
+static volatile uint8_t mission_send_in = 0;            // written by MissionRequest()
+static volatile uint8_t mission_send_out = 0;           // written by MAVMissionOutput_40hz()
 
 #define MAX_PARAMS 10
 static uint16_t params[MAX_PARAMS];
@@ -73,6 +91,24 @@ static uint16_t get(uint16_t index)
 	return data;
 }
 
+static boolean mission_bit(const uint8_t* bitmap, uint16_t seq)
+{
+	return (bitmap[seq >> 3] & (1 << (seq & 7))) != 0;
+}
+
+static void mission_ack(uint8_t type)
+{
+	mission_ack_type = type;
+	mavlink_flags.mavlink_send_mission_ack = 1;
+}
+
+static void mission_upload_abort(uint8_t type)
+{
+	DPRINT("mission upload aborted: %u\r\n", type);
+	mavlink_flags.mavlink_receiving_waypoints = false;
+	mission_ack(type);
+}
+
 static inline void MissionRequestList(mavlink_message_t* handle_msg)
 {
 	mavlink_mission_request_list_t packet;
@@ -89,6 +125,7 @@ static inline void MissionRequestList(mavlink_message_t* handle_msg)
 	mavlink_flags.mavlink_receiving_waypoints = false;
 	mavlink_waypoint_dest_sysid = handle_msg->sysid;
 	mavlink_waypoint_dest_compid = handle_msg->compid;
+	mission_send_in = mission_send_out;
 	// Start sending waypoints
 	mavlink_flags.mavlink_send_waypoint_count = 1;
 	DPRINT("mission request list: sysid %u compid %u\r\n", handle_msg->sysid, handle_msg->compid);
@@ -97,6 +134,8 @@ static inline void MissionRequestList(mavlink_message_t* handle_msg)
 static inline void MissionRequest(mavlink_message_t* handle_msg)
 {
 	mavlink_mission_request_t packet;
+	uint8_t i;
+	uint8_t in;
 
 	//send_text((uint8_t*)"waypoint request\r\n");
 	//DPRINT("mission request\r\n");
@@ -111,19 +150,23 @@ static inline void MissionRequest(mavlink_message_t* handle_msg)
 	mavlink_msg_mission_request_decode(handle_msg, &packet);
 	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
-	mavlink_waypoint_requested_sequence_number = packet.seq;
 	DPRINT("mission request: packet.seq %u\r\n", packet.seq);
+	if (packet.seq >= waypoint_count()) return;
 	mavlink_waypoint_frame = MAV_FRAME_GLOBAL; // reference frame
-	if (mavlink_waypoint_requested_sequence_number == waypointIndex)
+
+	// queue the waypoint to be sent, unless it already is
+	in = mission_send_in;
+	for (i = mission_send_out; i != in; i = (i + 1) % MISSION_SEND_QUEUE_SIZE)
 	{
-		mavlink_waypoint_current = true;
+		if (mission_send_queue[i] == packet.seq) return;
 	}
-	else
+	if ((in + 1) % MISSION_SEND_QUEUE_SIZE == mission_send_out)
 	{
-		mavlink_waypoint_current = false;
+		DPRINT("mission request queue full\r\n");
+		return; // the GCS will ask again
 	}
-	// send waypoint
-	mavlink_flags.mavlink_send_specific_waypoint = 1;
+	mission_send_queue[in] = packet.seq;
+	mission_send_in = (in + 1) % MISSION_SEND_QUEUE_SIZE;
 
 	/************** Not converted to MAVLink wire protocol 1.0 yet *******************/
 	//uint8_t action = MAV_ACTION_NAVIGATE; // action
@@ -213,7 +256,7 @@ static inline void MissionClearAll(mavlink_message_t* handle_msg)
 	// send acknowledgement 3 times to makes sure it is received
 	for (i = 0; i < 3; i++)
 	{
-		mavlink_msg_mission_ack_send(MAVLINK_COMM_0, handle_msg->sysid, handle_msg->compid, type);
+		mavlink_msg_mission_ack_send(mavlink_gcs_chan, handle_msg->sysid, handle_msg->compid, type);
 	}
 }
 
@@ -238,7 +281,7 @@ static inline void MissionSetCurrent(mavlink_message_t* handle_msg)
 		//temp = get_wp_with_index(packet.seq);
 		//set_next_WP(&temp);
 	}
-	mavlink_msg_mission_current_send(MAVLINK_COMM_0, get(PARAM_WP_INDEX));
+	mavlink_msg_mission_current_send(mavlink_gcs_chan, get(PARAM_WP_INDEX));
 }
 
 static inline void MissionCount(mavlink_message_t* handle_msg)
@@ -252,17 +295,32 @@ static inline void MissionCount(mavlink_message_t* handle_msg)
 	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
 
 	DPRINT("mission count: %u\r\n", packet.count);
+	mavlink_waypoint_dest_sysid = handle_msg->sysid;
+	mavlink_waypoint_dest_compid = handle_msg->compid;
+	mavlink_flags.mavlink_receiving_waypoints = false;
+	mavlink_flags.mavlink_sending_waypoints = false;
+	mission_upload_count = 0;
+
+	if (packet.count == 0)
+	{
+		set(PARAM_WP_TOTAL, 0);
+		clear_flightplan();
+		mission_ack(MAV_MISSION_ACCEPTED);
+		return;
+	}
+	if (!flightplan_shadow_begin(packet.count))
+	{
+		mission_ack(packet.count > MAX_WAYPOINTS ? MAV_MISSION_NO_SPACE : MAV_MISSION_ERROR);
+		return;
+	}
 	// start waypoint receiving
-	set(PARAM_WP_TOTAL, packet.count);
-	if (get(PARAM_WP_TOTAL) > MAX_WAYPOINTS)
-		set(PARAM_WP_TOTAL, MAX_WAYPOINTS);
+	memset(mission_received, 0, sizeof(mission_received));
+	memset(mission_retry, 0, sizeof(mission_retry));
+	mission_received_count = 0;
+	mission_upload_count = packet.count;
 	//mavlink_flags.waypoint_timelast_receive = millis();
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
-
 	mavlink_flags.mavlink_receiving_waypoints = true;
-	mavlink_flags.mavlink_sending_waypoints = false;
-	mavlink_flags.mavlink_request_specific_waypoint = 1;
-	waypoint_request_i = 0;
 }
 
 static inline void MissionItem(mavlink_message_t* handle_msg)
@@ -273,17 +331,26 @@ static inline void MissionItem(mavlink_message_t* handle_msg)
 	//send_text((uint8_t*)"waypoint\r\n");
 //	DPRINT("mission item\r\n");
 
-	// Check if receiving waypoint
-	if (!mavlink_flags.mavlink_receiving_waypoints) return;
-
 	// decode
 	mavlink_msg_mission_item_decode(handle_msg, &packet);
 	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
 
 	DPRINT("mission item: %u\r\n", packet.seq);
 
-	// check if this is the requested waypoint
-	if (packet.seq != waypoint_request_i) return;
+	// Check if receiving waypoint
+	if (!mavlink_flags.mavlink_receiving_waypoints)
+	{
+		// the GCS repeats the last item if our acknowledgement was lost
+		if (mission_upload_count != 0 && packet.seq == mission_upload_count - 1)
+		{
+			mission_ack(mission_ack_type);
+		}
+		return;
+	}
+
+	// ignore items we did not ask for, and repeats of those already received
+	if (packet.seq >= mission_upload_count) return;
+	if (mission_bit(mission_received, packet.seq)) return;
 
 	// store waypoint
 	//uint8_t loadAction = 0; // 0 insert in list, 1 exec now
@@ -315,8 +382,12 @@ static inline void MissionItem(mavlink_message_t* handle_msg)
 					//(radius_of_earth*cos(ToRad(home.lat/1.0e7)))) + home.lng;
 			//tell_command.lat = 1.0e7*ToDeg(packet.y/radius_of_earth) + home.lat;
 			//tell_command.alt = -packet.z*1.0e2 + home.alt;
-			break;
+			mission_upload_abort(MAV_MISSION_UNSUPPORTED_FRAME);
+			return;
 		}
+		default:
+			mission_upload_abort(MAV_MISSION_UNSUPPORTED_FRAME);
+			return;
 	}
 
 	// defaults
@@ -357,33 +428,40 @@ static inline void MissionItem(mavlink_message_t* handle_msg)
 			//tell_command.p1 = packet.param2/1.0e2;
 			break;
 		default:
+			mission_upload_abort(MAV_MISSION_UNSUPPORTED);
 			return;
 	}
 
-	// save waypoint
-	add_waypoint(wp, flags);
+	// stage waypoint in the shadow flight plan
+	if (!flightplan_shadow_set(packet.seq, wp, flags))
+	{
+		mission_upload_abort(MAV_MISSION_INVALID);
+		return;
+	}
 	//set_wp_with_index(tell_command, packet.seq);
 
 	// update waypoint receiving state machine
 	//global_data.waypoint_timelast_receive = millis();
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
-	waypoint_request_i++;
+	mission_received[packet.seq >> 3] |= (1 << (packet.seq & 7));
+	mission_received_count++;
 
-	if (waypoint_request_i == get(PARAM_WP_TOTAL))
+	if (mission_received_count == mission_upload_count)
 	{
-		uint8_t type = 0; // ok (0), error(1)
 		//gcs.send_text("flight plane received");
 		DPRINT("flight plan received\r\n");
-		mavlink_msg_mission_ack_send(MAVLINK_COMM_0, handle_msg->sysid, handle_msg->compid, type);
 		mavlink_flags.mavlink_receiving_waypoints = false;
 		// XXX ignores waypoint radius for individual waypoints, can
 		// only set WP_RADIUS parameter
-
-		// send MAVLINK_MSG_ID_MISSION_ACK ?
-	}
-	else
-	{
-		mavlink_flags.mavlink_request_specific_waypoint = 1;
+		if (flightplan_shadow_commit())
+		{
+			set(PARAM_WP_TOTAL, mission_upload_count);
+			mission_ack(MAV_MISSION_ACCEPTED);
+		}
+		else
+		{
+			mission_ack(MAV_MISSION_ERROR);
+		}
 	}
 }
 
@@ -423,21 +501,54 @@ boolean MAVMissionHandleMessage(mavlink_message_t* handle_msg)
 
 vect3_32t getWaypoint3D(uint16_t wp);
 
+#if (FLIGHT_PLAN_TYPE == FP_WAYPOINTS)
+
+// Request the next items of an upload, lowest first. An item is requested
+// again only when its own retry time has run out, so a lost item costs one
+// extra request rather than a restart of the whole transfer.
+static void mission_request_items(void)
+{
+	uint16_t seq;
+	uint8_t in_flight = 0;
+
+	for (seq = 0; seq < mission_upload_count; seq++)
+	{
+		if (mission_retry[seq] != 0 && !mission_bit(mission_received, seq))
+		{
+			mission_retry[seq]--;
+			if (mission_retry[seq] != 0) in_flight++;
+		}
+	}
+	for (seq = 0; seq < mission_upload_count && in_flight < MAVLINK_MISSION_WINDOW; seq++)
+	{
+		if (mission_retry[seq] != 0 || mission_bit(mission_received, seq)) continue;
+		if (!mavlink_chan_tx_room(mavlink_gcs_chan, MISSION_REQUEST_PACKET_LEN)) break;
+		DPRINT("requesting waypoint: %u\r\n", seq);
+//static inline void mavlink_msg_mission_request_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, uint16_t seq)
+		mavlink_msg_mission_request_send(mavlink_gcs_chan, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, seq);
+		mission_retry[seq] = MAVLINK_MISSION_RETRY;
+		in_flight++;
+	}
+}
+
+#endif // (FLIGHT_PLAN_TYPE == FP_WAYPOINTS)
+
 void MAVMissionOutput_40hz(void)
 {
 #if (FLIGHT_PLAN_TYPE == FP_WAYPOINTS) // LOGO_WAYPOINTS cannot be uploaded / downloaded
 	vect3_32t wp;
+	uint16_t seq;
 
 	if (mavlink_flags.mavlink_send_waypoint_reached == 1)
 	{
 		mavlink_flags.mavlink_send_waypoint_reached = 0;
-		mavlink_msg_mission_item_reached_send(MAVLINK_COMM_0, mav_waypoint_reached);
+		mavlink_msg_mission_item_reached_send(mavlink_gcs_chan, mav_waypoint_reached);
 	}
 
 	if (mavlink_flags.mavlink_send_waypoint_changed == 1)
 	{
 		mavlink_flags.mavlink_send_waypoint_changed = 0;
-		mavlink_msg_mission_current_send(MAVLINK_COMM_0, mav_waypoint_changed);
+		mavlink_msg_mission_current_send(mavlink_gcs_chan, mav_waypoint_changed);
 	}
 
 //static inline void mavlink_msg_mission_item_reached_send(mavlink_channel_t chan, uint16_t seq)
@@ -455,14 +566,15 @@ void MAVMissionOutput_40hz(void)
 		mavlink_flags.mavlink_receiving_waypoints = false;
 	}
 
-//	if (mavlink_flags.mavlink_receiving_waypoints == 1)
-	if (mavlink_flags.mavlink_request_specific_waypoint == 1)
+	if (mavlink_flags.mavlink_receiving_waypoints == 1)
 	{
-		DPRINT("requesting waypoint: %u\r\n", waypoint_request_i);
-			//mavlink_flags.waypoint_request_i = 0;
-//static inline void mavlink_msg_mission_request_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, uint16_t seq)
-		mavlink_msg_mission_request_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, waypoint_request_i);
-		mavlink_flags.mavlink_request_specific_waypoint = 0;
+		mission_request_items();
+	}
+
+	if (mavlink_flags.mavlink_send_mission_ack == 1)
+	{
+		mavlink_flags.mavlink_send_mission_ack = 0;
+		mavlink_msg_mission_ack_send(mavlink_gcs_chan, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, mission_ack_type);
 	}
 
 	// SEND NUMBER OF WAYPOINTS IN WAYPOINTS LIST
@@ -472,15 +584,17 @@ void MAVMissionOutput_40hz(void)
 
 		//send_text((uint8_t *)"Sending waypoint count\r\n");
 		DPRINT("Sending waypoint count: %u\r\n", number_of_waypoints);
-		mavlink_msg_mission_count_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, number_of_waypoints);
+		mavlink_msg_mission_count_send(mavlink_gcs_chan, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, number_of_waypoints);
 		mavlink_flags.mavlink_send_waypoint_count = 0;
 	}
 
-	// SEND DETAILS OF A SPECIFIC WAYPOINT
-	if (mavlink_flags.mavlink_send_specific_waypoint == 1)
+	// SEND DETAILS OF EACH REQUESTED WAYPOINT
+	while (mission_send_out != mission_send_in)
 	{
+			if (!mavlink_chan_tx_room(mavlink_gcs_chan, MISSION_ITEM_PACKET_LEN)) break;
+			seq = mission_send_queue[mission_send_out];
 			//send_text((uint8_t *)"Time to send a specific waypoint\r\n");
-			DPRINT("Time to send a specific waypoint: %u\r\n", mavlink_waypoint_requested_sequence_number);
+			DPRINT("Time to send a specific waypoint: %u\r\n", seq);
 
 //			mavlink_msg_mission_item_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, 
 //			    uint16_t seq, uint8_t frame, uint16_t command, uint8_t current, uint8_t autocontinue, 
@@ -493,7 +607,7 @@ void MAVMissionOutput_40hz(void)
 //			struct waypoint3D getWaypoint3D(uint16_t wp);
 //			struct waypoint3D wp;
 //			wp = getWaypoint3D(mavlink_waypoint_requested_sequence_number);
-			wp = getWaypoint3D(mavlink_waypoint_requested_sequence_number);
+			wp = getWaypoint3D(seq);
 
 			//float lat_float, lon_float, alt_float = 0.0;
 			//uint32_t accum_long = IMUlocationy._.W1 + (lat_origin.WW / 90); //  meters North from Equator
@@ -502,14 +616,14 @@ void MAVMissionOutput_40hz(void)
 			//extern struct relWaypointDef wp_to_relative(struct waypointDef wp);
 			//struct relWaypointDef current_waypoint = wp_to_relative(waypoints[waypointIndex]);
 			//alt_float =  ((float)(IMUlocationz._.W1)) + (float)(alt_origin.WW / 100.0);
-			mavlink_msg_mission_item_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, \
-			    mavlink_waypoint_requested_sequence_number, mavlink_waypoint_frame, MAV_CMD_NAV_WAYPOINT, mavlink_waypoint_current, true, \
+			mavlink_msg_mission_item_send(mavlink_gcs_chan, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, \
+			    seq, mavlink_waypoint_frame, MAV_CMD_NAV_WAYPOINT, seq == waypointIndex, true, \
 			    0.0, 0.0, 0.0, 0.0, \
 			    (float)wp.y / 10000000.0, (float)wp.x / 10000000.0, wp.z);
 
 			DPRINT("waypoint %f %f %f\r\n", (double)wp.y / 10000000.0, (double)wp.x / 10000000.0, (double)wp.z);
 
-			mavlink_flags.mavlink_send_specific_waypoint = 0;
+			mission_send_out = (mission_send_out + 1) % MISSION_SEND_QUEUE_SIZE;
 	}
 	if (mavlink_waypoint_timeout  > 0) mavlink_waypoint_timeout--;
 
@@ -518,7 +632,7 @@ void MAVMissionOutput_40hz(void)
 	// Acknowledge a command if flaged to do so.
 	if (mavlink_send_command_ack == true)
 	{
-		mavlink_msg_command_ack_send(MAVLINK_COMM_0, mavlink_command_ack_command, mavlink_command_ack_result);
+		mavlink_msg_command_ack_send(mavlink_gcs_chan, mavlink_command_ack_command, mavlink_command_ack_result);
 		mavlink_send_command_ack = false;
 	}
  */
@@ -29,7 +29,7 @@
 //#include "../libDCM/libDCM_internal.h" // Needed for access to internal DCM value
 #include "../libDCM/libDCM.h" // Needed for access to internal DCM value
 #include "../libDCM/rmat.h"
-//#include <string.h>
+#include <string.h>
 //#include <stdarg.h>
 #include <math.h>
 
@@ -68,7 +68,7 @@ static void mavlink_set_maxstack(float setting, int16_t i);
 
 static void mavlink_send_param_maxstack(int16_t i)
 {
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    (4096 - maxstack), MAVLINK_TYPE_FLOAT,  count_of_parameters_list, i);
 	//mavlink_msg_param_value_send(mavlink_channel_t chan, const char *param_id, float param_value, uint8_t param_type, uint16_t param_count, uint16_t param_index)
 }
@@ -117,7 +117,7 @@ static boolean mavlink_parameter_out_of_bounds(mavlink_param_union_t parm, int16
 
 void mavlink_send_param_gyroscale_Q14(int16_t i)
 {
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    (float)(*((int16_t*) mavlink_parameters_list[i].pparam) / (SCALEGYRO * 16384.0)),
 	    MAVLINK_TYPE_FLOAT, count_of_parameters_list, i); // 16384.0 is RMAX defined as a float.
 }
@@ -131,7 +131,7 @@ void mavlink_set_param_gyroscale_Q14(mavlink_param_union_t setting, int16_t i)
 
 void mavlink_send_param_float(int16_t i)
 {
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    *((float*)mavlink_parameters_list[i].pparam),
 	    MAVLINK_TYPE_FLOAT, count_of_parameters_list, i);
 }
@@ -146,11 +146,11 @@ void mavlink_set_param_float(mavlink_param_union_t setting, int16_t i)
 void mavlink_send_param_Q14(int16_t i)
 {
 #if (QGROUNDCTONROL_PID_COMPATIBILITY == 1) // see mavlink_options.h for details
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    (floor((((float)(*((int16_t*)mavlink_parameters_list[i].pparam) / 16384.0)) * 10000) + 0.5) / 10000.0),
 	    MAVLINK_TYPE_FLOAT, count_of_parameters_list, i); // 16384.0 is RMAX defined as a float.
 #else
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    (float)(*((int16_t*) mavlink_parameters_list[i].pparam) / 16384.0),
 	    MAVLINK_TYPE_FLOAT, count_of_parameters_list, i); // 16384.0 is RMAX defined as a float.
 #endif
@@ -169,7 +169,7 @@ void mavlink_send_param_pwtrim(int16_t i)
 	if (mavlink_parameters_list[i].pparam >= (uint8_t*)(&udb_pwTrim[0] + NUM_INPUTS))
 		return;
 
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    (float)(*((int16_t*) mavlink_parameters_list[i].pparam) / 2.0),
 	    MAVLINK_TYPE_FLOAT, count_of_parameters_list, i); // 16384.0 is RMAX defined as a float.
 }
@@ -189,7 +189,7 @@ void mavlink_send_param_int16(int16_t i)
 	param_union_t param;
 
 	param.param_int32 = *((int16_t*)mavlink_parameters_list[i].pparam);
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_INT32_T, count_of_parameters_list, i); // 16384.0 is RMAX defined as a float.
 }
 
@@ -219,7 +219,7 @@ void mavlink_send_int_circular(int16_t i)
 	deg_angle.WW >>= 5;
     deg_angle.WW += 0x8000 ; // Take care of the rounding error
 	param.param_int32 = deg_angle._.W1; // >> 6;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_INT32_T, count_of_parameters_list, i);
 }
 
@@ -244,7 +244,7 @@ void mavlink_send_dm_airspeed_in_cm(int16_t i)
 	airspeed._.W0 = *((int16_t*)mavlink_parameters_list[i].pparam);
 	airspeed.WW = __builtin_mulss(airspeed._.W0, 10.0);
 	param.param_int32 = airspeed._.W0;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_INT32_T, count_of_parameters_list, i);
 }
 
@@ -265,7 +265,7 @@ void mavlink_send_cm_airspeed_in_m(int16_t i)
 
 	param.param_float = (float)*((int16_t*)mavlink_parameters_list[i].pparam);
 	param.param_float *= 0.01;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_FLOAT, count_of_parameters_list, i);
 }
 
@@ -286,7 +286,7 @@ void mavlink_send_dm_airspeed_in_m(int16_t i)
 
 	param.param_float = (float)*((int16_t*)mavlink_parameters_list[i].pparam);
 	param.param_float *= 0.1;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_FLOAT, count_of_parameters_list, i);
 }
 
@@ -314,7 +314,7 @@ void mavlink_send_dcm_angle(int16_t i)
 	deg_angle.WW >>= 2;
 	deg_angle.WW += 0x8000 ; // Take care of the rounding error
 	param.param_int32 = deg_angle._.W1; // >> 6;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_INT32_T, count_of_parameters_list, i);
 }
 
@@ -344,7 +344,7 @@ void mavlink_send_frame_anglerate(int16_t i)
 	deg_angle.WW <<= 2;
 	deg_angle.WW += 0x8000 ; // Take care of the rounding error
 	param.param_int32 = deg_angle._.W1; // >> 6;
-	mavlink_msg_param_value_send(MAVLINK_COMM_0, mavlink_parameters_list[i].name,
+	mavlink_msg_param_value_send(mavlink_gcs_chan, mavlink_parameters_list[i].name,
 	    param.param_float, MAVLINK_TYPE_INT32_T, count_of_parameters_list, i);
 }
 
@@ -418,8 +418,21 @@ static void MAVParamsSet(const mavlink_message_t* handle_msg)
 			if ((mavlink_parameters_list[i].readonly == false) &&
 			    (mavlink_parameter_out_of_bounds(param, i) == false))
 			{
+#if (USE_NV_MEMORY == 1)
+				// Only a change of the stored value needs to be saved
+				uint8_t previous[sizeof(param_union_t)];
+				uint16_t size = mavlink_parameters_list[i].param_size;
+				if (size > sizeof(previous)) size = sizeof(previous);
+				memcpy(previous, mavlink_parameters_list[i].pparam, size);
+#endif
 				mavlink_parameter_parsers[mavlink_parameters_list[i].udb_param_type].set_param(param, i);
 				DPRINT("parameter[%i] %s, %f set\r\n", i, (const char*)packet.param_id, (double)param.param_float);
+#if (USE_NV_MEMORY == 1)
+				if (memcmp(previous, mavlink_parameters_list[i].pparam, size) != 0)
+				{
+					data_services_param_changed(i);
+				}
+#endif
 			}
 			else
 			{
@@ -30,7 +30,6 @@
 #include "config.h"
 #include "navigate.h"
 #include "altitudeCntrl.h"
-#include "telemetry_log.h"
 #include "flightplan_waypoints.h"
 #include "../libDCM/gpsData.h"
 #include "../libDCM/gpsParseCommon.h"
@@ -47,34 +46,57 @@
 
 extern uint16_t maxstack;
 
-int16_t mavlink_sue_telemetry_counter = 13; // Countdown counter, for use with SERIAL_UDB_EXTRA compatibility
-boolean mavlink_sue_toggle = false;
-
 #define MAVLINK_SUE_CHANNEL_MAX_SIZE 12 //  MatrixPilot.xml MAVLink has fixed SUE protocol for 10 channels
 
-void MAVUDBExtraOutput(void)
+// Each MAVLink channel runs its own SUE sequence, as channels may be
+// streaming SUE at different rates (or not at all).
+typedef struct mavlink_sue_state {
+	int16_t telemetry_counter;      // Countdown counter, for use with SERIAL_UDB_EXTRA compatibility
+	boolean toggle;
+	boolean f13_print_prepare;
+	boolean f13_print_pending;
+	// Following are required for saving state of PWM variables for SERIAL_UDB_EXTRA compatibility
+	int16_t pwIn_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
+	int16_t pwOut_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
+	int16_t pwTrim_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
+} mavlink_sue_state_t;
+
+static mavlink_sue_state_t mavlink_sue[MAVLINK_NUM_CHANNELS] = {
+	{ 13, false, false, false },
+	{ 13, false, false, false },
+	{ 13, false, false, false },
+};
+
+void MAVUDBExtraOutput(mavlink_channel_t chan)
 {
 	// SEND SERIAL_UDB_EXTRA (SUE) VIA MAVLINK FOR BACKWARDS COMPATIBILITY with FLAN.PYW (FLIGHT ANALYZER)
 	// SUE messages have important MatrixPilot specific information like cause of reboots e.g. power brownout.
 	// The MAVLink messages for this section of code are defined in
 	// Tools/MAVLink/mavlink/pymavlink/message_definitions/V1.0/matrixpilot.xml
+	mavlink_sue_state_t* sue = &mavlink_sue[chan];
+	int16_t* pwIn_save = sue->pwIn_save;
+	int16_t* pwOut_save = sue->pwOut_save;
+	int16_t* pwTrim_save = sue->pwTrim_save;
 	int16_t i;
-	static int mavlink_sue_toggle = 0;
-	static boolean f13_print_prepare = false;
-	
-	// Following are required for saving state of PWM variables for SERIAL_UDB_EXTRA compatibility
-	static int16_t pwIn_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
-	static int16_t pwOut_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
-	static int16_t pwTrim_save[MAVLINK_SUE_CHANNEL_MAX_SIZE + 1];
-	
-	switch  (mavlink_sue_telemetry_counter)
+
+	// The F13 request is shared by all channels, so latch it for each of them
+	if (state_flags._.f13_print_req == 1)
+	{
+		for (i = 0; i < MAVLINK_NUM_CHANNELS; i++)
+		{
+			mavlink_sue[i].f13_print_pending = true;
+		}
+		state_flags._.f13_print_req = 0;
+	}
+
+	switch (sue->telemetry_counter)
 	{
 		case 13:
 //			serial_output("F22:Sensors=%i,%i,%i,%i,%i,%i\n",
 //				UDB_XACCEL.value, UDB_YACCEL.value,
 //				UDB_ZACCEL.value + (Z_GRAVITY_SIGN ((int16_t)(2*GRAVITY))),
 //				udb_xrate.value, udb_yrate.value, udb_zrate.value);
-			mavlink_msg_serial_udb_extra_f22_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f22_send(chan,
 				UDB_XACCEL.value, UDB_YACCEL.value,
 				UDB_ZACCEL.value + (Z_GRAVITY_SIGN ((int16_t)(2*GRAVITY))),
 				udb_xrate.value, udb_yrate.value, udb_zrate.value);
@@ -83,7 +105,7 @@ void MAVUDBExtraOutput(void)
 //			serial_output("F21:Offsets=%i,%i,%i,%i,%i,%i\n",
 //				UDB_XACCEL.offset, UDB_YACCEL.offset, UDB_ZACCEL.offset,
 //				udb_xrate.offset, udb_yrate.offset, udb_zrate.offset);
-			mavlink_msg_serial_udb_extra_f21_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f21_send(chan,
 				UDB_XACCEL.offset, UDB_YACCEL.offset, UDB_ZACCEL.offset,
 				udb_xrate.offset, udb_yrate.offset, udb_zrate.offset);
 			break;
@@ -93,7 +115,7 @@ void MAVUDBExtraOutput(void)
 //			serial_output(":IDB=");
 //			serial_output(ID_VEHICLE_REGISTRATION);
 //			serial_output(":\r\n");
-			mavlink_msg_serial_udb_extra_f15_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f15_send(chan,
 				(uint8_t*)ID_VEHICLE_MODEL_NAME, 
 				(uint8_t*)ID_VEHICLE_REGISTRATION);
 			break;
@@ -103,21 +125,21 @@ void MAVUDBExtraOutput(void)
 //			serial_output(":IDD=");
 //			serial_output(ID_DIY_DRONES_URL);
 //			serial_output(":\r\n");
-			mavlink_msg_serial_udb_extra_f16_send(MAVLINK_COMM_0, 
+			mavlink_msg_serial_udb_extra_f16_send(chan, 
 				(uint8_t*)ID_LEAD_PILOT,
 				(uint8_t*)ID_DIY_DRONES_URL);
 			break;
 		case 9:
 //			serial_output("F17:FD_FWD=%5.3f:TR_NAV=%5.3f:TR_FBW=%5.3f:\r\n",
 //				turns.FeedForward, turns.TurnRateNav, turns.TurnRateFBW);
-			mavlink_msg_serial_udb_extra_f17_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f17_send(chan,
 				turns.FeedForward, turns.TurnRateNav, turns.TurnRateFBW);
 			break;
 		case 8:
 //			serial_output("F18:AOA_NRM=%5.3f:AOA_INV=%5.3f:EL_TRIM_NRM=%5.3f:EL_TRIM_INV=%5.3f:CRUISE_SPD=%5.3f:\r\n",
 //				turns.AngleOfAttackNormal, turns.AngleOfAttackInverted, turns.ElevatorTrimNormal,
 //				turns.ElevatorTrimInverted, turns.RefSpeed);
-			mavlink_msg_serial_udb_extra_f18_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f18_send(chan,
 				turns.AngleOfAttackNormal, turns.AngleOfAttackInverted, turns.ElevatorTrimNormal,
 				turns.ElevatorTrimInverted, turns.RefSpeed);
 			break;
@@ -125,7 +147,7 @@ void MAVUDBExtraOutput(void)
 //			serial_output("F19:AIL=%i,%i:ELEV=%i,%i:THROT=%i,%i:RUDD=%i,%i:\r\n",
 //				AILERON_OUTPUT_CHANNEL, AILERON_CHANNEL_REVERSED, ELEVATOR_OUTPUT_CHANNEL,ELEVATOR_CHANNEL_REVERSED,
 //				THROTTLE_OUTPUT_CHANNEL, THROTTLE_CHANNEL_REVERSED, RUDDER_OUTPUT_CHANNEL,RUDDER_CHANNEL_REVERSED );
-			mavlink_msg_serial_udb_extra_f19_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f19_send(chan,
 				AILERON_OUTPUT_CHANNEL, AILERON_CHANNEL_REVERSED, ELEVATOR_OUTPUT_CHANNEL,ELEVATOR_CHANNEL_REVERSED,
 				THROTTLE_OUTPUT_CHANNEL, THROTTLE_CHANNEL_REVERSED, RUDDER_OUTPUT_CHANNEL,RUDDER_CHANNEL_REVERSED);
 			break;
@@ -136,7 +158,7 @@ void MAVUDBExtraOutput(void)
 //				WIND_ESTIMATION, GPS_TYPE, DEADRECKONING, BOARD_TYPE, AIRFRAME_TYPE,
 //				get_reset_flags(), trap_flags, trap_source, osc_fail_count,
 //				CLOCK_CONFIG, FLIGHT_PLAN_TYPE);
-			mavlink_msg_serial_udb_extra_f14_send(MAVLINK_COMM_0, 
+			mavlink_msg_serial_udb_extra_f14_send(chan, 
 				WIND_ESTIMATION, GPS_TYPE, DEADRECKONING, BOARD_TYPE, AIRFRAME_TYPE,
 				get_reset_flags(), trap_flags, trap_source, osc_fail_count,
 				CLOCK_CONFIG, FLIGHT_PLAN_TYPE);
@@ -148,7 +170,7 @@ void MAVUDBExtraOutput(void)
 //				settings._.YawStabilizationAileron, settings._.AileronNavigation,
 //				settings._.RudderNavigation, settings._.AltitudeholdStabilized,
 //				settings._.AltitudeholdWaypoint, settings._.RacingMode);
-			mavlink_msg_serial_udb_extra_f4_send(MAVLINK_COMM_0, 
+			mavlink_msg_serial_udb_extra_f4_send(chan, 
 				settings._.RollStabilizaionAilerons, settings._.RollStabilizationRudder,
 				settings._.PitchStabilization, settings._.YawStabilizationRudder,
 				settings._.YawStabilizationAileron, settings._.AileronNavigation,
@@ -158,26 +180,26 @@ void MAVUDBExtraOutput(void)
 		case 4:
 //			serial_output("F5:YAWKP_A=%5.3f:YAWKD_A=%5.3f:ROLLKP=%5.3f:ROLLKD=%5.3f:A_BOOST=%5.3f:A_BOOST=NULL\r\n",
 //				gains.YawKPAileron, gains.YawKDAileron, gains.RollKP, gains.RollKD);
-			mavlink_msg_serial_udb_extra_f5_send(MAVLINK_COMM_0, 
+			mavlink_msg_serial_udb_extra_f5_send(chan, 
 				gains.YawKPAileron, gains.YawKDAileron, gains.RollKP, gains.RollKD);
 			break;
 		case 3:
 //			serial_output("F6:P_GAIN=%5.3f:P_KD=%5.3f:RUD_E_MIX=NULL:ROL_E_MIX=NULL:E_BOOST=%3.1f:\r\n",
 //				gains.Pitchgain, gains.PitchKD, gains.ElevatorBoost);
-			mavlink_msg_serial_udb_extra_f6_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f6_send(chan,
 				gains.Pitchgain, gains.PitchKD, 0, 0, gains.ElevatorBoost);
 			break;
 		case 2:
 //			serial_output("F7:Y_KP_R=%5.4f:Y_KD_R=%5.3f:RLKP_RUD=%5.3f:RLKD_RUD=%5.3f:RUD_BOOST=%5.3f:RTL_PITCH_DN=%5.3f:\r\n",
 //				gains.YawKPRudder, gains.YawKDRudder, gains.RollKPRudder, gains.RollKDRudder, gains.RudderBoost, gains.RtlPitchDown);
-			mavlink_msg_serial_udb_extra_f7_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f7_send(chan,
 				gains.YawKPRudder, gains.YawKDRudder, gains.RollKPRudder, gains.RollKDRudder, gains.RudderBoost, gains.RtlPitchDown);
 			break;
 		case 1:
 //			serial_output("F8:H_MAX=%6.1f:H_MIN=%6.1f:MIN_THR=%3.2f:MAX_THR=%3.2f:PITCH_MIN_THR=%4.1f:PITCH_MAX_THR=%4.1f:PITCH_ZERO_THR=%4.1f:\r\n",
 //				altit.HeightTargetMax, altit.HeightTargetMin, altit.AltHoldThrottleMin, altit.AltHoldThrottleMax,
 //				altit.AltHoldPitchMin, altit.AltHoldPitchMax, altit.AltHoldPitchHigh);
-			mavlink_msg_serial_udb_extra_f8_send(MAVLINK_COMM_0,
+			mavlink_msg_serial_udb_extra_f8_send(chan,
 				altit.HeightTargetMax, altit.HeightTargetMin, altit.AltHoldThrottleMin, altit.AltHoldThrottleMax,
 				altit.AltHoldPitchMin, altit.AltHoldPitchMax, altit.AltHoldPitchHigh);
 			break;
@@ -186,18 +208,18 @@ void MAVUDBExtraOutput(void)
 			// F2 below means "Format Revision 2: and is used by a Telemetry parser to invoke the right pattern matching
 			// F2 is a compromise between easy reading of raw data in an ascii file and minimising extraneous data in the stream.
 			
-			mavlink_sue_toggle = !mavlink_sue_toggle;
-			if (state_flags._.f13_print_req == 1)
+			sue->toggle = !sue->toggle;
+			if (sue->f13_print_pending)
 			{
-				if (mavlink_sue_toggle && !f13_print_prepare)
+				if (sue->toggle && !sue->f13_print_prepare)
 				{
-					f13_print_prepare = true;
+					sue->f13_print_prepare = true;
 					return;  //wait for next run
 				}
  			}
-			if (!f13_print_prepare)
+			if (!sue->f13_print_prepare)
 			{
-				if (mavlink_sue_toggle)
+				if (sue->toggle)
 				{
 //					serial_output("F2:T%li:S%d%d%d:N%li:E%li:A%li:W%i:"
 //					              "a%i:b%i:c%i:d%i:e%i:f%i:g%i:h%i:i%i:"
@@ -218,7 +240,7 @@ void MAVUDBExtraOutput(void)
 //#endif // MAG_YAW_DRIFT
 //						svs, hdop);
 					
-					mavlink_msg_serial_udb_extra_f2_a_send(MAVLINK_COMM_0, 
+					mavlink_msg_serial_udb_extra_f2_a_send(chan, 
 						tow.WW, ((udb_flags._.radio_on << 2) + (dcm_flags._.nav_capable << 1) + state_flags._.GPS_steering),
 						lat_gps.WW, lon_gps.WW, alt_sl_gps.WW, waypointIndex,
 						rmat[0], rmat[1], rmat[2],
@@ -242,8 +264,10 @@ void MAVUDBExtraOutput(void)
 					
 					// The following code line assumes an update rate of 4HZ, (MAVUDBExtra() called at 8 HZ))
 					// It is not changed for now, to preserve close compatibility with SERIAL_UDB_EXTRA code.
+					// Only the telemetry channel advances it, so that additional channels
+					// streaming SUE do not make time run faster.
 
-					if (tow.WW > 0) tow.WW += 250; 
+					if (tow.WW > 0 && chan == MAVLINK_COMM_TELEMETRY) tow.WW += 250;
 
 					// Save  pwIn and PwOut buffers for printing next time around
 					// Save  pwIn and PwOut buffers for sending next time around in f2_b format message
@@ -306,7 +330,7 @@ void MAVUDBExtraOutput(void)
 //					serial_output("stk%d:", (int16_t)(4096-maxstack));
 //					serial_output("\r\n");
 
-					mavlink_msg_serial_udb_extra_f2_b_send(MAVLINK_COMM_0,
+					mavlink_msg_serial_udb_extra_f2_b_send(chan,
 						tow.WW,
 						pwIn_save[1], pwIn_save[2], pwIn_save[3], pwIn_save[4], pwIn_save[5],pwIn_save[6],
 						pwIn_save[7], pwIn_save[8], pwIn_save[9], pwIn_save[10], pwIn_save[11], pwIn_save[12],
@@ -344,23 +368,23 @@ void MAVUDBExtraOutput(void)
 						
 				}
 			}
-			if (state_flags._.f13_print_req == 1)
+			if (sue->f13_print_pending)
 			{
 				// The F13 line of telemetry is printed when origin has been captured and in between F2 lines in SERIAL_UDB_EXTRA
-				if (!f13_print_prepare)
+				if (!sue->f13_print_prepare)
 				{
 					return;
 				}
 				else
 				{
-					f13_print_prepare = false;
+					sue->f13_print_prepare = false;
 				}
 //				serial_output("F13:week%i:origN%li:origE%li:origA%li:\r\n", week_no, lat_origin.WW, lon_origin.WW, alt_origin);
-				mavlink_msg_serial_udb_extra_f13_send(MAVLINK_COMM_0, 
+				mavlink_msg_serial_udb_extra_f13_send(chan, 
 					week_no.BB, lat_origin.WW, lon_origin.WW, alt_origin.WW);
 				
 //				serial_output("F20:NUM_IN=%i:TRIM=",NUM_INPUTS);
-				mavlink_msg_serial_udb_extra_f20_send(MAVLINK_COMM_0, 
+				mavlink_msg_serial_udb_extra_f20_send(chan, 
 					NUM_INPUTS,                                                         \
 					pwTrim_save[1], pwTrim_save[2],  pwTrim_save[3],  pwTrim_save[4],   \
 					pwTrim_save[5], pwTrim_save[6],  pwTrim_save[7],  pwTrim_save[8],   \
@@ -370,18 +394,15 @@ void MAVUDBExtraOutput(void)
 //					serial_output("%i,",udb_pwTrim[i]);
 //				}
 //				serial_output(":\r\n");
-				state_flags._.f13_print_req = 0;
+				sue->f13_print_pending = false;
 			}
 			break;
 		}
 	}
-	if (mavlink_sue_telemetry_counter)
+	if (sue->telemetry_counter)
 	{
-		mavlink_sue_telemetry_counter--;
+		sue->telemetry_counter--;
 	}
-#if (USE_TELELOG == 1)
-	log_swapbuf();
-#endif
 }
 
 #endif // (USE_MAVLINK == 1)
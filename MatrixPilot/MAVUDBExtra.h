@@ -23,7 +23,7 @@
 #define MAVUDBEXTRA_H
 
 
-void MAVUDBExtraOutput(void);
+void MAVUDBExtraOutput(mavlink_channel_t chan);
 
 
 #endif // MAVUDBEXTRA_H
@@ -26,6 +26,7 @@
 #include "../libDCM/estWind.h"
 #include "../libDCM/mathlibNAV.h"
 #include "../libDCM/deadReckoning.h"
+#include "pidCntrl.h"
 
 int16_t minimum_groundspeed;
 int16_t minimum_airspeed;
@@ -131,13 +132,7 @@ static int16_t calc_target_airspeed(int16_t desiredSpd)
 	if (groundspeed < minimum_groundspeed)
 		target += (minimum_groundspeed - groundspeed);
 
-	if (target > maximum_airspeed)
-		target = maximum_airspeed;
-
-	if (target < minimum_airspeed)
-		target = minimum_airspeed;
-
-	return target;
+	return cntrl_saturate(target, minimum_airspeed, maximum_airspeed);
 }
 
 // Calculate the airspeed error vs target airspeed including filtering
@@ -154,13 +149,8 @@ static int16_t calc_airspeed_error(void)
 static int32_t calc_airspeed_int_error(int16_t aspdError, int32_t aspd_integral)
 {
 	union longww airspeed_int = {aspd_integral};
-	airspeed_int.WW += __builtin_mulss(airspeed_pitch_ki, airspeedError) << 2;
-
-	if (airspeed_int._.W1 > airspeed_pitch_ki_limit)
-		airspeed_int._.W1 = airspeed_pitch_ki_limit;
-	else if (airspeed_int._.W1 < -airspeed_pitch_ki_limit)
-		airspeed_int._.W1 = -airspeed_pitch_ki_limit;
 
+	cntrl_integrate(&airspeed_int, airspeed_pitch_ki, aspdError, 2, airspeed_pitch_ki_limit);
 	return airspeed_int.WW;
 }
 
@@ -27,6 +27,7 @@
 #include "states.h"
 #include "altitudeCntrl.h"
 #include "sonarCntrl.h"
+#include "pidCntrl.h"
 #include "../libDCM/rmat.h"
 #include "../libDCM/gpsData.h"
 #include "../libDCM/estWind.h"
@@ -74,6 +75,31 @@ int16_t alt_hold_pitch_high;
 int16_t rtl_pitch_down;
 int16_t desiredSpeed;
 
+// The gains of the loops, worked out from altit when it is loaded or saved
+// rather than in floating point on every call.
+static int16_t max_throttle;
+static int16_t throttle_height_gain;
+static int16_t pitch_at_max;
+static int16_t pitch_at_zero;
+static int16_t pitch_height_gain;
+static int16_t height_throttle_gain;
+static int16_t height_marginx8;
+static int16_t height_min;
+static int16_t height_max;
+
+static void compute_altitude_gains(void)
+{
+	max_throttle         = (int16_t)(MAXTHROTTLE);
+	throttle_height_gain = (int16_t)(THROTTLEHEIGHTGAIN);
+	pitch_at_max         = (int16_t)(PITCHATMAX);
+	pitch_at_zero        = (int16_t)(PITCHATZERO);
+	pitch_height_gain    = (int16_t)(PITCHHEIGHTGAIN);
+	height_throttle_gain = (int16_t)(HEIGHTTHROTTLEGAIN);
+	height_marginx8      = (int16_t)(altit.HeightMargin*8.0);
+	height_min           = (int16_t)(altit.HeightTargetMin);
+	height_max           = (int16_t)(altit.HeightTargetMax);
+}
+
 void init_altitudeCntrl(void)
 {
 	height_target_min     = altit.HeightTargetMin;
@@ -86,6 +112,7 @@ void init_altitudeCntrl(void)
 	alt_hold_pitch_high   = altit.AltHoldPitchHigh;
 	rtl_pitch_down        = gains.RtlPitchDown;
 	desiredSpeed          = altit.DesiredSpeed * 10; // Stored in 10ths of meters per second
+	compute_altitude_gains();
 }
 
 void save_altitudeCntrl(void)
@@ -99,6 +126,7 @@ void save_altitudeCntrl(void)
 	altit.AltHoldPitchMax = alt_hold_pitch_max;
 	altit.AltHoldPitchHigh = alt_hold_pitch_high;
 //	desiredSpeed / 10;
+	compute_altitude_gains();
 }
 
 #if (SPEED_CONTROL == 1)  // speed control loop
@@ -265,12 +293,11 @@ static void normalAltitudeCntrl(void)
 			else if (settings._.AltitudeholdStabilized == AH_FULL)
 			{
 				// In stabilized mode using full altitude hold, use the throttle stick value to determine desiredHeight,
-				desiredHeight = ((__builtin_mulss((int16_t)(HEIGHTTHROTTLEGAIN), throttleInOffset - ((int16_t)(DEADBAND)))) >> 11)
-				                + (int16_t)(altit.HeightTargetMin);
+				desiredHeight = ((__builtin_mulss(height_throttle_gain, throttleInOffset - ((int16_t)(DEADBAND)))) >> 11)
+				                + height_min;
 }
 //#endif
-			if (desiredHeight < (int16_t)(altit.HeightTargetMin)) desiredHeight = (int16_t)(altit.HeightTargetMin);
-			if (desiredHeight > (int16_t)(altit.HeightTargetMax)) desiredHeight = (int16_t)(altit.HeightTargetMax);
+			desiredHeight = cntrl_saturate(desiredHeight, height_min, height_max);
 		}
 		if (throttleInOffset < (int16_t)(DEADBAND) && udb_flags._.radio_on)
 		{
@@ -281,33 +308,33 @@ static void normalAltitudeCntrl(void)
 		{
 			heightError._.W1 = -desiredHeight;
 			heightError.WW = (heightError.WW + IMUlocationz.WW + speed_height) >> 13;
-			if (heightError._.W0 < (-(int16_t)(altit.HeightMargin*8.0)))
+			if (heightError._.W0 < -height_marginx8)
 			{
-				throttleAccum.WW = (int16_t)(MAXTHROTTLE);
+				throttleAccum.WW = max_throttle;
 			}
-			else if (heightError._.W0 > (int16_t)(altit.HeightMargin*8.0))
+			else if (heightError._.W0 > height_marginx8)
 			{
 				throttleAccum.WW = 0;
 			}
 			else
 			{
-				throttleAccum.WW = (int16_t)(MAXTHROTTLE) + (__builtin_mulss((int16_t)(THROTTLEHEIGHTGAIN), (-heightError._.W0 - (int16_t)(altit.HeightMargin*8.0))) >> 3);
-				if (throttleAccum.WW > (int16_t)(MAXTHROTTLE))throttleAccum.WW = (int16_t)(MAXTHROTTLE);
+				throttleAccum.WW = max_throttle + (__builtin_mulss(throttle_height_gain, (-heightError._.W0 - height_marginx8)) >> 3);
+				if (throttleAccum.WW > max_throttle) throttleAccum.WW = max_throttle;
 			}
 			heightError._.W1 = - desiredHeight;
 			heightError.WW = (heightError.WW + IMUlocationz.WW - speed_height) >> 13;
-			if (heightError._.W0 < (- (int16_t)(altit.HeightMargin*8.0)))
+			if (heightError._.W0 < -height_marginx8)
 			{
-				pitchAltitudeAdjust = (int16_t)(PITCHATMAX);
+				pitchAltitudeAdjust = pitch_at_max;
 			}
-			else if (heightError._.W0 > (int16_t)(altit.HeightMargin*8.0))
+			else if (heightError._.W0 > height_marginx8)
 			{
-				pitchAltitudeAdjust = (int16_t)(PITCHATZERO);
+				pitchAltitudeAdjust = pitch_at_zero;
 			}
 			else
 			{
-				pitchAccum.WW = __builtin_mulss((int16_t)(PITCHHEIGHTGAIN), - heightError._.W0 - (int16_t)(altit.HeightMargin*8.0)) >> 3;
-				pitchAltitudeAdjust = (int16_t)(PITCHATMAX) + pitchAccum._.W0;
+				pitchAccum.WW = __builtin_mulss(pitch_height_gain, - heightError._.W0 - height_marginx8) >> 3;
+				pitchAltitudeAdjust = pitch_at_max + pitchAccum._.W0;
 			}
 //#if (RACING_MODE == 1)
 			if (settings._.RacingMode == 1)
@@ -331,16 +358,14 @@ static void normalAltitudeCntrl(void)
 				pitchAltitudeAdjust = 0;
 			}
 			
-			throttleFiltered.WW += (((int32_t)(udb_pwTrim[THROTTLE_INPUT_CHANNEL] - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
-			set_throttle_control(throttleFiltered._.W1 - throttleIn);
+			set_throttle_control(cntrl_lowpass(&throttleFiltered, udb_pwTrim[THROTTLE_INPUT_CHANNEL], THROTTLEFILTSHIFT) - throttleIn);
 			filterManual = true;
 		}
 		else
 		{
 			// Servo reversing is handled in servoMix.c
 			int16_t throttleOut = udb_servo_pulsesat(udb_pwTrim[THROTTLE_INPUT_CHANNEL] + throttleAccum.WW);
-			throttleFiltered.WW += (((int32_t)(throttleOut - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
-			set_throttle_control(throttleFiltered._.W1 - throttleIn);
+			set_throttle_control(cntrl_lowpass(&throttleFiltered, throttleOut, THROTTLEFILTSHIFT) - throttleIn);
 			filterManual = true;
 		}
 		if (!state_flags._.altitude_hold_pitch)
@@ -361,7 +386,7 @@ static void manualThrottle(int16_t throttleIn)
 
 	int16_t throttle_control_pre;
 
-	throttleFiltered.WW += (((int32_t)(throttleIn - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
+	cntrl_lowpass(&throttleFiltered, throttleIn, THROTTLEFILTSHIFT);
 	if (filterManual)
 	{
 		// Continue to filter the throttle control value in manual mode to avoid large, instant
@@ -387,7 +412,7 @@ static void hoverAltitudeCntrl(void)
 	int16_t throttle_control_pre;
 	int16_t throttleIn = (udb_flags._.radio_on == 1) ? udb_pwIn[THROTTLE_INPUT_CHANNEL] : udb_pwTrim[THROTTLE_INPUT_CHANNEL];
 
-	throttleFiltered.WW += (((int32_t)(throttleIn - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
+	cntrl_lowpass(&throttleFiltered, throttleIn, THROTTLEFILTSHIFT);
 	if (filterManual)
 	{
 		// Continue to filter the throttle control value in manual mode to avoid large, instant
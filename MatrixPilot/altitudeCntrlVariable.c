@@ -30,6 +30,7 @@
 #include "airspeedCntrl.h"
 #include "altitudeCntrl.h"
 #include "sonarCntrl.h"
+#include "pidCntrl.h"
 #include "../libDCM/deadReckoning.h"
 #include "../libUDB/servoOut.h"
 
@@ -84,6 +85,19 @@ int16_t height_throttle_gain;
 int16_t desiredSpeed;
 boolean speed_control;
 
+// The parameters the internal variables were last worked out from
+static struct {
+	int16_t height_target_min;
+	int16_t height_target_max;
+	int16_t height_margin;
+	fractional alt_hold_throttle_min;
+	fractional alt_hold_throttle_max;
+	int16_t alt_hold_pitch_min;
+	int16_t alt_hold_pitch_max;
+	int16_t alt_hold_pitch_high;
+} computed_from;
+static boolean computed = false;
+
 void init_altitudeCntrlVariable(void)
 {
 
@@ -106,6 +120,7 @@ void init_altitudeCntrlVariable(void)
 	pitch_at_zero         = PITCHATZERO;
 	pitch_height_gain     = PITCHHEIGHTGAIN;
 	height_throttle_gain  = HEIGHTTHROTTLEGAIN;
+	computed              = false;
 
 // Initialize to the value from options.h.  Allow updating this value from LOGO/MavLink/etc.
 // Stored in 10ths of meters per second
@@ -201,17 +216,35 @@ void setTargetAltitude(int16_t targetAlt)
 	desiredHeight = targetAlt;
 }
 
-static void normalAltitudeCntrl(void)
+// Work out the internal variables from the parameters, which can be changed
+// at any time over MAVLink. This takes three divides, so it is only done when
+// one of the parameters has changed.
+static void compute_altitude_gains(void)
 {
-	union longww throttleAccum;
-	union longww pitchAccum;
-	int16_t throttleIn;
-	int16_t throttleInOffset;
-	union longww heightError = { 0 };
-	int32_t speed_height;
-
 	union longww temp;
 
+	if (computed &&
+	    computed_from.height_target_min     == height_target_min &&
+	    computed_from.height_target_max     == height_target_max &&
+	    computed_from.height_margin         == height_margin &&
+	    computed_from.alt_hold_throttle_min == alt_hold_throttle_min &&
+	    computed_from.alt_hold_throttle_max == alt_hold_throttle_max &&
+	    computed_from.alt_hold_pitch_min    == alt_hold_pitch_min &&
+	    computed_from.alt_hold_pitch_max    == alt_hold_pitch_max &&
+	    computed_from.alt_hold_pitch_high   == alt_hold_pitch_high)
+	{
+		return;
+	}
+	computed_from.height_target_min     = height_target_min;
+	computed_from.height_target_max     = height_target_max;
+	computed_from.height_margin         = height_margin;
+	computed_from.alt_hold_throttle_min = alt_hold_throttle_min;
+	computed_from.alt_hold_throttle_max = alt_hold_throttle_max;
+	computed_from.alt_hold_pitch_min    = alt_hold_pitch_min;
+	computed_from.alt_hold_pitch_max    = alt_hold_pitch_max;
+	computed_from.alt_hold_pitch_high   = alt_hold_pitch_high;
+	computed = true;
+
 	temp.WW = __builtin_mulss(alt_hold_throttle_max , 2.0 * SERVORANGE);
 	temp.WW <<= 2;
 	if(temp._.W0 & 0x8000) temp._.W1 ++;
@@ -248,6 +281,18 @@ static void normalAltitudeCntrl(void)
 	temp.WW <<= 2;
 	height_throttle_gain =	__builtin_divsd(temp.WW , (SERVORANGE*SERVOSAT));
 	height_throttle_gain >>= 2;
+}
+
+static void normalAltitudeCntrl(void)
+{
+	union longww throttleAccum;
+	union longww pitchAccum;
+	int16_t throttleIn;
+	int16_t throttleInOffset;
+	union longww heightError = { 0 };
+	int32_t speed_height;
+
+	compute_altitude_gains();
 
 	int16_t height_marginx8 = height_margin << 3;
 
@@ -296,8 +341,7 @@ static void normalAltitudeCntrl(void)
 				desiredHeight = ((__builtin_mulss(height_throttle_gain, throttleInOffset - ((int16_t)(DEADBAND)))) >> 11)
 				                + height_target_min;
 			}
-			if (desiredHeight < (int16_t)(height_target_min)) desiredHeight = (int16_t)(height_target_min);
-			if (desiredHeight > (int16_t)(height_target_max)) desiredHeight = (int16_t)(height_target_max);
+			desiredHeight = cntrl_saturate(desiredHeight, height_target_min, height_target_max);
 		}
 		
 		if (throttleInOffset < (int16_t)(DEADBAND) && udb_flags._.radio_on)
@@ -363,16 +407,14 @@ static void normalAltitudeCntrl(void)
 				pitchAltitudeAdjust = 0;
 			}
 
-			throttleFiltered.WW += (((int32_t)(udb_pwTrim[THROTTLE_INPUT_CHANNEL] - throttleFiltered._.W1))<<THROTTLEFILTSHIFT);
-			set_throttle_control(throttleFiltered._.W1 - throttleIn);
+			set_throttle_control(cntrl_lowpass(&throttleFiltered, udb_pwTrim[THROTTLE_INPUT_CHANNEL], THROTTLEFILTSHIFT) - throttleIn);
 			filterManual = true;
 		}
 		else
 		{
 			// Servo reversing is handled in servoMix.c
 			int16_t throttleOut = udb_servo_pulsesat(udb_pwTrim[THROTTLE_INPUT_CHANNEL] + throttleAccum.WW);
-			throttleFiltered.WW += (((int32_t)(throttleOut - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
-			set_throttle_control(throttleFiltered._.W1 - throttleIn);
+			set_throttle_control(cntrl_lowpass(&throttleFiltered, throttleOut, THROTTLEFILTSHIFT) - throttleIn);
 			filterManual = true;
 		}
 
@@ -392,7 +434,7 @@ static void manualThrottle(int16_t throttleIn)
 {
 	int16_t throttle_control_pre;
 
-	throttleFiltered.WW += (((int32_t)(throttleIn - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
+	cntrl_lowpass(&throttleFiltered, throttleIn, THROTTLEFILTSHIFT);
 
 	if (filterManual)
 	{
@@ -417,7 +459,7 @@ static void hoverAltitudeCntrl(void)
 	int16_t throttle_control_pre;
 	int16_t throttleIn = (udb_flags._.radio_on == 1) ? udb_pwIn[THROTTLE_INPUT_CHANNEL] : udb_pwTrim[THROTTLE_INPUT_CHANNEL];
 
-	throttleFiltered.WW += (((int32_t)(throttleIn - throttleFiltered._.W1)) << THROTTLEFILTSHIFT);
+	cntrl_lowpass(&throttleFiltered, throttleIn, THROTTLEFILTSHIFT);
 
 	if (filterManual)
 	{
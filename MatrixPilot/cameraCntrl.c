@@ -21,6 +21,7 @@
 #include "defines.h"
 #include "states.h"
 #include "cameraCntrl.h"
+#include "pidCntrl.h"
 #include "../libDCM/mathlibNAV.h"
 #include "../libDCM/deadReckoning.h"
 #include "../libDCM/rmat.h"
@@ -53,6 +54,37 @@ const int16_t yaw_servo_pwm_min        = ((CAM_YAW_SERVO_MIN   - CAM_YAW_OFFSET_
 static struct relative3D view_location = { 0, 20, 0 };
 static struct relative3D camera_view   = { 0,  0, 0 };
 
+#if (CAM_TARGET_PREDICTION == 1)
+// Camera targeting follows a track of the target, its position and velocity,
+// and aims at where the target will be once the servos have moved there.
+// The full solution for the servos, which rotates the view into the plane's
+// reference and takes two arctangents, is only worked out every
+// CAM_SOLUTION_FRAMES frames. In between, the camera angles are carried on
+// from the plane's gyros, and from the rate at which the line of sight to the
+// target was turning, which takes a few multiplies a frame.
+#define CAM_SOLUTION_FRAMES     4       // solve for the servos at 10Hz
+#define CAM_SOLUTION_SHIFT      2       // log2(CAM_SOLUTION_FRAMES)
+#define CAM_TARGET_MAX_AGE      80      // in frames, an older position of the target is not extrapolated any further
+#define CAM_LOS_STEP            2048    // a solution this far from the angles carried on is for a new target
+
+// Frames of 1/40 second to look ahead, for the target and for the plane
+#define TARGET_LEAD_FRAMES      ((int16_t)((CAM_TARGET_LATENCY + CAM_SERVO_LATENCY) * 40.0 + 0.5))
+#define PLANE_LEAD_FRAMES       ((int16_t)(CAM_SERVO_LATENCY * 40.0 + 0.5))
+
+// The change in a 16 bit angle over a frame, scaled by 65536, for each unit of omegagyro,
+// at the rate rmat.c integrates the gyros.
+#define CAM_GYRO_GAIN           (SCALEGYRO * 3.0 / RMAX * (65536.0 / (2.0 * 3.1416)) / 40.0 * 65536.0)
+
+const int16_t cam_gyro_gain        = CAM_GYRO_GAIN;
+const int16_t pitch_servo_pwm_rate = (CAM_PITCH_SERVO_RATE * 65536.0 / (360.0 * 40.0)) * PITCH_SERVO_RATIO;
+const int16_t yaw_servo_pwm_rate   = (CAM_YAW_SERVO_RATE   * 65536.0 / (360.0 * 40.0)) * YAW_SERVO_RATIO;
+
+static struct relative3D target_velocity = { 0, 0, 0 }; // in cm/sec
+static uint16_t camera_view_fraction[3] = { 0, 0, 0 };  // the fractions of a meter of camera_view, in 1/65536ths
+static int16_t target_age = CAM_TARGET_MAX_AGE;         // frames since the target's position was received
+static int16_t solution_countdown = 0;                  // frames until the next solution
+#endif // CAM_TARGET_PREDICTION
+
 #if (CAM_TESTING_OVERIDE == 1)  // Used to test that Camera swings by correct angles when camera control gains.
 #define CAM_TEST_TIMER 200      // e.g. value of 200 means 5 seconds (200 decremented 40 times / second until zero).
 int16_t cam_test_yaw            = CAM_TESTING_YAW_ANGLE   * 65536.0 / 360.0;
@@ -88,8 +120,43 @@ void set_camera_view(struct relative3D current_view)
 #endif
 }
 
+#if (CAM_TARGET_PREDICTION == 1)
+// The distance in meters, in the high word, covered at a velocity in cm/sec over a number of frames
+static int32_t lead_distance(int16_t velocity, int16_t frames)
+{
+	// there are 4000 frames of cm/sec to a meter, and 65536 / 4000 is 16.384
+	return __builtin_mulsu(velocity, __builtin_muluu(frames, (uint16_t)(16.384 * 1024)) >> 10);
+}
+
+// The view along one axis, from where the plane will be to where the target will be.
+// The meters are returned, and the fraction of a meter is kept, as the leads are
+// only a meter or two, and whole meters would turn the camera in steps.
+static int16_t lead_view(int16_t target, int16_t target_velocity, int32_t plane, int16_t plane_velocity, uint16_t* fraction)
+{
+	union longww view;
+
+	view.WW = ((int32_t)target << 16) + lead_distance(target_velocity, target_age + TARGET_LEAD_FRAMES)
+	        - plane - lead_distance(plane_velocity, PLANE_LEAD_FRAMES);
+	*fraction = view._.W0;
+	return view._.W1;
+}
+#endif // CAM_TARGET_PREDICTION
+
 void compute_camera_view(void)
 {
+#if (CAM_TARGET_PREDICTION == 1)
+	if (solution_countdown != 0) return;    // only the frames which solve for the servos use the view
+
+#if (DEADRECKONING == 1)
+	camera_view.x = lead_view(view_location.x, target_velocity.x, IMUlocationx.WW, IMUvelocityx._.W1, &camera_view_fraction[0]);
+	camera_view.y = lead_view(view_location.y, target_velocity.y, IMUlocationy.WW, IMUvelocityy._.W1, &camera_view_fraction[1]);
+	camera_view.z = lead_view(view_location.z, target_velocity.z, IMUlocationz.WW, IMUvelocityz._.W1, &camera_view_fraction[2]);
+#else
+	camera_view.x = lead_view(view_location.x, target_velocity.x, (int32_t)GPSlocation.x << 16, 0, &camera_view_fraction[0]);
+	camera_view.y = lead_view(view_location.y, target_velocity.y, (int32_t)GPSlocation.y << 16, 0, &camera_view_fraction[1]);
+	camera_view.z = lead_view(view_location.z, target_velocity.z, (int32_t)GPSlocation.z << 16, 0, &camera_view_fraction[2]);
+#endif
+#else
 #if (DEADRECKONING == 1)
 	camera_view.x = view_location.x - IMUlocationx._.W1;
 	camera_view.y = view_location.y - IMUlocationy._.W1;
@@ -99,8 +166,170 @@ void compute_camera_view(void)
 	camera_view.y = view_location.y - GPSlocation.y;
 	camera_view.z = view_location.z - GPSlocation.z;
 #endif
+#endif // CAM_TARGET_PREDICTION
 }
 
+#if (USE_CAMERA_STABILIZATION == 1)
+
+// The camera angles, in the plane's reference, for camera_view
+static void camera_view_angles(int16_t* cam_pitch16, int16_t* cam_yaw16)
+{
+	struct relative2D matrix_accum = { 0, 0 };      // Temporary variable to keep intermediate results of functions
+	fractional cam_vector_ground[] = { 0, 0, 0 };   // Vector to camera target from within ground coordinate reference
+	fractional cam_vector_plane[]  = { 0, 0, 0 };   // Vector to camera target from within plane's coordinate reference
+	fractional rmat_transpose[]    = { RMAX, 0, 0, 0, RMAX, 0, 0, 0, RMAX };
+	int16_t shift = 0;
+
+	// The maths here is as follows.
+	// Take a vector defined in the earth reference (camera_view),
+	// and rotate into the plane's reference. This requires the use of the inverse
+	// of rmat which is also the transpose of the rmat matrix.
+	// Then calculate each of the angles for yaw and pitch in the plane's reference. (roll not implemented at this time).
+
+	// Convert externally requested camera view into a structure of type fractional 
+	// Convert from "UAV Devboard - Ground" convention to "Aviation Convention - Ground"
+	cam_vector_ground[0] = -camera_view.x;
+	cam_vector_ground[1] =  camera_view.y;
+	cam_vector_ground[2] = -camera_view.z;
+
+	// Scale the vector up as far as it safely goes, as the resolution of the angles
+	// is that of the vector, and a view of a few hundred meters has only a few bits.
+	while (cam_vector_ground[0] < 4096 && cam_vector_ground[0] > -4096 &&
+	       cam_vector_ground[1] < 4096 && cam_vector_ground[1] > -4096 &&
+	       cam_vector_ground[2] < 4096 && cam_vector_ground[2] > -4096 &&
+	       (cam_vector_ground[0] | cam_vector_ground[1] | cam_vector_ground[2]) != 0)
+	{
+		cam_vector_ground[0] <<= 1;
+		cam_vector_ground[1] <<= 1;
+		cam_vector_ground[2] <<= 1;
+		shift++;
+	}
+#if (CAM_TARGET_PREDICTION == 1)
+	// and the bits shifted in are those of the fraction of a meter
+	if (shift != 0)
+	{
+		cam_vector_ground[0] -= camera_view_fraction[0] >> (16 - shift);
+		cam_vector_ground[1] += camera_view_fraction[1] >> (16 - shift);
+		cam_vector_ground[2] -= camera_view_fraction[2] >> (16 - shift);
+	}
+#endif
+
+	// Rotate camera vector from ground reference into plane reference
+	MatrixTranspose(3, 3, rmat_transpose, rmat);
+	// It does not matter that the result of the following operation is not the expected magnitude
+	// because the code only uses the ratios of X,Y,Z relative to each other to calculate angles.
+	MatrixMultiply(3, 3, 1, cam_vector_plane, rmat_transpose, cam_vector_ground);
+
+	// Convert camera vector which is now in plane's coordinate reference, to a Yaw angle with respect to front of plane.
+	matrix_accum.x = cam_vector_plane[0];
+	matrix_accum.y = cam_vector_plane[1];
+	*cam_yaw16 = rect_to_polar16(&matrix_accum) - 16384; // subtract 90 degrees so yaw measured in line with fuselage
+
+#if (CAM_TESTING_OVERIDE == 1)
+	cam_test_timer--;
+	if (cam_test_timer <= 0)
+	{
+		cam_test_timer = CAM_TEST_TIMER;
+		cam_test_yaw = cam_test_yaw * -1;   // reverse the angle of test
+	}
+	*cam_yaw16 = cam_test_yaw;
+#endif
+
+	// Convert camera vector (which is in plane's coordinaet reference) to a pitch angle.
+	matrix_accum.y = cam_vector_plane[2];
+	*cam_pitch16 = rect_to_polar16(&matrix_accum); // Note matrix_accum.x is the left over result of yaw call to rect_to_polar16
+
+#if (CAM_TESTING_OVERIDE == 1)
+	*cam_pitch16 = cam_testing_pitch_angle; 
+#endif
+}
+
+#if (CAM_TARGET_PREDICTION == 1)
+static boolean cam_tracking = false;
+static union longww cam_pitch_track = { 0 };            // camera angles carried on between solutions, in the high words
+static union longww cam_yaw_track   = { 0 };
+static int32_t los_pitch_rate = 0;                      // turning of the line of sight each frame, scaled as the angles
+static int32_t los_yaw_rate   = 0;
+static int16_t cam_sin_yaw, cam_cos_yaw, cam_tan_pitch; // of the camera angles of the last solution
+
+// The camera angles for the track of the target, solved for every CAM_SOLUTION_FRAMES
+// frames, and carried on from the gyros in between.
+static void cam_track_angles(int16_t* cam_pitch16, int16_t* cam_yaw16)
+{
+	int16_t pitch16, yaw16;
+	int16_t step_pitch, step_yaw;
+	int16_t sin_pitch, cos_pitch;
+	int16_t pitch_rate, yaw_rate;
+	int32_t gyro_pitch, gyro_yaw;
+	int32_t accum;
+
+	if (solution_countdown == 0)
+	{
+		camera_view_angles(&pitch16, &yaw16);
+		// What the gyros did not account for since the last solution is the turning of the line
+		// of sight, from the motion of the target and the plane. Half of it goes into its rate.
+		step_pitch = pitch16 - cam_pitch_track._.W1;
+		step_yaw   = yaw16   - cam_yaw_track._.W1;
+		if (cam_tracking &&
+		    step_pitch > -CAM_LOS_STEP && step_pitch < CAM_LOS_STEP &&
+		    step_yaw   > -CAM_LOS_STEP && step_yaw   < CAM_LOS_STEP)
+		{
+			los_pitch_rate += ((int32_t)step_pitch << 16) >> (CAM_SOLUTION_SHIFT + 1);
+			los_yaw_rate   += ((int32_t)step_yaw   << 16) >> (CAM_SOLUTION_SHIFT + 1);
+		}
+		else
+		{
+			los_pitch_rate = 0;
+			los_yaw_rate   = 0;
+		}
+		cam_tracking = true;
+		cam_pitch_track._.W1 = pitch16;
+		cam_pitch_track._.W0 = 0;
+		cam_yaw_track._.W1 = yaw16;
+		cam_yaw_track._.W0 = 0;
+
+		cam_sin_yaw = sine((int8_t)(yaw16 >> 8));
+		cam_cos_yaw = cosine((int8_t)(yaw16 >> 8));
+		sin_pitch = sine((int8_t)(pitch16 >> 8));
+		cos_pitch = cosine((int8_t)(pitch16 >> 8));
+		// held to within +/- 2 of the tangent of 63 degrees, looking nearly straight up or down
+		if (sin_pitch < 2 * cos_pitch && sin_pitch > -2 * cos_pitch)
+		{
+			cam_tan_pitch = __builtin_divsd(((int32_t)sin_pitch) << 14, cos_pitch);
+		}
+		else
+		{
+			cam_tan_pitch = (sin_pitch > 0) ? CNTRL_MAX : -CNTRL_MAX;
+		}
+		solution_countdown = CAM_SOLUTION_FRAMES;
+	}
+
+	// The rotation of the plane about the camera's pitch and yaw axes over this frame.
+	// The camera turns the other way, to keep pointing the same way.
+	accum = __builtin_mulss(omegagyro[0], cam_cos_yaw) + __builtin_mulss(omegagyro[1], cam_sin_yaw);
+	pitch_rate = cntrl_saturate(-(accum >> 14), CNTRL_MIN, CNTRL_MAX);
+	accum = __builtin_mulss(omegagyro[1], cam_cos_yaw) - __builtin_mulss(omegagyro[0], cam_sin_yaw);
+	accum = __builtin_mulss(cntrl_saturate(accum >> 14, CNTRL_MIN, CNTRL_MAX), cam_tan_pitch) >> 14;
+	yaw_rate = cntrl_saturate(accum - omegagyro[2], CNTRL_MIN, CNTRL_MAX);
+	gyro_pitch = __builtin_mulss(pitch_rate, cam_gyro_gain);
+	gyro_yaw   = __builtin_mulss(yaw_rate,   cam_gyro_gain);
+
+	if (solution_countdown != CAM_SOLUTION_FRAMES)
+	{
+		cam_pitch_track.WW += gyro_pitch + los_pitch_rate;
+		cam_yaw_track.WW   += gyro_yaw   + los_yaw_rate;
+	}
+	solution_countdown--;
+
+	// The servos are led by the rotation of the plane over the time they take to respond.
+	// The view was already led by the motion of the plane and of the target.
+	*cam_pitch16 = cam_pitch_track._.W1 + (int16_t)(((gyro_pitch >> 4) * PLANE_LEAD_FRAMES) >> 12);
+	*cam_yaw16   = cam_yaw_track._.W1   + (int16_t)(((gyro_yaw   >> 4) * PLANE_LEAD_FRAMES) >> 12);
+}
+#endif // CAM_TARGET_PREDICTION
+
+#endif // USE_CAMERA_STABILIZATION
+
 void cameraCntrl(void)
 {
 #if (USE_CAMERA_STABILIZATION == 1)
@@ -110,9 +339,12 @@ void cameraCntrl(void)
 	int8_t  cam_yaw8    = 0;    // An 8 bit version of cam_yaw to use with sine(), cosine()
 
 	struct relative2D matrix_accum = { 0, 0 };      // Temporary variable to keep intermediate results of functions
-	fractional cam_vector_ground[] = { 0, 0, 0 };   // Vector to camera target from within ground coordinate reference
-	fractional cam_vector_plane[]  = { 0, 0, 0 };   // Vector to camera target from within plane's coordinate reference
-	fractional rmat_transpose[]    = { RMAX, 0, 0, 0, RMAX, 0, 0, 0, RMAX };
+#if (CAM_TARGET_PREDICTION == 1)
+	int16_t last_pitch_pwm_delta = cam_pitch_servo_pwm_delta;
+	int16_t last_yaw_pwm_delta   = cam_yaw_servo_pwm_delta;
+
+	if (target_age < CAM_TARGET_MAX_AGE) target_age++;
+#endif
 
 	// In Manual Mode
 #if (CAMERA_MODE_INPUT_CHANNEL == CHANNEL_UNUSED)
@@ -124,6 +356,10 @@ void cameraCntrl(void)
 		// set camera to default position
 		cam_pitch_servo_pwm_delta = -pitch_offset_centred_pwm;  // Pitch Servo
 		cam_yaw_servo_pwm_delta   = -yaw_offset_centred_pwm;    // Yaw Servo
+#if (CAM_TARGET_PREDICTION == 1)
+		cam_tracking = false;
+		solution_countdown = 0;
+#endif
 	}
 	else
 	{
@@ -157,51 +393,26 @@ void cameraCntrl(void)
 			camera_view.x = -sine(cam_yaw8);
 			camera_view.y =  cosine(cam_yaw8);
 			camera_view.z = -tan_pitch_in_stabilized_mode;
+#if (CAM_TARGET_PREDICTION == 1)
+			camera_view_fraction[0] = 0;
+			camera_view_fraction[1] = 0;
+			camera_view_fraction[2] = 0;
+			cam_tracking = false;
+			solution_countdown = 0;
+#endif
+			camera_view_angles(&cam_pitch16, &cam_yaw16);
 		}
-
-		// Waypoint Mode and Stabilized Mode (and RTL)
-
-		// The maths here is as follows.
-		// Take a vector defined in the earth reference (camera_view),
-		// and rotate into the plane's reference. This requires the use of the inverse
-		// of rmat which is also the transpose of the rmat matrix.
-		// Then calculate each of the angles for yaw and pitch in the plane's reference. (roll not implemented at this time).
-		// Finally, convert camera angles in yaw and pitch to servo rotation angles.
-
-		// Convert externally requested camera view into a structure of type fractional 
-		// Convert from "UAV Devboard - Ground" convention to "Aviation Convention - Ground"
-		cam_vector_ground[0] = -camera_view.x;
-		cam_vector_ground[1] =  camera_view.y;
-		cam_vector_ground[2] = -camera_view.z;
-
-		// Rotate camera vector from ground reference into plane reference
-		MatrixTranspose(3, 3, rmat_transpose, rmat);
-		// It does not matter that the result of the following operation is not the expected magnitude
-		// because the code only uses the ratios of X,Y,Z relative to each other to calculate angles.
-		MatrixMultiply(3, 3, 1, cam_vector_plane, rmat_transpose, cam_vector_ground);
-
-		// Convert camera vector which is now in plane's coordinate reference, to a Yaw angle with respect to front of plane.
-		matrix_accum.x = cam_vector_plane[0];
-		matrix_accum.y = cam_vector_plane[1];
-		cam_yaw16 = rect_to_polar16(&matrix_accum) - 16384; // subtract 90 degrees so yaw measured in line with fuselage
-
-#if (CAM_TESTING_OVERIDE == 1)
-		cam_test_timer--;
-		if (cam_test_timer <= 0)
+		else
 		{
-			cam_test_timer = CAM_TEST_TIMER;
-			cam_test_yaw = cam_test_yaw * -1;   // reverse the angle of test
-		}
-		cam_yaw16 = cam_test_yaw;
+			// Waypoint Mode (and RTL)
+#if (CAM_TARGET_PREDICTION == 1)
+			cam_track_angles(&cam_pitch16, &cam_yaw16);
+#else
+			camera_view_angles(&cam_pitch16, &cam_yaw16);
 #endif
+		}
 
-		// Convert camera vector (which is in plane's coordinaet reference) to a pitch angle.
-		matrix_accum.y = cam_vector_plane[2];
-		cam_pitch16 = rect_to_polar16(&matrix_accum); // Note matrix_accum.x is the left over result of yaw call to rect_to_polar16
-
-#if (CAM_TESTING_OVERIDE == 1)
-		cam_pitch16 = cam_testing_pitch_angle; 
-#endif
+		// Finally, convert camera angles in yaw and pitch to servo rotation angles.
 
 		// One day, insert special logic for when camera nearly pointing straight down 
 		// to prevent large movements of camera on yaw for small changes in roll and pitch.
@@ -224,14 +435,42 @@ void cameraCntrl(void)
 		cam.WW = __builtin_mulss(cam_yaw16 , yaw_servo_high_ratio) + 0x8000;
 		cam_yaw_servo_pwm_delta = cam._.W1 - yaw_offset_centred_pwm;
 	}
+#if (CAM_TARGET_PREDICTION == 1)
+	// Move the servos no faster than they can follow
+	cam_pitch_servo_pwm_delta = cntrl_saturate(cam_pitch_servo_pwm_delta,
+	    last_pitch_pwm_delta - pitch_servo_pwm_rate, last_pitch_pwm_delta + pitch_servo_pwm_rate);
+	cam_yaw_servo_pwm_delta = cntrl_saturate(cam_yaw_servo_pwm_delta,
+	    last_yaw_pwm_delta - yaw_servo_pwm_rate, last_yaw_pwm_delta + yaw_servo_pwm_rate);
+#endif
 #endif // USE_CAMERA_STABILIZATION
 }
 
 #if (CAM_USE_EXTERNAL_TARGET_DATA == 1)
 
-struct relative3D cam_inject; // Camera view location received on the serial port
+struct relative3D cam_inject[2]; // Camera view location, and its velocity in cm/sec if sent, received on the serial port
 uint8_t cam_inject_pos = 0;
 
+#if (CAM_TARGET_PREDICTION == 1)
+// The velocity of a target which only sends its location, from how far it has
+// moved since it was last received, smoothed over about four locations
+static int16_t estimate_velocity(int16_t velocity, int16_t from, int16_t to)
+{
+	int16_t moved = to - from;
+
+	if (target_age == 0)
+	{
+		return velocity;
+	}
+	// Nothing is known of the velocity of a target not heard from for a while, or which jumped
+	if (target_age >= CAM_TARGET_MAX_AGE || moved > 8 * target_age || moved < -8 * target_age)
+	{
+		return 0;
+	}
+	// 4000 frames of cm/sec to a meter
+	return velocity + ((__builtin_divsd(__builtin_mulss(moved, 4000), target_age) - (int32_t)velocity) >> 2);
+}
+#endif // CAM_TARGET_PREDICTION
+
 void camera_live_begin(void)
 {
 	cam_inject_pos = 0;
@@ -258,11 +497,28 @@ void camera_live_received_byte(uint8_t inbyte)
 
 void camera_live_commit(void)
 {
-	if (cam_inject_pos == sizeof(cam_inject))
+	if (cam_inject_pos == sizeof(struct relative3D))
+	{
+#if (CAM_TARGET_PREDICTION == 1)
+		target_velocity.x = estimate_velocity(target_velocity.x, view_location.x, cam_inject[0].x);
+		target_velocity.y = estimate_velocity(target_velocity.y, view_location.y, cam_inject[0].y);
+		target_velocity.z = estimate_velocity(target_velocity.z, view_location.z, cam_inject[0].z);
+		target_age = 0;
+#endif
+		view_location.x = cam_inject[0].x;
+		view_location.y = cam_inject[0].y;
+		view_location.z = cam_inject[0].z;
+	}
+	else if (cam_inject_pos == sizeof(cam_inject))
 	{
-		view_location.x = cam_inject.x;
-		view_location.y = cam_inject.y;
-		view_location.z = cam_inject.z;
+#if (CAM_TARGET_PREDICTION == 1)
+		camera_live_commit_track(cam_inject[0], cam_inject[1]);
+#else
+		// the velocity is only of use in predicting where the target will be
+		view_location.x = cam_inject[0].x;
+		view_location.y = cam_inject[0].y;
+		view_location.z = cam_inject[0].z;
+#endif
 	}
 	cam_inject_pos = 0;
 }
@@ -272,6 +528,25 @@ void camera_live_commit_values(const struct relative3D target)
 	view_location.x = target.x ; //relative position towards the east
 	view_location.y = target.y ; //relative position towards the north
 	view_location.z = target.z ; //relative position vertically up
+#if (CAM_TARGET_PREDICTION == 1)
+	target_velocity.x = 0;
+	target_velocity.y = 0;
+	target_velocity.z = 0;
+	target_age = 0;
+#endif
+}
+
+#if (CAM_TARGET_PREDICTION == 1)
+void camera_live_commit_track(const struct relative3D target, const struct relative3D velocity)
+{
+	view_location.x = target.x;
+	view_location.y = target.y;
+	view_location.z = target.z;
+	target_velocity.x = velocity.x; // in cm/sec
+	target_velocity.y = velocity.y;
+	target_velocity.z = velocity.z;
+	target_age = 0;
 }
+#endif // CAM_TARGET_PREDICTION
 
 #endif // CAM_USE_EXTERNAL_TARGET_DATA
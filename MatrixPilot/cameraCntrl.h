@@ -35,6 +35,7 @@ void camera_live_begin(void);
 void camera_live_received_byte(uint8_t inbyte);
 void camera_live_commit(void);
 void camera_live_commit_values(const struct relative3D target);
+void camera_live_commit_track(const struct relative3D target, const struct relative3D velocity);
 
 //#define CAM_VIEW_LAUNCH     { 0, 0, 0 }
 
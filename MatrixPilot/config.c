@@ -33,6 +33,10 @@
 #include "minIni.h"
 #include "navigate.h"
 #include "airspeedCntrl.h"
+#include "gainSchedule.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 
 
 union settings_word settings;
@@ -41,59 +45,89 @@ struct altit_variables altit;
 struct hover_variables hover;
 struct turns_variables turns;
 
-static const char* strConfigFile = "config.ini";
-//static const char* strNetwork = "NETWORK";
-static const char* strStabilise = "STABILISE";
-static const char* strNavigation = "NAVIGATION";
-static const char* strRoll = "ROLL";
-static const char* strPitch = "PITCH";
-static const char* strYaw = "YAW";
-static const char* strAltitude = "ALTITUDE";
-static const char* strRTL = "RTL";
-static const char* strHover = "HOVER";
-static const char* strTurns = "TURNS";
-static const char* strMode = "MODE";
+static const char strConfigFile[] = "config.ini";
+static const char strStabilise[] = "STABILISE";
+static const char strNavigation[] = "NAVIGATION";
+static const char strRoll[] = "ROLL";
+static const char strPitch[] = "PITCH";
+static const char strYaw[] = "YAW";
+static const char strAltitude[] = "ALTITUDE";
+static const char strRTL[] = "RTL";
+static const char strHover[] = "HOVER";
+static const char strTurns[] = "TURNS";
+static const char strMode[] = "MODE";
+
+// Every setting in config.ini is bound to its variable by an entry in
+// config_keys[]. config_load() sets each variable to its default and then
+// reads the whole file in a single pass, and config_save() writes all of
+// the settings back with a single rewrite of the file, where the ini_get*()
+// and ini_put*() functions open and scan the file once for each setting.
+// The settings and network bit fields can not be pointed to, so are read
+// into the int16_t fields of config_bits first.
+
+#define CONFIG_BOOL         0
+#define CONFIG_INT          1       // int16_t
+#define CONFIG_FLOAT        2
+#define CONFIG_STRING       3       // char[size]
+
+#define CONFIG_LOAD         1
+#define CONFIG_SAVE         2
+
+typedef struct config_key {
+	const char* section;
+	const char* key;
+	uint8_t type;
+	uint8_t flags;
+	uint8_t size;
+	void* value;
+	float def;
+	const char* def_string;
+} config_key_t;
+
+#define CONFIG_B(sec, key, var, def)    { sec, key, CONFIG_BOOL,   CONFIG_LOAD, 0, &(var), (def), NULL }
+#define CONFIG_I(sec, key, var, def)    { sec, key, CONFIG_INT,    CONFIG_LOAD, 0, &(var), (def), NULL }
+#define CONFIG_F(sec, key, var, def)    { sec, key, CONFIG_FLOAT,  CONFIG_LOAD | CONFIG_SAVE, 0, &(var), (def), NULL }
+#define CONFIG_FS(sec, key, var)        { sec, key, CONFIG_FLOAT,  CONFIG_SAVE, 0, &(var), 0, NULL }
+#define CONFIG_S(sec, key, var, def)    { sec, key, CONFIG_STRING, CONFIG_LOAD, sizeof(var), (var), 0, (def) }
+
+static struct {
+	int16_t roll_ail;
+	int16_t roll_rud;
+	int16_t pitch;
+	int16_t yaw_rud;
+	int16_t yaw_ail;
+	int16_t ail;
+	int16_t rud;
+	int16_t alt_stabilised;
+	int16_t alt_waypoint;
+	int16_t racing;
+#if (NETWORK_INTERFACE != NETWORK_INTERFACE_NONE)
+	int16_t port;
+	int16_t uart1;
+	int16_t uart2;
+	int16_t flybywire;
+	int16_t mavlink;
+	int16_t debug;
+	int16_t adsb;
+	int16_t logo;
+	int16_t cam_tracking;
+	int16_t gpstest;
+	int16_t pwmreport;
+	int16_t xplane;
+	int16_t telemetry_extra;
+	int16_t ground_station;
+#endif
+} config_bits;
 
 #if (NETWORK_INTERFACE != NETWORK_INTERFACE_NONE)
 
-static const char* strNetwork = "NETWORK";
+static const char strNetwork[] = "NETWORK";
 union network_module_word nw_mod;
 char address[16];
 char gateway[16];
 char subnet[16];
 char dhcp = 55;
-
-static void load_network(void)
-{
-	int port = 0;
-	int result;
-
-	result = ini_gets(strNetwork, "address", "10.10.10.10", address, sizeof(address), strConfigFile);
-	result = ini_gets(strNetwork, "gateway", "10.1.1.1", gateway, sizeof(gateway), strConfigFile);
-	result = ini_gets(strNetwork, "subnet", "255.0.0.0", subnet, sizeof(subnet), strConfigFile);
-	port = ini_getl(strNetwork, "port", 21, strConfigFile);
-	dhcp = ini_getbool(strNetwork, "dhcp", 1, strConfigFile);
-
-	printf("IP address: %s\r\n", address);
-	printf("IP gateway: %s\r\n", gateway);
-	printf("IP subnet: %s\r\n", subnet);
-	printf("IP port: %u\r\n", port);
-	printf("DHCP: %u\r\n", dhcp);
-
-	nw_mod._.uart1           = ini_getbool(strNetwork, "uart1", NETWORK_USE_UART1, strConfigFile);
-	nw_mod._.uart2           = ini_getbool(strNetwork, "uart2", NETWORK_USE_UART2, strConfigFile);
-	nw_mod._.flybywire       = ini_getbool(strNetwork, "flybywire", NETWORK_USE_FLYBYWIRE, strConfigFile);
-	nw_mod._.mavlink         = ini_getbool(strNetwork, "mavlink", NETWORK_USE_MAVLINK, strConfigFile);
-	nw_mod._.debug           = ini_getbool(strNetwork, "debug", NETWORK_USE_DEBUG, strConfigFile);
-	nw_mod._.adsb            = ini_getbool(strNetwork, "adsb", NETWORK_USE_ADSB, strConfigFile);
-	nw_mod._.logo            = ini_getbool(strNetwork, "logo", NETWORK_USE_LOGO, strConfigFile);
-	nw_mod._.cam_tracking    = ini_getbool(strNetwork, "cam_tracking", NETWORK_USE_CAM_TRACKING, strConfigFile);
-	nw_mod._.gpstest         = ini_getbool(strNetwork, "gpstest", NETWORK_USE_GPSTEST, strConfigFile);
-	nw_mod._.pwmreport       = ini_getbool(strNetwork, "pwmreport", NETWORK_USE_PWMREPORT, strConfigFile);
-	nw_mod._.xplane          = ini_getbool(strNetwork, "xplane", NETWORK_USE_XPLANE, strConfigFile);
-	nw_mod._.telemetry_extra = ini_getbool(strNetwork, "telemetry_extra", NETWORK_USE_TELEMETRY_EXTRA, strConfigFile);
-	nw_mod._.ground_station  = ini_getbool(strNetwork, "ground_station", NETWORK_USE_GROUND_STATION, strConfigFile);
-}
+static int16_t dhcp_bit;
 
 #endif // NETWORK_INTERFACE
 
@@ -121,29 +155,6 @@ pilot = "Not Defined"
 url = "http://www.diydrones.com"
  */
 
-static void load_settings(void)
-{
-//	printf("load_settings()\r\n");
-
-	settings._.RollStabilizaionAilerons = ini_getbool(strStabilise, "roll_ail", ROLL_STABILIZATION_AILERONS, strConfigFile);
-	settings._.RollStabilizationRudder = ini_getbool(strStabilise, "roll_rud", ROLL_STABILIZATION_RUDDER, strConfigFile);
-	settings._.PitchStabilization = ini_getbool(strStabilise, "pitch", PITCH_STABILIZATION, strConfigFile);
-	settings._.YawStabilizationRudder = ini_getbool(strStabilise, "yaw_rud", YAW_STABILIZATION_RUDDER, strConfigFile);
-	settings._.YawStabilizationAileron = ini_getbool(strStabilise, "yaw_ail", YAW_STABILIZATION_AILERON, strConfigFile);
-
-	settings._.AileronNavigation = ini_getbool(strNavigation, "ail", AILERON_NAVIGATION, strConfigFile);
-	settings._.RudderNavigation = ini_getbool(strNavigation, "rud", RUDDER_NAVIGATION, strConfigFile);
-	// = ini_getbool(strNavigation, "wind", WIND_GAIN_ADJUSTMENT, strConfigFile);
-
-	settings._.AltitudeholdStabilized = ini_getl(strAltitude, "stabilised", ALTITUDEHOLD_STABILIZED, strConfigFile);
-	settings._.AltitudeholdWaypoint = ini_getl(strAltitude, "waypoint", ALTITUDEHOLD_WAYPOINT, strConfigFile);
-	settings._.RacingMode = ini_getbool(strMode, "racing", RACING_MODE, strConfigFile);
-}
-
-static void save_settings(void)
-{
-}
-
 /*
 [ALTITUDE]
 # NONE = 0, FULL = 1, PITCH = 2
@@ -152,7 +163,6 @@ stabilised = 1
 waypoint = 1
  */
 
-
 /*
 
 new for helicalTurns:
@@ -172,142 +182,286 @@ and we remove the following:
 #define ROLL_ELEV_MIX                       0.35
 
  */
-static void load_turns(void)
-{
-	turns.FeedForward = ini_getf(strTurns, "feedfwd", FEED_FORWARD, strConfigFile);
-	DPRINT("turns.FeedForward = %f\r\n", (double)turns.FeedForward);
-	turns.TurnRateNav = ini_getf(strTurns, "ratenav", TURN_RATE_NAV, strConfigFile);
-	turns.TurnRateFBW = ini_getf(strTurns, "ratefbw", TURN_RATE_FBW, strConfigFile);
-	turns.RefSpeed = ini_getf(strTurns, "refspd", REFERENCE_SPEED, strConfigFile);
-	turns.AngleOfAttackNormal = ini_getf(strTurns, "aoanorm", ANGLE_OF_ATTACK_NORMAL, strConfigFile);
-	turns.AngleOfAttackInverted = ini_getf(strTurns, "aoainvt", ANGLE_OF_ATTACK_INVERTED, strConfigFile);
-	turns.ElevatorTrimNormal = ini_getf(strTurns, "elenorm", ELEVATOR_TRIM_NORMAL, strConfigFile);
-	turns.ElevatorTrimInverted = ini_getf(strTurns, "eleinvt", ELEVATOR_TRIM_INVERTED, strConfigFile);
-}
 
-static void load_gains(void)
-{
+static const config_key_t config_keys[] = {
+#if (NETWORK_INTERFACE != NETWORK_INTERFACE_NONE)
+	CONFIG_S(strNetwork, "address", address, "10.10.10.10"),
+	CONFIG_S(strNetwork, "gateway", gateway, "10.1.1.1"),
+	CONFIG_S(strNetwork, "subnet", subnet, "255.0.0.0"),
+	CONFIG_I(strNetwork, "port", config_bits.port, 21),
+	CONFIG_B(strNetwork, "dhcp", dhcp_bit, 1),
+	CONFIG_B(strNetwork, "uart1", config_bits.uart1, NETWORK_USE_UART1),
+	CONFIG_B(strNetwork, "uart2", config_bits.uart2, NETWORK_USE_UART2),
+	CONFIG_B(strNetwork, "flybywire", config_bits.flybywire, NETWORK_USE_FLYBYWIRE),
+	CONFIG_B(strNetwork, "mavlink", config_bits.mavlink, NETWORK_USE_MAVLINK),
+	CONFIG_B(strNetwork, "debug", config_bits.debug, NETWORK_USE_DEBUG),
+	CONFIG_B(strNetwork, "adsb", config_bits.adsb, NETWORK_USE_ADSB),
+	CONFIG_B(strNetwork, "logo", config_bits.logo, NETWORK_USE_LOGO),
+	CONFIG_B(strNetwork, "cam_tracking", config_bits.cam_tracking, NETWORK_USE_CAM_TRACKING),
+	CONFIG_B(strNetwork, "gpstest", config_bits.gpstest, NETWORK_USE_GPSTEST),
+	CONFIG_B(strNetwork, "pwmreport", config_bits.pwmreport, NETWORK_USE_PWMREPORT),
+	CONFIG_B(strNetwork, "xplane", config_bits.xplane, NETWORK_USE_XPLANE),
+	CONFIG_B(strNetwork, "telemetry_extra", config_bits.telemetry_extra, NETWORK_USE_TELEMETRY_EXTRA),
+	CONFIG_B(strNetwork, "ground_station", config_bits.ground_station, NETWORK_USE_GROUND_STATION),
+#endif // NETWORK_INTERFACE
+
+	CONFIG_B(strStabilise, "roll_ail", config_bits.roll_ail, ROLL_STABILIZATION_AILERONS),
+	CONFIG_B(strStabilise, "roll_rud", config_bits.roll_rud, ROLL_STABILIZATION_RUDDER),
+	CONFIG_B(strStabilise, "pitch", config_bits.pitch, PITCH_STABILIZATION),
+	CONFIG_B(strStabilise, "yaw_rud", config_bits.yaw_rud, YAW_STABILIZATION_RUDDER),
+	CONFIG_B(strStabilise, "yaw_ail", config_bits.yaw_ail, YAW_STABILIZATION_AILERON),
+	CONFIG_B(strNavigation, "ail", config_bits.ail, AILERON_NAVIGATION),
+	CONFIG_B(strNavigation, "rud", config_bits.rud, RUDDER_NAVIGATION),
+	// = ini_getbool(strNavigation, "wind", WIND_GAIN_ADJUSTMENT, strConfigFile);
+	CONFIG_I(strAltitude, "stabilised", config_bits.alt_stabilised, ALTITUDEHOLD_STABILIZED),
+	CONFIG_I(strAltitude, "waypoint", config_bits.alt_waypoint, ALTITUDEHOLD_WAYPOINT),
+	CONFIG_B(strMode, "racing", config_bits.racing, RACING_MODE),
+
 // Aileron/Roll Control Gains
-	gains.RollKP = ini_getf(strRoll, "rollkp", ROLLKP, strConfigFile);
-	gains.RollKD = ini_getf(strRoll, "rollkd", ROLLKD, strConfigFile);
-	gains.YawKPAileron = ini_getf(strRoll, "yawkp", YAWKP_AILERON, strConfigFile);
-	gains.YawKDAileron = ini_getf(strRoll, "yawkd", YAWKD_AILERON, strConfigFile);
-//	gains.AileronBoost = ini_getf(strRoll, "boost", AILERON_BOOST, strConfigFile);
+	CONFIG_F(strRoll, "rollkp", gains.RollKP, ROLLKP),
+	CONFIG_F(strRoll, "rollkd", gains.RollKD, ROLLKD),
+	CONFIG_F(strRoll, "yawkp", gains.YawKPAileron, YAWKP_AILERON),
+	CONFIG_F(strRoll, "yawkd", gains.YawKDAileron, YAWKD_AILERON),
+	CONFIG_FS(strRoll, "boost", gains.AileronBoost),
 
 // Elevator/Pitch Control Gains
-	gains.Pitchgain = ini_getf(strPitch, "gain", PITCHGAIN, strConfigFile);
-	gains.PitchKD = ini_getf(strPitch, "pitchkd", PITCHKD, strConfigFile);
-//	gains.RudderElevMix = ini_getf(strPitch, "rudder", RUDDER_ELEV_MIX, strConfigFile);
-//	gains.RollElevMix = ini_getf(strPitch, "roll", ROLL_ELEV_MIX, strConfigFile);
-	gains.ElevatorBoost = ini_getf(strPitch, "boost", ELEVATOR_BOOST, strConfigFile);
+	CONFIG_F(strPitch, "gain", gains.Pitchgain, PITCHGAIN),
+	CONFIG_F(strPitch, "pitchkd", gains.PitchKD, PITCHKD),
+	CONFIG_FS(strPitch, "rudder", gains.RudderElevMix),
+	CONFIG_FS(strPitch, "roll", gains.RollElevMix),
+	CONFIG_F(strPitch, "boost", gains.ElevatorBoost, ELEVATOR_BOOST),
 	// = ini_getf(strPitch, "invert", INVERTED_NEUTRAL_PITCH, strConfigFile);
 
 // Rudder/Yaw Control Gains
-	gains.YawKPRudder = ini_getf(strYaw, "yawkp", YAWKP_RUDDER, strConfigFile);
-	gains.YawKDRudder = ini_getf(strYaw, "yawkd", YAWKD_RUDDER, strConfigFile);
-	gains.RollKPRudder = ini_getf(strYaw, "rollkp", ROLLKP_RUDDER, strConfigFile);
-	gains.RollKDRudder = ini_getf(strYaw, "rollkd", ROLLKD_RUDDER, strConfigFile);
+	CONFIG_F(strYaw, "yawkp", gains.YawKPRudder, YAWKP_RUDDER),
+	CONFIG_F(strYaw, "yawkd", gains.YawKDRudder, YAWKD_RUDDER),
+	CONFIG_F(strYaw, "rollkp", gains.RollKPRudder, ROLLKP_RUDDER),
+	CONFIG_F(strYaw, "rollkd", gains.RollKDRudder, ROLLKD_RUDDER),
 	// = ini_getf(strYaw, "mix", MANUAL_AILERON_RUDDER_MIX, strConfigFile);
-	gains.RudderBoost = ini_getf(strYaw, "boost", RUDDER_BOOST, strConfigFile);
+	CONFIG_F(strYaw, "boost", gains.RudderBoost, RUDDER_BOOST),
 
 // Altitude Hold
-	altit.DesiredSpeed = ini_getf(strAltitude, "desired_speed", DESIRED_SPEED, strConfigFile);
-	altit.HeightMargin = ini_getf(strAltitude, "height_margin", HEIGHT_MARGIN, strConfigFile);
-	altit.HeightTargetMax = ini_getf(strAltitude, "height_max", HEIGHT_TARGET_MAX, strConfigFile);
-	altit.HeightTargetMin = ini_getf(strAltitude, "height_min", HEIGHT_TARGET_MIN, strConfigFile);
-	altit.AltHoldThrottleMin = ini_getf(strAltitude, "throt_min", ALT_HOLD_THROTTLE_MIN, strConfigFile);
-	altit.AltHoldThrottleMax = ini_getf(strAltitude, "throt_max", ALT_HOLD_THROTTLE_MAX, strConfigFile);
-	altit.AltHoldPitchMin = ini_getf(strAltitude, "pitch_min", ALT_HOLD_PITCH_MIN, strConfigFile);
-	altit.AltHoldPitchMax = ini_getf(strAltitude, "pitch_max", ALT_HOLD_PITCH_MAX, strConfigFile);
-	altit.AltHoldPitchHigh = ini_getf(strAltitude, "pitch_high", ALT_HOLD_PITCH_HIGH, strConfigFile);
+	CONFIG_F(strAltitude, "desired_speed", altit.DesiredSpeed, DESIRED_SPEED),
+	CONFIG_F(strAltitude, "height_margin", altit.HeightMargin, HEIGHT_MARGIN),
+	CONFIG_F(strAltitude, "height_max", altit.HeightTargetMax, HEIGHT_TARGET_MAX),
+	CONFIG_F(strAltitude, "height_min", altit.HeightTargetMin, HEIGHT_TARGET_MIN),
+	CONFIG_F(strAltitude, "throt_min", altit.AltHoldThrottleMin, ALT_HOLD_THROTTLE_MIN),
+	CONFIG_F(strAltitude, "throt_max", altit.AltHoldThrottleMax, ALT_HOLD_THROTTLE_MAX),
+	CONFIG_F(strAltitude, "pitch_min", altit.AltHoldPitchMin, ALT_HOLD_PITCH_MIN),
+	CONFIG_F(strAltitude, "pitch_max", altit.AltHoldPitchMax, ALT_HOLD_PITCH_MAX),
+	CONFIG_F(strAltitude, "pitch_high", altit.AltHoldPitchHigh, ALT_HOLD_PITCH_HIGH),
 	// = ini_getl(strAltitude, "margin", HEIGHT_MARGIN, strConfigFile);
 
 // Return To Launch Pitch Down
-	gains.RtlPitchDown = ini_getf(strRTL, "pitch", RTL_PITCH_DOWN, strConfigFile);
+	CONFIG_F(strRTL, "pitch", gains.RtlPitchDown, RTL_PITCH_DOWN),
 
 // Hover
-    hover.HoverRollKP = ini_getf(strHover, "rollkp", HOVER_ROLLKP, strConfigFile);
-    hover.HoverRollKD = ini_getf(strHover, "rollkd", HOVER_ROLLKD, strConfigFile);
-    hover.HoverPitchGain = ini_getf(strHover, "gain", HOVER_PITCHGAIN, strConfigFile);
-    hover.HoverPitchKD = ini_getf(strHover, "pitchkd", HOVER_PITCHKD, strConfigFile);
-    hover.HoverPitchOffset = ini_getf(strHover, "pitch", HOVER_PITCH_OFFSET, strConfigFile);
-    hover.HoverYawKP = ini_getf(strHover, "yawkp", HOVER_YAWKP, strConfigFile);
-    hover.HoverYawKD = ini_getf(strHover, "yawkd", HOVER_YAWKD, strConfigFile);
-    hover.HoverYawOffset = ini_getf(strHover, "yaw", HOVER_YAW_OFFSET, strConfigFile);
-    hover.HoverPitchTowardsWP = ini_getf(strHover, "wp", HOVER_PITCH_TOWARDS_WP, strConfigFile);
-    hover.HoverNavMaxPitchRadius = ini_getf(strHover, "radius", HOVER_NAV_MAX_PITCH_RADIUS, strConfigFile);
+	CONFIG_F(strHover, "rollkp", hover.HoverRollKP, HOVER_ROLLKP),
+	CONFIG_F(strHover, "rollkd", hover.HoverRollKD, HOVER_ROLLKD),
+	CONFIG_F(strHover, "gain", hover.HoverPitchGain, HOVER_PITCHGAIN),
+	CONFIG_F(strHover, "pitchkd", hover.HoverPitchKD, HOVER_PITCHKD),
+	CONFIG_F(strHover, "pitch", hover.HoverPitchOffset, HOVER_PITCH_OFFSET),
+	CONFIG_F(strHover, "yawkp", hover.HoverYawKP, HOVER_YAWKP),
+	CONFIG_F(strHover, "yawkd", hover.HoverYawKD, HOVER_YAWKD),
+	CONFIG_F(strHover, "yaw", hover.HoverYawOffset, HOVER_YAW_OFFSET),
+	CONFIG_F(strHover, "wp", hover.HoverPitchTowardsWP, HOVER_PITCH_TOWARDS_WP),
+	CONFIG_F(strHover, "radius", hover.HoverNavMaxPitchRadius, HOVER_NAV_MAX_PITCH_RADIUS),
+
+// Helical Turns
+	CONFIG_F(strTurns, "feedfwd", turns.FeedForward, FEED_FORWARD),
+	CONFIG_F(strTurns, "ratenav", turns.TurnRateNav, TURN_RATE_NAV),
+	CONFIG_F(strTurns, "ratefbw", turns.TurnRateFBW, TURN_RATE_FBW),
+	CONFIG_F(strTurns, "refspd", turns.RefSpeed, REFERENCE_SPEED),
+	CONFIG_F(strTurns, "aoanorm", turns.AngleOfAttackNormal, ANGLE_OF_ATTACK_NORMAL),
+	CONFIG_F(strTurns, "aoainvt", turns.AngleOfAttackInverted, ANGLE_OF_ATTACK_INVERTED),
+	CONFIG_F(strTurns, "elenorm", turns.ElevatorTrimNormal, ELEVATOR_TRIM_NORMAL),
+	CONFIG_F(strTurns, "eleinvt", turns.ElevatorTrimInverted, ELEVATOR_TRIM_INVERTED),
+};
+
+#define CONFIG_KEYS (sizeof(config_keys) / sizeof(config_keys[0]))
+
+static boolean same_name(const char* a, const char* b)
+{
+	while (*a && toupper((unsigned char)*a) == toupper((unsigned char)*b))
+	{
+		a++;
+		b++;
+	}
+	return (*a == *b);
 }
 
-static void save_gains(void)
+static const config_key_t* config_find(const char* section, const char* key)
 {
-// Aileron/Roll Control Gains
-	ini_putf(strRoll, "rollkp", gains.RollKP, strConfigFile);
-	ini_putf(strRoll, "rollkd", gains.RollKD, strConfigFile);
-	ini_putf(strRoll, "yawkp", gains.YawKPAileron, strConfigFile);
-	ini_putf(strRoll, "yawkd", gains.YawKDAileron, strConfigFile);
-	ini_putf(strRoll, "boost", gains.AileronBoost, strConfigFile);
+	uint16_t i;
+
+	for (i = 0; i < CONFIG_KEYS; i++)
+	{
+		if (same_name(config_keys[i].key, key) && same_name(config_keys[i].section, section))
+		{
+			return &config_keys[i];
+		}
+	}
+	return NULL;
+}
 
-// Elevator/Pitch Control Gains
-	ini_putf(strPitch, "gain", gains.Pitchgain, strConfigFile);
-	ini_putf(strPitch, "pitchkd", gains.PitchKD, strConfigFile);
-	ini_putf(strPitch, "rudder", gains.RudderElevMix, strConfigFile);
-	ini_putf(strPitch, "roll", gains.RollElevMix, strConfigFile);
-	ini_putf(strPitch, "boost", gains.ElevatorBoost, strConfigFile);
-	// = ini_putf(strPitch, "invert", gains.INVERTED_NEUTRALPitch, strConfigFile);
+// as ini_getbool(), ini_getl(), ini_getf() and ini_gets() would read value
+static void config_set(const config_key_t* k, const char* value)
+{
+	char c;
+
+	switch (k->type)
+	{
+		case CONFIG_BOOL:
+			c = toupper((unsigned char)value[0]);
+			if (c == 'Y' || c == '1' || c == 'T')
+			{
+				*(int16_t*)k->value = 1;
+			}
+			else if (c == 'N' || c == '0' || c == 'F')
+			{
+				*(int16_t*)k->value = 0;
+			}
+			break;
+		case CONFIG_INT:
+			if (*value)
+			{
+				// as ini_getl(), base 16 after 0x, and base 10 even with a leading 0
+				*(int16_t*)k->value = (int16_t)strtol(value, NULL, (toupper((unsigned char)value[1]) == 'X') ? 16 : 10);
+			}
+			break;
+		case CONFIG_FLOAT:
+			if (*value)
+			{
+				*(float*)k->value = (float)strtod(value, NULL);
+			}
+			break;
+		case CONFIG_STRING:
+			strncpy((char*)k->value, value, k->size - 1);
+			((char*)k->value)[k->size - 1] = '\0';
+			break;
+	}
+}
 
-// Rudder/Yaw Control Gains
-	ini_putf(strYaw, "yawkp", gains.YawKPRudder, strConfigFile);
-	ini_putf(strYaw, "yawkd", gains.YawKDRudder, strConfigFile);
-	ini_putf(strYaw, "rollkp", gains.RollKPRudder, strConfigFile);
-	ini_putf(strYaw, "rollkd", gains.RollKDRudder, strConfigFile);
-	// = ini_putf(strYaw, "mix", gains.MANUAL_AILERON_Rudder_MIX, strConfigFile);
-	ini_putf(strYaw, "boost", gains.RudderBoost, strConfigFile);
+static void config_default(const config_key_t* k)
+{
+	switch (k->type)
+	{
+		case CONFIG_BOOL:
+		case CONFIG_INT:
+			*(int16_t*)k->value = (int16_t)k->def;
+			break;
+		case CONFIG_FLOAT:
+			*(float*)k->value = k->def;
+			break;
+		case CONFIG_STRING:
+			config_set(k, k->def_string);
+			break;
+	}
+}
 
-// Altitude Hold
-	ini_putf(strAltitude, "desired_speed", altit.DesiredSpeed, strConfigFile);
-	ini_putf(strAltitude, "height_margin", altit.HeightMargin, strConfigFile);
-	ini_putf(strAltitude, "height_max", altit.HeightTargetMax, strConfigFile);
-	ini_putf(strAltitude, "height_min", altit.HeightTargetMin, strConfigFile);
-	ini_putf(strAltitude, "throt_min", altit.AltHoldThrottleMin, strConfigFile);
-	ini_putf(strAltitude, "throt_max", altit.AltHoldThrottleMax, strConfigFile);
-	ini_putf(strAltitude, "pitch_min", altit.AltHoldPitchMin, strConfigFile);
-	ini_putf(strAltitude, "pitch_max", altit.AltHoldPitchMax, strConfigFile);
-	ini_putf(strAltitude, "pitch_high", altit.AltHoldPitchHigh, strConfigFile);
-	// = ini_getl(strAltitude, "margin", altit.Height_MARGIN, strConfigFile);
+// ini_browse() callback, for every setting in the file
+static int config_read(const char* section, const char* key, const char* value, const void* user_data)
+{
+	const config_key_t* k = config_find(section, key);
 
-// Return To Launch Pitch Down
-	ini_putf(strRTL, "pitch", gains.RtlPitchDown, strConfigFile);
+	if (k != NULL && (k->flags & CONFIG_LOAD))
+	{
+		config_set(k, value);
+	}
+	return 1;
+}
 
-// Hover
-	ini_putf(strHover, "rollkp", hover.HoverRollKP, strConfigFile);
-	ini_putf(strHover, "rollkd", hover.HoverRollKD, strConfigFile);
-	ini_putf(strHover, "gain", hover.HoverPitchGain, strConfigFile);
-	ini_putf(strHover, "pitchkd", hover.HoverPitchKD, strConfigFile);
-	ini_putf(strHover, "pitch", hover.HoverPitchOffset, strConfigFile);
-	ini_putf(strHover, "yawkp", hover.HoverYawKP, strConfigFile);
-	ini_putf(strHover, "yawkd", hover.HoverYawKD, strConfigFile);
-	ini_putf(strHover, "yaw", hover.HoverYawOffset, strConfigFile);
-	ini_putf(strHover, "wp", hover.HoverPitchTowardsWP, strConfigFile);
-	ini_putf(strHover, "radius", hover.HoverNavMaxPitchRadius, strConfigFile);
+// ini_putbatch() callback, naming each setting to be saved
+static int config_write(int index, const char** section, const char** key, char* value, int size, const void* user_data)
+{
+	const config_key_t* k;
+
+	if (index >= (int)CONFIG_KEYS)
+	{
+		return 0;
+	}
+	k = &config_keys[index];
+	*section = k->section;
+	*key = (k->flags & CONFIG_SAVE) ? k->key : NULL;
+	if (value != NULL && *key != NULL)
+	{
+		switch (k->type)
+		{
+			case CONFIG_BOOL:
+			case CONFIG_INT:
+				snprintf(value, size, "%i", *(int16_t*)k->value);
+				break;
+			case CONFIG_FLOAT:
+				snprintf(value, size, "%f", (double)*(float*)k->value);
+				break;
+			case CONFIG_STRING:
+				snprintf(value, size, "%s", (char*)k->value);
+				break;
+		}
+	}
+	return 1;
 }
 
-static void save_turns(void)
+#if (NETWORK_INTERFACE != NETWORK_INTERFACE_NONE)
+
+static void load_network(void)
+{
+	dhcp = dhcp_bit;
+
+	printf("IP address: %s\r\n", address);
+	printf("IP gateway: %s\r\n", gateway);
+	printf("IP subnet: %s\r\n", subnet);
+	printf("IP port: %u\r\n", config_bits.port);
+	printf("DHCP: %u\r\n", dhcp);
+
+	nw_mod._.uart1           = config_bits.uart1;
+	nw_mod._.uart2           = config_bits.uart2;
+	nw_mod._.flybywire       = config_bits.flybywire;
+	nw_mod._.mavlink         = config_bits.mavlink;
+	nw_mod._.debug           = config_bits.debug;
+	nw_mod._.adsb            = config_bits.adsb;
+	nw_mod._.logo            = config_bits.logo;
+	nw_mod._.cam_tracking    = config_bits.cam_tracking;
+	nw_mod._.gpstest         = config_bits.gpstest;
+	nw_mod._.pwmreport       = config_bits.pwmreport;
+	nw_mod._.xplane          = config_bits.xplane;
+	nw_mod._.telemetry_extra = config_bits.telemetry_extra;
+	nw_mod._.ground_station  = config_bits.ground_station;
+}
+
+#endif // NETWORK_INTERFACE
+
+static void load_settings(void)
 {
-	ini_putf(strTurns, "feedfwd", turns.FeedForward, strConfigFile);
-	ini_putf(strTurns, "ratenav", turns.TurnRateNav, strConfigFile);
-	ini_putf(strTurns, "ratefbw", turns.TurnRateFBW, strConfigFile);
-	ini_putf(strTurns, "refspd", turns.RefSpeed, strConfigFile);
-	ini_putf(strTurns, "aoanorm", turns.AngleOfAttackNormal, strConfigFile);
-	ini_putf(strTurns, "aoainvt", turns.AngleOfAttackInverted, strConfigFile);
-	ini_putf(strTurns, "elenorm", turns.ElevatorTrimNormal, strConfigFile);
-	ini_putf(strTurns, "eleinvt", turns.ElevatorTrimInverted, strConfigFile);
+	settings._.RollStabilizaionAilerons = config_bits.roll_ail;
+	settings._.RollStabilizationRudder = config_bits.roll_rud;
+	settings._.PitchStabilization = config_bits.pitch;
+	settings._.YawStabilizationRudder = config_bits.yaw_rud;
+	settings._.YawStabilizationAileron = config_bits.yaw_ail;
+	settings._.AileronNavigation = config_bits.ail;
+	settings._.RudderNavigation = config_bits.rud;
+	settings._.AltitudeholdStabilized = config_bits.alt_stabilised;
+	settings._.AltitudeholdWaypoint = config_bits.alt_waypoint;
+	settings._.RacingMode = config_bits.racing;
 }
 
 void config_load(void)
 {
+	uint16_t i;
+
+	for (i = 0; i < CONFIG_KEYS; i++)
+	{
+		if (config_keys[i].flags & CONFIG_LOAD)
+		{
+			config_default(&config_keys[i]);
+		}
+	}
+	ini_browse(config_read, NULL, strConfigFile);
+#if (NETWORK_INTERFACE != NETWORK_INTERFACE_NONE)
+	load_network();
+#endif
 	load_settings();
-	load_gains();
-	load_turns();
+	DPRINT("turns.FeedForward = %f\r\n", (double)turns.FeedForward);
 
 	init_yawCntrl();
 	init_rollCntrl();
@@ -315,6 +469,7 @@ void config_load(void)
 
 	init_navigation();
 	init_airspeedCntrl();
+	init_gainSchedule();
 	init_altitudeCntrl();
 	init_altitudeCntrlVariable();
 }
@@ -333,9 +488,10 @@ void config_save(void)
 	save_altitudeCntrl();
 #endif
 
-	save_settings();
-	save_gains();
-	save_turns();
+	if (!ini_putbatch(config_write, NULL, strConfigFile))
+	{
+		DPRINT("ERROR: %s could not be saved\r\n", strConfigFile);
+	}
 }
 
 void config_init(void)
@@ -20,6 +20,9 @@
 
 // TODO: bad header file name, implies it has editable options, which it does not
 
+#ifndef CONFIG_H
+#define CONFIG_H
+
 ////////////////////////////////////////////////////////////////////////////////
 // config.h
 // 
@@ -148,3 +151,5 @@ extern union settings_word settings;
 void config_load(void);
 void config_save(void);
 void config_init(void);
+
+#endif // CONFIG_H
@@ -21,6 +21,7 @@
 #include "defines.h"
 #include "behaviour.h"
 #include "options_ports.h"
+#include "options_mavlink.h"
 
 
 // This file should generate no code.
@@ -239,6 +240,18 @@
 	#error("USE_TELELOG requires USE_FILESYS"
 #endif
 
+#if ((USE_TELELOG == 1) && defined(TELELOG_BLOCKS) && (TELELOG_BLOCKS < 2))
+	#error("TELELOG_BLOCKS must be at least 2"
+#endif
+
+#if ((USE_TELELOG == 1) && defined(TELELOG_MAX_FILES) && (TELELOG_MAX_FILES < 2 || TELELOG_MAX_FILES > 255))
+	#error("TELELOG_MAX_FILES must be between 2 and 255"
+#endif
+
+#if ((USE_MAVLINK == 1) && (MAVLINK_FTP == 1) && (USE_FILESYS == 0))
+	#error("MAVLINK_FTP requires USE_FILESYS"
+#endif
+
 #if ((USE_USB == 1) && (BOARD_TYPE != AUAV3_BOARD))
 	#error("USE_USB only supported on AUAV3 board"
 #endif
@@ -251,6 +264,10 @@
 	#error("HILSIM_USB only supported on AUAV3 board"
 #endif
 
+#if ((MAVLINK_USB_CHANNEL == 1) && ((USE_USB != 1) || (USE_CDC != 1) || (HILSIM_USB == 1)))
+	#error("MAVLINK_USB_CHANNEL requires USE_USB and USE_CDC, and can't be used with HILSIM_USB"
+#endif
+
 #ifdef INVERTED_NEUTRAL_PITCH
 #ifdef ANGLE_OF_ATTACK_INVERTED
 #error ( "Both INVERTED_NEUTRAL_PITCH and ANGLE_OF_ATTACK_INVERTED are being used. Use only one or the other."
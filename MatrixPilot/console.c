@@ -27,6 +27,7 @@
 #include "../libDCM/estAltitude.h"
 #include "../libUDB/uart.h"
 #include "options_ports.h"
+#include "profile.h"
 #include <string.h>
 
 #if (CONSOLE_UART != 0)
@@ -281,6 +282,30 @@ static void cmd_close(char* arg)
 #endif
 }
 
+void filesys_stats(void);
+
+static void cmd_fs(char* arg)
+{
+#if (USE_FILESYS == 1)
+	filesys_stats();
+#endif
+}
+
+// 'prof' prints the code section timings, and 'prof reset' starts them again
+static void cmd_prof(char* arg)
+{
+#if (USE_PROFILING == 1)
+	if (arg != NULL && strcmp(arg, "reset") == 0)
+	{
+		profile_reset();
+		return;
+	}
+	profile_print();
+#else
+	printf("USE_PROFILING is not enabled\r\n");
+#endif
+}
+
 //void navigate_print(void);
 static void cmd_nav(char* arg)
 {
@@ -308,6 +333,8 @@ const cmds_t cmdslist[] = {
 	{ 0, cmd_reset,  "reset" },
 	{ 0, cmd_trap,   "trap" },
 	{ 0, cmd_close,  "close" },
+	{ 0, cmd_fs,     "fs" },
+	{ 0, cmd_prof,   "prof" },
 };
 
 static void cmd_help(char* arg)
@@ -35,7 +35,10 @@
 
 #include "data_services.h"
 #include "../libUDB/events.h"
+#include "../libUDB/heartbeat.h"
+#include "../libDCM/gpsData.h"
 #include "parameter_table.h"
+#include <stdlib.h>
 #include <string.h>
 
 #if (SILSIM == 1)
@@ -45,6 +48,9 @@ int _SWR = 0;
 // Data buffer used for services
 static uint8_t data_services_buffer[DATA_SERVICE_BUFFER_SIZE];
 
+// Layout signature the area in the buffer was saved with
+static uint16_t data_services_layout = 0;
+
 // callback type for data services user
 static DSRV_callbackFunc data_services_user_callback = NULL;
 
@@ -118,8 +124,8 @@ static void data_services_write_callback(boolean success);
 // Get the index in the nv memory table for the storage handle.
 static uint16_t data_services_get_table_index(uint16_t data_storage_handle);
 
-// Calculate the size of the complete list of variable items in bytes
-static uint16_t data_services_calc_item_size(uint16_t table_index);
+// Size of the storage area for a table entry in bytes
+static uint16_t data_services_area_size(uint16_t table_index);
 
 // Tracking index into table
 static uint16_t data_services_table_index = 0;
@@ -127,6 +133,20 @@ static uint16_t data_services_table_index = 0;
 // Flags that determine how and when to do serialisation
 static uint16_t data_services_serialize_flags = 0;
 
+// Set for each storage handle whose parameters have changed since they were
+// last saved or loaded. One byte each, so they can be set and cleared from
+// different interrupt levels.
+static volatile uint8_t data_services_dirty[MAX_DATA_HANDLES];
+
+// Heartbeat count when a parameter last changed
+static uint16_t data_services_change_time = 0;
+
+// Only write the areas marked as changed
+static boolean data_services_dirty_only = false;
+
+// Automatic save of changed parameters
+static void data_services_auto_save(void);
+
 
 void data_services_init(void)
 {
@@ -164,6 +184,9 @@ static void data_services(void)
 	case DATA_SERVICE_STATE_WRITE:
 		data_services_write();
 		break;
+	case DATA_SERVICE_STATE_WAITING:
+		data_services_auto_save();
+		break;
 //	case DATA_SERVICE_STATE_WRITE_ALL:
 //		data_services_write_all();
 		break;
@@ -185,7 +208,7 @@ static void data_services_init_table_index(void)
 		{
 			if (storage_check_area_exists(
 			    mavlink_parameter_blocks[data_services_table_index].data_storage_area,
-			    data_services_calc_item_size(data_services_table_index),
+			    data_services_area_size(data_services_table_index),
 			    DATA_STORAGE_CHECKSUM_STRUCT) == true)
 			{
 				data_services_table_index++;
@@ -194,7 +217,7 @@ static void data_services_init_table_index(void)
 			{
 				// Storage area does not exist so request to create it
 				if (storage_create_area(mavlink_parameter_blocks[data_services_table_index].data_storage_area, 
-				    data_services_calc_item_size(data_services_table_index), 
+				    data_services_area_size(data_services_table_index), 
 				    DATA_STORAGE_CHECKSUM_STRUCT, 
 				    &data_services_init_all_callback) == true)
 				{
@@ -230,19 +253,11 @@ static void data_services_init_all_callback(boolean success)
 	data_service_state = DATA_SERVICE_STATE_INIT_ALL;
 }
 
-// Calculate the size of the complete list of variable items in bytes
-static uint16_t data_services_calc_item_size(uint16_t table_index)
+// An area holds the items of its parameter block, back to back. The size is
+// generated by pyparam.
+static uint16_t data_services_area_size(uint16_t table_index)
 {
-	uint16_t item_index;
-	uint16_t size = 0;
-	uint16_t start_index = mavlink_parameter_blocks[table_index].block_start_index;
-	uint16_t count = mavlink_parameter_blocks[table_index].block_size;
-
-	for (item_index = 0; item_index < count; item_index++)
-	{
-		size += mavlink_parameters_list[start_index + item_index].param_size;
-	}
-	return size;
+	return mavlink_parameter_blocks[table_index].data_size;
 }
 
 // Read data area at index
@@ -263,14 +278,14 @@ static void data_services_read_index(void)
 	if ((service_flags & data_services_serialize_flags) | (data_services_serialize_flags & STORAGE_FLAG_ALL))
 	{
 		uint16_t handle = mavlink_parameter_blocks[data_services_table_index].data_storage_area;
-		uint16_t size = data_services_calc_item_size(data_services_table_index);
+		uint16_t size = data_services_area_size(data_services_table_index);
 		uint16_t type = DATA_STORAGE_CHECKSUM_STRUCT; //mavlink_parameter_blocks[data_services_table_index].data_type;
 	
 		// TODO: Check here if data handle is ok 
 	
 		if (type == DATA_STORAGE_CHECKSUM_STRUCT)
 		{
-			if (storage_read(handle, data_services_buffer, size, &data_services_read_callback) == true)
+			if (storage_read_layout(handle, data_services_buffer, size, &data_services_layout, &data_services_read_callback) == true)
 			{
 				data_service_state = DATA_SERVICE_STATE_READ_WAITING;
 			}
@@ -302,6 +317,7 @@ boolean data_services_save_all(uint16_t serialize_flags, DSRV_callbackFunc pcall
 	data_services_user_callback   = pcallback;
 	data_services_table_index     = 0;
 	data_services_do_all_areas    = true;
+	data_services_dirty_only      = false;
 	data_service_state            = DATA_SERVICE_STATE_WRITE;
 
 	return true;
@@ -339,7 +355,29 @@ void data_services_load_all(uint16_t serialize_flags, DSRV_callbackFunc pcallbac
 // Data is correct so serialise it from the buffer to the live data
 static void data_services_read_done(void)
 {
+	uint16_t handle = mavlink_parameter_blocks[data_services_table_index].data_storage_area;
+	uint16_t layout = mavlink_parameter_blocks[data_services_table_index].data_layout;
+
+	if ((data_services_layout != layout) && (data_services_layout != 0))
+	{
+		// The area was saved with a different layout of parameters. Keep the
+		// built in values, and have them saved in the new layout.
+		DPRINT("storage area %u has an old layout\r\n", handle);
+		data_services_dirty[handle] = true;
+		data_services_change_time = udb_heartbeat_counter;
+		data_services_read_callback(false);
+		return;
+	}
 	serialise_buffer_to_items(data_services_table_index);
+	data_services_dirty[handle] = false;
+
+	if (data_services_layout == 0)
+	{
+		// Saved before layouts were recorded, so it is loaded as it always
+		// was, and saved again with its layout.
+		data_services_dirty[handle] = true;
+		data_services_change_time = udb_heartbeat_counter;
+	}
 
 	if (mavlink_parameter_blocks[data_services_table_index].ploadCallback != NULL)
 	{
@@ -378,59 +416,43 @@ static void data_services_read_callback(boolean success)
 }
 
 // Serialise a list of data items/variables to the buffer
-// returns total size of the items
+// returns total size of the area
 static uint16_t serialise_items_to_buffer(uint16_t table_index)
 {
 	if (table_index >= mavlink_parameter_block_count) return 0;
+	if (data_services_area_size(table_index) > DATA_SERVICE_BUFFER_SIZE) return 0;
 
-	const mavlink_parameter* pParameter;
-	const uint8_t* pData;
+	const mavlink_parameter_block* pBlock = &mavlink_parameter_blocks[table_index];
+	const data_services_item* pItem = &data_services_items[pBlock->block_start_index];
 
 	uint16_t item_index;
 	uint16_t buffer_index = 0;
-	uint16_t item_size;
-	uint16_t block_start = mavlink_parameter_blocks[table_index].block_start_index;
-	uint16_t item_count = mavlink_parameter_blocks[table_index].block_size;
 
-	for(item_index = 0; item_index < item_count; item_index++)
+	for (item_index = 0; item_index < pBlock->block_size; item_index++, pItem++)
 	{
-		pParameter = &mavlink_parameters_list[block_start + item_index];
-		pData      = pParameter->pparam;
-		item_size  = pParameter->param_size;
-
-		if ((buffer_index + item_size) > DATA_SERVICE_BUFFER_SIZE)
-			return 0;
-		memcpy(&data_services_buffer[buffer_index], pData, item_size);
-		buffer_index += item_size;
+		memcpy(&data_services_buffer[buffer_index], pItem->pdata, pItem->size);
+		buffer_index += pItem->size;
 	}
 	return buffer_index;
 }
 
 // Serialise the buffer to a list of data items/variables
-// returns total size of the items
+// returns total size of the area
 static uint16_t serialise_buffer_to_items(uint16_t table_index)
 {
 	if (table_index >= mavlink_parameter_block_count) return 0;
+	if (data_services_area_size(table_index) > DATA_SERVICE_BUFFER_SIZE) return 0;
 
-	const mavlink_parameter* pParameter;
-	const uint8_t* pData;
+	const mavlink_parameter_block* pBlock = &mavlink_parameter_blocks[table_index];
+	const data_services_item* pItem = &data_services_items[pBlock->block_start_index];
 
 	uint16_t item_index;
 	uint16_t buffer_index = 0;
-	uint16_t item_size;
-	uint16_t block_start = mavlink_parameter_blocks[table_index].block_start_index;
-	uint16_t item_count = mavlink_parameter_blocks[table_index].block_size;
 
-	for(item_index = 0; item_index < item_count; item_index++)
+	for (item_index = 0; item_index < pBlock->block_size; item_index++, pItem++)
 	{
-		pParameter = &mavlink_parameters_list[block_start + item_index];
-		pData      = pParameter->pparam;
-		item_size  = pParameter->param_size;
-
-		if ((buffer_index + item_size) > DATA_SERVICE_BUFFER_SIZE)
-			return 0;
-		memcpy((uint8_t*) pData, &data_services_buffer[buffer_index], item_size);
-		buffer_index += item_size;
+		memcpy(pItem->pdata, &data_services_buffer[buffer_index], pItem->size);
+		buffer_index += pItem->size;
 	}
 	return buffer_index;
 }
@@ -458,6 +480,7 @@ boolean data_services_save_specific(uint16_t data_storage_handle, DSRV_callbackF
 
 	data_services_user_callback = pcallback;
 	data_services_do_all_areas = false;                 // One area only
+	data_services_dirty_only = false;
 	data_services_serialize_flags = STORAGE_FLAG_ALL;   // Flag to write regardless of flags
 
 	data_service_state = DATA_SERVICE_STATE_WRITE;
@@ -475,6 +498,19 @@ static void data_services_write(void)
 		return;
 	}
 
+	uint16_t handle = mavlink_parameter_blocks[data_services_table_index].data_storage_area;
+
+	// Skip the areas which have not changed
+	if ((data_services_dirty_only == true) && (data_services_dirty[handle] == false))
+	{
+		data_services_table_index++;
+		return;
+	}
+
+	// Clear the flag before the items are serialised, so that a change made
+	// while the area is being written is saved the next time
+	data_services_dirty[handle] = false;
+
 	uint16_t size = serialise_items_to_buffer(data_services_table_index);
 
 	if (size == 0)
@@ -485,8 +521,6 @@ static void data_services_write(void)
 		return;
 	}
 
-	uint16_t handle = mavlink_parameter_blocks[data_services_table_index].data_storage_area;
-	//data_services_calc_item_size(data_services_table_index);
 	uint16_t type = DATA_STORAGE_CHECKSUM_STRUCT;
 
 	// TODO: Check here if data handle is ok
@@ -496,11 +530,14 @@ static void data_services_write(void)
 	    ((data_services_serialize_flags & mavlink_parameter_blocks[data_services_table_index].data_storage_flags) ||
 	    (data_services_serialize_flags & STORAGE_FLAG_ALL)))
 	{
-		if (storage_write(handle, data_services_buffer, size, &data_services_write_callback) == true)
+		if (storage_write_layout(handle, data_services_buffer, size,
+		    mavlink_parameter_blocks[data_services_table_index].data_layout,
+		    &data_services_write_callback) == true)
 		{
 			data_service_state = DATA_SERVICE_STATE_WRITE_WAITING;
 			return;
 		}
+		data_services_dirty[handle] = true;
 	}
 	else
 	{
@@ -533,9 +570,73 @@ static void data_services_write_callback(boolean success)
 	}
 	else
 	{
+		// Try again after the next quiet period
+		data_services_dirty[mavlink_parameter_blocks[data_services_table_index].data_storage_area] = true;
+		data_services_change_time = udb_heartbeat_counter;
+
 		if (data_services_user_callback != NULL) data_services_user_callback(false);
 		data_service_state = DATA_SERVICE_STATE_WAITING;
 	}
 }
 
+void data_services_param_changed(uint16_t param_index)
+{
+	uint16_t index;
+
+	for (index = 0; index < mavlink_parameter_block_count; index++)
+	{
+		if ((param_index >= mavlink_parameter_blocks[index].block_start_index) &&
+		    (param_index < mavlink_parameter_blocks[index].block_start_index + mavlink_parameter_blocks[index].block_size))
+		{
+			data_services_dirty[mavlink_parameter_blocks[index].data_storage_area] = true;
+			data_services_change_time = udb_heartbeat_counter;
+			return;
+		}
+	}
+}
+
+#if (PARAM_AUTO_SAVE == 2)
+// True if the aircraft can be treated as disarmed: it is not moving, and the
+// throttle is at its trim, or the radio is off.
+static boolean data_services_disarmed(void)
+{
+	if (sog_gps.BB > 100) return false;    // 1 m/s
+#if (THROTTLE_INPUT_CHANNEL != CHANNEL_UNUSED)
+	if (udb_flags._.radio_on &&
+	    (abs(udb_pwIn[THROTTLE_INPUT_CHANNEL] - udb_pwTrim[THROTTLE_INPUT_CHANNEL]) > 100))
+		return false;
+#endif
+	return true;
+}
+#endif // (PARAM_AUTO_SAVE == 2)
+
+// Save the areas holding changed parameters once no parameter has changed for
+// PARAM_SAVE_QUIET_TIME seconds, so that a burst of changes from the ground
+// station is written once, and only the areas which changed are written.
+static void data_services_auto_save(void)
+{
+#if (PARAM_AUTO_SAVE != 0)
+	uint16_t handle;
+
+	for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+	{
+		if (data_services_dirty[handle]) break;
+	}
+	if (handle == MAX_DATA_HANDLES) return;
+
+	if ((uint16_t)(udb_heartbeat_counter - data_services_change_time) < PARAM_SAVE_QUIET_TIME * HEARTBEAT_HZ) return;
+#if (PARAM_AUTO_SAVE == 2)
+	if (data_services_disarmed() == false) return;
+#endif
+
+	DPRINT("saving changed parameters\r\n");
+	data_services_serialize_flags = STORAGE_FLAG_ALL;
+	data_services_user_callback   = NULL;
+	data_services_table_index     = 0;
+	data_services_do_all_areas    = true;
+	data_services_dirty_only      = true;
+	data_service_state            = DATA_SERVICE_STATE_WRITE;
+#endif // (PARAM_AUTO_SAVE != 0)
+}
+
 #endif // (USE_NV_MEMORY == 1)
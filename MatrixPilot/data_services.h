@@ -74,5 +74,9 @@ boolean data_services_save_specific(uint16_t data_storage_handle, DSRV_callbackF
 // return true if services not busy and request can be serviced
 boolean data_services_save_all(uint16_t serialize_flags, DSRV_callbackFunc pcallback);
 
+// Record that a parameter in mavlink_parameters_list has changed, so that the
+// storage area holding it is saved automatically (see PARAM_AUTO_SAVE)
+void data_services_param_changed(uint16_t param_index);
+
 #endif // DATA_SERVICES_H
 
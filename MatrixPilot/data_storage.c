@@ -32,7 +32,7 @@
 
 #include "../libUDB/libUDB.h"
 
-#if (USE_NV_MEMORY == 1)
+#if (USE_NV_MEMORY == 1) && (USE_DATA_STORAGE_LOG == 0)
 
 #include "data_storage.h"
 #include "../libUDB/NV_memory.h"
@@ -128,6 +128,8 @@ static uint16_t data_storage_type      = DATA_STORAGE_NULL;
 static uint16_t data_storage_size      = 0;     // Storage size including header
 static uint16_t data_storage_data_size = 0;     // Storage size of data only
 static uint16_t data_storage_handle    = INVALID_HANDLE;
+static uint16_t data_storage_layout    = 0;     // Layout of the data being written
+static uint16_t* pdata_storage_layout  = NULL;  // Layout of the data being read
 static DS_callbackFunc data_storage_user_callback = NULL;
 
 static DATA_STORAGE_HEADER data_storage_header; // Buffer for header information
@@ -225,7 +227,7 @@ static void data_storage_service(void)
 			{
 				data_storage_header.data_checksum = crc_calculate((uint8_t*)pdata_storage_data, data_storage_data_size);
 				data_storage_header.data_handle = data_storage_handle;
-				data_storage_header.data_version = 0;
+				data_storage_header.data_version = data_storage_layout;
 				memcpy(data_storage_header.data_preamble, data_storage_preamble, sizeof(data_storage_preamble));
 
 				if (udb_nv_memory_write((uint8_t*)&data_storage_header,
@@ -317,6 +319,9 @@ static void data_storage_service(void)
 
 			if (data_storage_header.data_checksum != crc_calculate((uint8_t*) pdata_storage_data, data_storage_data_size))
 				success = false;
+
+			if (pdata_storage_layout != NULL)
+				*pdata_storage_layout = data_storage_header.data_version;
 		}
 
 		// Status to waiting and callback the user with result
@@ -468,6 +473,11 @@ static boolean storage_test_handle(uint16_t data_handle)
 }
 
 boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_write_layout(data_handle, pwrData, size, 0, callback);
+}
+
+boolean storage_write_layout(uint16_t data_handle, uint8_t* pwrData, uint16_t size, uint16_t layout, DS_callbackFunc callback)
 {
 	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
 
@@ -479,6 +489,7 @@ boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_
 	data_storage_handle        = data_handle;
 	data_storage_user_callback = callback;
 	data_storage_data_size     = size;
+	data_storage_layout        = layout;
 
 	data_storage_type = data_storage_table.table[data_handle].data_type;
 
@@ -519,6 +530,11 @@ static void storage_write_header_callback(boolean success)
 }
 
 boolean storage_read(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_read_layout(data_handle, pwrData, size, NULL, callback);
+}
+
+boolean storage_read_layout(uint16_t data_handle, uint8_t* pwrData, uint16_t size, uint16_t* pLayout, DS_callbackFunc callback)
 {
 	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
 
@@ -530,6 +546,9 @@ boolean storage_read(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_c
 	data_storage_data_size     = size;
 	data_storage_handle        = data_handle;
 	data_storage_user_callback = callback;
+	pdata_storage_layout       = pLayout;
+
+	if (pLayout != NULL) *pLayout = 0;
 
 	switch (data_storage_table.table[data_handle].data_type)
 	{
@@ -769,4 +788,4 @@ static void storage_clear_specific_area_callback(boolean success)
 	data_storage_status = DATA_STORAGE_STATUS_WAITING;
 }
 
-#endif // USE_NV_MEMORY
+#endif // (USE_NV_MEMORY == 1) && (USE_DATA_STORAGE_LOG == 0)
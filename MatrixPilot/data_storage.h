@@ -95,10 +95,29 @@ typedef struct tagDATA_STORAGE_HEADER
 {
 	uint8_t  data_preamble[DATA_PREAMBLE_SIZE];
 	uint16_t data_handle;
-	uint16_t data_version;
+	uint16_t data_version;     // Layout of the data, from storage_write_layout
 	uint16_t data_checksum;
 } DATA_STORAGE_HEADER;
 
+// Log structured storage (USE_DATA_STORAGE_LOG)
+// Each write of an area appends a new record to the log. Records start on a
+// FAT_CHUNK_BYTE_SIZE boundary and never cross a segment boundary. The log is
+// compacted one segment at a time by copying forward the records in use.
+#define DATA_STORAGE_LOG_SIZE       0x8000  // Bytes of NV memory used by the log
+#define DATA_STORAGE_SEGMENT_SIZE   1024    // Unit of log compaction
+
+typedef struct tagDATA_STORAGE_RECORD
+{
+	uint8_t  record_preamble[DATA_PREAMBLE_SIZE];
+	uint32_t data_version;     // Increases with every record written
+	uint16_t data_handle;
+	uint16_t data_type;
+	uint16_t data_size;        // Size of the area, excluding this header
+	uint16_t data_layout;      // Layout of the data, from storage_write_layout
+	uint16_t data_checksum;
+	uint16_t record_checksum;  // Checksum of the fields above
+} DATA_STORAGE_RECORD;
+
 // Trigger storage service in low priority process.
 void storage_service_trigger(void);
 
@@ -109,6 +128,12 @@ void data_storage_init(void);
 boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_callbackFunc callback);
 boolean storage_read(uint16_t data_handle, uint8_t* prdData, uint16_t size, DS_callbackFunc callback);
 
+// As above, saving a signature of the layout of the data in the header of the
+// area. The layout is read back into *pLayout, and is 0 if the data was saved
+// by storage_write.
+boolean storage_write_layout(uint16_t data_handle, uint8_t* pwrData, uint16_t size, uint16_t layout, DS_callbackFunc callback);
+boolean storage_read_layout(uint16_t data_handle, uint8_t* prdData, uint16_t size, uint16_t* pLayout, DS_callbackFunc callback);
+
 // Create a storage area
 // Size = size in bytes
 // type = data management type
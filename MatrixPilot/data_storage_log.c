@@ -0,0 +1,787 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//******************************************************************/
+// DATA STORAGE - LOG STRUCTURED
+// Implements the data storage interface of data_storage.h as an append-only
+// log of versioned records (USE_DATA_STORAGE_LOG in options_nv_memory.h).
+//
+// Every create, write or clear of an area appends a new record to the head of
+// the log, and its header is written last. A record replaces an earlier one for
+// the same handle when it has a higher version, so a write interrupted by a
+// reset leaves the previous copy in place. Nothing is rewritten in place, so
+// writes are spread evenly over the whole device.
+//
+// At startup a single scan of the log rebuilds the index of current records in
+// ram, and finds the head of the log after the newest record.
+//
+// The log is compacted one segment at a time. The segment ahead of the head is
+// always kept free of current records, by copying them to the head before the
+// head moves into the segment before it.
+//
+// Uses X.25 checksum from MAVink libraries
+//
+
+#include "../libUDB/libUDB.h"
+
+#if (USE_NV_MEMORY == 1) && (USE_DATA_STORAGE_LOG == 1)
+
+#include "data_storage.h"
+#include "../libUDB/NV_memory.h"
+#include "../libUDB/events.h"
+#include <stddef.h>
+#include <string.h>
+
+// Include MAVlink library for checksums
+#include "../MAVLink/include/mavlink_types.h"
+#include "../MAVLink/include/checksum.h"
+
+
+#define LOG_PAGE_SIZE           FAT_CHUNK_BYTE_SIZE
+#define LOG_SEGMENTS            (DATA_STORAGE_LOG_SIZE / DATA_STORAGE_SEGMENT_SIZE)
+#define LOG_SEGMENT_PAGES       (DATA_STORAGE_SEGMENT_SIZE / LOG_PAGE_SIZE)
+
+// Two segments are kept free, for the head and for compaction
+#define LOG_MAX_CURRENT_PAGES   ((LOG_SEGMENTS - 2) * LOG_SEGMENT_PAGES)
+
+// Bytes of data which fit in the first page of a record, after the header
+#define LOG_FIRST_PAGE_DATA     (LOG_PAGE_SIZE - sizeof(DATA_STORAGE_RECORD))
+
+#define NO_RECORD               0xFFFF
+
+enum
+{
+	DATA_STORAGE_STATUS_START,
+	DATA_STORAGE_SCAN,              // Read the next page of the log
+	DATA_STORAGE_SCANNING,
+	DATA_STORAGE_SCAN_PAGE,         // Check the page just read
+	DATA_STORAGE_STATUS_WAITING,
+
+	DATA_STORAGE_READ,
+	DATA_STORAGE_READING_DATA,
+	DATA_STORAGE_READ_DATA_COMPLETE,
+
+	DATA_STORAGE_MAKE_ROOM,         // Make room at the head for a new record
+	DATA_STORAGE_RELOCATE_READ,     // Copy a record from the segment ahead of the head
+	DATA_STORAGE_RELOCATE_READING,
+	DATA_STORAGE_RELOCATE_WRITE,
+	DATA_STORAGE_RELOCATE_WRITING,
+
+	DATA_STORAGE_WRITE_DATA,        // Write the pages of a record after the first
+	DATA_STORAGE_WRITING_DATA,
+	DATA_STORAGE_WRITE_HEADER,      // Write the first page, holding the header
+	DATA_STORAGE_WRITING_HEADER,
+};
+
+static uint16_t data_storage_status = DATA_STORAGE_STATUS_START;
+
+// Entry in the ram index of the current record for each handle
+typedef struct tagDATA_STORAGE_INDEX
+{
+	uint16_t address;               // Address of the record, or NO_RECORD
+	uint16_t type;
+	uint16_t size;
+	uint16_t layout;
+	uint16_t checksum;
+	uint32_t version;
+	boolean  has_data;              // false if the area has been created or cleared
+} DATA_STORAGE_INDEX;
+
+static DATA_STORAGE_INDEX data_storage_index[MAX_DATA_HANDLES];
+
+static uint16_t data_storage_head = 0;      // Address of the next record
+static uint32_t data_storage_version = 0;   // Version of the newest record
+
+// A constant preamble used to mark a record holding data
+static const uint8_t data_storage_preamble[] = {0xAA, 0x5A, 0xA5, 0x55};
+
+// A constant preamble used to mark a record which creates or clears an area
+static const uint8_t area_storage_preamble[] = {0x55, 0xA5, 0x5A, 0xAA};
+
+// Callers data.  Used on reading or writing an area.
+static uint8_t* pdata_storage_data     = NULL;
+static uint16_t data_storage_data_size = 0;
+static uint16_t data_storage_handle    = INVALID_HANDLE;
+static DS_callbackFunc data_storage_user_callback = NULL;
+
+static DATA_STORAGE_RECORD data_storage_record; // Header of the record being written
+static uint16_t data_storage_pages = 0;         // Pages of the record being written
+static uint16_t data_storage_skips = 0;         // Segments skipped to make room for it
+
+static uint8_t data_storage_page[LOG_PAGE_SIZE]; // Buffer for scanning and copying
+
+static uint16_t scan_address   = 0;     // Page being scanned
+static uint16_t scan_record    = 0;     // Start of the record being checked
+static uint16_t scan_remaining = 0;     // Data bytes of the record still to check
+static uint16_t scan_checksum  = 0;
+
+static uint16_t relocate_handle = INVALID_HANDLE;
+static uint16_t relocate_page   = 0;    // Page of the record being copied, last first
+
+static uint16_t data_storage_event_handle = INVALID_HANDLE;
+
+static void storage_scan_page(void);
+static void storage_make_room(void);
+static void storage_relocate_write(void);
+static void storage_write_header(void);
+
+static void storage_scan_callback(boolean success);
+static void storage_relocate_read_callback(boolean success);
+static void storage_relocate_write_callback(boolean success);
+static void storage_write_data_callback(boolean success);
+static void storage_write_header_callback(boolean success);
+static void storage_read_data_callback(boolean success);
+
+
+// Status of storage services
+boolean storage_services_started(void)
+{
+	switch (data_storage_status)
+	{
+	case DATA_STORAGE_STATUS_START:
+	case DATA_STORAGE_SCAN:
+	case DATA_STORAGE_SCANNING:
+	case DATA_STORAGE_SCAN_PAGE:
+		return false;
+	}
+	return true;
+}
+
+// Finish the current request and callback the user with the result
+static void storage_finish(boolean success)
+{
+	data_storage_status = DATA_STORAGE_STATUS_WAITING;
+	if (data_storage_user_callback != NULL)
+		data_storage_user_callback(success);
+}
+
+static void data_storage_service(void)
+{
+	uint16_t handle;
+
+	switch (data_storage_status)
+	{
+	case DATA_STORAGE_STATUS_START:
+		for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+		{
+			data_storage_index[handle].address = NO_RECORD;
+		}
+		data_storage_head = 0;
+		data_storage_version = 0;
+		scan_address = 0;
+		scan_remaining = 0;
+		data_storage_status = DATA_STORAGE_SCAN;
+		storage_service_trigger();
+		break;
+
+	case DATA_STORAGE_SCAN:
+		// If NV memory not ready, immediate return and retry next time.
+		if (udb_nv_memory_read(data_storage_page, scan_address, LOG_PAGE_SIZE, &storage_scan_callback) == false) return;
+		data_storage_status = DATA_STORAGE_SCANNING;
+		break;
+
+	case DATA_STORAGE_SCAN_PAGE:
+		storage_scan_page();
+		break;
+
+	case DATA_STORAGE_READ:
+		if (data_storage_index[data_storage_handle].has_data == false)
+		{
+			storage_finish(false);
+			return;
+		}
+		if (udb_nv_memory_read(pdata_storage_data,
+		    data_storage_index[data_storage_handle].address + sizeof(DATA_STORAGE_RECORD),
+		    data_storage_data_size,
+		    &storage_read_data_callback) == false)
+		{
+			storage_finish(false);
+			return;
+		}
+		data_storage_status = DATA_STORAGE_READING_DATA;
+		break;
+
+	case DATA_STORAGE_READ_DATA_COMPLETE:
+		storage_finish(crc_calculate(pdata_storage_data, data_storage_data_size) == data_storage_index[data_storage_handle].checksum);
+		break;
+
+	case DATA_STORAGE_MAKE_ROOM:
+		storage_make_room();
+		break;
+
+	case DATA_STORAGE_RELOCATE_READ:
+		if (udb_nv_memory_read(data_storage_page,
+		    data_storage_index[relocate_handle].address + relocate_page * LOG_PAGE_SIZE,
+		    LOG_PAGE_SIZE,
+		    &storage_relocate_read_callback) == false)
+		{
+			storage_finish(false);
+			return;
+		}
+		data_storage_status = DATA_STORAGE_RELOCATE_READING;
+		break;
+
+	case DATA_STORAGE_RELOCATE_WRITE:
+		storage_relocate_write();
+		break;
+
+	case DATA_STORAGE_WRITE_DATA:
+		// The data after the first page goes first, so that the header is written last
+		if (udb_nv_memory_write(pdata_storage_data + LOG_FIRST_PAGE_DATA,
+		    data_storage_head + LOG_PAGE_SIZE,
+		    data_storage_data_size - LOG_FIRST_PAGE_DATA,
+		    &storage_write_data_callback) == false)
+		{
+			storage_finish(false);
+			return;
+		}
+		data_storage_status = DATA_STORAGE_WRITING_DATA;
+		break;
+
+	case DATA_STORAGE_WRITE_HEADER:
+		storage_write_header();
+		break;
+	}
+}
+
+// Initialise the data storage
+void data_storage_init(void)
+{
+	data_storage_event_handle = register_event(&data_storage_service);
+}
+
+// Trigger storage service in low priority process.
+void storage_service_trigger(void)
+{
+	trigger_event(data_storage_event_handle);
+}
+
+// Number of pages used by a record holding data_size bytes of data
+static uint16_t record_pages(uint16_t data_size)
+{
+	return (sizeof(DATA_STORAGE_RECORD) + data_size + LOG_PAGE_SIZE - 1) / LOG_PAGE_SIZE;
+}
+
+static uint16_t index_pages(const DATA_STORAGE_INDEX* pIndex)
+{
+	return record_pages(pIndex->has_data ? pIndex->size : 0);
+}
+
+// Start address of the segment after the one holding address
+static uint16_t next_segment(uint16_t address)
+{
+	return (uint16_t)(((address / DATA_STORAGE_SEGMENT_SIZE) + 1) * DATA_STORAGE_SEGMENT_SIZE) % DATA_STORAGE_LOG_SIZE;
+}
+
+// Find a current record which overlaps the given address range
+// returns its handle, or INVALID_HANDLE if there is none
+static uint16_t find_record_in(uint16_t address, uint16_t size)
+{
+	uint16_t handle;
+	DATA_STORAGE_INDEX* pIndex;
+
+	for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+	{
+		pIndex = &data_storage_index[handle];
+		if (pIndex->address == NO_RECORD) continue;
+		if ((pIndex->address < address + size) &&
+		    (pIndex->address + index_pages(pIndex) * LOG_PAGE_SIZE > address))
+		{
+			return handle;
+		}
+	}
+	return INVALID_HANDLE;
+}
+
+// Total pages used by current records, other than the one for except_handle
+static uint16_t current_pages(uint16_t except_handle)
+{
+	uint16_t handle;
+	uint16_t pages = 0;
+
+	for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+	{
+		if ((handle != except_handle) && (data_storage_index[handle].address != NO_RECORD))
+			pages += index_pages(&data_storage_index[handle]);
+	}
+	return pages;
+}
+
+static uint16_t record_checksum(const DATA_STORAGE_RECORD* pRecord)
+{
+	return crc_calculate((const uint8_t*) pRecord, offsetof(DATA_STORAGE_RECORD, record_checksum));
+}
+
+// Check a record header read from address
+static boolean record_valid(const DATA_STORAGE_RECORD* pRecord, uint16_t address)
+{
+	uint16_t data_size;
+
+	if (memcmp(pRecord->record_preamble, data_storage_preamble, DATA_PREAMBLE_SIZE) == 0)
+		data_size = pRecord->data_size;
+	else if (memcmp(pRecord->record_preamble, area_storage_preamble, DATA_PREAMBLE_SIZE) == 0)
+		data_size = 0;
+	else
+		return false;
+
+	if (pRecord->record_checksum != record_checksum(pRecord)) return false;
+	if (pRecord->data_handle >= MAX_DATA_HANDLES) return false;
+	if (pRecord->data_size > DATA_STORAGE_SEGMENT_SIZE - sizeof(DATA_STORAGE_RECORD)) return false;
+
+	// Records never cross a segment boundary
+	if ((address % DATA_STORAGE_SEGMENT_SIZE) + record_pages(data_size) * LOG_PAGE_SIZE > DATA_STORAGE_SEGMENT_SIZE) return false;
+
+	return true;
+}
+
+static void advance_head(uint16_t pages)
+{
+	data_storage_head = (data_storage_head + pages * LOG_PAGE_SIZE) % DATA_STORAGE_LOG_SIZE;
+}
+
+// Continue the scan at address, or finish it at the end of the log
+static void storage_scan_next(uint16_t address)
+{
+	scan_address = address;
+	if (scan_address < DATA_STORAGE_LOG_SIZE)
+	{
+		data_storage_status = DATA_STORAGE_SCAN;
+		storage_service_trigger();
+		return;
+	}
+
+	data_storage_head %= DATA_STORAGE_LOG_SIZE;
+
+#if (MANUAL_ERASE_TABLE == 1)
+	// Forget all the records found. New records still follow the newest one.
+	uint16_t handle;
+	for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+	{
+		data_storage_index[handle].address = NO_RECORD;
+	}
+#endif
+
+	DPRINT("data storage log head 0x%04X, version %lu, %u pages in use\r\n",
+	       data_storage_head, (unsigned long) data_storage_version, current_pages(INVALID_HANDLE));
+	data_storage_status = DATA_STORAGE_STATUS_WAITING;
+}
+
+// The record at scan_record is complete and correct
+static void storage_scan_found(void)
+{
+	DATA_STORAGE_INDEX* pIndex = &data_storage_index[data_storage_record.data_handle];
+	boolean has_data = (memcmp(data_storage_record.record_preamble, data_storage_preamble, DATA_PREAMBLE_SIZE) == 0);
+	uint16_t pages = record_pages(has_data ? data_storage_record.data_size : 0);
+
+	if ((pIndex->address == NO_RECORD) || (data_storage_record.data_version > pIndex->version))
+	{
+		pIndex->address  = scan_record;
+		pIndex->type     = data_storage_record.data_type;
+		pIndex->size     = data_storage_record.data_size;
+		pIndex->layout   = data_storage_record.data_layout;
+		pIndex->checksum = data_storage_record.data_checksum;
+		pIndex->version  = data_storage_record.data_version;
+		pIndex->has_data = has_data;
+	}
+
+	// The head of the log follows the newest record
+	if (data_storage_record.data_version > data_storage_version)
+	{
+		data_storage_version = data_storage_record.data_version;
+		data_storage_head = scan_record + pages * LOG_PAGE_SIZE;
+	}
+
+	storage_scan_next(scan_record + pages * LOG_PAGE_SIZE);
+}
+
+// Check a page of the log.  A record is only accepted once the checksum of all
+// of its data is correct, otherwise the scan continues at the following page.
+static void storage_scan_page(void)
+{
+	uint16_t offset = 0;
+	uint16_t count;
+
+	if (scan_remaining == 0)
+	{
+		memcpy(&data_storage_record, data_storage_page, sizeof(DATA_STORAGE_RECORD));
+		if (record_valid(&data_storage_record, scan_address) == false)
+		{
+			storage_scan_next(scan_address + LOG_PAGE_SIZE);
+			return;
+		}
+		scan_record = scan_address;
+		if (memcmp(data_storage_record.record_preamble, area_storage_preamble, DATA_PREAMBLE_SIZE) == 0)
+		{
+			storage_scan_found();
+			return;
+		}
+		scan_remaining = data_storage_record.data_size;
+		crc_init(&scan_checksum);
+		offset = sizeof(DATA_STORAGE_RECORD);
+	}
+
+	count = LOG_PAGE_SIZE - offset;
+	if (count > scan_remaining) count = scan_remaining;
+	scan_remaining -= count;
+	while (count--)
+	{
+		crc_accumulate(data_storage_page[offset++], &scan_checksum);
+	}
+
+	if (scan_remaining != 0)
+	{
+		storage_scan_next(scan_address + LOG_PAGE_SIZE);
+	}
+	else if (scan_checksum == data_storage_record.data_checksum)
+	{
+		storage_scan_found();
+	}
+	else
+	{
+		storage_scan_next(scan_record + LOG_PAGE_SIZE);
+	}
+}
+
+// If read fails, retry the same page
+static void storage_scan_callback(boolean success)
+{
+	data_storage_status = success ? DATA_STORAGE_SCAN_PAGE : DATA_STORAGE_SCAN;
+	storage_service_trigger();
+}
+
+// Start appending a record for an area.  pData is NULL for a record which
+// creates or clears the area without any data.
+static boolean storage_append(uint16_t data_handle, uint8_t* pData, uint16_t type, uint16_t size, uint16_t layout, DS_callbackFunc callback)
+{
+	uint16_t pages = record_pages((pData != NULL) ? size : 0);
+
+	if (current_pages(data_handle) + pages > LOG_MAX_CURRENT_PAGES) return false;
+
+	pdata_storage_data         = pData;
+	data_storage_data_size     = size;
+	data_storage_handle        = data_handle;
+	data_storage_user_callback = callback;
+	data_storage_pages         = pages;
+	data_storage_skips         = 0;
+
+	memcpy(data_storage_record.record_preamble, (pData != NULL) ? data_storage_preamble : area_storage_preamble, DATA_PREAMBLE_SIZE);
+	data_storage_record.data_handle   = data_handle;
+	data_storage_record.data_type     = type;
+	data_storage_record.data_size     = size;
+	data_storage_record.data_layout   = layout;
+	data_storage_record.data_checksum = (pData != NULL) ? crc_calculate(pData, size) : 0;
+
+	data_storage_status = DATA_STORAGE_MAKE_ROOM;
+	storage_service_trigger();
+	return true;
+}
+
+// Make room at the head of the log for the record being written.
+// The head skips the rest of its segment if the record does not fit there, and
+// any current records in the segment after the head's are first copied to the head.
+static void storage_make_room(void)
+{
+	uint16_t segment = next_segment(data_storage_head);
+	uint16_t room = DATA_STORAGE_SEGMENT_SIZE - (data_storage_head % DATA_STORAGE_SEGMENT_SIZE);
+	uint16_t handle;
+
+	if (data_storage_pages * LOG_PAGE_SIZE > room)
+	{
+		if ((++data_storage_skips > LOG_SEGMENTS) ||
+		    (find_record_in(segment, DATA_STORAGE_SEGMENT_SIZE) != INVALID_HANDLE))
+		{
+			storage_finish(false);  // The log is full
+			return;
+		}
+		data_storage_head = segment;
+		storage_service_trigger();
+		return;
+	}
+
+	handle = find_record_in(segment, DATA_STORAGE_SEGMENT_SIZE);
+	if (handle != INVALID_HANDLE)
+	{
+		if (index_pages(&data_storage_index[handle]) * LOG_PAGE_SIZE > room)
+		{
+			storage_finish(false);
+			return;
+		}
+		relocate_handle = handle;
+		relocate_page = index_pages(&data_storage_index[handle]) - 1;
+		data_storage_status = DATA_STORAGE_RELOCATE_READ;
+		storage_service_trigger();
+		return;
+	}
+
+	// Never overwrite a current record
+	if (find_record_in(data_storage_head, data_storage_pages * LOG_PAGE_SIZE) != INVALID_HANDLE)
+	{
+		storage_finish(false);
+		return;
+	}
+
+	data_storage_status = (data_storage_pages > 1) ? DATA_STORAGE_WRITE_DATA : DATA_STORAGE_WRITE_HEADER;
+	storage_service_trigger();
+}
+
+// Write a page of the record being copied to the same page at the head.  The
+// first page goes last, and gets a new version so the copy replaces the original.
+static void storage_relocate_write(void)
+{
+	if (relocate_page == 0)
+	{
+		DATA_STORAGE_RECORD record;
+
+		memcpy(&record, data_storage_page, sizeof(DATA_STORAGE_RECORD));
+		if ((record_valid(&record, data_storage_index[relocate_handle].address) == false) ||
+		    (record.data_handle != relocate_handle))
+		{
+			// The original has been damaged, so there is nothing to keep
+			data_storage_index[relocate_handle].address = NO_RECORD;
+			data_storage_status = DATA_STORAGE_MAKE_ROOM;
+			storage_service_trigger();
+			return;
+		}
+		record.data_version = ++data_storage_version;
+		record.record_checksum = record_checksum(&record);
+		memcpy(data_storage_page, &record, sizeof(DATA_STORAGE_RECORD));
+	}
+
+	if (udb_nv_memory_write(data_storage_page,
+	    data_storage_head + relocate_page * LOG_PAGE_SIZE,
+	    LOG_PAGE_SIZE,
+	    &storage_relocate_write_callback) == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_RELOCATE_WRITING;
+}
+
+static void storage_relocate_read_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_RELOCATE_WRITE;
+	storage_service_trigger();
+}
+
+static void storage_relocate_write_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	if (relocate_page != 0)
+	{
+		relocate_page--;
+		data_storage_status = DATA_STORAGE_RELOCATE_READ;
+	}
+	else
+	{
+		data_storage_index[relocate_handle].address = data_storage_head;
+		data_storage_index[relocate_handle].version = data_storage_version;
+		advance_head(index_pages(&data_storage_index[relocate_handle]));
+		data_storage_status = DATA_STORAGE_MAKE_ROOM;
+	}
+	storage_service_trigger();
+}
+
+static void storage_write_data_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_WRITE_HEADER;
+	storage_service_trigger();
+}
+
+// Write the first page of the record, with the header and the start of the data
+static void storage_write_header(void)
+{
+	uint16_t count = 0;
+
+	data_storage_record.data_version = ++data_storage_version;
+	data_storage_record.record_checksum = record_checksum(&data_storage_record);
+	memcpy(data_storage_page, &data_storage_record, sizeof(DATA_STORAGE_RECORD));
+
+	if (pdata_storage_data != NULL)
+	{
+		count = data_storage_data_size;
+		if (count > LOG_FIRST_PAGE_DATA) count = LOG_FIRST_PAGE_DATA;
+		memcpy(&data_storage_page[sizeof(DATA_STORAGE_RECORD)], pdata_storage_data, count);
+	}
+
+	if (udb_nv_memory_write(data_storage_page,
+	    data_storage_head,
+	    sizeof(DATA_STORAGE_RECORD) + count,
+	    &storage_write_header_callback) == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_WRITING_HEADER;
+}
+
+// The record is complete, so it replaces the previous one for the area
+static void storage_write_header_callback(boolean success)
+{
+	DATA_STORAGE_INDEX* pIndex = &data_storage_index[data_storage_handle];
+
+	if (success)
+	{
+		pIndex->address  = data_storage_head;
+		pIndex->type     = data_storage_record.data_type;
+		pIndex->size     = data_storage_record.data_size;
+		pIndex->layout   = data_storage_record.data_layout;
+		pIndex->checksum = data_storage_record.data_checksum;
+		pIndex->version  = data_storage_record.data_version;
+		pIndex->has_data = (pdata_storage_data != NULL);
+		advance_head(data_storage_pages);
+	}
+	storage_finish(success);
+}
+
+static void storage_read_data_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_finish(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_READ_DATA_COMPLETE;
+	storage_service_trigger();
+}
+
+static boolean storage_type_valid(uint16_t type)
+{
+	return (type == DATA_STORAGE_CHECKSUM_STRUCT) || (type == DATA_STORAGE_SELF_MANAGED);
+}
+
+// Test the data handle to see if it has a current record
+static boolean storage_test_handle(uint16_t data_handle)
+{
+	if (data_handle >= MAX_DATA_HANDLES) return false;
+	DATA_STORAGE_INDEX* pIndex = &data_storage_index[data_handle];
+	if (pIndex->address == NO_RECORD) return false;
+	if (storage_type_valid(pIndex->type) == false) return false;
+	if (pIndex->size == 0) return false;
+	return true;
+}
+
+boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_write_layout(data_handle, pwrData, size, 0, callback);
+}
+
+boolean storage_write_layout(uint16_t data_handle, uint8_t* pwrData, uint16_t size, uint16_t layout, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	// If the data storage area has not been created, return false
+	if (storage_test_handle(data_handle) == false)
+		return false;
+
+	if (data_storage_index[data_handle].size != size) return false;
+
+	return storage_append(data_handle, pwrData, data_storage_index[data_handle].type, size, layout, callback);
+}
+
+boolean storage_read(uint16_t data_handle, uint8_t* prdData, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_read_layout(data_handle, prdData, size, NULL, callback);
+}
+
+boolean storage_read_layout(uint16_t data_handle, uint8_t* prdData, uint16_t size, uint16_t* pLayout, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	// If the data storage area has not been created, return false
+	if (storage_test_handle(data_handle) == false)
+		return false;
+
+	if (data_storage_index[data_handle].size != size) return false;
+
+	pdata_storage_data         = prdData;
+	data_storage_data_size     = size;
+	data_storage_handle        = data_handle;
+	data_storage_user_callback = callback;
+
+	if (pLayout != NULL) *pLayout = data_storage_index[data_handle].layout;
+
+	data_storage_status = DATA_STORAGE_READ;
+	storage_service_trigger();
+	return true;
+}
+
+// Lookup the index to see if an area exists
+// Does not require callback.  Always has immediate return
+boolean storage_check_area_exists(uint16_t data_handle, uint16_t size, uint16_t type)
+{
+	if (storage_test_handle(data_handle) == false) return false;
+	if (data_storage_index[data_handle].type != type) return false;
+	if (data_storage_index[data_handle].size != size) return false;
+	return true;
+}
+
+// Create a storage area
+// Size = size in bytes
+// type = data management type
+// callback = user callback for when process finished
+boolean storage_create_area(uint16_t data_handle, uint16_t size, uint16_t type, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	if (data_handle >= MAX_DATA_HANDLES) return false;
+	if (storage_type_valid(type) == false) return false;
+	if ((size == 0) || (size > DATA_STORAGE_SEGMENT_SIZE - sizeof(DATA_STORAGE_RECORD))) return false;
+
+	return storage_append(data_handle, NULL, type, size, 0, callback);
+}
+
+// Clear specific data storage area by appending a record without data
+boolean storage_clear_area(uint16_t data_handle, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	if (storage_test_handle(data_handle) == false)
+	{
+		if (callback != NULL) callback(false);
+		return true;
+	}
+
+	// Already clear
+	if (data_storage_index[data_handle].has_data == false)
+	{
+		if (callback != NULL) callback(true);
+		return true;
+	}
+
+	return storage_append(data_handle, NULL, data_storage_index[data_handle].type, data_storage_index[data_handle].size, 0, callback);
+}
+
+#endif // (USE_NV_MEMORY == 1) && (USE_DATA_STORAGE_LOG == 1)
@@ -271,6 +271,16 @@ static int8_t interruptStackBase = 0;  // stack depth when entering interrupt (c
 // How many layers deep can Ifs, Repeats and Subroutines be nested
 #define LOGO_STACK_DEPTH            12
 
+// Where each instruction of the current set transfers control to, resolved
+// once when the set is begun: the TO of the subroutine for DO, EXEC and
+// SET_INTERRUPT, and the matching ELSE or END for IF and ELSE.
+#define MAX_INSTRUCTIONS_IN_SET ((NUM_INSTRUCTIONS > NUM_RTL_INSTRUCTIONS) ? NUM_INSTRUCTIONS : NUM_RTL_INSTRUCTIONS)
+static int16_t jumpTargets[MAX_INSTRUCTIONS_IN_SET];
+static boolean jumpTargetsValid = false;
+
+// An injected instruction is not in the current set, so has no jump target
+static boolean processingInjectedInstruction = false;
+
 struct logoStackFrame {
 	uint16_t frameType              :  2;
 	int16_t returnInstructionIndex  : 14;   // instructionIndex before the first instruction of the subroutine (a TO or REPEAT line, or -1 for MAIN)
@@ -302,6 +312,7 @@ static int16_t penState;
 static boolean process_one_instruction(struct logoInstructionDef instr);
 static void update_goal_from(struct relative3D old_waypoint);
 static void process_instructions(void);
+static void compile_jump_targets(void);
 
 int16_t flightplan_logo_index_get(void)
 {
@@ -335,6 +346,7 @@ void flightplan_logo_begin(int16_t flightplanNum)
 		currentInstructionSet = (struct logoInstructionDef*)instructions;
 		numInstructionsInCurrentSet = NUM_INSTRUCTIONS;
 	}
+	compile_jump_targets();
 
 	instructionIndex = 0;
 
@@ -425,7 +437,9 @@ void flightplan_logo_update(void)
 	// first run any injected instruction from the serial port
 	if (logo_inject_pos == LOGO_INJECT_READY)
 	{
+		processingInjectedInstruction = true;
 		process_one_instruction(logo_inject_instr);
+		processingInjectedInstruction = false;
 		if (logo_inject_instr.cmd == 2 || logo_inject_instr.cmd == 10) // DO / EXEC
 		{
 			instructionIndex++;
@@ -514,6 +528,16 @@ static int16_t find_start_of_subroutine(uint8_t subcmd)
 	return -1;
 }
 
+// For the DO, EXEC or SET_INTERRUPT being processed, find the location of the given subroutine
+static int16_t find_subroutine_target(uint8_t subcmd)
+{
+	if (jumpTargetsValid && !processingInjectedInstruction)
+	{
+		return jumpTargets[instructionIndex];
+	}
+	return find_start_of_subroutine(subcmd);
+}
+
 // When an IF condition was false, use this to skip to ELSE or END
 // When an IF condition was true, and we ran the block, and reach an ELSE, skips to the END
 static uint16_t find_end_of_current_if_block(void)
@@ -521,6 +545,11 @@ static uint16_t find_end_of_current_if_block(void)
 	int16_t i;
 	int16_t nestedDepth = 0;
 
+	if (jumpTargetsValid && !processingInjectedInstruction)
+	{
+		return jumpTargets[instructionIndex];
+	}
+
 	for (i = instructionIndex+1; i < numInstructionsInCurrentSet; i++)
 	{
 		if (currentInstructionSet[i].cmd == 1 && currentInstructionSet[i].subcmd == 0) nestedDepth++; // into a REPEAT
@@ -535,6 +564,108 @@ static uint16_t find_end_of_current_if_block(void)
 	return 0;
 }
 
+// Fill in jumpTargets for the current instruction set, giving the same targets
+// as find_start_of_subroutine() and find_end_of_current_if_block() would.
+// This takes a single pass, so that beginning a large flight plan does not
+// overrun the navigation cycle.
+static void compile_jump_targets(void)
+{
+	struct blockFrame {
+		int16_t index;
+		uint8_t pending;    // still needs its ELSE or END
+		uint8_t opener;     // an IF or REPEAT, which nests
+	};
+	struct blockFrame blocks[LOGO_STACK_DEPTH * 2];
+	int16_t depth = 0;
+	int16_t firstSubroutine = -1;
+	int16_t i;
+	int16_t j;
+
+	// Chain the TO instructions together through their own entries, in
+	// program order, as a TO is never run
+	for (i = numInstructionsInCurrentSet - 1; i >= 0; i--)
+	{
+		if (currentInstructionSet[i].cmd == 1 && currentInstructionSet[i].subcmd == 2)
+		{
+			jumpTargets[i] = firstSubroutine;
+			firstSubroutine = i;
+		}
+	}
+
+	for (i = 0; i < numInstructionsInCurrentSet; i++)
+	{
+		struct logoInstructionDef* instr = &currentInstructionSet[i];
+		int16_t subroutine = -1;
+
+		if (instr->cmd == 2 || instr->cmd == 10 || (instr->cmd == 12 && instr->subcmd == 1)) // DO, EXEC, SET_INTERRUPT
+		{
+			uint8_t sub = (instr->cmd == 12) ? instr->arg : instr->subcmd;
+
+			if (sub != 0) // subcmd 0 is reserved to always mean the start of the logo program
+			{
+				for (j = firstSubroutine; j != -1; j = jumpTargets[j])
+				{
+					if (currentInstructionSet[j].arg == sub)
+					{
+						subroutine = j;
+						break;
+					}
+				}
+			}
+			jumpTargets[i] = subroutine;
+		}
+		else if (instr->cmd == 1 && instr->subcmd == 2) // TO
+		{
+			continue;
+		}
+		else if (instr->cmd == 1 && (instr->subcmd == 1 || instr->subcmd == 3)) // END, ELSE
+		{
+			jumpTargets[i] = 0;
+
+			// Entries above the innermost IF or REPEAT are ELSEs at the same depth
+			while (depth > 0 && !blocks[depth-1].opener)
+			{
+				depth--;
+				jumpTargets[blocks[depth].index] = i;
+			}
+			if (depth > 0 && blocks[depth-1].pending)
+			{
+				jumpTargets[blocks[depth-1].index] = i;
+				blocks[depth-1].pending = false;
+			}
+			if (instr->subcmd == 1)
+			{
+				// END closes the innermost IF or REPEAT
+				if (depth > 0) depth--;
+			}
+			else
+			{
+				// ELSE waits for the next ELSE or END at its depth
+				if (depth == LOGO_STACK_DEPTH * 2) break;
+				blocks[depth].index = i;
+				blocks[depth].pending = true;
+				blocks[depth].opener = false;
+				depth++;
+			}
+		}
+		else if ((instr->cmd == 1 && instr->subcmd == 0) || (instr->cmd >= 14 && instr->cmd <= 19)) // REPEAT, IF
+		{
+			jumpTargets[i] = 0;
+			if (depth == LOGO_STACK_DEPTH * 2) break;
+			blocks[depth].index = i;
+			blocks[depth].pending = (instr->cmd != 1);
+			blocks[depth].opener = true;
+			depth++;
+		}
+		else
+		{
+			jumpTargets[i] = 0;
+		}
+	}
+	// Nested too deeply to follow, so find the targets as they are needed
+	jumpTargetsValid = (i == numInstructionsInCurrentSet);
+}
+
 // Referencing PARAM in a LOGO program uses the PARAM from the current subroutine frame, even if
 // we're also nested deeper inside of IF or REPEAT frames.  This finds the current subroutine's frame.
 static int16_t get_current_stack_parameter_frame_index(void)
@@ -760,7 +891,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 			break;
 
 		case 10: // Exec (reset the stack and then call a subroutine)
-			instructionIndex = find_start_of_subroutine(instr.subcmd);
+			instructionIndex = find_subroutine_target(instr.subcmd);
 			logoStack[0].returnInstructionIndex = instructionIndex;
 			logoStackIndex = 0;
 			interruptStackBase = 0;
@@ -774,7 +905,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 				logoStack[logoStackIndex].arg = instr.arg;
 				logoStack[logoStackIndex].returnInstructionIndex = instructionIndex;
 			}
-			instructionIndex = find_start_of_subroutine(instr.subcmd);
+			instructionIndex = find_subroutine_target(instr.subcmd);
 			break;
 
 		case 3: // Forward/Back
@@ -972,7 +1103,15 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 		case 12: // Interrupts
 			switch (instr.subcmd) {
 				case 1: // Set
-					interruptIndex = find_start_of_subroutine(instr.arg);
+					if (instr.use_param)
+					{
+						// The subroutine number is only known now
+						interruptIndex = find_start_of_subroutine(instr.arg);
+					}
+					else
+					{
+						interruptIndex = find_subroutine_target(instr.arg);
+					}
 					break;
 				case 0: // Clear
 					interruptIndex = 0;
@@ -50,15 +50,37 @@ struct waypointDef { struct waypoint3D loc; int16_t flags; struct waypoint3D vie
 //int16_t waypointIndex = 0;
 
 #ifdef USE_DYNAMIC_WAYPOINTS
-static struct waypointDef WaypointSet[MAX_WAYPOINTS];
-static struct waypointDef* currentWaypointSet = (struct waypointDef*)WaypointSet;
+#if (SHADOW_WAYPOINTS == 1)
+static struct waypointDef WaypointSet[2][MAX_WAYPOINTS];
+#else
+static struct waypointDef WaypointSet[1][MAX_WAYPOINTS];
+#endif
+static struct waypointDef* currentWaypointSet = (struct waypointDef*)WaypointSet[0];
 static int16_t numPointsInCurrentSet = 0;
+// A flight plan being uploaded is staged in the set which is not in use, and
+// is swapped in by the navigation once it is complete (see flightplan_shadow_swap).
+// Without SHADOW_WAYPOINTS, it is staged in the current set.
+static struct waypointDef* shadowWaypointSet = (struct waypointDef*)WaypointSet[SHADOW_WAYPOINTS];
+static int16_t numPointsInShadowSet = 0;
+static volatile boolean shadowSetPending = false;
 #else
 static const struct waypointDef* currentWaypointSet = (struct waypointDef*)waypoints;
 static int16_t numPointsInCurrentSet = NUMBER_POINTS;
 #endif
 
 static struct relWaypointDef current_waypoint;
+
+// The current set of waypoints is converted to relative coordinates, and the
+// geometry of each leg worked out, once (see build_legs). Moving on to the
+// next waypoint then only copies its leg into the navigation.
+#ifdef USE_DYNAMIC_WAYPOINTS
+#define MAX_LEGS MAX_WAYPOINTS
+#else
+#define MAX_LEGS ((NUMBER_POINTS > NUMBER_RTL_POINTS) ? NUMBER_POINTS : NUMBER_RTL_POINTS)
+#endif
+static struct relWaypointDef relWaypointSet[MAX_LEGS];
+static struct navLegDef legSet[MAX_LEGS];   // legSet[i] ends at waypoint i, legSet[0] starts at the last one
+static boolean legSetValid = false;
 static struct waypointDef wp_inject;
 static uint8_t wp_inject_pos = 0;
 #define WP_INJECT_READY 255
@@ -123,9 +145,55 @@ static vect3_32t wp_to_absolute_coords(struct waypointDef wp)
 	return v;
 }
 
+// Leaves legSetValid false if the set is too long, and the legs are then
+// worked out as each is flown.
+static void build_legs(void)
+{
+	int16_t i;
+
+	if (numPointsInCurrentSet > MAX_LEGS)
+	{
+		legSetValid = false;
+		return;
+	}
+	for (i = 0; i < numPointsInCurrentSet; i++)
+	{
+		relWaypointSet[i] = wp_to_relative(currentWaypointSet[i]);
+	}
+	for (i = 1; i < numPointsInCurrentSet; i++)
+	{
+		navigate_compute_leg(&legSet[i], relWaypointSet[i-1].loc, relWaypointSet[i].loc);
+	}
+	if (numPointsInCurrentSet > 1)
+	{
+		navigate_compute_leg(&legSet[0], relWaypointSet[numPointsInCurrentSet-1].loc, relWaypointSet[0].loc);
+	}
+	legSetValid = true;
+}
+
+static struct relWaypointDef rel_waypoint(int16_t index)
+{
+	if (!legSetValid)
+	{
+		build_legs();
+	}
+	if (legSetValid)
+	{
+		return relWaypointSet[index];
+	}
+	return wp_to_relative(currentWaypointSet[index]);
+}
+
+// Absolute waypoints are relative to the origin, so their legs are worked out again
+void flightplan_waypoints_origin_changed(void)
+{
+	legSetValid = false;
+}
+
 void clear_flightplan(void)
 {
 	numPointsInCurrentSet = 0;
+	legSetValid = false;
 }
 
 // X is Longitude in degrees * 10^7
@@ -143,6 +211,7 @@ void add_waypoint(struct waypoint3D wp, int16_t flags)
 		currentWaypointSet[numPointsInCurrentSet].loc.z = wp.z;
 		currentWaypointSet[numPointsInCurrentSet].flags = flags;
 		numPointsInCurrentSet++;
+		legSetValid = false;
 	}
 	else
 	{
@@ -153,6 +222,102 @@ void add_waypoint(struct waypoint3D wp, int16_t flags)
 
 #endif // USE_DYNAMIC_WAYPOINTS
 }
+
+#ifdef USE_DYNAMIC_WAYPOINTS
+
+boolean flightplan_shadow_begin(int16_t count)
+{
+	if (count <= 0 || count > MAX_WAYPOINTS)
+	{
+		DPRINT("flightplan_shadow_begin(%i) no room\r\n", count);
+		return false;
+	}
+	if (shadowSetPending)
+	{
+		DPRINT("flightplan_shadow_begin(%i) previous flight plan not yet in use\r\n", count);
+		return false;
+	}
+#if (SHADOW_WAYPOINTS != 1)
+	clear_flightplan();
+#endif
+	numPointsInShadowSet = count;
+	return true;
+}
+
+boolean flightplan_shadow_set(int16_t index, struct waypoint3D wp, int16_t flags)
+{
+	static const struct waypoint3D no_viewpoint = { 0, 0, 0 };
+
+	if (index < 0 || index >= numPointsInShadowSet)
+	{
+		return false;
+	}
+	if ((flags & F_ABSOLUTE) && (labs(wp.y) > 900000000 || labs(wp.x) > 1800000000))
+	{
+		DPRINT("flightplan_shadow_set(%i) invalid location\r\n", index);
+		return false;
+	}
+	shadowWaypointSet[index].loc = wp;
+	shadowWaypointSet[index].flags = flags;
+	shadowWaypointSet[index].viewpoint = no_viewpoint;
+	return true;
+}
+
+boolean flightplan_shadow_commit(void)
+{
+	if (numPointsInShadowSet == 0)
+	{
+		return false;
+	}
+	shadowSetPending = true;
+	return true;
+}
+
+// The new flight plan is swapped in by the navigation, as geofence.c does
+// with a new fence, so a frame never sees a flight plan which is partly
+// replaced. Leg 0 of the new flight plan is started straight away.
+void flightplan_shadow_swap(void)
+{
+	struct waypointDef* previous = currentWaypointSet;
+
+	if (!shadowSetPending)
+	{
+		return;
+	}
+	waypointIndex = 0;
+	currentWaypointSet = shadowWaypointSet;
+	numPointsInCurrentSet = numPointsInShadowSet;
+	shadowWaypointSet = previous;
+	numPointsInShadowSet = 0;
+	legSetValid = false;
+	set_waypoint(0);
+	shadowSetPending = false;
+}
+
+#else
+
+boolean flightplan_shadow_begin(int16_t count)
+{
+	DPRINT("Must define USE_DYNAMIC_WAYPOINTS in order to upload waypoints\r\n");
+	return false;
+}
+
+boolean flightplan_shadow_set(int16_t index, struct waypoint3D wp, int16_t flags)
+{
+	return false;
+}
+
+boolean flightplan_shadow_commit(void)
+{
+	return false;
+}
+
+void flightplan_shadow_swap(void)
+{
+}
+
+#endif // USE_DYNAMIC_WAYPOINTS
+
 /*
 void add_waypoint(int32_t x, int32_t y, int16_t z, int16_t flags)
 {
@@ -196,6 +361,7 @@ static void load_flightplan(const struct waypointDef* waypoints, int count)
 		dst_wp->viewpoint = src_wp->viewpoint;
 	}
 	numPointsInCurrentSet = count;
+	legSetValid = false;
 }
 
 #else
@@ -204,6 +370,7 @@ static void load_flightplan(const struct waypointDef* waypoints, int count)
 {
 	currentWaypointSet = waypoints;
 	numPointsInCurrentSet = count;
+	legSetValid = false;
 }
 
 #endif
@@ -236,7 +403,8 @@ void flightplan_waypoints_begin(int16_t flightplanNum)
 //		numPointsInCurrentSet = NUMBER_POINTS;
 	}
 	waypointIndex = 0;
-	current_waypoint = wp_to_relative(currentWaypointSet[0]);
+	build_legs();
+	current_waypoint = rel_waypoint(0);
 	navigate_set_goal(GPSlocation, current_waypoint.loc);
 	set_camera_view(current_waypoint.viewpoint);
 	setBehavior(current_waypoint.flags);
@@ -271,29 +439,27 @@ void set_waypoint(int16_t index)
 #if (USE_MAVLINK == 1)
 		mavlink_waypoint_changed(waypointIndex);
 #endif
+		current_waypoint = rel_waypoint(waypointIndex);
+		if (waypointIndex == 0 && numPointsInCurrentSet == 1)
+		{
+			navigate_set_goal(GPSlocation, current_waypoint.loc);
+		}
+		else if (legSetValid)
+		{
+			navigate_set_leg(&legSet[waypointIndex]);
+		}
+		else
+		{
+			struct relWaypointDef previous_waypoint = wp_to_relative(currentWaypointSet[(waypointIndex == 0) ? numPointsInCurrentSet-1 : waypointIndex-1]);
+			navigate_set_goal(previous_waypoint.loc, current_waypoint.loc);
+		}
+		set_camera_view(current_waypoint.viewpoint);
 		if (waypointIndex == 0)
 		{
-			if (numPointsInCurrentSet > 1)
-			{
-				struct relWaypointDef previous_waypoint = wp_to_relative(currentWaypointSet[numPointsInCurrentSet-1]);
-				current_waypoint  = wp_to_relative(currentWaypointSet[0]);
-				navigate_set_goal(previous_waypoint.loc, current_waypoint.loc);
-				set_camera_view(current_waypoint.viewpoint);
-			}
-			else
-			{
-				current_waypoint = wp_to_relative(currentWaypointSet[0]);
-				navigate_set_goal(GPSlocation, current_waypoint.loc);
-				set_camera_view(current_waypoint.viewpoint);
-			}
 			setBehavior(currentWaypointSet[0].flags);
 		}
 		else
 		{
-			struct relWaypointDef previous_waypoint = wp_to_relative(currentWaypointSet[waypointIndex-1]);
-			current_waypoint = wp_to_relative(currentWaypointSet[waypointIndex]);
-			navigate_set_goal(previous_waypoint.loc, current_waypoint.loc);
-			set_camera_view(current_waypoint.viewpoint);
 			setBehavior(current_waypoint.flags);
 		}
 #if (DEADRECKONING == 0)
@@ -354,6 +520,25 @@ static void next_waypoint(void)
 	}
 }
 
+// The distance from the finish line at which to move on to the next waypoint.
+// With TURN_ANTICIPATION, this is where the turn onto the next leg has to
+// start for the aircraft to roll out on its track. It is not worked out while
+// the finish line is further away than any lead could be.
+static int16_t leg_switch_distance(void)
+{
+#if (TURN_ANTICIPATION == 1)
+	if (legSetValid && numPointsInCurrentSet > 1 && extended_range == 0 && tofinish_line <= TURN_LEAD_MAX_DISTANCE)
+	{
+		int16_t lead = navigate_turn_lead(&legSet[(waypointIndex + 1 < numPointsInCurrentSet) ? waypointIndex + 1 : 0]);
+		if (lead >= 0)
+		{
+			return lead;
+		}
+	}
+#endif // TURN_ANTICIPATION
+	return WAYPOINT_PROXIMITY_RADIUS;
+}
+
 //void run_flightplan(void)
 void flightplan_waypoints_update(void)
 {
@@ -386,17 +571,17 @@ void flightplan_waypoints_update(void)
 	}
 	else
 	{
-		if (tofinish_line < WAYPOINT_PROXIMITY_RADIUS) // crossed the finish line
+		if (desired_behavior._.loiter)
 		{
-			if (desired_behavior._.loiter)
-			{
-				navigate_set_goal(GPSlocation, wp_to_relative(currentWaypointSet[waypointIndex]).loc);
-			}
-			else
+			if (tofinish_line < WAYPOINT_PROXIMITY_RADIUS) // crossed the finish line
 			{
-				next_waypoint();
+				navigate_set_goal(GPSlocation, rel_waypoint(waypointIndex).loc);
 			}
 		}
+		else if (tofinish_line < leg_switch_distance())
+		{
+			next_waypoint();
+		}
 	}
 }
 
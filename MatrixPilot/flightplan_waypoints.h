@@ -24,7 +24,17 @@
 
 
 //#define USE_DYNAMIC_WAYPOINTS
+#ifndef MAX_WAYPOINTS
 #define MAX_WAYPOINTS 20
+#endif
+
+// With SHADOW_WAYPOINTS set to 1, a flight plan being uploaded is staged in a
+// second set of MAX_WAYPOINTS waypoints, and the current one is flown until
+// the upload is complete. Set it to 0 to save the RAM of the second set, and
+// the current flight plan is cleared when an upload starts instead.
+#ifndef SHADOW_WAYPOINTS
+#define SHADOW_WAYPOINTS 1
+#endif
 
 extern int16_t waypointIndex;
 
@@ -33,6 +43,17 @@ int16_t waypoint_count(void);
 void set_waypoint(int16_t index);
 void clear_flightplan(void);
 void add_waypoint(struct waypoint3D wp, int16_t flags);
+void flightplan_waypoints_origin_changed(void);
+
+// A new flight plan is staged in a shadow set, one waypoint at a time and in
+// any order, and then replaces the current flight plan in a single step.
+// These all return false if the flight plan can not be staged or is invalid.
+boolean flightplan_shadow_begin(int16_t count);
+boolean flightplan_shadow_set(int16_t index, struct waypoint3D wp, int16_t flags);
+boolean flightplan_shadow_commit(void);
+// Called by the navigation each time it runs, to replace the current flight
+// plan with a committed one.
+void flightplan_shadow_swap(void);
 
 void flightplan_waypoints_init(void);
 void flightplan_waypoints_begin(int16_t flightplanNum);
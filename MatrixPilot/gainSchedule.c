@@ -0,0 +1,173 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "defines.h"
+#include "gainSchedule.h"
+#include "../libDCM/deadReckoning.h"
+#include "../libDCM/gpsData.h"
+#include "../libDCM/estAltitude.h"
+#include <math.h>
+
+#ifndef GAIN_SCHEDULE_AIRSPEEDS
+#define GAIN_SCHEDULE_AIRSPEEDS             { 7.0, 12.0, 16.0, 20.0 }
+#endif
+#ifndef GAIN_SCHEDULE_ROLL
+#define GAIN_SCHEDULE_ROLL                  { 1.0, 1.0, 1.0, 1.0 }
+#endif
+#ifndef GAIN_SCHEDULE_PITCH
+#define GAIN_SCHEDULE_PITCH                 { 1.0, 1.0, 1.0, 1.0 }
+#endif
+#ifndef GAIN_SCHEDULE_YAW
+#define GAIN_SCHEDULE_YAW                   { 1.0, 1.0, 1.0, 1.0 }
+#endif
+#ifndef GAIN_SCHEDULE_NAV
+#define GAIN_SCHEDULE_NAV                   { 1.0, 1.0, 1.0, 1.0 }
+#endif
+
+int16_t gain_schedule_airspeed[GAIN_SCHEDULE_POINTS];
+int16_t gain_schedule_scale[GAIN_LOOPS][GAIN_SCHEDULE_POINTS];
+
+void init_gainSchedule(void)
+{
+	static const float airspeeds[GAIN_SCHEDULE_POINTS] = GAIN_SCHEDULE_AIRSPEEDS;
+	static const float scales[GAIN_LOOPS][GAIN_SCHEDULE_POINTS] = {
+		GAIN_SCHEDULE_ROLL, GAIN_SCHEDULE_PITCH, GAIN_SCHEDULE_YAW, GAIN_SCHEDULE_NAV
+	};
+	int16_t loop;
+	int16_t i;
+
+	for (i = 0; i < GAIN_SCHEDULE_POINTS; i++)
+	{
+		gain_schedule_airspeed[i] = (int16_t)(airspeeds[i] * 100);
+		for (loop = 0; loop < GAIN_LOOPS; loop++)
+		{
+			gain_schedule_scale[loop][i] = (int16_t)(scales[loop][i] * RMAX);
+		}
+	}
+}
+
+#if (GAIN_SCHEDULING == 1)
+
+// The scales of the gains for this frame
+static int16_t active_scale[GAIN_LOOPS] = { RMAX, RMAX, RMAX, RMAX };
+
+#if (GAIN_SCHEDULE_DENSITY == 1)
+// The square root of the air density relative to sea level, in Q14.
+// Density changes slowly, so it is worked out once a second.
+static uint16_t sqrt_density_ratio = RMAX;
+static int16_t density_counter = 0;
+
+static void update_density_ratio(void)
+{
+	float ratio;
+
+#if (USE_BAROMETER_ALTITUDE == 1)
+	if (get_barometer_pressure() > 0)
+	{
+		// pressure is in Pascals and temperature in tenths of a degree C
+		ratio = ((float)get_barometer_pressure() / 101325.0f) *
+		        (2881.5f / (get_barometer_temperature() + 2731.5f));
+	}
+	else
+#endif // USE_BAROMETER_ALTITUDE
+	{
+		// standard atmosphere at the GPS altitude, which is in centimeters
+		ratio = 1.0f - 2.25577e-7f * (float)alt_sl_gps.WW;
+		ratio = (ratio > 0.1f) ? powf(ratio, 4.2559f) : 0.01f;
+	}
+	if (ratio > 3.9f) ratio = 3.9f;
+	sqrt_density_ratio = (uint16_t)(sqrtf(ratio) * RMAX);
+}
+#endif // GAIN_SCHEDULE_DENSITY
+
+// Interpolate a loop's scale at an airspeed, holding the end values outside
+// of the table. Points which are not above the one before them are skipped.
+static int16_t interpolate_scale(const int16_t* scale, int16_t airspeed)
+{
+	int16_t i;
+	int16_t lower = 0;
+	int16_t span;
+
+	if (airspeed <= gain_schedule_airspeed[0])
+	{
+		return scale[0];
+	}
+	for (i = 1; i < GAIN_SCHEDULE_POINTS; i++)
+	{
+		span = gain_schedule_airspeed[i] - gain_schedule_airspeed[lower];
+		if (span <= 0)
+		{
+			continue;
+		}
+		if (airspeed < gain_schedule_airspeed[i])
+		{
+			return scale[lower] + __builtin_divsd(
+			    __builtin_mulss(scale[i] - scale[lower], airspeed - gain_schedule_airspeed[lower]), span);
+		}
+		lower = i;
+	}
+	return scale[lower];
+}
+
+// Called once a frame, before the control loops
+void gainSchedule(void)
+{
+	int16_t airspeed;
+	int16_t loop;
+
+#if (GAIN_SCHEDULE_DENSITY == 1)
+	if (density_counter-- <= 0)
+	{
+		density_counter = 40;
+		update_density_ratio();
+	}
+	{
+		uint32_t equivalent = __builtin_muluu(air_speed_3DIMU, sqrt_density_ratio) >> 14;
+		airspeed = (equivalent > 32767) ? 32767 : (int16_t)equivalent;
+	}
+#else
+	airspeed = (air_speed_3DIMU > 32767) ? 32767 : air_speed_3DIMU;
+#endif // GAIN_SCHEDULE_DENSITY
+
+	for (loop = 0; loop < GAIN_LOOPS; loop++)
+	{
+		active_scale[loop] = interpolate_scale(gain_schedule_scale[loop], airspeed);
+		if (active_scale[loop] < 0)
+		{
+			active_scale[loop] = 0;
+		}
+	}
+}
+
+uint16_t scheduled_gain(uint16_t gain, gain_loop_t loop)
+{
+	uint32_t accum = __builtin_muluu(gain, active_scale[loop]) >> 14;
+
+	return (accum > 0xFFFF) ? 0xFFFF : (uint16_t)accum;
+}
+
+#else
+
+void gainSchedule(void)
+{
+}
+
+#endif // GAIN_SCHEDULING
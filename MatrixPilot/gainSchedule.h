@@ -0,0 +1,51 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef _GAINSCHEDULE_H_
+#define _GAINSCHEDULE_H_
+
+
+#define GAIN_SCHEDULE_POINTS    4
+
+// The control loops whose gains are scheduled with airspeed
+typedef enum {
+	GAIN_ROLL = 0,          // rollkp, rollkd, yawkdail and the roll feed forward
+	GAIN_PITCH,             // pitchgain, pitchkd and the pitch feed forward
+	GAIN_YAW,               // yawkprud, yawkdrud, rollkprud and rollkdrud
+	GAIN_NAV,               // yawkpail and the turn gain in navigation
+	GAIN_LOOPS
+} gain_loop_t;
+
+// Schedule tables, as MAVLink parameters: airspeeds in cm/sec and scales in Q14
+extern int16_t gain_schedule_airspeed[GAIN_SCHEDULE_POINTS];
+extern int16_t gain_schedule_scale[GAIN_LOOPS][GAIN_SCHEDULE_POINTS];
+
+void init_gainSchedule(void);
+void gainSchedule(void);
+
+#if (GAIN_SCHEDULING == 1)
+uint16_t scheduled_gain(uint16_t gain, gain_loop_t loop);
+#else
+#define scheduled_gain(gain, loop) (gain)
+#endif // GAIN_SCHEDULING
+
+
+#endif // _GAINSCHEDULE_H_
@@ -0,0 +1,604 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "defines.h"
+#include "geofence.h"
+#include "parameter_datatypes.h"
+#include "data_storage.h"
+#include "../libDCM/deadReckoning.h"
+#include "../libDCM/gpsData.h"
+#include "../libDCM/mathlibNAV.h"
+#include <string.h>
+#include <stdlib.h>
+
+#ifndef GEOFENCE_MAX_POINTS
+#define GEOFENCE_MAX_POINTS                 64
+#endif
+#ifndef GEOFENCE_LOOKAHEAD
+#define GEOFENCE_LOOKAHEAD                  2
+#endif
+#ifndef GEOFENCE_MIN_ALT
+#define GEOFENCE_MIN_ALT                    0
+#endif
+#ifndef GEOFENCE_MAX_ALT
+#define GEOFENCE_MAX_ALT                    0
+#endif
+
+int16_t geofence_action = GEOFENCE_ACTION_RTL;
+int16_t geofence_total = 0;
+int16_t geofence_min_alt = GEOFENCE_MIN_ALT;
+int16_t geofence_max_alt = GEOFENCE_MAX_ALT;
+
+#if (USE_GEOFENCE == 1)
+
+#if (GEOFENCE_MAX_POINTS > 254)
+#error "GEOFENCE_MAX_POINTS must be no more than 254, as fence points are numbered with a byte"
+#endif
+
+#define GEOFENCE_MAX_ZONES      8
+#define GEOFENCE_STRIPS         8       // horizontal strips in the index of each zone
+#define GEOFENCE_INDEX_SIZE     (GEOFENCE_MAX_POINTS * 3)
+#define GEOFENCE_RANGE          16000   // meters from the origin that the fence may reach
+
+struct fence_point {
+	int32_t lat;                // degrees * 10^7
+	int32_t lon;
+};
+
+// The fence as it is stored, and as it is staged during an upload
+struct geofence_store {
+	uint16_t count;
+	struct fence_point points[GEOFENCE_MAX_POINTS];
+};
+
+// The index of a zone. The zone's bounding box is divided into horizontal
+// strips, and each strip lists the edges which reach into it. A point is then
+// tested against the edges in its own strip only, rather than all of them.
+struct fence_zone {
+	uint8_t first;              // the zone's first vertex in fence_xy
+	uint8_t count;              // its vertices, without the closing one
+	boolean exclusion;
+	int16_t min_x, max_x, min_y, max_y;
+	int16_t strip_height;       // in meters, or 0 when there was no room to index the zone
+	uint16_t strip_start[GEOFENCE_STRIPS + 1];  // where each strip's edges start in strip_edges
+};
+
+static struct geofence_store fence;     // the fence in use
+static struct geofence_store staged;    // an upload, or the fence read from storage
+static uint8_t staged_received[(GEOFENCE_MAX_POINTS + 7) / 8];
+static uint8_t staged_remaining = 0;
+static volatile boolean commit_pending = false;
+static boolean save_pending = false;
+
+static vect2_16t fence_xy[GEOFENCE_MAX_POINTS];         // fence points in meters from the origin
+static struct fence_zone zones[GEOFENCE_MAX_ZONES];
+static uint8_t zone_count = 0;
+static uint8_t strip_edges[GEOFENCE_INDEX_SIZE];
+static boolean origin_valid = false;
+static boolean index_valid = false;
+
+static uint8_t next_zone = 0;
+static uint8_t zone_breaches = 0;       // a bit for each zone which is breached
+static boolean floor_armed = false;
+static boolean rtl_request = false;
+static uint32_t frame_counter = 0;
+static struct geofence_status status;
+
+static boolean storage_reading(void);
+
+void geofence_origin_changed(void)
+{
+	origin_valid = true;
+	index_valid = false;
+}
+
+boolean geofence_take_rtl_request(void)
+{
+	boolean request = rtl_request;
+
+	rtl_request = false;
+	return request;
+}
+
+void geofence_get_status(struct geofence_status* s)
+{
+	*s = status;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Fence points
+
+boolean geofence_set_point(uint8_t idx, uint8_t count, int32_t lat, int32_t lon)
+{
+	if (count == 0 || count > GEOFENCE_MAX_POINTS || idx >= count || count != geofence_total)
+	{
+		return false;
+	}
+	if (labs(lat) > 900000000 || labs(lon) > 1800000000)
+	{
+		return false;
+	}
+	if (commit_pending || storage_reading())
+	{
+		// staged holds a fence still to be committed, or one being read from
+		// storage. The ground station resends points which are not taken.
+		return false;
+	}
+	if (count != staged.count || staged_remaining == 0)
+	{
+		// a new upload
+		staged.count = count;
+		staged_remaining = count;
+		memset(staged_received, 0, sizeof(staged_received));
+	}
+	staged.points[idx].lat = lat;
+	staged.points[idx].lon = lon;
+	if ((staged_received[idx >> 3] & (1 << (idx & 7))) == 0)
+	{
+		staged_received[idx >> 3] |= (1 << (idx & 7));
+		if (--staged_remaining == 0)
+		{
+			commit_pending = true;
+			save_pending = true;
+		}
+	}
+	return true;
+}
+
+boolean geofence_get_point(uint8_t idx, int32_t* lat, int32_t* lon)
+{
+	if (idx >= fence.count)
+	{
+		return false;
+	}
+	*lat = fence.points[idx].lat;
+	*lon = fence.points[idx].lon;
+	return true;
+}
+
+uint8_t geofence_point_count(void)
+{
+	return fence.count;
+}
+
+// The index of the point which closes the zone starting at first, or count
+// if the zone is not closed.
+static uint8_t zone_end(const struct geofence_store* f, uint8_t first)
+{
+	uint8_t i;
+
+	for (i = first + 1; i < f->count; i++)
+	{
+		if (f->points[i].lat == f->points[first].lat && f->points[i].lon == f->points[first].lon)
+		{
+			break;
+		}
+	}
+	return i;
+}
+
+static boolean fence_valid(const struct geofence_store* f)
+{
+	uint8_t i = 1;
+	uint8_t end;
+	uint8_t zones_found = 0;
+
+	if (f->count > GEOFENCE_MAX_POINTS)
+	{
+		return false;
+	}
+	while (i < f->count)
+	{
+		end = zone_end(f, i);
+		if (end - i < 3 || ++zones_found > GEOFENCE_MAX_ZONES)
+		{
+			return false;
+		}
+		i = end + 1;
+	}
+	return true;
+}
+
+// Replace the fence in use with the staged one. This is done in the flight
+// control frame, so the checks never see a fence which is partly replaced.
+static void commit_staged(void)
+{
+	commit_pending = false;
+	if (!fence_valid(&staged))
+	{
+		DPRINT("geofence: invalid fence of %u points\r\n", staged.count);
+		save_pending = false;
+		return;
+	}
+	memcpy(&fence, &staged, sizeof(fence));
+	geofence_total = fence.count;
+	index_valid = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Storage
+
+#if (USE_NV_MEMORY == 1)
+
+typedef enum {
+	STORE_START,                // waiting for storage to start, to read the fence
+	STORE_READING,
+	STORE_IDLE,
+	STORE_CREATING,
+	STORE_WRITING
+} store_state_t;
+
+static volatile store_state_t store_state = STORE_START;
+
+static void geofence_read_callback(boolean success)
+{
+	if (success)
+	{
+		commit_pending = true;
+	}
+	store_state = STORE_IDLE;
+}
+
+static void geofence_create_callback(boolean success)
+{
+	if (!success)
+	{
+		save_pending = false;
+	}
+	store_state = STORE_IDLE;
+}
+
+static void geofence_write_callback(boolean success)
+{
+	store_state = STORE_IDLE;
+}
+
+static boolean storage_busy(void)
+{
+	return (store_state == STORE_READING || store_state == STORE_CREATING || store_state == STORE_WRITING);
+}
+
+static boolean storage_reading(void)
+{
+	return (store_state == STORE_READING);
+}
+
+static void geofence_storage_service(void)
+{
+	if (store_state == STORE_START && storage_services_started())
+	{
+		// a fence uploaded before storage started replaces the stored one
+		if (save_pending || !storage_check_area_exists(STORAGE_HANDLE_GEOFENCE, sizeof(staged), DATA_STORAGE_CHECKSUM_STRUCT))
+		{
+			store_state = STORE_IDLE;
+		}
+		else if (storage_read(STORAGE_HANDLE_GEOFENCE, (uint8_t*)&staged, sizeof(staged), &geofence_read_callback))
+		{
+			store_state = STORE_READING;
+		}
+	}
+	else if (store_state == STORE_IDLE && save_pending && !commit_pending)
+	{
+		if (!storage_check_area_exists(STORAGE_HANDLE_GEOFENCE, sizeof(fence), DATA_STORAGE_CHECKSUM_STRUCT))
+		{
+			if (storage_create_area(STORAGE_HANDLE_GEOFENCE, sizeof(fence), DATA_STORAGE_CHECKSUM_STRUCT, &geofence_create_callback))
+			{
+				store_state = STORE_CREATING;
+			}
+		}
+		else if (storage_write(STORAGE_HANDLE_GEOFENCE, (uint8_t*)&fence, sizeof(fence), &geofence_write_callback))
+		{
+			save_pending = false;
+			store_state = STORE_WRITING;
+		}
+	}
+}
+
+#else
+
+static boolean storage_busy(void)
+{
+	return false;
+}
+
+static boolean storage_reading(void)
+{
+	return false;
+}
+
+static void geofence_storage_service(void)
+{
+	save_pending = false;
+}
+
+#endif // USE_NV_MEMORY
+
+////////////////////////////////////////////////////////////////////////////////
+// Index
+
+static int16_t clamp_range(int32_t v)
+{
+	if (v > GEOFENCE_RANGE) return GEOFENCE_RANGE;
+	if (v < -GEOFENCE_RANGE) return -GEOFENCE_RANGE;
+	return (int16_t)v;
+}
+
+// Fence points are converted to meters from the origin in the same way as
+// waypoints are. Points further away than GEOFENCE_RANGE are brought in to
+// it, which keeps the products in the crossing test within 32 bits.
+static vect2_16t fence_to_local(const struct fence_point* p)
+{
+	vect2_16t xy;
+
+	xy.x = clamp_range(long_scale((p->lon - lon_origin.WW) / 90, cos_lat));
+	xy.y = clamp_range((p->lat - lat_origin.WW) / 90);
+	return xy;
+}
+
+static void edge_vertices(const struct fence_zone* z, uint8_t e, const vect2_16t** a, const vect2_16t** b)
+{
+	*a = &fence_xy[z->first + e];
+	*b = &fence_xy[z->first + ((e + 1 < z->count) ? e + 1 : 0)];
+}
+
+// List the edges reaching into each strip, and return the next free place in
+// strip_edges. If there is no room, the zone is left with no strip index.
+static uint16_t index_zone(struct fence_zone* z, uint16_t used)
+{
+	const vect2_16t* a;
+	const vect2_16t* b;
+	uint16_t start = used;
+	int16_t lo;
+	int16_t hi;
+	uint8_t s;
+	uint8_t e;
+	uint8_t i;
+
+	z->min_x = z->max_x = fence_xy[z->first].x;
+	z->min_y = z->max_y = fence_xy[z->first].y;
+	for (i = 1; i < z->count; i++)
+	{
+		const vect2_16t* v = &fence_xy[z->first + i];
+		if (v->x < z->min_x) z->min_x = v->x;
+		if (v->x > z->max_x) z->max_x = v->x;
+		if (v->y < z->min_y) z->min_y = v->y;
+		if (v->y > z->max_y) z->max_y = v->y;
+	}
+	z->strip_height = (z->max_y - z->min_y) / GEOFENCE_STRIPS + 1;
+
+	for (s = 0; s < GEOFENCE_STRIPS; s++)
+	{
+		lo = z->min_y + s * z->strip_height;
+		hi = lo + z->strip_height;
+		z->strip_start[s] = used;
+		for (e = 0; e < z->count; e++)
+		{
+			edge_vertices(z, e, &a, &b);
+			if (a->y == b->y)
+			{
+				continue;   // a horizontal edge is never crossed by the test ray
+			}
+			if ((a->y < hi || b->y < hi) && (a->y >= lo || b->y >= lo))
+			{
+				if (used >= GEOFENCE_INDEX_SIZE)
+				{
+					z->strip_height = 0;
+					return start;
+				}
+				strip_edges[used++] = e;
+			}
+		}
+	}
+	z->strip_start[GEOFENCE_STRIPS] = used;
+	return used;
+}
+
+static void build_index(void)
+{
+	uint16_t used = 0;
+	uint8_t i = 1;
+	uint8_t end;
+	uint8_t j;
+
+	zone_count = 0;
+	while (i < fence.count && zone_count < GEOFENCE_MAX_ZONES)
+	{
+		end = zone_end(&fence, i);
+		for (j = i; j < end; j++)
+		{
+			fence_xy[j] = fence_to_local(&fence.points[j]);
+		}
+		zones[zone_count].first = i;
+		zones[zone_count].count = end - i;
+		zones[zone_count].exclusion = (zone_count != 0);
+		used = index_zone(&zones[zone_count], used);
+		zone_count++;
+		i = end + 1;
+	}
+	next_zone = 0;
+	zone_breaches = 0;
+	index_valid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Checks
+
+// Whether the edge e is crossed by a ray from the point towards +x. The
+// crossing is compared by cross multiplication, to avoid a division.
+static boolean edge_crosses(const struct fence_zone* z, uint8_t e, int16_t px, int16_t py)
+{
+	const vect2_16t* a;
+	const vect2_16t* b;
+	int32_t lhs;
+	int32_t rhs;
+
+	edge_vertices(z, e, &a, &b);
+	if ((a->y > py) == (b->y > py))
+	{
+		return false;
+	}
+	lhs = __builtin_mulss(px - a->x, b->y - a->y);
+	rhs = __builtin_mulss(py - a->y, b->x - a->x);
+	return (b->y > a->y) ? (lhs < rhs) : (lhs > rhs);
+}
+
+static boolean inside_zone(const struct fence_zone* z, int16_t px, int16_t py)
+{
+	boolean inside = false;
+	uint16_t k;
+	uint16_t end;
+	uint8_t s;
+	uint8_t e;
+
+	if (px < z->min_x || px > z->max_x || py < z->min_y || py > z->max_y)
+	{
+		return false;
+	}
+	if (z->strip_height == 0)
+	{
+		for (e = 0; e < z->count; e++)
+		{
+			inside ^= edge_crosses(z, e, px, py);
+		}
+		return inside;
+	}
+	s = (py - z->min_y) / z->strip_height;
+	end = z->strip_start[s + 1];
+	for (k = z->strip_start[s]; k < end; k++)
+	{
+		inside ^= edge_crosses(z, strip_edges[k], px, py);
+	}
+	return inside;
+}
+
+static void set_breach(uint8_t breach_type)
+{
+	if (breach_type != GEOFENCE_BREACH_NONE)
+	{
+		if (!status.breached)
+		{
+			status.breached = true;
+			status.breach_count++;
+			status.breach_time = frame_counter * 25;
+			if (geofence_action != GEOFENCE_ACTION_REPORT)
+			{
+				rtl_request = true;
+			}
+			DPRINT("geofence: breach %u\r\n", breach_type);
+		}
+		status.breach_type = breach_type;
+	}
+	else if (status.breached)
+	{
+		status.breached = false;
+		rtl_request = false;
+	}
+}
+
+// Called once a frame, at 40Hz. The altitude limits and one zone are checked
+// at the aircraft's position, and at where it will be GEOFENCE_LOOKAHEAD
+// seconds from now at its present velocity. The zones are checked in turn, so
+// that the work in a frame depends only on the number of edges in a strip.
+void geofence_update(void)
+{
+	int16_t x, y, z;
+	int16_t px, py, pz;
+	uint8_t breach_type = GEOFENCE_BREACH_NONE;
+	uint8_t bit;
+	boolean out;
+
+	frame_counter++;
+	geofence_storage_service();
+	if (commit_pending && !storage_busy())
+	{
+		commit_staged();
+	}
+	if (geofence_action == GEOFENCE_ACTION_NONE || !origin_valid || !dcm_flags._.dead_reckon_enable)
+	{
+		set_breach(GEOFENCE_BREACH_NONE);
+		return;
+	}
+	if (!index_valid)
+	{
+		build_index();
+		return;
+	}
+
+	x = clamp_range(IMUlocationx._.W1);
+	y = clamp_range(IMUlocationy._.W1);
+	z = IMUlocationz._.W1;
+	px = clamp_range(x + __builtin_mulss(IMUvelocityx._.W1, GEOFENCE_LOOKAHEAD) / 100);
+	py = clamp_range(y + __builtin_mulss(IMUvelocityy._.W1, GEOFENCE_LOOKAHEAD) / 100);
+	pz = clamp_range(z + __builtin_mulss(IMUvelocityz._.W1, GEOFENCE_LOOKAHEAD) / 100);
+
+	if (zone_count != 0)
+	{
+		if (next_zone >= zone_count)
+		{
+			next_zone = 0;
+		}
+		if (zones[next_zone].exclusion)
+		{
+			out = inside_zone(&zones[next_zone], x, y) || inside_zone(&zones[next_zone], px, py);
+		}
+		else
+		{
+			out = !inside_zone(&zones[next_zone], x, y) || !inside_zone(&zones[next_zone], px, py);
+		}
+		bit = 1 << next_zone;
+		zone_breaches = out ? (zone_breaches | bit) : (zone_breaches & ~bit);
+		next_zone++;
+	}
+
+	// The floor is only enforced once the aircraft has climbed above it
+	if (geofence_min_alt > 0)
+	{
+		if (!floor_armed)
+		{
+			floor_armed = (z > geofence_min_alt);
+		}
+		else if (z < geofence_min_alt || pz < geofence_min_alt)
+		{
+			breach_type = GEOFENCE_BREACH_MINALT;
+		}
+	}
+	if (geofence_max_alt > 0 && (z > geofence_max_alt || pz > geofence_max_alt))
+	{
+		breach_type = GEOFENCE_BREACH_MAXALT;
+	}
+	if (zone_breaches != 0)
+	{
+		breach_type = GEOFENCE_BREACH_BOUNDARY;
+	}
+	set_breach(breach_type);
+}
+
+#else
+
+void geofence_origin_changed(void)
+{
+}
+
+void geofence_update(void)
+{
+}
+
+#endif // USE_GEOFENCE
@@ -0,0 +1,72 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef _GEOFENCE_H_
+#define _GEOFENCE_H_
+
+
+// Actions on a breach, the values of MAVLink's FENCE_ACTION. Any action other
+// than none or report returns to launch.
+#define GEOFENCE_ACTION_NONE        0
+#define GEOFENCE_ACTION_REPORT      2
+#define GEOFENCE_ACTION_RTL         4
+
+// Breach types, the values of MAVLink's FENCE_BREACH
+#define GEOFENCE_BREACH_NONE        0
+#define GEOFENCE_BREACH_MINALT      1
+#define GEOFENCE_BREACH_MAXALT      2
+#define GEOFENCE_BREACH_BOUNDARY    3
+
+struct geofence_status {
+	boolean  breached;          // the aircraft is, or soon will be, outside the fence
+	uint8_t  breach_type;       // of the last breach
+	uint16_t breach_count;
+	uint32_t breach_time;       // of the last breach, in milliseconds since the fence started
+};
+
+// Parameters: the action on a breach, the number of fence points expected in
+// an upload, and the altitude floor and ceiling in meters above the origin,
+// which are not enforced when 0.
+extern int16_t geofence_action;
+extern int16_t geofence_total;
+extern int16_t geofence_min_alt;
+extern int16_t geofence_max_alt;
+
+void geofence_origin_changed(void);
+void geofence_update(void);
+
+// True once when a breach begins whose action is to return to launch
+boolean geofence_take_rtl_request(void);
+void geofence_get_status(struct geofence_status* status);
+
+// Fence points, in the order of the MAVLink fence protocol. Point 0 is the
+// return point, which is kept but not used as MatrixPilot returns to its
+// origin. The rest are the vertices of the zones, each zone closed by
+// repeating its first vertex. The first zone is the one to stay inside, and
+// any others are zones to stay out of. Latitudes and longitudes are in
+// degrees * 10^7. An upload of count points replaces the fence once all of
+// them have arrived.
+boolean geofence_set_point(uint8_t idx, uint8_t count, int32_t lat, int32_t lon);
+boolean geofence_get_point(uint8_t idx, int32_t* lat, int32_t* lon);
+uint8_t geofence_point_count(void);
+
+
+#endif // _GEOFENCE_H_
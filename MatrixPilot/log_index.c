@@ -0,0 +1,348 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#include "defines.h"
+#include "log_index.h"
+#include "../libDCM/gpsData.h"
+#include "../libDCM/gpsParseCommon.h"
+#if (WIN == 1 || NIX == 1 || PX4 == 1)
+#include "../Tools/MatrixPilot-SIL/SIL-filesystem.h"
+#else
+#include "MDD-File-System/FSIO.h"
+#endif
+#include "../libFlashFS/filesys.h"
+#include <string.h>
+#include <stdio.h>
+
+#define LOG_INDEX_MAGIC1    'L'
+#define LOG_INDEX_MAGIC2    'X'
+#define LOG_INDEX_VERSION   1
+
+// The index file is this header followed by count entries, oldest first.
+// The checksum covers the header, with checksum zero, and the entries.
+typedef struct log_index_header {
+	uint8_t  magic1;
+	uint8_t  magic2;
+	uint8_t  version;
+	uint8_t  count;
+	uint16_t next_seq;              // the sequence number of the next log
+	uint16_t checksum;
+	uint32_t used;                  // bytes held by the logs in the index
+} log_index_header_t;
+
+static log_index_header_t header;
+static log_index_entry_t entries[TELELOG_MAX_FILES];
+static boolean index_ok = false;
+static char next_name[13];
+
+
+static void log_name(char* name, uint16_t seq)
+{
+	sprintf(name, "log%05u.txt", seq);
+}
+
+// True if log a is newer than log b. The sequence numbers wrap, so this holds
+// as long as the logs on the card are within 32767 of each other.
+static boolean seq_after(uint16_t a, uint16_t b)
+{
+	return (int16_t)(a - b) > 0;
+}
+
+static void index_reset(void)
+{
+	memset(&header, 0, sizeof(header));
+	header.magic1 = LOG_INDEX_MAGIC1;
+	header.magic2 = LOG_INDEX_MAGIC2;
+	header.version = LOG_INDEX_VERSION;
+}
+
+// Fletcher-16, enough to catch an index left half written by a power loss
+static uint16_t index_checksum(void)
+{
+	log_index_header_t h = header;
+	const uint8_t* p;
+	uint16_t sum1 = 0;
+	uint16_t sum2 = 0;
+	uint16_t i;
+
+	h.checksum = 0;
+	for (p = (const uint8_t*)&h, i = 0; i < sizeof(h); i++)
+	{
+		sum1 = (sum1 + p[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	for (p = (const uint8_t*)entries, i = 0; i < header.count * sizeof(log_index_entry_t); i++)
+	{
+		sum1 = (sum1 + p[i]) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return (sum2 << 8) | sum1;
+}
+
+static boolean index_load(void)
+{
+	FSFILE* fp;
+	boolean ok = false;
+
+	fp = FSfopen(LOG_INDEX_FILE, FS_READ);
+	if (fp == NULL)
+	{
+		return false;
+	}
+	if (FSfread(&header, sizeof(header), 1, fp) == 1 &&
+	    header.magic1 == LOG_INDEX_MAGIC1 && header.magic2 == LOG_INDEX_MAGIC2 &&
+	    header.version == LOG_INDEX_VERSION && header.count <= TELELOG_MAX_FILES &&
+	    (header.count == 0 || FSfread(entries, sizeof(log_index_entry_t), header.count, fp) == header.count))
+	{
+		ok = (header.checksum == index_checksum());
+	}
+	FSfclose(fp);
+	if (!ok)
+	{
+		index_reset();  // never leave a count from a corrupt index in the header
+	}
+	return ok;
+}
+
+static boolean index_save(void)
+{
+	FSFILE* fp;
+	boolean ok;
+
+	header.checksum = index_checksum();
+	fp = FSfopen(LOG_INDEX_FILE, FS_WRITE);
+	if (fp == NULL)
+	{
+		return false;
+	}
+	ok = (FSfwrite(&header, sizeof(header), 1, fp) == 1 &&
+	      (header.count == 0 || FSfwrite(entries, sizeof(log_index_entry_t), header.count, fp) == header.count));
+	filesys_fclose(fp);
+	return ok;
+}
+
+// the sequence number of a log named log<5 digits>.txt, in either case, or -1
+static int32_t log_seq_of(const char* name)
+{
+	int32_t seq = 0;
+	int16_t i;
+
+	if (strlen(name) != 12 ||
+	    (name[0] | 0x20) != 'l' || (name[1] | 0x20) != 'o' || (name[2] | 0x20) != 'g' ||
+	    name[8] != '.' || (name[9] | 0x20) != 't' || (name[10] | 0x20) != 'x' || (name[11] | 0x20) != 't')
+	{
+		return -1;
+	}
+	for (i = 3; i < 8; i++)
+	{
+		if (name[i] < '0' || name[i] > '9') return -1;
+		seq = seq * 10 + (name[i] - '0');
+	}
+	return (seq <= 0xFFFF) ? seq : -1;
+}
+
+// Rebuild the index from the logs on the file system, keeping the newest
+// TELELOG_MAX_FILES of them in order. Any older logs are left alone.
+static void index_rebuild(void)
+{
+	SearchRec rec;
+	log_index_entry_t e;
+	int32_t seq;
+	int16_t i;
+	uint16_t skipped = 0;
+
+	index_reset();
+	if (FindFirst("log*.txt", ATTR_MASK, &rec) != 0)
+	{
+		return;
+	}
+	do {
+		if (rec.attributes & (ATTR_DIRECTORY | ATTR_VOLUME))
+		{
+			continue;
+		}
+		seq = log_seq_of(rec.filename);
+		if (seq < 0)
+		{
+			continue;
+		}
+		if (header.count == TELELOG_MAX_FILES)
+		{
+			skipped++;
+			if (seq_after(entries[0].seq, (uint16_t)seq))
+			{
+				continue;
+			}
+			header.used -= entries[0].size;
+			memmove(&entries[0], &entries[1], (TELELOG_MAX_FILES - 1) * sizeof(log_index_entry_t));
+			header.count--;
+		}
+		memset(&e, 0, sizeof(e));
+		e.seq = (uint16_t)seq;
+		e.size = rec.filesize;
+		for (i = header.count; i > 0 && seq_after(entries[i - 1].seq, e.seq); i--)
+		{
+			entries[i] = entries[i - 1];
+		}
+		entries[i] = e;
+		header.count++;
+		header.used += e.size;
+	} while (FindNext(&rec) == 0);
+	if (header.count > 0)
+	{
+		header.next_seq = entries[header.count - 1].seq + 1;
+	}
+	DPRINT("log index rebuilt, %u logs, %u older logs not indexed\r\n", header.count, skipped);
+}
+
+// A log opened after the index was last saved, and never closed, as the
+// power was lost in flight, is taken into the index with the size it has.
+static void index_adopt(void)
+{
+	log_index_entry_t* e;
+	FSFILE* fp;
+	char name[13];
+
+	if (header.count == TELELOG_MAX_FILES)
+	{
+		return;
+	}
+	log_name(name, header.next_seq);
+	fp = FSfopen(name, FS_READ);
+	if (fp == NULL)
+	{
+		return;
+	}
+	e = &entries[header.count++];
+	memset(e, 0, sizeof(*e));
+	e->seq = header.next_seq++;
+	if (FSfseek(fp, 0, SEEK_END) == 0)
+	{
+		e->size = FSftell(fp);
+		header.used += e->size;
+	}
+	FSfclose(fp);
+	DPRINT("%s was not closed, %lu bytes\r\n", name, (unsigned long)e->size);
+}
+
+// Remove the oldest logs until there is room for the next one in the index,
+// and those left fit the space allowed. The newest log is always kept.
+static void index_recycle(void)
+{
+	char name[13];
+
+	while (header.count > 1 &&
+	       (header.count >= TELELOG_MAX_FILES || header.used > TELELOG_SPACE_KB * 1024UL))
+	{
+		log_name(name, entries[0].seq);
+		filesys_remove(name);
+		DPRINT("%s recycled\r\n", name);
+		header.used -= entries[0].size;
+		header.count--;
+		memmove(&entries[0], &entries[1], header.count * sizeof(log_index_entry_t));
+	}
+}
+
+boolean log_index_init(void)
+{
+	if (!index_load())
+	{
+		index_rebuild();
+	}
+	index_adopt();
+	index_recycle();
+	log_name(next_name, header.next_seq);
+	index_ok = index_save();
+	if (!index_ok)
+	{
+		DPRINT("ERROR: %s could not be saved\r\n", LOG_INDEX_FILE);
+	}
+	return index_ok;
+}
+
+const char* log_index_next_name(void)
+{
+	if (next_name[0] == '\0')
+	{
+		log_name(next_name, header.next_seq);
+	}
+	return next_name;
+}
+
+// The index is not saved here, so opening a log costs no more file access.
+// The saved index still names this log as the next one, so if it is never
+// closed index_adopt() finds it.
+void log_index_opened(void)
+{
+	log_index_entry_t* e;
+
+	if (index_ok && header.count < TELELOG_MAX_FILES)
+	{
+		e = &entries[header.count++];
+		e->seq = header.next_seq;
+		e->size = 0;
+		if (gps_nav_valid())
+		{
+			e->week = week_no.BB;
+			e->tow = tow.WW;
+		}
+		else
+		{
+			e->week = 0;
+			e->tow = 0;
+		}
+	}
+	header.next_seq++;
+	log_name(next_name, header.next_seq);
+}
+
+void log_index_closed(uint32_t size)
+{
+	if (!index_ok || header.count == 0)
+	{
+		return;
+	}
+	entries[header.count - 1].size = size;
+	header.used += size;
+	index_recycle();
+	if (!index_save())
+	{
+		DPRINT("ERROR: %s could not be saved\r\n", LOG_INDEX_FILE);
+	}
+}
+
+uint8_t log_index_count(void)
+{
+	return header.count;
+}
+
+const log_index_entry_t* log_index_entry(uint8_t i)
+{
+	return (i < header.count) ? &entries[i] : NULL;
+}
+
+uint32_t log_index_free_bytes(void)
+{
+	uint32_t budget = TELELOG_SPACE_KB * 1024UL;
+
+	return (header.used < budget) ? budget - header.used : 0;
+}
@@ -0,0 +1,74 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+// Index of the telemetry logs on the file system.
+//
+// The logs are named log<seq>.txt, from a sequence number kept in the index
+// file LOG_INDEX_FILE together with the size and GPS time of each log. The
+// index is loaded, and the name of the next log reserved, by log_index_init()
+// at background priority well before the aircraft is armed, so opening a log
+// needs no search of the file system. When a log is closed the oldest logs
+// are removed until no more than TELELOG_MAX_FILES - 1 remain, using no more
+// than TELELOG_SPACE_KB between them.
+//
+// If the index is missing or damaged it is rebuilt once from the logs found
+// on the file system.
+
+#ifndef TELELOG_MAX_FILES
+#define TELELOG_MAX_FILES 20
+#endif
+
+#ifndef TELELOG_SPACE_KB
+#define TELELOG_SPACE_KB 65536UL
+#endif
+
+#define LOG_INDEX_FILE "logindex.dat"
+
+typedef struct log_index_entry {
+	uint16_t seq;                   // the log is log<seq>.txt
+	uint16_t week;                  // GPS week and time of week when the log was opened,
+	uint32_t tow;                   // both 0 if it was opened without a GPS fix
+	uint32_t size;                  // bytes, once the log has been closed
+} log_index_entry_t;
+
+// Load the index, and reserve the name of the next log. Returns false if the
+// file system could not be used, when logs are still named in sequence but
+// never removed.
+boolean log_index_init(void);
+
+// the name reserved for the next log, which log_index_opened() takes into use
+const char* log_index_next_name(void);
+void log_index_opened(void);
+
+// record the size of the log just closed, recycle the oldest logs as needed,
+// reserve the next name and save the index
+void log_index_closed(uint32_t size);
+
+// the logs held, oldest first, and the bytes left of TELELOG_SPACE_KB
+uint8_t log_index_count(void);
+const log_index_entry_t* log_index_entry(uint8_t i);
+uint32_t log_index_free_bytes(void);
+
+#endif // LOG_INDEX_H
@@ -46,12 +46,18 @@
 #include "options_mavlink.h"
 #include <setjmp.h>
 
-//#include "../libFlashFS/filesys.h"
+#if (USE_FILESYS == 1)
+#include "../libFlashFS/filesys.h"
+#endif
 
 #if (USE_TELELOG == 1)
 #include "telemetry_log.h"
 #endif
 
+#if (USE_MAVLINK == 1)
+#include "../MAVLink/MAVFTP.h"
+#endif
+
 #if (USE_USB == 1)
 #include "preflight.h"
 #endif
@@ -99,6 +105,12 @@ int matrixpilot_loop(void)
 #if (USE_TELELOG == 1)
 	telemetry_log();
 #endif
+#if (USE_FILESYS == 1)
+	filesys_service();
+#endif
+#if (USE_MAVLINK == 1 && MAVLINK_FTP == 1)
+	MAVFTPService();
+#endif
 #if (USE_USB == 1)
 	USBPollingService();
 #endif
@@ -12,14 +12,15 @@
 #define INI_BUFFERSIZE  256				// maximum line length, maximum path length 
 
 #include "MDD-File-System/FSIO.h"
+#include "../libFlashFS/filesys.h"
 #include <string.h>
 
 #define INI_FILETYPE					FSFILE*
 #define ini_openread(filename,file)		((*(file) = FSfopen((filename), FS_READ)) != NULL)
 #define ini_openwrite(filename,file)	((*(file) = FSfopen((filename), FS_WRITE)) != NULL)
-#define ini_close(file)					(FSfclose(*(file)) == 0)
+#define ini_close(file)					(filesys_fclose(*(file)) == 0)
 #define ini_write(buffer,file)			(FSfwrite((buffer), 1, strlen(buffer), (*file)) > 0)
-#define ini_remove(filename)			(FSremove((filename)) == 0)
+#define ini_remove(filename)			(filesys_remove((filename)) == 0)
 
 #define INI_FILEPOS						long
 #define ini_tell(file,pos)				(*(pos) = FSftell(*(file)))
@@ -52,7 +53,7 @@ static int ini_rename(const char *source, const char *dest)
 {
   FSFILE* ftmp = FSfopen((source), FS_READ);
   FSrename((dest), ftmp);
-  return FSfclose(ftmp) == 0;
+  return filesys_fclose(ftmp) == 0;
 }
 #endif
 
@@ -770,6 +770,152 @@ int ini_puts(const TCHAR *Section, const TCHAR *Key, const TCHAR *Value, const T
   return close_rename(&rfp, &wfp, Filename, LocalBuffer);  /* clean up and rename */
 }
 
+#if !defined INI_NOBATCH
+/* the settings of a batch are identified by their index, while the callback
+ * names them; return the index of the first setting in Section (and named Key,
+ * unless Key is NULL), skipping those already written if Written is not NULL
+ */
+static int batch_find(INI_BATCHCALLBACK Callback, const void *UserData,
+                      const TCHAR *Section, int lenSec, const TCHAR *Key, int lenKey,
+                      const unsigned char *Written)
+{
+  const TCHAR *s, *k;
+  int idx;
+
+  for (idx = 0; idx < INI_BATCHSIZE && Callback(idx, &s, &k, NULL, 0, UserData); idx++) {
+    if (k == NULL || (Written != NULL && (Written[idx >> 3] & (1 << (idx & 7))) != 0))
+      continue;
+    if ((int)_tcslen(s) != lenSec || _tcsnicmp(s, Section, lenSec) != 0)
+      continue;
+    if (Key == NULL || ((int)_tcslen(k) == lenKey && _tcsnicmp(k, Key, lenKey) == 0))
+      return idx;
+  } /* for */
+  return -1;
+}
+
+static void batch_write(INI_BATCHCALLBACK Callback, const void *UserData, int idx,
+                        unsigned char *Written, TCHAR *LocalBuffer, INI_FILETYPE *fp)
+{
+  const TCHAR *s, *k;
+  static TCHAR Value[INI_BATCHVALUESIZE];  /* not on the stack next to LocalBuffer, see save_strncpy() */
+
+  Value[0] = '\0';
+  (void)Callback(idx, &s, &k, Value, sizearray(Value), UserData);
+  writekey(LocalBuffer, k, Value, fp);
+  Written[idx >> 3] |= (unsigned char)(1 << (idx & 7));
+}
+
+/* write the settings of a section which have not been written yet */
+static void batch_flush(INI_BATCHCALLBACK Callback, const void *UserData, const TCHAR *Section,
+                        unsigned char *Written, TCHAR *LocalBuffer, INI_FILETYPE *fp)
+{
+  int idx;
+
+  while ((idx = batch_find(Callback, UserData, Section, _tcslen(Section), NULL, 0, Written)) >= 0)
+    batch_write(Callback, UserData, idx, Written, LocalBuffer, fp);
+}
+
+/** ini_putbatch()
+ * \param Callback    a pointer to a function that names each setting of the
+ *                    batch, by index, and formats its value
+ * \param UserData    arbitrary data, which the function passes on the the
+ *                    \c Callback function
+ * \param Filename    the name and full path of the .ini file to write to
+ *
+ * \return            1 if successful, otherwise 0
+ *
+ * \note              Writes every setting of the batch with a single rewrite
+ *                    of the INI file, where ini_puts() rewrites it for each
+ *                    setting. Settings already in the file are replaced in
+ *                    place, those which are not are added to the end of their
+ *                    section, and the other lines are kept as they are.
+ *                    The \c Callback function sets the section and key names
+ *                    of the setting at Index, and returns 1, or returns 0 if
+ *                    there is no such setting; a NULL key skips the setting.
+ *                    It formats the value into Value only if Value is not NULL.
+ *                    At most INI_BATCHSIZE settings are written.
+ */
+int ini_putbatch(INI_BATCHCALLBACK Callback, const void *UserData, const TCHAR *Filename)
+{
+  INI_FILETYPE rfp;
+  INI_FILETYPE wfp;
+  INI_FILEPOS mark;
+  TCHAR *sp, *ep;
+  TCHAR LocalBuffer[INI_BUFFERSIZE];
+  unsigned char Written[(INI_BATCHSIZE + 7) / 8];
+  const TCHAR *section = __T("");  /* keys above the first section */
+  const TCHAR *s, *k;
+  int idx, reading, eol = 1;
+
+  assert(Filename != NULL);
+  if (Callback == NULL)
+    return 0;
+  memset(Written, 0, sizeof(Written));
+  ini_tempname(LocalBuffer, Filename, INI_BUFFERSIZE);
+  if (!ini_openwrite(LocalBuffer, &wfp))
+    return 0;
+  reading = ini_openread(Filename, &rfp);
+
+  /* Copy the file, replacing the values of the settings in the batch, and
+   * adding those missing from a section where the section ends. The section
+   * name points into the batch, or is NULL for a section the batch does not use.
+   */
+  while (reading) {
+    (void)ini_tell(&rfp, &mark);
+    if (!ini_read(LocalBuffer, INI_BUFFERSIZE, &rfp))
+      break;
+    sp = skipleading(LocalBuffer);
+    ep = _tcschr(sp, ']');
+    if (*sp == '[' && ep != NULL) {
+      if (section != NULL && batch_find(Callback, UserData, section, _tcslen(section), NULL, 0, Written) >= 0) {
+        batch_flush(Callback, UserData, section, Written, LocalBuffer, &wfp);
+        (void)ini_seek(&rfp, &mark);  /* read the section heading again, as writekey() destroyed it */
+        (void)ini_read(LocalBuffer, INI_BUFFERSIZE, &rfp);
+        sp = skipleading(LocalBuffer);
+        ep = _tcschr(sp, ']');
+      } /* if */
+      idx = batch_find(Callback, UserData, sp + 1, (int)(ep - sp - 1), NULL, 0, NULL);
+      section = NULL;
+      if (idx >= 0)
+        (void)Callback(idx, &section, &k, NULL, 0, UserData);
+    } else if (section != NULL && *sp != ';' && *sp != '#') {
+      ep = _tcschr(sp, '=');
+      if (ep == NULL)
+        ep = _tcschr(sp, ':');
+      if (ep != NULL) {
+        idx = batch_find(Callback, UserData, section, _tcslen(section), sp, (int)(skiptrailing(ep, sp) - sp), Written);
+        if (idx >= 0) {
+          batch_write(Callback, UserData, idx, Written, LocalBuffer, &wfp);
+          eol = 1;
+          continue;
+        } /* if */
+      } /* if */
+    } /* if */
+    (void)ini_write(LocalBuffer, &wfp);
+    eol = (_tcschr(LocalBuffer, '\n') != NULL);
+  } /* while */
+  if (section != NULL)
+    batch_flush(Callback, UserData, section, Written, LocalBuffer, &wfp);
+
+  /* Add the sections which were not in the file */
+  for (idx = 0; idx < INI_BATCHSIZE && Callback(idx, &s, &k, NULL, 0, UserData); idx++) {
+    if (k == NULL || (Written[idx >> 3] & (1 << (idx & 7))) != 0)
+      continue;
+    if (!eol)
+      (void)ini_write(INI_LINETERM, &wfp);  /* force a new line behind the last line of the INI file */
+    eol = 1;
+    writesection(LocalBuffer, s, &wfp);
+    batch_flush(Callback, UserData, s, Written, LocalBuffer, &wfp);
+  } /* for */
+
+  if (reading)
+    return close_rename(&rfp, &wfp, Filename, LocalBuffer);  /* clean up and rename */
+  (void)ini_close(&wfp);
+  ini_tempname(LocalBuffer, Filename, INI_BUFFERSIZE);
+  return ini_rename(LocalBuffer, Filename);
+}
+#endif /* INI_NOBATCH */
+
 /* Ansi C "itoa" based on Kernighan & Ritchie's "Ansi C" book. */
 #define ABS(v)  ((v) < 0 ? -(v) : (v))
 
@@ -30,6 +30,12 @@
 #if !defined INI_BUFFERSIZE
   #define INI_BUFFERSIZE  512
 #endif
+#if !defined INI_BATCHSIZE
+  #define INI_BATCHSIZE       128   /* most settings written by one ini_putbatch() */
+#endif
+#if !defined INI_BATCHVALUESIZE
+  #define INI_BATCHVALUESIZE  32    /* longest value written by ini_putbatch() */
+#endif
 
 #if defined __cplusplus
   extern "C" {
@@ -51,6 +57,10 @@ int   ini_puts(const mTCHAR *Section, const mTCHAR *Key, const mTCHAR *Value, co
 #if defined INI_REAL
 int   ini_putf(const mTCHAR *Section, const mTCHAR *Key, INI_REAL Value, const mTCHAR *Filename);
 #endif
+#if !defined INI_NOBATCH
+typedef int (*INI_BATCHCALLBACK)(int Index, const mTCHAR **Section, const mTCHAR **Key, mTCHAR *Value, int ValueSize, const void *UserData);
+int   ini_putbatch(INI_BATCHCALLBACK Callback, const void *UserData, const mTCHAR *Filename);
+#endif /* INI_NOBATCH */
 #endif /* INI_READONLY */
 
 #if !defined INI_NOBROWSE
@@ -28,6 +28,9 @@
 #include "states.h"
 #include "flightplan.h"
 #include "flightplan_waypoints.h"
+#include "profile.h"
+#include "gainSchedule.h"
+#include "geofence.h"
 #include "../libUDB/libUDB.h"
 #include "../libDCM/gpsParseCommon.h"
 #include "../libDCM/deadReckoning.h"
@@ -56,19 +59,7 @@ int16_t progress_to_goal = 0;
 int8_t desired_dir = 0;
 int8_t extended_range = 0;
 
-
-struct waypointparameters {
-	int16_t x;
-	int16_t y;
-	int16_t cosphi;
-	int16_t sinphi;
-	int8_t  phi;
-	int16_t height;
-	int16_t fromHeight;
-	int16_t legDist;
-};
-
-static struct waypointparameters navgoal;
+static struct navLegDef navgoal;
 static int16_t desired_bearing_over_ground_vector[2];
 
 struct relative2D togoal = { 0, 0 };
@@ -110,6 +101,8 @@ static void setup_origin(void)
 	{
 		dcm_set_origin_location(lon_gps.WW, lat_gps.WW, alt_sl_gps.WW);
 	}
+	flightplan_waypoints_origin_changed();
+	geofence_origin_changed();
 	state_flags._.f13_print_req = 1; // Flag telemetry output that the origin can now be printed.
 }
 
@@ -136,10 +129,13 @@ void dcm_callback_gps_location_updated(void)
 // the interrupt handler will simply skip some of the navigation passes.
 }
 
+// Compute the geometry of the leg from fromPoint to toPoint, without making
+// it the current goal. The flight plan uses this to work out its legs once,
+// when it is loaded, and navigate_set_leg() to fly each of them.
 #ifdef USE_EXTENDED_NAV
-void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+void navigate_compute_leg(struct navLegDef* leg, struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
 #else
-void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+void navigate_compute_leg(struct navLegDef* leg, struct relative3D fromPoint, struct relative3D toPoint)
 #endif // USE_EXTENDED_NAV
 {
 	struct relative2D courseLeg;
@@ -179,18 +175,20 @@ void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
 		toPoint.y = fromPoint.y + from_to_y.WW;
 		toPoint.z = fromPoint.z + from_to_z;
 
-		extended_range = 1;
+		leg->extended_range = 1;
 	}
 	else
 	{
-		extended_range = 0;
+		leg->extended_range = 0;
 	}
+#else
+	leg->extended_range = 0;
 #endif // USE_EXTENDED_NAV
 
-	navgoal.x = toPoint.x;
-	navgoal.y = toPoint.y;
-	navgoal.height = toPoint.z;
-	navgoal.fromHeight = fromPoint.z;
+	leg->x = toPoint.x;
+	leg->y = toPoint.y;
+	leg->height = toPoint.z;
+	leg->fromHeight = fromPoint.z;
 
 	courseLeg.x = toPoint.x - fromPoint.x;
 	courseLeg.y = toPoint.y - fromPoint.y;
@@ -203,17 +201,31 @@ void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
 //  an angle, and also the leg distance is required.
 //  But leg distance is produced as a by product of vector2_normalize.
 //  TODO: revise the following two lines.
-	navgoal.phi = rect_to_polar(&courseLeg); // binary angle (0 - 256 = 360 degrees)
-	navgoal.legDist = courseLeg.x;
+	leg->phi = rect_to_polar(&courseLeg); // binary angle (0 - 256 = 360 degrees)
+	leg->legDist = courseLeg.x;
 
-//struct waypointparameters { int16_t x; int16_t y; int16_t cosphi; int16_t sinphi; int8_t phi; int16_t height; int16_t fromHeight; int16_t legDist; };
-//extern struct waypointparameters navgoal;
-//	DPRINT("navigate_set_goal(..) x %i y %i phi %i height %i dist %i\r\n", navgoal.x, navgoal.y, navgoal.phi, navgoal.height, navgoal.legDist);
+//	DPRINT("navigate_compute_leg(..) x %i y %i phi %i height %i dist %i\r\n", leg->x, leg->y, leg->phi, leg->height, leg->legDist);
 
 //  New method for computing cosine and sine of course direction
 	vector2_normalize(&courseDirection[0], &courseDirection[0]);
-	navgoal.cosphi = courseDirection[0];
-	navgoal.sinphi = courseDirection[1];
+	leg->cosphi = courseDirection[0];
+	leg->sinphi = courseDirection[1];
+}
+
+void navigate_set_leg(const struct navLegDef* leg)
+{
+	navgoal = *leg;
+	extended_range = leg->extended_range;
+}
+
+#ifdef USE_EXTENDED_NAV
+void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+#else
+void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+#endif // USE_EXTENDED_NAV
+{
+	navigate_compute_leg(&navgoal, fromPoint, toPoint);
+	extended_range = navgoal.extended_range;
 }
 
 void navigate_set_goal_height(int16_t z)
@@ -223,10 +235,11 @@ void navigate_set_goal_height(int16_t z)
 
 void navigate_process_flightplan(void)
 {
+	flightplan_shadow_swap();
 	if (gps_nav_valid() && state_flags._.GPS_steering)
 	{
 		navigate_compute_bearing_to_goal();
-		flightplan_update(); // was called run_flightplan();
+		PROFILE(PROFILE_FLIGHTPLAN, flightplan_update()); // was called run_flightplan();
 		compute_camera_view();
 	}
 }
@@ -393,6 +406,177 @@ void navigate_compute_bearing_to_goal(void)
 	}
 }
 
+#if (TURN_ANTICIPATION == 1)
+
+#define TURN_LEAD_MIN_AIR_SPEED  500        // cm/sec, below this the turn is not worked out
+#define TURN_LEAD_MAX_ACCN       (4 * 981)  // cm/sec/sec, the limit of helicalTurnCntrl
+#define TURN_LEAD_MIN_ANGLE      364        // 2 degrees, as a 16 bit circular
+#define TURN_LEAD_PARALLEL       1430       // sine of 5 degrees, RMAX scaling
+#define RMAX_PI_2                25736      // pi / 2, RMAX scaling
+
+// The aircraft holds a leg with the heading which cancels the cross wind.
+// Returns the unit vector of that heading, and the ground speed along the leg,
+// which is zero or less if the leg can not be flown.
+static int16_t leg_air_heading(int16_t heading[2], const struct navLegDef* leg, int16_t air_speed)
+{
+	union longww accum;
+	int16_t along_wind;
+	int16_t cross_air;
+	int16_t along_air;
+
+	accum.WW = (__builtin_mulss(estimatedWind[0], leg->cosphi)
+	          + __builtin_mulss(estimatedWind[1], leg->sinphi)) << 2;
+	along_wind = accum._.W1;
+	accum.WW = (__builtin_mulss(estimatedWind[0], leg->sinphi)
+	          - __builtin_mulss(estimatedWind[1], leg->cosphi)) << 2;
+	cross_air = accum._.W1;
+	if (abs(cross_air) >= air_speed)
+	{
+		return 0;
+	}
+	along_air = sqrt_long(__builtin_mulss(air_speed, air_speed) - __builtin_mulss(cross_air, cross_air));
+	accum.WW = (__builtin_mulss(along_air, leg->cosphi) - __builtin_mulss(cross_air, leg->sinphi)) << 2;
+	heading[0] = accum._.W1;
+	accum.WW = (__builtin_mulss(along_air, leg->sinphi) + __builtin_mulss(cross_air, leg->cosphi)) << 2;
+	heading[1] = accum._.W1;
+	vector2_normalize(heading, heading);
+	return along_air + along_wind;
+}
+
+// Returns the distance short of the finish line of the current leg at which
+// to start the turn onto the next leg, so that the turn rolls out on the
+// track of the next leg, or -1 if the turn can not be worked out.
+//
+// The navigation turns at TURN_RATE_NAV, or less if that would need more
+// than 4g, until the heading is within 90 degrees of the one it wants, and
+// then at that rate times the sine of the heading error. With a turn radius
+// of R through the air, a heading change e0 and a crab angle t on the next
+// leg, the aircraft ends up this far across the track of the next leg:
+//   e0 up to 90 degrees:  R * (e0 cos(t) - 2 ln(cos(e0 / 2)) sin(t))
+//   beyond:               R * ((pi/2 - cos(e0)) cos(t) + (e0 - pi/2 + 1 - sin(e0) + ln(2)) sin(t))
+// and the turn starts where the current leg is that far from that track.
+int16_t navigate_turn_lead(const struct navLegDef* next)
+{
+	union longww accum;
+	struct relative2D turn;
+	int16_t heading[2][2];
+	int16_t air_speed;
+	uint32_t turn_rate;     // radians per second, RMAX scaling
+	uint16_t turn_angle;
+	int16_t turn_cos;
+	int16_t turn_sin;
+	int16_t crab_cos;
+	int16_t crab_sin;
+	int16_t cross_legs;
+	int16_t radius;
+	int32_t e0;             // radians, RMAX scaling
+	int32_t e2;
+	int32_t e4;
+	int32_t across;         // across the next track, in radii, RMAX scaling
+	int32_t tail;
+	int32_t lead;
+
+	air_speed = vector2_mag(IMUvelocityx._.W1 - estimatedWind[0],
+	                        IMUvelocityy._.W1 - estimatedWind[1]);
+	if (air_speed < TURN_LEAD_MIN_AIR_SPEED)
+	{
+		return -1;
+	}
+	turn_rate = (uint32_t)TURN_LEAD_MAX_ACCN * RMAX / air_speed;
+	if (turn_rate > scheduled_gain(turngainnav, GAIN_NAV))
+	{
+		turn_rate = scheduled_gain(turngainnav, GAIN_NAV);
+	}
+	if (turn_rate == 0 || __builtin_muluu(air_speed, 164) > turn_rate * TURN_LEAD_MAX_RADIUS)
+	{
+		return -1;
+	}
+	radius = __builtin_muluu(air_speed, 164) / turn_rate; // 164 is RMAX / 100
+
+	if (leg_air_heading(heading[0], &navgoal, air_speed) <= 0 ||
+	    leg_air_heading(heading[1], next, air_speed) <= 0)
+	{
+		return -1;
+	}
+	accum.WW = (__builtin_mulss(heading[0][0], heading[1][0])
+	          + __builtin_mulss(heading[0][1], heading[1][1])) << 2;
+	turn_cos = accum._.W1;
+	accum.WW = (__builtin_mulss(heading[0][0], heading[1][1])
+	          - __builtin_mulss(heading[0][1], heading[1][0])) << 2;
+	turn_sin = abs(accum._.W1);
+	turn.x = turn_cos;
+	turn.y = turn_sin;
+	turn_angle = (uint16_t)rect_to_polar16(&turn);
+	if (turn_angle < TURN_LEAD_MIN_ANGLE)
+	{
+		return 0;
+	}
+
+	// the crab angle on the next leg, positive into the turn, and the turn
+	// between the tracks, in the same sense
+	accum.WW = (__builtin_mulss(heading[1][0], next->cosphi)
+	          + __builtin_mulss(heading[1][1], next->sinphi)) << 2;
+	crab_cos = accum._.W1;
+	accum.WW = (__builtin_mulss(heading[1][1], next->cosphi)
+	          - __builtin_mulss(heading[1][0], next->sinphi)) << 2;
+	crab_sin = accum._.W1;
+	accum.WW = (__builtin_mulss(navgoal.cosphi, next->sinphi)
+	          - __builtin_mulss(navgoal.sinphi, next->cosphi)) << 2;
+	cross_legs = accum._.W1;
+	accum.WW = (__builtin_mulss(heading[0][0], heading[1][1])
+	          - __builtin_mulss(heading[0][1], heading[1][0]));
+	if (accum.WW < 0)
+	{
+		crab_sin = -crab_sin;
+		cross_legs = -cross_legs;
+	}
+
+	e0 = ((int32_t)turn_angle * 804) >> 9;  // pi / 2 is 804 / 512
+	if (e0 > RMAX_PI_2)
+	{
+		// turning at the full rate, until the heading is within 90 degrees
+		across = ((int32_t)(-turn_cos) * crab_cos
+		       + (e0 - RMAX_PI_2 + RMAX - turn_sin) * crab_sin) >> 14;
+		e0 = RMAX_PI_2;
+	}
+	else
+	{
+		across = 0;
+	}
+	// -2 ln(cos(e / 2)) is e^2/4 + e^4/96 + e^6/1440, to within 0.01 up to 90 degrees
+	e2 = (e0 * e0) >> 14;
+	e4 = (e2 * e2) >> 14;
+	tail = (e2 >> 2) + e4 / 96 + ((e4 * (e2 >> 2)) >> 12) / 1440;
+	tail = ((e0 * crab_cos) >> 14) + ((tail * crab_sin) >> 14);
+	across += tail;
+
+	if (cross_legs < TURN_LEAD_PARALLEL)
+	{
+		// a small turn between legs which are close to parallel, or a reversal
+		lead = (turn_angle < 16384) ? radius : TURN_LEAD_MAX_RADII * radius;
+	}
+	else
+	{
+		lead = (radius * across) / cross_legs;
+	}
+	// reversals are cut short
+	if (lead > TURN_LEAD_MAX_RADII * radius)
+	{
+		lead = TURN_LEAD_MAX_RADII * radius;
+	}
+	if (lead > navgoal.legDist)
+	{
+		lead = navgoal.legDist;
+	}
+	if (lead < 0)
+	{
+		lead = 0;
+	}
+	return (int16_t)lead;
+}
+
+#endif // TURN_ANTICIPATION
+
 uint16_t wind_gain_adjustment(void)
 {
 #if (WIND_GAIN_ADJUSTMENT == 1)
@@ -502,6 +686,7 @@ int16_t navigate_determine_deflection(char navType)
 	crossprod.WW = __builtin_mulss(actualX, desiredY) - __builtin_mulss(actualY, desiredX);
 	crossprod.WW = crossprod.WW << 2; // at this point, we have 1/4 of the cross product
 	                                  // cannot go any higher than that, could get overflow
+	yawkp = scheduled_gain(yawkp, GAIN_NAV);
 	if (dotprod._.W1 > 0)
 	{
 		deflectionAccum.WW = (__builtin_mulsu(crossprod._.W1, yawkp) << 1);
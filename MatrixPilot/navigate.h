@@ -28,18 +28,40 @@ extern int8_t desired_dir;
 extern uint16_t turngainfbw; // fly by wire turn gain
 extern uint16_t turngainnav; // waypoints turn gain
 
+// The geometry of a leg of the flight plan, as flown by the navigation
+struct navLegDef {
+	int16_t x;              // the goal
+	int16_t y;
+	int16_t cosphi;         // unit vector along the leg
+	int16_t sinphi;
+	int8_t  phi;            // direction of the leg, binary angle
+	int8_t  extended_range; // the goal is short of the waypoint, see USE_EXTENDED_NAV
+	int16_t height;         // height of the goal
+	int16_t fromHeight;     // height at the start of the leg
+	int16_t legDist;        // length of the leg
+};
+
 void init_navigation(void);
 void save_navigation(void);
 #ifdef USE_EXTENDED_NAV
 void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint);
+void navigate_compute_leg(struct navLegDef* leg, struct relative3D_32 fromPoint, struct relative3D_32 toPoint);
 #else
 void navigate_set_goal(struct relative3D fromPoint , struct relative3D toPoint);
+void navigate_compute_leg(struct navLegDef* leg, struct relative3D fromPoint, struct relative3D toPoint);
 #endif // USE_EXTENDED_NAV
+void navigate_set_leg(const struct navLegDef* leg);
 void navigate_set_goal_height(int16_t z);
 void navigate_compute_bearing_to_goal(void);
 void navigate_process_flightplan(void);
 int16_t navigate_determine_deflection(char navType);
 int16_t navigate_desired_height(void);
+#if (TURN_ANTICIPATION == 1)
+#define TURN_LEAD_MAX_RADIUS     4000       // meters
+#define TURN_LEAD_MAX_RADII      4          // the longest lead, in turn radii
+#define TURN_LEAD_MAX_DISTANCE   (TURN_LEAD_MAX_RADII * TURN_LEAD_MAX_RADIUS) // meters, no lead is longer
+int16_t navigate_turn_lead(const struct navLegDef* next);
+#endif
 
 // NEW STUFF:
 int16_t navigate_get_goal(vect3_16t* goal);
@@ -1,19 +1,249 @@
 // pyparam generated file - DO NOT EDIT
 
 
+#include "defines.h"
 #include "parameter_table.h"
 #include "data_services.h"
 
 #if(USE_NV_MEMORY == 1)
 
+#include "gain_variables.h"
+#include "../libUDB/magnetometer.h"
+#include "../libUDB/ADchannel.h"
+#include "altitudeCntrl.h"
+#include "airspeedCntrl.h"
+#include "config.h"
+#include "gainSchedule.h"
+#include "geofence.h"
+
+const data_services_item data_services_items[] = {
+	{ (uint8_t*)&rollkp, sizeof(rollkp) },
+	{ (uint8_t*)&rollkd, sizeof(rollkd) },
+	{ (uint8_t*)&yawkpail, sizeof(yawkpail) },
+	{ (uint8_t*)&yawkdail, sizeof(yawkdail) },
+	{ (uint8_t*)&pitchgain, sizeof(pitchgain) },
+	{ (uint8_t*)&pitchkd, sizeof(pitchkd) },
+	{ (uint8_t*)&rollkprud, sizeof(rollkprud) },
+	{ (uint8_t*)&yawkprud, sizeof(yawkprud) },
+	{ (uint8_t*)&yawkdrud, sizeof(yawkdrud) },
+	{ (uint8_t*)&rollkprud, sizeof(rollkprud) },
+	{ (uint8_t*)&rollkdrud, sizeof(rollkdrud) },
+
+	{ (uint8_t*)&rawMagCalib[0], sizeof(rawMagCalib[0]) },
+	{ (uint8_t*)&rawMagCalib[1], sizeof(rawMagCalib[1]) },
+	{ (uint8_t*)&rawMagCalib[2], sizeof(rawMagCalib[2]) },
+	{ (uint8_t*)&magGain[0], sizeof(magGain[0]) },
+	{ (uint8_t*)&magGain[1], sizeof(magGain[1]) },
+	{ (uint8_t*)&magGain[2], sizeof(magGain[2]) },
+	{ (uint8_t*)&udb_magOffset[0], sizeof(udb_magOffset[0]) },
+	{ (uint8_t*)&udb_magOffset[1], sizeof(udb_magOffset[1]) },
+	{ (uint8_t*)&udb_magOffset[2], sizeof(udb_magOffset[2]) },
+	{ (uint8_t*)&dcm_declination_angle.BB, sizeof(dcm_declination_angle.BB) },
+
+	{ (uint8_t*)&udb_pwTrim[AILERON_INPUT_CHANNEL], sizeof(udb_pwTrim[AILERON_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[ELEVATOR_INPUT_CHANNEL], sizeof(udb_pwTrim[ELEVATOR_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[RUDDER_INPUT_CHANNEL], sizeof(udb_pwTrim[RUDDER_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[AILERON_SECONDARY_INPUT_CHANNEL], sizeof(udb_pwTrim[AILERON_SECONDARY_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[ROLL_INPUT_CHANNEL], sizeof(udb_pwTrim[ROLL_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[PITCH_INPUT_CHANNEL], sizeof(udb_pwTrim[PITCH_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[THROTTLE_INPUT_CHANNEL], sizeof(udb_pwTrim[THROTTLE_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[YAW_INPUT_CHANNEL], sizeof(udb_pwTrim[YAW_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[FLAP_INPUT_CHANNEL], sizeof(udb_pwTrim[FLAP_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[BRAKE_INPUT_CHANNEL], sizeof(udb_pwTrim[BRAKE_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[SPOILER_INPUT_CHANNEL], sizeof(udb_pwTrim[SPOILER_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[CAMBER_INPUT_CHANNEL], sizeof(udb_pwTrim[CAMBER_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[CROW_INPUT_CHANNEL], sizeof(udb_pwTrim[CROW_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[CAMERA_PITCH_INPUT_CHANNEL], sizeof(udb_pwTrim[CAMERA_PITCH_INPUT_CHANNEL]) },
+	{ (uint8_t*)&udb_pwTrim[CAMERA_YAW_INPUT_CHANNEL], sizeof(udb_pwTrim[CAMERA_YAW_INPUT_CHANNEL]) },
+
+	{ (uint8_t*)&udb_xaccel.offset, sizeof(udb_xaccel.offset) },
+	{ (uint8_t*)&udb_yaccel.offset, sizeof(udb_yaccel.offset) },
+	{ (uint8_t*)&udb_zaccel.offset, sizeof(udb_zaccel.offset) },
+	{ (uint8_t*)&udb_xrate.offset, sizeof(udb_xrate.offset) },
+	{ (uint8_t*)&udb_yrate.offset, sizeof(udb_yrate.offset) },
+	{ (uint8_t*)&udb_zrate.offset, sizeof(udb_zrate.offset) },
+	{ (uint8_t*)&udb_vref.offset, sizeof(udb_vref.offset) },
+
+	{ (uint8_t*)&height_target_min, sizeof(height_target_min) },
+	{ (uint8_t*)&height_target_max, sizeof(height_target_max) },
+	{ (uint8_t*)&height_margin, sizeof(height_margin) },
+	{ (uint8_t*)&alt_hold_throttle_min, sizeof(alt_hold_throttle_min) },
+	{ (uint8_t*)&alt_hold_throttle_max, sizeof(alt_hold_throttle_max) },
+	{ (uint8_t*)&alt_hold_pitch_min, sizeof(alt_hold_pitch_min) },
+	{ (uint8_t*)&alt_hold_pitch_max, sizeof(alt_hold_pitch_max) },
+	{ (uint8_t*)&alt_hold_pitch_high, sizeof(alt_hold_pitch_high) },
+	{ (uint8_t*)&rtl_pitch_down, sizeof(rtl_pitch_down) },
+
+	{ (uint8_t*)&desiredSpeed, sizeof(desiredSpeed) },
+	{ (uint8_t*)&minimum_groundspeed, sizeof(minimum_groundspeed) },
+	{ (uint8_t*)&minimum_airspeed, sizeof(minimum_airspeed) },
+	{ (uint8_t*)&maximum_airspeed, sizeof(maximum_airspeed) },
+	{ (uint8_t*)&cruise_airspeed, sizeof(cruise_airspeed) },
+	{ (uint8_t*)&airspeed_pitch_min_aspd, sizeof(airspeed_pitch_min_aspd) },
+	{ (uint8_t*)&airspeed_pitch_max_aspd, sizeof(airspeed_pitch_max_aspd) },
+	{ (uint8_t*)&airspeed_pitch_adjust_rate, sizeof(airspeed_pitch_adjust_rate) },
+	{ (uint8_t*)&airspeed_pitch_ki, sizeof(airspeed_pitch_ki) },
+	{ (uint8_t*)&airspeed_pitch_ki_limit, sizeof(airspeed_pitch_ki_limit) },
+
+	{ (uint8_t*)&turns.ElevatorTrimNormal, sizeof(turns.ElevatorTrimNormal) },
+	{ (uint8_t*)&turns.ElevatorTrimInverted, sizeof(turns.ElevatorTrimInverted) },
+	{ (uint8_t*)&turns.RefSpeed, sizeof(turns.RefSpeed) },
+	{ (uint8_t*)&turns.AngleOfAttackNormal, sizeof(turns.AngleOfAttackNormal) },
+	{ (uint8_t*)&turns.AngleOfAttackInverted, sizeof(turns.AngleOfAttackInverted) },
+	{ (uint8_t*)&turns.FeedForward, sizeof(turns.FeedForward) },
+	{ (uint8_t*)&turns.TurnRateNav, sizeof(turns.TurnRateNav) },
+	{ (uint8_t*)&turns.TurnRateFBW, sizeof(turns.TurnRateFBW) },
+
+	{ (uint8_t*)&gain_schedule_airspeed[0], sizeof(gain_schedule_airspeed[0]) },
+	{ (uint8_t*)&gain_schedule_airspeed[1], sizeof(gain_schedule_airspeed[1]) },
+	{ (uint8_t*)&gain_schedule_airspeed[2], sizeof(gain_schedule_airspeed[2]) },
+	{ (uint8_t*)&gain_schedule_airspeed[3], sizeof(gain_schedule_airspeed[3]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_ROLL][0], sizeof(gain_schedule_scale[GAIN_ROLL][0]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_ROLL][1], sizeof(gain_schedule_scale[GAIN_ROLL][1]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_ROLL][2], sizeof(gain_schedule_scale[GAIN_ROLL][2]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_ROLL][3], sizeof(gain_schedule_scale[GAIN_ROLL][3]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_PITCH][0], sizeof(gain_schedule_scale[GAIN_PITCH][0]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_PITCH][1], sizeof(gain_schedule_scale[GAIN_PITCH][1]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_PITCH][2], sizeof(gain_schedule_scale[GAIN_PITCH][2]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_PITCH][3], sizeof(gain_schedule_scale[GAIN_PITCH][3]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_YAW][0], sizeof(gain_schedule_scale[GAIN_YAW][0]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_YAW][1], sizeof(gain_schedule_scale[GAIN_YAW][1]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_YAW][2], sizeof(gain_schedule_scale[GAIN_YAW][2]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_YAW][3], sizeof(gain_schedule_scale[GAIN_YAW][3]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_NAV][0], sizeof(gain_schedule_scale[GAIN_NAV][0]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_NAV][1], sizeof(gain_schedule_scale[GAIN_NAV][1]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_NAV][2], sizeof(gain_schedule_scale[GAIN_NAV][2]) },
+	{ (uint8_t*)&gain_schedule_scale[GAIN_NAV][3], sizeof(gain_schedule_scale[GAIN_NAV][3]) },
+
+	{ (uint8_t*)&geofence_action, sizeof(geofence_action) },
+	{ (uint8_t*)&geofence_total, sizeof(geofence_total) },
+	{ (uint8_t*)&geofence_min_alt, sizeof(geofence_min_alt) },
+	{ (uint8_t*)&geofence_max_alt, sizeof(geofence_max_alt) },
+
+};
+
+#define STORAGE_SIZE_CONTROL_GAINS ( \
+	sizeof(rollkp) + \
+	sizeof(rollkd) + \
+	sizeof(yawkpail) + \
+	sizeof(yawkdail) + \
+	sizeof(pitchgain) + \
+	sizeof(pitchkd) + \
+	sizeof(rollkprud) + \
+	sizeof(yawkprud) + \
+	sizeof(yawkdrud) + \
+	sizeof(rollkprud) + \
+	sizeof(rollkdrud))
+
+#define STORAGE_SIZE_MAG_CALIB ( \
+	sizeof(rawMagCalib[0]) + \
+	sizeof(rawMagCalib[1]) + \
+	sizeof(rawMagCalib[2]) + \
+	sizeof(magGain[0]) + \
+	sizeof(magGain[1]) + \
+	sizeof(magGain[2]) + \
+	sizeof(udb_magOffset[0]) + \
+	sizeof(udb_magOffset[1]) + \
+	sizeof(udb_magOffset[2]) + \
+	sizeof(dcm_declination_angle.BB))
+
+#define STORAGE_SIZE_RADIO_TRIM ( \
+	sizeof(udb_pwTrim[AILERON_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[ELEVATOR_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[RUDDER_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[AILERON_SECONDARY_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[ROLL_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[PITCH_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[THROTTLE_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[YAW_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[FLAP_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[BRAKE_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[SPOILER_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[CAMBER_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[CROW_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[CAMERA_PITCH_INPUT_CHANNEL]) + \
+	sizeof(udb_pwTrim[CAMERA_YAW_INPUT_CHANNEL]))
+
+#define STORAGE_SIZE_IMU_CALIB ( \
+	sizeof(udb_xaccel.offset) + \
+	sizeof(udb_yaccel.offset) + \
+	sizeof(udb_zaccel.offset) + \
+	sizeof(udb_xrate.offset) + \
+	sizeof(udb_yrate.offset) + \
+	sizeof(udb_zrate.offset) + \
+	sizeof(udb_vref.offset))
+
+#define STORAGE_SIZE_THROTTLE_HEIGHT_OPTIONS ( \
+	sizeof(height_target_min) + \
+	sizeof(height_target_max) + \
+	sizeof(height_margin) + \
+	sizeof(alt_hold_throttle_min) + \
+	sizeof(alt_hold_throttle_max) + \
+	sizeof(alt_hold_pitch_min) + \
+	sizeof(alt_hold_pitch_max) + \
+	sizeof(alt_hold_pitch_high) + \
+	sizeof(rtl_pitch_down))
+
+#define STORAGE_SIZE_AIRSPEED_OPTIONS ( \
+	sizeof(desiredSpeed) + \
+	sizeof(minimum_groundspeed) + \
+	sizeof(minimum_airspeed) + \
+	sizeof(maximum_airspeed) + \
+	sizeof(cruise_airspeed) + \
+	sizeof(airspeed_pitch_min_aspd) + \
+	sizeof(airspeed_pitch_max_aspd) + \
+	sizeof(airspeed_pitch_adjust_rate) + \
+	sizeof(airspeed_pitch_ki) + \
+	sizeof(airspeed_pitch_ki_limit))
+
+#define STORAGE_SIZE_TURNS_OPTIONS ( \
+	sizeof(turns.ElevatorTrimNormal) + \
+	sizeof(turns.ElevatorTrimInverted) + \
+	sizeof(turns.RefSpeed) + \
+	sizeof(turns.AngleOfAttackNormal) + \
+	sizeof(turns.AngleOfAttackInverted) + \
+	sizeof(turns.FeedForward) + \
+	sizeof(turns.TurnRateNav) + \
+	sizeof(turns.TurnRateFBW))
+
+#define STORAGE_SIZE_GAIN_SCHEDULE ( \
+	sizeof(gain_schedule_airspeed[0]) + \
+	sizeof(gain_schedule_airspeed[1]) + \
+	sizeof(gain_schedule_airspeed[2]) + \
+	sizeof(gain_schedule_airspeed[3]) + \
+	sizeof(gain_schedule_scale[GAIN_ROLL][0]) + \
+	sizeof(gain_schedule_scale[GAIN_ROLL][1]) + \
+	sizeof(gain_schedule_scale[GAIN_ROLL][2]) + \
+	sizeof(gain_schedule_scale[GAIN_ROLL][3]) + \
+	sizeof(gain_schedule_scale[GAIN_PITCH][0]) + \
+	sizeof(gain_schedule_scale[GAIN_PITCH][1]) + \
+	sizeof(gain_schedule_scale[GAIN_PITCH][2]) + \
+	sizeof(gain_schedule_scale[GAIN_PITCH][3]) + \
+	sizeof(gain_schedule_scale[GAIN_YAW][0]) + \
+	sizeof(gain_schedule_scale[GAIN_YAW][1]) + \
+	sizeof(gain_schedule_scale[GAIN_YAW][2]) + \
+	sizeof(gain_schedule_scale[GAIN_YAW][3]) + \
+	sizeof(gain_schedule_scale[GAIN_NAV][0]) + \
+	sizeof(gain_schedule_scale[GAIN_NAV][1]) + \
+	sizeof(gain_schedule_scale[GAIN_NAV][2]) + \
+	sizeof(gain_schedule_scale[GAIN_NAV][3]))
+
+#define STORAGE_SIZE_GEOFENCE_OPTIONS ( \
+	sizeof(geofence_action) + \
+	sizeof(geofence_total) + \
+	sizeof(geofence_min_alt) + \
+	sizeof(geofence_max_alt))
+
 const mavlink_parameter_block mavlink_parameter_blocks[] = {
-	{ STORAGE_HANDLE_CONTROL_GAINS, 0, 11, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, NULL },
-	{ STORAGE_HANDLE_MAG_CALIB, 11, 10, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, NULL },
-	{ STORAGE_HANDLE_RADIO_TRIM, 21, 15, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, &udb_skip_radio_trim },
-	{ STORAGE_HANDLE_IMU_CALIB, 36, 7, STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, &udb_skip_imu_calibration },
-	{ STORAGE_HANDLE_THROTTLE_HEIGHT_OPTIONS, 43, 9, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
-	{ STORAGE_HANDLE_AIRSPEED_OPTIONS, 52, 10, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
-	{ STORAGE_HANDLE_TURNS_OPTIONS, 62, 8, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
+	{ STORAGE_HANDLE_CONTROL_GAINS, 0, 11, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, NULL, STORAGE_SIZE_CONTROL_GAINS, 0x91AF },
+	{ STORAGE_HANDLE_MAG_CALIB, 11, 10, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, NULL, STORAGE_SIZE_MAG_CALIB, 0xDEE0 },
+	{ STORAGE_HANDLE_RADIO_TRIM, 21, 15, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, &udb_skip_radio_trim, STORAGE_SIZE_RADIO_TRIM, 0xD8E5 },
+	{ STORAGE_HANDLE_IMU_CALIB, 36, 7, STORAGE_FLAG_LOAD_AT_REBOOT | STORAGE_FLAG_STORE_CALIB, &udb_skip_imu_calibration, STORAGE_SIZE_IMU_CALIB, 0xB906 },
+	{ STORAGE_HANDLE_THROTTLE_HEIGHT_OPTIONS, 43, 9, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL, STORAGE_SIZE_THROTTLE_HEIGHT_OPTIONS, 0x335E },
+	{ STORAGE_HANDLE_AIRSPEED_OPTIONS, 52, 10, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL, STORAGE_SIZE_AIRSPEED_OPTIONS, 0xD54B },
+	{ STORAGE_HANDLE_TURNS_OPTIONS, 62, 8, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL, STORAGE_SIZE_TURNS_OPTIONS, 0x7785 },
+	{ STORAGE_HANDLE_GAIN_SCHEDULE, 70, 20, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL, STORAGE_SIZE_GAIN_SCHEDULE, 0xB4B7 },
+	{ STORAGE_HANDLE_GEOFENCE_OPTIONS, 90, 4, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL, STORAGE_SIZE_GEOFENCE_OPTIONS, 0x7BB5 },
 };
 
 
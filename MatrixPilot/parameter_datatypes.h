@@ -31,6 +31,9 @@ typedef enum
 	STORAGE_HANDLE_THROTTLE_HEIGHT_OPTIONS = 11,
 	STORAGE_HANDLE_AIRSPEED_OPTIONS = 12,
 	STORAGE_HANDLE_TURNS_OPTIONS = 13,
+	STORAGE_HANDLE_GAIN_SCHEDULE = 14,
+	STORAGE_HANDLE_GEOFENCE_OPTIONS = 15,
+	STORAGE_HANDLE_GEOFENCE = 16,
 	} data_storage_handles_e;
 
 typedef enum
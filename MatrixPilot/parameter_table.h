@@ -92,11 +92,23 @@ typedef struct tag_mavlink_parameter_block
 	const uint16_t block_size;
 	const uint16_t data_storage_flags;
 	PT_callbackFunc ploadCallback;
+	const uint16_t data_size;           // Total size of the items in the block
+	const uint16_t data_layout;         // Signature of the names and types of the items, never 0
 } mavlink_parameter_block;
 
 extern const mavlink_parameter_block mavlink_parameter_blocks[];
 extern const uint16_t mavlink_parameter_block_count;
 
+// A variable stored in a parameter block. data_services_items follows the
+// order of mavlink_parameters_list, so block_start_index indexes both.
+typedef struct tag_data_services_item
+{
+	uint8_t* pdata;
+	uint16_t size;
+} data_services_item;
+
+extern const data_services_item data_services_items[];
+
 // Collection of data on all memory areas served
 //extern const mavlink_parameter_block data_services_table[];
 
@@ -7,13 +7,15 @@
 
 #include "parameter_table.h"
 #include "data_storage.h"
+#include "gain_variables.h"
 #include "../libUDB/magnetometer.h"
 #include "../libUDB/ADchannel.h"
 #include "altitudeCntrl.h"
 #include "airspeedCntrl.h"
 #include "config.h"
+#include "gainSchedule.h"
+#include "geofence.h"
 
-#include "gain_variables.h"
 
 const mavlink_parameter_parser mavlink_parameter_parsers[] = {
 	{ &mavlink_send_param_int16, &mavlink_set_param_int16, MAVLINK_TYPE_INT32_T},
@@ -111,6 +113,32 @@ const mavlink_parameter mavlink_parameters_list[] = {
 	{"TURN_RATE_NAV", {0.0}, {100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateNav, sizeof(turns.TurnRateNav) },
 	{"TURN_RATE_FBW", {0.0}, {100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateFBW, sizeof(turns.TurnRateFBW) },
 
+	{"GS_ASPD0", {0.0}, {300.0}, UDB_TYPE_M_AIRSPEED_TO_CM, PARAMETER_READWRITE, (void*)&gain_schedule_airspeed[0], sizeof(gain_schedule_airspeed[0]) },
+	{"GS_ASPD1", {0.0}, {300.0}, UDB_TYPE_M_AIRSPEED_TO_CM, PARAMETER_READWRITE, (void*)&gain_schedule_airspeed[1], sizeof(gain_schedule_airspeed[1]) },
+	{"GS_ASPD2", {0.0}, {300.0}, UDB_TYPE_M_AIRSPEED_TO_CM, PARAMETER_READWRITE, (void*)&gain_schedule_airspeed[2], sizeof(gain_schedule_airspeed[2]) },
+	{"GS_ASPD3", {0.0}, {300.0}, UDB_TYPE_M_AIRSPEED_TO_CM, PARAMETER_READWRITE, (void*)&gain_schedule_airspeed[3], sizeof(gain_schedule_airspeed[3]) },
+	{"GS_ROLL0", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_ROLL][0], sizeof(gain_schedule_scale[GAIN_ROLL][0]) },
+	{"GS_ROLL1", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_ROLL][1], sizeof(gain_schedule_scale[GAIN_ROLL][1]) },
+	{"GS_ROLL2", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_ROLL][2], sizeof(gain_schedule_scale[GAIN_ROLL][2]) },
+	{"GS_ROLL3", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_ROLL][3], sizeof(gain_schedule_scale[GAIN_ROLL][3]) },
+	{"GS_PITCH0", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_PITCH][0], sizeof(gain_schedule_scale[GAIN_PITCH][0]) },
+	{"GS_PITCH1", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_PITCH][1], sizeof(gain_schedule_scale[GAIN_PITCH][1]) },
+	{"GS_PITCH2", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_PITCH][2], sizeof(gain_schedule_scale[GAIN_PITCH][2]) },
+	{"GS_PITCH3", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_PITCH][3], sizeof(gain_schedule_scale[GAIN_PITCH][3]) },
+	{"GS_YAW0", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_YAW][0], sizeof(gain_schedule_scale[GAIN_YAW][0]) },
+	{"GS_YAW1", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_YAW][1], sizeof(gain_schedule_scale[GAIN_YAW][1]) },
+	{"GS_YAW2", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_YAW][2], sizeof(gain_schedule_scale[GAIN_YAW][2]) },
+	{"GS_YAW3", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_YAW][3], sizeof(gain_schedule_scale[GAIN_YAW][3]) },
+	{"GS_NAV0", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_NAV][0], sizeof(gain_schedule_scale[GAIN_NAV][0]) },
+	{"GS_NAV1", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_NAV][1], sizeof(gain_schedule_scale[GAIN_NAV][1]) },
+	{"GS_NAV2", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_NAV][2], sizeof(gain_schedule_scale[GAIN_NAV][2]) },
+	{"GS_NAV3", {0.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&gain_schedule_scale[GAIN_NAV][3], sizeof(gain_schedule_scale[GAIN_NAV][3]) },
+
+	{"FENCE_ACTION", {0}, {4}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&geofence_action, sizeof(geofence_action) },
+	{"FENCE_TOTAL", {0}, {254}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&geofence_total, sizeof(geofence_total) },
+	{"FENCE_MINALT", {0}, {10000}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&geofence_min_alt, sizeof(geofence_min_alt) },
+	{"FENCE_MAXALT", {0}, {10000}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&geofence_max_alt, sizeof(geofence_max_alt) },
+
 };
 
 const uint16_t count_of_parameters_list = sizeof(mavlink_parameters_list) / sizeof(mavlink_parameter);
@@ -84,13 +84,39 @@ void parameter_table_init(void)
 
 	mavlink_parameters_list[62].min.param_float=-1.0; mavlink_parameters_list[62].max.param_float=1.0; // turns.ElevatorTrimNormal - TURN_ELE_TR_NRM
 	mavlink_parameters_list[63].min.param_float=-1.0; mavlink_parameters_list[63].max.param_float=1.0; // turns.ElevatorTrimInverted - TURN_ELE_TR_INV
-	mavlink_parameters_list[64].min.param_float=0.0; mavlink_parameters_list[64].max.param_float=999.0; // turns.CruiseSpeed - TURN_CRUISE_SPD
+	mavlink_parameters_list[64].min.param_float=0.0; mavlink_parameters_list[64].max.param_float=999.0; // turns.RefSpeed - TURN_CRUISE_SPD
 	mavlink_parameters_list[65].min.param_float=-90.0; mavlink_parameters_list[65].max.param_float=90.0; // turns.AngleOfAttackNormal - TURN_AOA_NORMAL
 	mavlink_parameters_list[66].min.param_float=-90.0; mavlink_parameters_list[66].max.param_float=90.0; // turns.AngleOfAttackInverted - TURN_AOA_INV
 	mavlink_parameters_list[67].min.param_float=0.0; mavlink_parameters_list[67].max.param_float=100.0; // turns.FeedForward - TURN_FEED_FWD
 	mavlink_parameters_list[68].min.param_float=0.0; mavlink_parameters_list[68].max.param_float=100.0; // turns.TurnRateNav - TURN_RATE_NAV
 	mavlink_parameters_list[69].min.param_float=0.0; mavlink_parameters_list[69].max.param_float=100.0; // turns.TurnRateFBW - TURN_RATE_FBW
 
+	mavlink_parameters_list[70].min.param_float=0.0; mavlink_parameters_list[70].max.param_float=300.0; // gain_schedule_airspeed[0] - GS_ASPD0
+	mavlink_parameters_list[71].min.param_float=0.0; mavlink_parameters_list[71].max.param_float=300.0; // gain_schedule_airspeed[1] - GS_ASPD1
+	mavlink_parameters_list[72].min.param_float=0.0; mavlink_parameters_list[72].max.param_float=300.0; // gain_schedule_airspeed[2] - GS_ASPD2
+	mavlink_parameters_list[73].min.param_float=0.0; mavlink_parameters_list[73].max.param_float=300.0; // gain_schedule_airspeed[3] - GS_ASPD3
+	mavlink_parameters_list[74].min.param_float=0.0; mavlink_parameters_list[74].max.param_float=1.99; // gain_schedule_scale[GAIN_ROLL][0] - GS_ROLL0
+	mavlink_parameters_list[75].min.param_float=0.0; mavlink_parameters_list[75].max.param_float=1.99; // gain_schedule_scale[GAIN_ROLL][1] - GS_ROLL1
+	mavlink_parameters_list[76].min.param_float=0.0; mavlink_parameters_list[76].max.param_float=1.99; // gain_schedule_scale[GAIN_ROLL][2] - GS_ROLL2
+	mavlink_parameters_list[77].min.param_float=0.0; mavlink_parameters_list[77].max.param_float=1.99; // gain_schedule_scale[GAIN_ROLL][3] - GS_ROLL3
+	mavlink_parameters_list[78].min.param_float=0.0; mavlink_parameters_list[78].max.param_float=1.99; // gain_schedule_scale[GAIN_PITCH][0] - GS_PITCH0
+	mavlink_parameters_list[79].min.param_float=0.0; mavlink_parameters_list[79].max.param_float=1.99; // gain_schedule_scale[GAIN_PITCH][1] - GS_PITCH1
+	mavlink_parameters_list[80].min.param_float=0.0; mavlink_parameters_list[80].max.param_float=1.99; // gain_schedule_scale[GAIN_PITCH][2] - GS_PITCH2
+	mavlink_parameters_list[81].min.param_float=0.0; mavlink_parameters_list[81].max.param_float=1.99; // gain_schedule_scale[GAIN_PITCH][3] - GS_PITCH3
+	mavlink_parameters_list[82].min.param_float=0.0; mavlink_parameters_list[82].max.param_float=1.99; // gain_schedule_scale[GAIN_YAW][0] - GS_YAW0
+	mavlink_parameters_list[83].min.param_float=0.0; mavlink_parameters_list[83].max.param_float=1.99; // gain_schedule_scale[GAIN_YAW][1] - GS_YAW1
+	mavlink_parameters_list[84].min.param_float=0.0; mavlink_parameters_list[84].max.param_float=1.99; // gain_schedule_scale[GAIN_YAW][2] - GS_YAW2
+	mavlink_parameters_list[85].min.param_float=0.0; mavlink_parameters_list[85].max.param_float=1.99; // gain_schedule_scale[GAIN_YAW][3] - GS_YAW3
+	mavlink_parameters_list[86].min.param_float=0.0; mavlink_parameters_list[86].max.param_float=1.99; // gain_schedule_scale[GAIN_NAV][0] - GS_NAV0
+	mavlink_parameters_list[87].min.param_float=0.0; mavlink_parameters_list[87].max.param_float=1.99; // gain_schedule_scale[GAIN_NAV][1] - GS_NAV1
+	mavlink_parameters_list[88].min.param_float=0.0; mavlink_parameters_list[88].max.param_float=1.99; // gain_schedule_scale[GAIN_NAV][2] - GS_NAV2
+	mavlink_parameters_list[89].min.param_float=0.0; mavlink_parameters_list[89].max.param_float=1.99; // gain_schedule_scale[GAIN_NAV][3] - GS_NAV3
+
+	mavlink_parameters_list[90].min.param_int32=0; mavlink_parameters_list[90].max.param_int32=4; // geofence_action - FENCE_ACTION
+	mavlink_parameters_list[91].min.param_int32=0; mavlink_parameters_list[91].max.param_int32=254; // geofence_total - FENCE_TOTAL
+	mavlink_parameters_list[92].min.param_int32=0; mavlink_parameters_list[92].max.param_int32=10000; // geofence_min_alt - FENCE_MINALT
+	mavlink_parameters_list[93].min.param_int32=0; mavlink_parameters_list[93].max.param_int32=10000; // geofence_max_alt - FENCE_MAXALT
+
 };
 
 #endif // (USE_MAVLINK == 1)
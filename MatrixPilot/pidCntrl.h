@@ -0,0 +1,145 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef _PIDCNTRL_H_
+#define _PIDCNTRL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// Fixed point building blocks of the control loops: gains, saturation, an
+// integrator with anti-windup, the PID terms and a first order filter.
+//
+// None of these loop or divide, so each takes the same few instructions
+// whatever its inputs. They are all inline, so that the shifts and limits
+// which are constants fold into the code of the loops which use them.
+//
+// Gains are unsigned, scaled by RMAX, or by SCALEGYRO*RMAX for gains on a gyro
+// rate. A term is the high word of the product of its input and its gain, as
+// the control loops have always worked it out.
+
+#define CNTRL_MIN   (-32767-1)
+#define CNTRL_MAX   32767
+
+// Limit a 32 bit value to lie within min and max
+static inline int16_t cntrl_saturate(int32_t value, int16_t min, int16_t max)
+{
+	if (value > max) return max;
+	if (value < min) return min;
+	return (int16_t)value;
+}
+
+// Add two values, saturating rather than overflowing
+static inline int16_t cntrl_add(int16_t a, int16_t b)
+{
+	return cntrl_saturate((int32_t)a + b, CNTRL_MIN, CNTRL_MAX);
+}
+
+// Subtract b from a, saturating. b may be CNTRL_MIN, which can not be negated.
+static inline int16_t cntrl_sub(int16_t a, int16_t b)
+{
+	return cntrl_saturate((int32_t)a - b, CNTRL_MIN, CNTRL_MAX);
+}
+
+// Scale a value by a gain
+static inline int16_t cntrl_gain(int16_t value, uint16_t gain)
+{
+	union longww accum;
+
+	accum.WW = __builtin_mulsu(value, gain);
+	return accum._.W1;
+}
+
+// Scale -value by a gain. The product is negated, rather than value, which
+// would wrap at CNTRL_MIN.
+static inline int16_t cntrl_gain_neg(int16_t value, uint16_t gain)
+{
+	union longww accum;
+
+	accum.WW = -__builtin_mulsu(value, gain);
+	return accum._.W1;
+}
+
+// Add ki * error, shifted up by shift, to an integral whose high word is held
+// within +/- limit. The low word keeps the fraction, so that small errors
+// still integrate. shift scales ki to the rate the loop is run at.
+static inline void cntrl_integrate(union longww* integral, uint16_t ki, int16_t error, int16_t shift, int16_t limit)
+{
+	integral->WW += __builtin_mulsu(error, ki) << shift;
+	if (integral->_.W1 > limit)
+	{
+		integral->_.W1 = limit;
+	}
+	else if (integral->_.W1 < -limit)
+	{
+		integral->_.W1 = -limit;
+	}
+}
+
+// First order low pass filter. The output, the high word of filtered, moves
+// towards the input by a fraction 2^(shift-16) of the difference each call.
+static inline int16_t cntrl_lowpass(union longww* filtered, int16_t input, int16_t shift)
+{
+	filtered->WW += ((int32_t)(input - filtered->_.W1)) << shift;
+	return filtered->_.W1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// PID terms
+//
+// The derivative acts on a measured rate, normally from the gyros, rather
+// than on the change in the error, so a step in what is asked for does not
+// kick the output. The feed forward term is for a rate which is being asked
+// for, as in a turn, and is subtracted, as that rate is of the opposite sign
+// to the error it will remove. The integral, where a loop has one, is kept
+// with cntrl_integrate().
+
+struct pidGains {
+	uint16_t kp;                // on the error
+	uint16_t kd;                // on the measured rate
+	uint16_t kff;               // on the feed forward
+};
+
+// The proportional, derivative and feed forward terms, summed before the
+// high word is taken so that the result is truncated only once
+static inline int16_t pid_terms(const struct pidGains* k, int16_t error, int16_t rate, int16_t feedforward)
+{
+	union longww accum;
+
+	accum.WW = __builtin_mulsu(error, k->kp)
+	         + __builtin_mulsu(rate, k->kd)
+	         - __builtin_mulsu(feedforward, k->kff);
+	return accum._.W1;
+}
+
+// The same terms negated, for the loops whose output opposes the error. As
+// in cntrl_gain_neg(), the sum is negated rather than the inputs.
+static inline int16_t pid_terms_neg(const struct pidGains* k, int16_t error, int16_t rate, int16_t feedforward)
+{
+	union longww accum;
+
+	accum.WW = __builtin_mulsu(feedforward, k->kff)
+	         - __builtin_mulsu(error, k->kp)
+	         - __builtin_mulsu(rate, k->kd);
+	return accum._.W1;
+}
+
+
+#endif // _PIDCNTRL_H_
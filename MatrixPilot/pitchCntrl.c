@@ -28,6 +28,8 @@
 #include "airspeedCntrl.h"
 #include "altitudeCntrl.h"
 #include "helicalTurnCntrl.h"
+#include "gainSchedule.h"
+#include "pidCntrl.h"
 #include "../libUDB/servoOut.h"
 #include "../libDCM/rmat.h"
 
@@ -82,7 +84,7 @@ void pitchCntrl(void)
 
 static void normalPitchCntrl(void)
 {
-	union longww pitchAccum;
+	struct pidGains k;
 //	int16_t aspd_adj;
 //	fractional aspd_err, aspd_diff;
 
@@ -93,10 +95,11 @@ static void normalPitchCntrl(void)
 
 	if (settings._.PitchStabilization && state_flags._.pitch_feedback)
 	{
-		pitchAccum.WW = __builtin_mulsu(tiltError[0], pitchgain) 
-		              - __builtin_mulsu(desiredRotationRateRadians[0], pitchfdfwd)
-		              + __builtin_mulsu(rotationRateError[0], pitchkd );
-		pitch_control = (int32_t)pitchAccum._.W1 + (int32_t) elevatorLoadingTrim;
+		k.kp  = scheduled_gain(pitchgain, GAIN_PITCH);
+		k.kd  = scheduled_gain(pitchkd, GAIN_PITCH);
+		k.kff = scheduled_gain(pitchfdfwd, GAIN_PITCH);
+		pitch_control = cntrl_add(pid_terms(&k, tiltError[0], rotationRateError[0], desiredRotationRateRadians[0]),
+		                          elevatorLoadingTrim);
 	}
 	else
 	{
@@ -107,6 +110,7 @@ static void normalPitchCntrl(void)
 static void hoverPitchCntrl(void)
 {
 	union longww pitchAccum;
+	struct pidGains k;
 	int16_t elevInput;
 	int16_t manualPitchOffset;
 	int32_t pitchToWP;
@@ -128,12 +132,13 @@ static void hoverPitchCntrl(void)
 		{
 			pitchToWP = 0;
 		}
-		pitchAccum.WW = __builtin_mulsu(rmat[8] + HOVERPOFFSET - pitchToWP + manualPitchOffset, hoverpitchgain)
-		              + __builtin_mulus(hoverpitchkd, pitchrate);
+		k.kp  = hoverpitchgain;
+		k.kd  = hoverpitchkd;
+		k.kff = 0;
+		pitch_control = pid_terms(&k, rmat[8] + HOVERPOFFSET - pitchToWP + manualPitchOffset, pitchrate, 0);
 	}
 	else
 	{
-		pitchAccum.WW = 0;
+		pitch_control = 0;
 	}
-	pitch_control = (int32_t)pitchAccum._.W1;
 }
@@ -0,0 +1,200 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "defines.h"
+#include "profile.h"
+#include "../libDCM/mathlibNAV.h"
+#include "../libUDB/heartbeat.h"
+#include <string.h>
+
+#if (USE_PROFILING == 1)
+
+// Each section keeps a histogram of its times in timer ticks. The buckets are
+// a quarter of an octave wide: each power of two from 4 ticks up is split into
+// four buckets, and the times of 0 to 3 ticks have a bucket each. That keeps
+// the percentiles within 25% while covering the timer's whole range.
+// When a bucket fills, all of them are halved, so the histogram keeps its
+// shape and the older samples slowly lose their weight.
+#define PROFILE_BUCKETS 60
+
+struct profile_histogram {
+	uint16_t count;     // samples since the last reset
+	uint16_t min;
+	uint16_t max;
+	uint16_t buckets[PROFILE_BUCKETS];
+};
+
+static const char* profile_names[PROFILE_SECTIONS] = {
+	"frame", "flightplan", "geofence", "helical", "roll", "yaw", "altitude", "pitch", "servomix"
+};
+
+static struct profile_histogram histograms[PROFILE_SECTIONS];
+static uint16_t frame_overruns = 0;
+
+static int16_t bucket_index(uint16_t ticks)
+{
+	int16_t msb;
+
+	if (ticks < 4)
+	{
+		return ticks;
+	}
+	msb = 16 - FindFirstBitFromLeft(ticks);
+	return ((msb - 1) << 2) + ((ticks >> (msb - 2)) & 3);
+}
+
+static uint16_t ticks_to_us(uint16_t ticks)
+{
+	return (uint16_t)(((uint32_t)ticks * 1000) / udb_timer_ticks_per_ms());
+}
+
+// The flight control frame has to be done within one heartbeat. Where that is
+// longer than the timer can count, the budget is the most it can count.
+static uint16_t frame_budget_ticks(void)
+{
+	uint32_t ticks = ((uint32_t)udb_timer_ticks_per_ms() * 1000) / HEARTBEAT_HZ;
+
+	return (ticks > 0xFFFF) ? 0xFFFF : (uint16_t)ticks;
+}
+
+void profile_record(profile_section_t section, uint16_t ticks)
+{
+	struct profile_histogram* h = &histograms[section];
+	int16_t b = bucket_index(ticks);
+	int16_t i;
+
+	if (h->buckets[b] == 0xFFFF)
+	{
+		for (i = 0; i < PROFILE_BUCKETS; i++)
+		{
+			h->buckets[i] >>= 1;
+		}
+	}
+	h->buckets[b]++;
+	if (h->count == 0 || ticks < h->min)
+	{
+		h->min = ticks;
+	}
+	if (ticks > h->max)
+	{
+		h->max = ticks;
+	}
+	if (h->count < 0xFFFF)
+	{
+		h->count++;
+	}
+	if (section == PROFILE_FRAME && ticks > frame_budget_ticks() && frame_overruns < 0xFFFF)
+	{
+		frame_overruns++;
+	}
+}
+
+// Estimate a percentile by interpolating within the bucket that holds it
+static uint16_t percentile(const struct profile_histogram* h, uint32_t total, uint16_t pct)
+{
+	uint32_t rank = (total * pct + 99) / 100;
+	uint32_t below = 0;
+	uint32_t lower;
+	uint32_t width;
+	uint32_t ticks;
+	int16_t b;
+
+	for (b = 0; b < PROFILE_BUCKETS; b++)
+	{
+		if (below + h->buckets[b] >= rank)
+		{
+			break;
+		}
+		below += h->buckets[b];
+	}
+	if (b == PROFILE_BUCKETS)
+	{
+		return h->max;
+	}
+	if (b < 4)
+	{
+		lower = b;
+		width = 1;
+	}
+	else
+	{
+		width = 1UL << ((b >> 2) - 1);
+		lower = (4 + (b & 3)) * width;
+	}
+	ticks = lower + (width * (rank - below)) / h->buckets[b];
+	if (ticks < h->min) ticks = h->min;
+	if (ticks > h->max) ticks = h->max;
+	return (uint16_t)ticks;
+}
+
+void profile_summarise(profile_section_t section, struct profile_summary* s)
+{
+	const struct profile_histogram* h = &histograms[section];
+	uint32_t total = 0;
+	int16_t i;
+
+	for (i = 0; i < PROFILE_BUCKETS; i++)
+	{
+		total += h->buckets[i];
+	}
+	s->name = profile_names[section];
+	s->count = h->count;
+	if (total == 0)
+	{
+		s->min_us = s->p50_us = s->p99_us = s->max_us = 0;
+		return;
+	}
+	s->min_us = ticks_to_us(h->min);
+	s->p50_us = ticks_to_us(percentile(h, total, 50));
+	s->p99_us = ticks_to_us(percentile(h, total, 99));
+	s->max_us = ticks_to_us(h->max);
+}
+
+uint16_t profile_frame_overruns(void)
+{
+	return frame_overruns;
+}
+
+void profile_reset(void)
+{
+	memset(histograms, 0, sizeof(histograms));
+	frame_overruns = 0;
+}
+
+void profile_print(void)
+{
+	struct profile_summary s;
+	int16_t i;
+
+	printf("section     count   min   p50   p99   max (us)\r\n");
+	for (i = 0; i < PROFILE_SECTIONS; i++)
+	{
+		profile_summarise((profile_section_t)i, &s);
+		printf("%-10s %6u %5u %5u %5u %5u\r\n", s.name, s.count, s.min_us, s.p50_us, s.p99_us, s.max_us);
+	}
+	profile_summarise(PROFILE_FRAME, &s);
+	printf("frame budget %uus, worst margin %ius, %u overruns\r\n",
+	       ticks_to_us(frame_budget_ticks()),
+	       (int16_t)(ticks_to_us(frame_budget_ticks()) - s.max_us),
+	       frame_overruns);
+}
+
+#endif // USE_PROFILING
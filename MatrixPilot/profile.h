@@ -0,0 +1,73 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+
+// Code sections timed when USE_PROFILING is 1. PROFILE_FRAME is the whole
+// 40Hz flight control frame, the rest are the parts of it.
+typedef enum {
+	PROFILE_FRAME = 0,
+	PROFILE_FLIGHTPLAN,
+	PROFILE_GEOFENCE,
+	PROFILE_HELICAL_TURN,
+	PROFILE_ROLL,
+	PROFILE_YAW,
+	PROFILE_ALTITUDE,
+	PROFILE_PITCH,
+	PROFILE_SERVO_MIX,
+	PROFILE_SECTIONS
+} profile_section_t;
+
+struct profile_summary {
+	const char* name;
+	uint16_t count;         // samples since the last reset
+	uint16_t min_us;
+	uint16_t p50_us;        // percentiles are estimated from the histogram
+	uint16_t p99_us;
+	uint16_t max_us;
+};
+
+#if (USE_PROFILING == 1)
+
+// Time a statement, and add the time taken to the histogram of a section
+#define PROFILE(section, statement) \
+	do { \
+		uint16_t profile_start = udb_timer_ticks(); \
+		statement; \
+		profile_record(section, udb_timer_ticks() - profile_start); \
+	} while (0)
+
+void profile_record(profile_section_t section, uint16_t ticks);
+void profile_summarise(profile_section_t section, struct profile_summary* s);
+uint16_t profile_frame_overruns(void);
+void profile_reset(void);
+void profile_print(void);
+
+#else
+
+#define PROFILE(section, statement) statement
+
+#endif // USE_PROFILING
+
+
+#endif // _PROFILE_H_
@@ -1,10 +1,4 @@
-/*
- * File:   ring_buffer.c
- * Author: markw
- *
- * Created on August 2, 2013, 8:12 AM
- */
-
+// This file is part of MatrixPilot.
 //
 //    http://code.google.com/p/gentlenav/
 //
@@ -24,171 +18,168 @@
 // You should have received a copy of the GNU General Public License
 // along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
 
-#include "../libUDB/libUDB.h"
-#include "../libUDB/serialIO.h"
-
-#ifdef USE_RING_BUFFER
 
-#include <xc.h>
-#include <stdint.h>
-#include <string.h>
+#include "defines.h"
 #include "ring_buffer.h"
+#include <string.h>
 
-// ring buffer code ported from Arduino SerialPort Library (C) 2011 GPLV3 by William Greiman.
-// there was a serious bug in put(char*, int), fixed here in ring_putn(char*, int).
-// RINGLEN is the usable number of bytes, RINGSIZE is the actual sizeof(ring_buffer).
-// ring_tail is modified by ring_get at IPL5 when transmitting data via UART2.
-// ring_head is not modified by ISRs: Since this is a transmit buffer, data is added
-// to the queue by calling one of the put methods at IPL0.
-#define RINGLEN 5800
-
-#define RINGSIZE (RINGLEN+1)
-static volatile int16_t ring_head = 0;
-static volatile int16_t ring_tail = 0;
-__attribute__((far)) char ring_buffer[RINGSIZE];
-
-#if (MAVLINK_MAX_PACKET_LEN > RINGLEN)
-#error "ringbuffer length must be >= MAVLINK_MAX_PACKET_LEN"
-#endif
+void ring_init(ring_t* ring, uint8_t* buffer, uint16_t size)
+{
+	memset(ring, 0, sizeof(ring_t));
+	ring->buffer = buffer;
+	ring->size = size;
+	ring->wrap = size;
+}
 
-// called by udb_serial_callback_get_byte_to_send at IPL5
-// modifies ring_tail
+void ring_attach(ring_t* ring, uint8_t reader, boolean attach)
+{
+	ring->tail[reader] = ring->head;
+	ring->attached[reader] = attach;
+}
 
-boolean ring_get(char* b)
+// Find the contiguous run of bytes waiting for a reader, following
+// the writer back to the start of the buffer if it has wrapped.
+static uint16_t ring_span(ring_t* ring, uint8_t reader, uint16_t* start)
 {
-	int16_t t = ring_tail;
-	if (ring_head == t)
+	uint16_t h = ring->head;
+	uint16_t t = ring->tail[reader];
+
+	if (h < t)
 	{
-		// buffer is empty
-		return false;
+		if (t < ring->wrap)
+		{
+			*start = t;
+			return ring->wrap - t;
+		}
+		t = 0;
+		ring->tail[reader] = 0;
 	}
-	*b = ring_buffer[t++];
-	ring_tail = t < RINGSIZE ? t : 0;
-	return true;
+	*start = t;
+	return h - t;
 }
 
-// insert 1 byte at head of buffer
-// return number of bytes stored, zero if buffer is full
-
-int16_t ring_put(char b)
+uint16_t ring_used(ring_t* ring, uint8_t reader)
 {
-	int16_t h = ring_head;
-	// OK to store here even if ring is full
-	ring_buffer[h++] = b;
-	if (h >= RINGSIZE) h = 0;
-	if (h == ring_tail) return 0; // buffer is full, didn't lose b (yet)
-	ring_head = h;
-	return 1;
-}
+	uint16_t h = ring->head;
+	uint16_t t = ring->tail[reader];
 
-// insert n bytes at head of buffer; modifies head at IPL5
-// If space available is less than n, store only space bytes.
-// return number of bytes stored, zero if buffer is full
+	if (h < t)
+	{
+		return (ring->wrap - t) + h;
+	}
+	return h - t;
+}
 
-int16_t ring_putn(const char* b, int16_t n)
+// Find where a contiguous block of len bytes would start, if there is room
+static boolean ring_fit(ring_t* ring, uint16_t len, uint16_t* at)
 {
-	// disable U2TX interrupt to fetch ring_tail
-	_U2TXIE = 0;
-
-	int16_t t = ring_tail;
+	uint16_t h = ring->head;
+	boolean fits_here = (h + len < ring->size);
+	boolean fits_start = (len < ring->size);
+	uint8_t i;
 
-	// re-enable U2TX interrupt
-	_U2TXIE = 1;
-
-	int16_t h = ring_head;
-	int16_t space;
-	if (h < t)
+	for (i = 0; i < RING_MAX_READERS; i++)
 	{
-		space = t - h - 1;
+		uint16_t t = ring->tail[i];
+
+		if (!ring->attached[i]) continue;
+		if (h < t)
+		{
+			// this reader has not followed the last wrap yet
+			fits_here = fits_here && (t - h > len);
+			fits_start = false;
+		}
+		else
+		{
+			// the new head must not catch up with the tail
+			fits_start = fits_start && (t > len);
+		}
 	}
-	else
+	if (fits_here)
 	{
-		space = RINGLEN - h + t;
+		*at = h;
 	}
-	if (n > space) n = space;
-	if ((n + h) <= RINGSIZE)
+	else if (fits_start)
 	{
-		memcpy(&ring_buffer[h], b, n);
+		*at = 0;
 	}
 	else
 	{
-		int16_t n1 = RINGSIZE - h;
-		memcpy(&ring_buffer[h], b, n1);
-		memcpy(ring_buffer, &b[n1], n - n1);
+		return false;
 	}
-	h += n;
-	ring_head = h < RINGSIZE ? h : h - RINGSIZE;
-	return n;
+	return true;
 }
 
-// return number of bytes in buffer
-
-int16_t ring_available()
+boolean ring_has_room(ring_t* ring, uint16_t len)
 {
-	// disable U2TX interrupt to fetch ring_tail
-	_U2TXIE = 0;
-
-	int16_t n = ring_head - ring_tail;
-
-	// re-enable U2TX interrupt
-	_U2TXIE = 1;
+	uint16_t at;
 
-	return n < 0 ? RINGSIZE + n : n;
+	return ring_fit(ring, len, &at);
 }
 
-// return space available in buffer (in bytes)
-
-int16_t ring_space()
+uint8_t* ring_reserve(ring_t* ring, uint16_t len)
 {
-	int16_t space;
-	// disable U2TX interrupt to fetch ring_tail
-	_U2TXIE = 0;
+	uint16_t at;
 
-	int16_t t = ring_tail;
+	if (!ring_fit(ring, len, &at))
+	{
+		ring->overflows++;
+		return NULL;
+	}
+	ring->reserved = at;
+	return &ring->buffer[at];
+}
 
-	// re-enable U2TX interrupt
-	_U2TXIE = 1;
+void ring_commit(ring_t* ring, uint16_t len)
+{
+	uint16_t h = ring->head;
+	uint16_t used;
+	uint8_t i;
 
-	if (ring_head < t)
+	if (len == 0) return;
+	if (ring->reserved != h)
 	{
-		space = t - ring_head - 1;
+		ring->wrap = h;         // must be visible before the head moves behind the tails
 	}
-	else
+	ring->head = ring->reserved + len;
+
+	for (i = 0; i < RING_MAX_READERS; i++)
 	{
-		space = RINGLEN - ring_head + t;
+		if (ring->attached[i])
+		{
+			used = ring_used(ring, i);
+			if (used > ring->high_water) ring->high_water = used;
+		}
 	}
-
-	return space;
 }
 
-int16_t queue_data(const char* buff, int16_t nbytes)
+int16_t ring_get(ring_t* ring, uint8_t reader)
 {
-	if (ring_space() > nbytes)
-	{
-		ring_putn(buff, nbytes);
-		return(1);
-	}
-	else
+	uint16_t start;
+
+	if (ring_span(ring, reader, &start) == 0)
 	{
-		return(0);
+		return -1;
 	}
+	ring->tail[reader] = start + 1;
+	return ring->buffer[start];
 }
 
-// send string out telemetry port
-
-int16_t queue_string(const char* string)
+uint16_t ring_peek(ring_t* ring, uint8_t reader, const uint8_t** data)
 {
-	return queue_data(string, strlen(string));
-}
+	uint16_t start;
+	uint16_t len = ring_span(ring, reader, &start);
 
-// queue a string without null terminator
+	*data = &ring->buffer[start];
+	return len;
+}
 
-void queue_prepend(const char* buff, int16_t nbytes)
+void ring_consume(ring_t* ring, uint8_t reader, uint16_t len)
 {
-	if (ring_space() > nbytes - 1)
+	uint16_t start;
+
+	if (ring_span(ring, reader, &start) >= len)
 	{
-		ring_putn(buff, nbytes - 1);
+		ring->tail[reader] = start + len;
 	}
 }
-
-#endif
@@ -1,22 +1,82 @@
-/* 
- * File:   ring_buffer.h
- * Author: markw
- *
- * Created on August 2, 2013, 8:12 AM
- */
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2013 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
 
 #ifndef RING_BUFFER_H
 #define RING_BUFFER_H
 
+// A single writer byte ring with reservation based writes.
+//
+// The writer reserves a contiguous block, formats or encodes straight into
+// it, and then commits the number of bytes actually used. A reservation which
+// would run past the end of the buffer starts again at the beginning, and the
+// readers skip the unused end. Each reader drains the same bytes through its
+// own tail, so data is never copied out of the ring before being sent.
+//
+// head and wrap are only written by the writer, each tail only by its reader,
+// so the ring may be filled and drained at different interrupt priorities
+// without disabling interrupts. Where packets come from more than one
+// priority, the caller must keep them from interleaving: MAVLink.c holds the
+// highest writer's priority from each reservation to its commit.
+
+#define RING_MAX_READERS    1
+#define RING_READER_TX      0   // the transmitter: UART interrupt or USB task
+
+typedef struct ring {
+	uint8_t* buffer;
+	uint16_t size;
+	volatile uint16_t head;                     // end of committed data
+	volatile uint16_t wrap;                     // end of valid data, while head has wrapped
+	volatile uint16_t tail[RING_MAX_READERS];
+	volatile boolean attached[RING_MAX_READERS];
+	uint16_t reserved;                          // start of the open reservation
+	uint16_t overflows;                         // reservations refused as the ring was full
+	uint16_t high_water;                        // the most bytes ever waiting for a reader
+} ring_t;
+
+void ring_init(ring_t* ring, uint8_t* buffer, uint16_t size);
+
+// Readers only hold up the writer while attached. Attaching discards
+// anything already in the ring, as far as that reader is concerned.
+void ring_attach(ring_t* ring, uint8_t reader, boolean attach);
+
+// Returns a contiguous block of len bytes, or NULL if there is no room, in
+// which case the overflow count is incremented. Follow with ring_commit().
+uint8_t* ring_reserve(ring_t* ring, uint16_t len);
+
+// Returns true if a reservation of len bytes would currently succeed. Lets a
+// writer pace itself to the readers rather than have its data dropped.
+boolean ring_has_room(ring_t* ring, uint16_t len);
+
+// Publish the first len bytes of the last reservation to the readers.
+void ring_commit(ring_t* ring, uint16_t len);
+
+// Returns the next byte for a reader, or -1 if there are none.
+int16_t ring_get(ring_t* ring, uint8_t reader);
 
-boolean ring_get(char* b);
-int16_t ring_put(char b);
-int16_t ring_putn(const char* b, int16_t n);
-int16_t ring_available();
-int16_t ring_space();
-int16_t queue_data(const char* buff, int16_t nbytes);
-int16_t queue_string(const char* string);
-void queue_prepend(const char* buff, int16_t nbytes);
+// Returns the number of contiguous bytes waiting for a reader, and where they
+// are. Release them with ring_consume() once they have been used.
+uint16_t ring_peek(ring_t* ring, uint8_t reader, const uint8_t** data);
+void ring_consume(ring_t* ring, uint8_t reader, uint16_t len);
 
+// Returns the total number of bytes waiting for a reader.
+uint16_t ring_used(ring_t* ring, uint8_t reader);
 
-#endif /* RING_BUFFER_H */
+#endif // RING_BUFFER_H
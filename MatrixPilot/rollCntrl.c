@@ -26,6 +26,8 @@
 #include "config.h"
 #include "states.h"
 #include "helicalTurnCntrl.h"
+#include "gainSchedule.h"
+#include "pidCntrl.h"
 #include "../libDCM/rmat.h"
 
 uint16_t yawkdail;
@@ -69,11 +71,14 @@ void rollCntrl(void)
 	}
 }
 
+// The roll and yaw rate damping are kept out of the PID terms, and truncated
+// on their own, as they always have been.
 void normalRollCntrl(void)
 {
-	union longww rollAccum = { 0 };
-	union longww gyroRollFeedback;
-	union longww gyroYawFeedback;
+	struct pidGains k = { 0, 0, 0 };
+	int16_t rollStabilization = 0;
+	int16_t gyroRollFeedback;
+	int16_t gyroYawFeedback;
 	fractional omegaAccum2;
 
 	if (!canStabilizeInverted() || !desired_behavior._.inverted)
@@ -90,30 +95,31 @@ void normalRollCntrl(void)
 #endif
 	if (settings._.RollStabilizaionAilerons && state_flags._.pitch_feedback)
 	{
-		gyroRollFeedback.WW = - __builtin_mulus(rollkd, rotationRateError[1]);
-		rollAccum.WW -= __builtin_mulsu(tiltError[1], rollkp);
-		rollAccum.WW += __builtin_mulsu(desiredRotationRateRadians[1], rollkpfdfwd);
+		k.kp  = scheduled_gain(rollkp, GAIN_ROLL);
+		k.kff = scheduled_gain(rollkpfdfwd, GAIN_ROLL);
+		rollStabilization = pid_terms_neg(&k, tiltError[1], 0, desiredRotationRateRadians[1]);
+		gyroRollFeedback = cntrl_gain_neg(rotationRateError[1], scheduled_gain(rollkd, GAIN_ROLL));
 	}
 	else
 	{
-		gyroRollFeedback.WW = 0;
+		gyroRollFeedback = 0;
 	}
 	if (settings._.YawStabilizationAileron && state_flags._.pitch_feedback)
 	{
-		gyroYawFeedback.WW = - __builtin_mulus(yawkdail, omegaAccum2);
+		gyroYawFeedback = cntrl_gain_neg(omegaAccum2, scheduled_gain(yawkdail, GAIN_ROLL));
 	}
 	else
 	{
-		gyroYawFeedback.WW = 0;
+		gyroYawFeedback = 0;
 	}
-	roll_control = (int32_t)rollAccum._.W1 + (int32_t)gyroRollFeedback._.W1 + (int32_t)gyroYawFeedback._.W1;
+	roll_control = cntrl_saturate((int32_t)rollStabilization + gyroRollFeedback + gyroYawFeedback, CNTRL_MIN, CNTRL_MAX);
 	// Servo reversing is handled in servoMix.c
 }
 
 void hoverRollCntrl(void)
 {
 	int16_t rollNavDeflection;
-	union longww gyroRollFeedback;
+	int16_t gyroRollFeedback;
 
 	if (state_flags._.pitch_feedback)
 	{
@@ -125,12 +131,12 @@ void hoverRollCntrl(void)
 		{
 			rollNavDeflection = 0;
 		}
-		gyroRollFeedback.WW = __builtin_mulus(hoverrollkd , omegaAccum[1]);
+		gyroRollFeedback = cntrl_gain(omegaAccum[1], hoverrollkd);
 	}
 	else
 	{
 		rollNavDeflection = 0;
-		gyroRollFeedback.WW = 0;
+		gyroRollFeedback = 0;
 	}
-	roll_control = rollNavDeflection -(int32_t)gyroRollFeedback._.W1;
+	roll_control = cntrl_sub(rollNavDeflection, gyroRollFeedback);
 }
@@ -31,50 +31,259 @@
 #if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
 #include "airspeedCntrl.h"
 #include "altitudeCntrl.h"
+#endif
+
+#if (AIRFRAME_TYPE == AIRFRAME_STANDARD || AIRFRAME_TYPE == AIRFRAME_VTAIL || \
+     AIRFRAME_TYPE == AIRFRAME_DELTA || AIRFRAME_TYPE == AIRFRAME_HELI || \
+     AIRFRAME_TYPE == AIRFRAME_GLIDER)
+#define USE_MIX_TABLE
+
+// The airframes are mixed by multiplying the inputs below by a constant
+// matrix, made from the channel assignments and reversing options in
+// options.h, and for the glider the factors in options_servo_mix.h. Each
+// output is the centre of its channel plus its row of the matrix times the
+// inputs, each product scaled by 1/MIX_ONE, plus its offset, saturated.
+//
+// The autopilot inputs are roll_control, pitch_control, yaw_control,
+// throttle_control and waggle. For the standard, V-tail, delta and heli
+// airframes the stick inputs are the pilot's roll, pitch, yaw and throttle,
+// as offsets from trim, unmixed from the radio channels by stickTable. In
+// stabilized modes the roll stick is ignored, as it is accounted for in the
+// turn control, and the pitch and yaw sticks are boosted by ElevatorBoost and
+// RudderBoost. The glider's inputs are made by glider_inputs(), from its brake
+// and flap selections and from its ailerons split into left and right parts.
+enum {
+	MIX_ROLL = 0,
+	MIX_PITCH,
+	MIX_YAW,
+	MIX_THROTTLE,
+	MIX_WAGGLE,
+#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
+	MIX_AILERON,                // aileron stick and roll control, from SERVOCENTER
+	MIX_AILERON_LEFT,           // the parts of MIX_AILERON to the left and right,
+	MIX_AILERON_RIGHT,          // with the flaps not at speed
+	MIX_AILERON_LEFT_SPEED,     // and with the flaps at speed
+	MIX_AILERON_RIGHT_SPEED,
+	MIX_FLAPS_POS,              // flaps, when positive
+	MIX_FLAPS_NEG,              // and when not
+	MIX_BRAKE,
+	MIX_MOTOR,                  // throttle selected for the autopilot, from 0
+	MIX_ELEVATOR_STICK,         // from SERVOCENTER
+	MIX_RUDDER_STICK,           // from SERVOCENTER
+#else
+	MIX_ROLL_STICK,
+	MIX_PITCH_STICK,
+	MIX_YAW_STICK,
+	MIX_THROTTLE_STICK,
+#if (AIRFRAME_TYPE == AIRFRAME_HELI)
+	MIX_HALF_ROLL,              // roll_control / 2
+	MIX_HALF_PITCH,             // pitch_control / 2
+#endif
+#endif
+	MIX_INPUTS
+};
+
+// Gains in 32nds, the resolution of the glider factors
+#define MIX_SHIFT           5
+#define MIX_ONE             (1 << MIX_SHIFT)
+#define MIX_GAIN(F)         ((int16_t)((F) * MIX_ONE))
+#define MIX_DIR(R)          ((R) ? -MIX_ONE : MIX_ONE)          // gain of 1, reversed if R
+#define MIX_DIR2(R1, R2)    MIX_DIR((R1) != (R2))               // both reversals applied
+
+#define MIX_THROTTLE_CUT    1   // output 0 while the trim channel reads 0, as a throttle with no signal
+#define MIX_INPUT_CENTRE    2   // centre the output on the radio input of the trim channel, rather than its trim
+#define MIX_SERVO_CENTRE    4   // centre the output on SERVOCENTER, rather than a trim
+#define MIX_FOLLOW          8   // take the output of the row before, rather than the inputs
+#define MIX_SCALED          16  // multiply the sum by (1 + scale / MIX_ONE)
+#define MIX_REVERSED        32  // reverse the sum about the centre
+#define MIX_UNSATURATED     64  // do not saturate the output
+#define MIX_REVERSED_IF(R)  ((R) ? MIX_REVERSED : 0)
+
+struct mixStickDef {
+	uint8_t channel[2];
+	int16_t gain[2];
+};
+
+struct mixOutputDef {
+	uint8_t output;             // output channel
+	uint8_t trim;               // input channel whose trim is the centre of the output
+	uint8_t flags;
+	int16_t offset;             // added to the sum
+	int16_t scale;              // with MIX_SCALED
+	int16_t gain[MIX_INPUTS];
+};
+
+#define R_AIL   AILERON_CHANNEL_REVERSED
+#define R_AIL2  AILERON_SECONDARY_CHANNEL_REVERSED
+#define R_ELE   ELEVATOR_CHANNEL_REVERSED
+#define R_RUD   RUDDER_CHANNEL_REVERSED
+#define R_THR   THROTTLE_CHANNEL_REVERSED
+#define R_SURF  ELEVON_VTAIL_SURFACES_REVERSED
+
+#define THROTTLE_MIX \
+	{ THROTTLE_OUTPUT_CHANNEL, THROTTLE_INPUT_CHANNEL, MIX_THROTTLE_CUT, 0, 0, \
+	  {            0,            0,            0, MIX_DIR(R_THR),            0,       0,       0,       0, MIX_ONE } }
+
+// The secondary aileron is the primary, reversed about the aileron trim if
+// need be, and is not saturated again
+#define AILERON_SECONDARY_MIX \
+	{ AILERON_SECONDARY_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, MIX_FOLLOW | MIX_UNSATURATED | MIX_REVERSED_IF(R_AIL2), 0, 0, { 0 } }
+
+#if (AIRFRAME_TYPE == AIRFRAME_STANDARD)
+#define MIX_STABILIZED_STICKS 1
+static const struct mixStickDef stickTable[4] = {
+	{ { AILERON_INPUT_CHANNEL,  0 }, { MIX_ONE, 0 } },
+	{ { ELEVATOR_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+	{ { RUDDER_INPUT_CHANNEL,   0 }, { MIX_ONE, 0 } },
+	{ { THROTTLE_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+};
+static const struct mixOutputDef mixTable[] = {
+//	                                                     roll           pitch             yaw        throttle          waggle   roll stk pitch stk yaw stk thr stk
+	{ AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0, 0, 0,
+	  { MIX_DIR(R_AIL),               0,              0,              0,  MIX_DIR(R_AIL), MIX_ONE,       0,       0,       0 } },
+	AILERON_SECONDARY_MIX,
+	{ ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0, 0, 0,
+	  {              0, MIX_DIR(R_ELE),              0,              0,               0,       0, MIX_ONE,       0,       0 } },
+	{ RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0, 0, 0,
+	  {              0,              0, MIX_DIR(R_RUD),              0, -MIX_DIR(R_RUD),       0,       0, MIX_ONE,       0 } },
+	THROTTLE_MIX
+};
+#endif // AIRFRAME_STANDARD
+
+#if (AIRFRAME_TYPE == AIRFRAME_VTAIL)
+#define MIX_STABILIZED_STICKS 1
+static const struct mixStickDef stickTable[4] = {
+	{ { AILERON_INPUT_CHANNEL,  0 }, { MIX_ONE, 0 } },
+	{ { RUDDER_INPUT_CHANNEL,   ELEVATOR_INPUT_CHANNEL }, {  MIX_DIR(R_RUD) / 2, MIX_DIR(R_ELE) / 2 } },
+	{ { RUDDER_INPUT_CHANNEL,   ELEVATOR_INPUT_CHANNEL }, { -MIX_DIR(R_RUD) / 2, MIX_DIR(R_ELE) / 2 } },
+	{ { THROTTLE_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+};
+static const struct mixOutputDef mixTable[] = {
+//	                                                     roll           pitch             yaw        throttle          waggle   roll stk pitch stk yaw stk thr stk
+	{ AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0, 0, 0,
+	  { MIX_DIR(R_AIL),               0,              0,              0,  MIX_DIR(R_AIL), MIX_ONE,       0,       0,       0 } },
+	AILERON_SECONDARY_MIX,
+	{ ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0, 0, 0,
+	  {              0, MIX_DIR(R_ELE), MIX_DIR2(R_ELE, R_SURF),      0,               0,       0, MIX_DIR(R_ELE), MIX_DIR(R_ELE), 0 } },
+	{ RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0, 0, 0,
+	  {              0, MIX_DIR(R_RUD), -MIX_DIR2(R_RUD, R_SURF),     0,               0,       0, MIX_DIR(R_RUD), -MIX_DIR(R_RUD), 0 } },
+	THROTTLE_MIX
+};
+#endif // AIRFRAME_VTAIL
+
+#if (AIRFRAME_TYPE == AIRFRAME_DELTA)
+#define MIX_STABILIZED_STICKS 1
+static const struct mixStickDef stickTable[4] = {
+	{ { ELEVATOR_INPUT_CHANNEL, AILERON_INPUT_CHANNEL }, { MIX_DIR(R_ELE) / 2, -MIX_DIR(R_AIL) / 2 } },
+	{ { ELEVATOR_INPUT_CHANNEL, AILERON_INPUT_CHANNEL }, { MIX_DIR(R_ELE) / 2,  MIX_DIR(R_AIL) / 2 } },
+	{ { RUDDER_INPUT_CHANNEL,   0 }, { MIX_ONE, 0 } },
+	{ { THROTTLE_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+};
+static const struct mixOutputDef mixTable[] = {
+//	                                                     roll           pitch             yaw        throttle          waggle   roll stk pitch stk yaw stk thr stk
+	{ AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0, 0, 0,
+	  { -MIX_DIR2(R_AIL, R_SURF), MIX_DIR(R_AIL),   0,              0, -MIX_DIR(R_AIL), -MIX_DIR(R_AIL), MIX_DIR(R_AIL), 0, 0 } },
+	{ ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0, 0, 0,
+	  { MIX_DIR2(R_ELE, R_SURF), MIX_DIR(R_ELE),    0,              0,  MIX_DIR(R_ELE),  MIX_DIR(R_ELE), MIX_DIR(R_ELE), 0, 0 } },
+	{ RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0, 0, 0,
+	  {              0,              0, MIX_DIR(R_RUD),              0, -MIX_DIR(R_RUD),       0,       0, MIX_ONE,       0 } },
+	THROTTLE_MIX
+};
+#endif // AIRFRAME_DELTA
+
+#if (AIRFRAME_TYPE == AIRFRAME_HELI)
+// Half of roll and half of pitch into each aileron, each halved on its own,
+// waggle and yaw are ignored for now. The secondary aileron is centred on the
+// radio input of its own channel, and is not saturated.
+#define MIX_STABILIZED_STICKS 0
+static const struct mixStickDef stickTable[4] = {
+	{ { AILERON_INPUT_CHANNEL,  0 }, { MIX_ONE, 0 } },
+	{ { ELEVATOR_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+	{ { RUDDER_INPUT_CHANNEL,   0 }, { MIX_ONE, 0 } },
+	{ { THROTTLE_INPUT_CHANNEL, 0 }, { MIX_ONE, 0 } },
+};
+static const struct mixOutputDef mixTable[] = {
+//	                                                     roll           pitch             yaw        throttle          waggle   roll stk pitch stk yaw stk thr stk   half roll     half pitch
+	{ AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0, 0, 0,
+	  {              0,              0,              0,              0,               0, MIX_ONE,       0,       0,       0, MIX_DIR(R_AIL), MIX_DIR(R_AIL) } },
+	{ ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0, 0, 0,
+	  {              0, MIX_DIR(R_ELE),              0,              0,               0,       0, MIX_ONE,       0,       0,              0,              0 } },
+	{ AILERON_SECONDARY_OUTPUT_CHANNEL, AILERON_SECONDARY_OUTPUT_CHANNEL, MIX_INPUT_CENTRE | MIX_UNSATURATED, 0, 0,
+	  {              0,              0,              0,              0,               0,       0,       0,       0,       0, -MIX_DIR(R_AIL2), MIX_DIR(R_AIL2) } },
+	{ RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0, 0, 0,
+	  {              0,              0,              0,              0,               0,       0,       0, MIX_ONE,       0,              0,              0 } },
+	THROTTLE_MIX
+};
+#endif // AIRFRAME_HELI
+
+#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
+// Each surface mixes the brake, the flaps and the parts of the ailerons by its
+// factors, then adds its offset and is reversed about SERVOCENTER if need be.
+// The rudder is then scaled by RUDDER_FACTOR. The right flap takes the flaps
+// factors of the left flap, and each flap its right speed factor for the left
+// part of the ailerons, as they always have. The throttle is set by
+// glider_inputs(), as it selects between the throttle and the brakes.
+#define GLIDER_SURFACE_MIX(CHANNEL, NAME, BRAKE, FLAPS_POS, FLAPS_NEG, LP, RP, LP_SPEED, RP_SPEED) \
+	{ CHANNEL, 0, MIX_SERVO_CENTRE | MIX_REVERSED_IF(NAME##_DIR_REVERSED), \
+	  REVERSE_IF_NEEDED(NAME##_OFFSET_REVERSED, NAME##_OUTPUT_OFFSET), 0, \
+	  { [MIX_BRAKE]               = MIX_GAIN(BRAKE), \
+	    [MIX_FLAPS_POS]           = MIX_GAIN(FLAPS_POS), \
+	    [MIX_FLAPS_NEG]           = MIX_GAIN(FLAPS_NEG), \
+	    [MIX_AILERON_LEFT]        = MIX_GAIN(LP), \
+	    [MIX_AILERON_RIGHT]       = MIX_GAIN(RP), \
+	    [MIX_AILERON_LEFT_SPEED]  = MIX_GAIN(LP_SPEED), \
+	    [MIX_AILERON_RIGHT_SPEED] = MIX_GAIN(RP_SPEED) } }
+
+static const struct mixOutputDef mixTable[] = {
+	GLIDER_SURFACE_MIX(AILERON_LEFT_OUTPUT_CHANNEL, AILERON_LEFT,
+	    AILERON_LEFT_BRAKE_FACTOR, AILERON_LEFT_FLAPS_POS_FACTOR, AILERON_LEFT_FLAPS_NEG_FACTOR,
+	    AILERON_LEFT_LP_FLAPS_FACTOR, AILERON_LEFT_RP_FLAPS_FACTOR,
+	    AILERON_LEFT_LP_SPEED_FLAPS_FACTOR, AILERON_LEFT_RP_SPEED_FLAPS_FACTOR),
+#if (FLAP_LEFT_OUTPUT_CHANNEL != 0)
+	GLIDER_SURFACE_MIX(FLAP_LEFT_OUTPUT_CHANNEL, FLAP_LEFT,
+	    FLAP_LEFT_BRAKE_FACTOR, FLAP_LEFT_FLAPS_POS_FACTOR, FLAP_LEFT_FLAPS_NEG_FACTOR,
+	    FLAP_LEFT_LP_FLAPS_FACTOR, FLAP_LEFT_RP_FLAPS_FACTOR,
+	    FLAP_LEFT_RP_SPEED_FLAPS_FACTOR, FLAP_LEFT_RP_SPEED_FLAPS_FACTOR),
+#endif
+#if (FLAP_RIGHT_OUTPUT_CHANNEL != 0)
+	GLIDER_SURFACE_MIX(FLAP_RIGHT_OUTPUT_CHANNEL, FLAP_RIGHT,
+	    FLAP_RIGHT_BRAKE_FACTOR, FLAP_LEFT_FLAPS_POS_FACTOR, FLAP_LEFT_FLAPS_NEG_FACTOR,
+	    FLAP_RIGHT_LP_FLAPS_FACTOR, FLAP_RIGHT_RP_FLAPS_FACTOR,
+	    FLAP_RIGHT_RP_SPEED_FLAPS_FACTOR, FLAP_RIGHT_RP_SPEED_FLAPS_FACTOR),
+#endif
+	GLIDER_SURFACE_MIX(AILERON_RIGHT_OUTPUT_CHANNEL, AILERON_RIGHT,
+	    AILERON_RIGHT_BRAKE_FACTOR, AILERON_RIGHT_FLAPS_POS_FACTOR, AILERON_RIGHT_FLAPS_NEG_FACTOR,
+	    AILERON_RIGHT_LP_FLAPS_FACTOR, AILERON_RIGHT_RP_FLAPS_FACTOR,
+	    AILERON_RIGHT_LP_SPEED_FLAPS_FACTOR, AILERON_RIGHT_RP_SPEED_FLAPS_FACTOR),
+	{ RUDDER_OUTPUT_CHANNEL, 0, MIX_SERVO_CENTRE | MIX_SCALED | MIX_REVERSED_IF(RUDDER_DIR_REVERSED),
+	  REVERSE_IF_NEEDED(RUDDER_OFFSET_REVERSED, RUDDER_OUTPUT_OFFSET), MIX_GAIN(RUDDER_FACTOR),
+	  { [MIX_YAW]             = MIX_DIR(R_RUD),
+	    [MIX_WAGGLE]          = -MIX_DIR(R_RUD),
+	    [MIX_AILERON]         = MIX_GAIN(RUDDER_FROM_AILERON_FACTOR),
+	    [MIX_RUDDER_STICK]    = MIX_ONE } },
+	{ ELEVATOR_OUTPUT_CHANNEL, 0, MIX_SERVO_CENTRE | MIX_REVERSED_IF(ELEVATOR_DIR_REVERSED),
+	  REVERSE_IF_NEEDED(ELEVATOR_OFFSET_REVERSED, ELEVATOR_OUTPUT_OFFSET), 0,
+	  { [MIX_PITCH]           = MIX_DIR(R_ELE),
+	    [MIX_BRAKE]           = MIX_GAIN(ELEVATOR_BRAKE_FACTOR),
+	    [MIX_MOTOR]           = MIX_GAIN(ELEVATOR_THROTTLE_FACTOR),
+	    [MIX_ELEVATOR_STICK]  = MIX_ONE } },
+#if (BRAKE_OUTPUT_CHANNEL != 0)
+	// brake control or logging
+	{ BRAKE_OUTPUT_CHANNEL, 0, MIX_SERVO_CENTRE, SERVOMIN - SERVOCENTER, 0,
+	  { [MIX_BRAKE]           = MIX_ONE } },
+#endif
+#if (FLAPS_OUTPUT_CHANNEL != 0)
+	// flaps control or logging
+	{ FLAPS_OUTPUT_CHANNEL, 0, MIX_SERVO_CENTRE, SERVOMIN - SERVOCENTER, 0,
+	  { [MIX_FLAPS_POS]       = MIX_ONE,
+	    [MIX_FLAPS_NEG]       = MIX_ONE } },
+#endif
+};
+#endif // AIRFRAME_GLIDER
 
-static int16_t aileronLeftBrakeFactor;
-static int16_t aileronLeftFlapsPosFactor;
-static int16_t aileronLeftFlapsNegFactor;
-static int16_t aileronLeftLpFlapsFactor;
-static int16_t aileronLeftRpFlapsFactor;
-static int16_t aileronLeftLpSpeedFlapsFactor;
-static int16_t aileronLeftRpSpeedFlapsFactor;
-
-static int16_t flapLeftBrakeFactor;
-static int16_t flapLeftFlapsPosFactor;
-static int16_t flapLeftFlapsNegFactor;
-static int16_t flapLeftRpFlapsFactor;
-static int16_t flapLeftLpFlapsFactor;
-static int16_t flapLeftRpSpeedFlapsFactor;
-static int16_t flapLeftLpSpeedFlapsFactor;
-
-static int16_t flapRightBrakeFactor;
-static int16_t flapRightFlapsPosFactor;
-static int16_t flapRightFlapsNegFactor;
-static int16_t flapRightRpFlapsFactor;
-static int16_t flapRightLpFlapsFactor;
-static int16_t flapRightRpSpeedFlapsFactor;
-static int16_t flapRightLpSpeedFlapsFactor;
-
-static int16_t aileronRightBrakeFactor;
-static int16_t aileronRightFlapsPosFactor;
-static int16_t aileronRightFlapsNegFactor;
-static int16_t aileronRightLpFlapsFactor;
-static int16_t aileronRightRpFlapsFactor;
-static int16_t aileronRightLpSpeedFlapsFactor;
-static int16_t aileronRightRpSpeedFlapsFactor;
-
-static int16_t elevatorBrakeFactor;
-static int16_t elevatorThrottleFactor;
-
-static int16_t rudderFromAileronFactor;
-static int16_t rudderFactor;
-
-static int16_t throttleFactor;
-
-static int32_t throttleSteps = 0;//range: 0..2000
-
-#endif //AIRFRAME_GLIDER
+#define NUM_MIX_OUTPUTS (sizeof(mixTable) / sizeof(mixTable[0]))
+
+#endif // AIRFRAME_STANDARD || AIRFRAME_VTAIL || AIRFRAME_DELTA || AIRFRAME_HELI || AIRFRAME_GLIDER
 
 // Perform control based on the airframe type.
 // Use the radio to determine the baseline pulse widths if the radio is on.
@@ -89,112 +298,14 @@ void servoMix_init(void)
 {
 	elevatorbgain = (int16_t)(8.0*gains.ElevatorBoost);
 	rudderbgain   = (int16_t)(8.0*gains.RudderBoost);
-
-
-#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
-	//convert fraction to x*32 integer;(0.03 resolution) 0.03 = 1 , 1.0 = 32 //only once, to save resources
-	aileronLeftBrakeFactor = (signed int)(AILERON_LEFT_BRAKE_FACTOR * 32.0);//float to int 
-	aileronLeftFlapsPosFactor = (signed int)(AILERON_LEFT_FLAPS_POS_FACTOR * 32.0);
-	aileronLeftFlapsNegFactor = (signed int)(AILERON_LEFT_FLAPS_NEG_FACTOR * 32.0);
-	aileronLeftLpFlapsFactor = (signed int)(AILERON_LEFT_LP_FLAPS_FACTOR * 32.0);
-	aileronLeftRpFlapsFactor = (signed int)(AILERON_LEFT_RP_FLAPS_FACTOR * 32.0);
-	aileronLeftLpSpeedFlapsFactor = (signed int)(AILERON_LEFT_LP_SPEED_FLAPS_FACTOR * 32.0);
-	aileronLeftRpSpeedFlapsFactor = (signed int)(AILERON_LEFT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	
-	flapLeftBrakeFactor = (signed int)(FLAP_LEFT_BRAKE_FACTOR * 32.0);
-	flapLeftFlapsPosFactor = (signed int)(FLAP_LEFT_FLAPS_POS_FACTOR * 32.0);
-	flapLeftFlapsNegFactor = (signed int)(FLAP_LEFT_FLAPS_NEG_FACTOR * 32.0);
-	flapLeftRpFlapsFactor = (signed int)(FLAP_LEFT_RP_FLAPS_FACTOR * 32.0);
-	flapLeftLpFlapsFactor = (signed int)(FLAP_LEFT_LP_FLAPS_FACTOR * 32.0);
-	flapLeftRpSpeedFlapsFactor = (signed int)(FLAP_LEFT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	flapLeftLpSpeedFlapsFactor = (signed int)(FLAP_LEFT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	
-	flapRightBrakeFactor = (signed int)(FLAP_RIGHT_BRAKE_FACTOR * 32.0);
-	flapRightFlapsPosFactor = (signed int)(FLAP_RIGHT_FLAPS_POS_FACTOR * 32.0);
-	flapRightFlapsNegFactor = (signed int)(FLAP_RIGHT_FLAPS_NEG_FACTOR * 32.0);
-	flapRightRpFlapsFactor = (signed int)(FLAP_RIGHT_RP_FLAPS_FACTOR * 32.0);
-	flapRightLpFlapsFactor = (signed int)(FLAP_RIGHT_LP_FLAPS_FACTOR * 32.0);
-	flapRightRpSpeedFlapsFactor = (signed int)(FLAP_RIGHT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	flapRightLpSpeedFlapsFactor = (signed int)(FLAP_RIGHT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	
-	aileronRightBrakeFactor = (signed int)(AILERON_RIGHT_BRAKE_FACTOR * 32.0);
-	aileronRightFlapsPosFactor = (signed int)(AILERON_RIGHT_FLAPS_POS_FACTOR * 32.0);
-	aileronRightFlapsNegFactor = (signed int)(AILERON_RIGHT_FLAPS_NEG_FACTOR * 32.0);
-	aileronRightLpFlapsFactor = (signed int)(AILERON_RIGHT_LP_FLAPS_FACTOR * 32.0);
-	aileronRightRpFlapsFactor = (signed int)(AILERON_RIGHT_RP_FLAPS_FACTOR * 32.0);
-	aileronRightLpSpeedFlapsFactor = (signed int)(AILERON_RIGHT_LP_SPEED_FLAPS_FACTOR * 32.0);
-	aileronRightRpSpeedFlapsFactor = (signed int)(AILERON_RIGHT_RP_SPEED_FLAPS_FACTOR * 32.0);
-	
-	elevatorBrakeFactor = (signed int)(ELEVATOR_BRAKE_FACTOR * 32.0);
-	elevatorThrottleFactor = (signed int)(ELEVATOR_THROTTLE_FACTOR * 32.0);
-	
-	rudderFromAileronFactor = (signed int)(RUDDER_FROM_AILERON_FACTOR * 32.0);
-	rudderFactor = (signed int)(RUDDER_FACTOR * 32.0);
-	
-	throttleFactor = (signed int)(THROTTLE_FACTOR * 32.0);
-	
-#endif //AIRFRAME_GLIDER
 }
 
-void servoMix(void)
-{
-	int32_t temp;
-	int16_t pwManual[NUM_INPUTS+1];
-
-	// If radio is off, use udb_pwTrim values instead of the udb_pwIn values
-	for (temp = 0; temp <= NUM_INPUTS; temp++)
-	{
-		if (udb_flags._.radio_on)
-			pwManual[temp] = udb_pwIn[temp];
-		else
-			pwManual[temp] = udb_pwTrim[temp];
-	}
-
-
-	// Standard airplane airframe
-	// Mix roll_control into ailerons
-	// Mix pitch_control into elevators
-	// Mix yaw control and waggle into rudder
-#if (AIRFRAME_TYPE == AIRFRAME_STANDARD)
-	// Apply boosts to elevator and rudder if in a controlled mode
-	// It does not matter whether the radio is on or not
-	if (state_flags._.pitch_feedback)
-	{
-		pwManual[AILERON_INPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] ; // in fly by wire or navigate mode, manual input is accounted for in the turn control
-		pwManual[ELEVATOR_INPUT_CHANNEL] += ((pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]) * elevatorbgain) >> 3;
-		pwManual[RUDDER_INPUT_CHANNEL] += ((pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]) * rudderbgain) >> 3;
-	}
-		temp = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		
-	udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, udb_pwOut[AILERON_OUTPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]);
-
-		temp = pwManual[ELEVATOR_INPUT_CHANNEL] + REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		temp = pwManual[RUDDER_INPUT_CHANNEL] + REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
-		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		}
-#endif // AIRFRAME_STANDARD
-
 #if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
-	{
-	static int16_t mixerSteps = 0;
-	static int16_t aileronInput = 0;
-	static int16_t ailInLeftPartFlapsNotSpeed=0;
-	static int16_t ailInRightPartFlapsNotSpeed=0;
-	static int16_t ailInLeftPartFlapsSpeed=0;
-	static int16_t ailInRightPartFlapsSpeed=0;
+// Make the glider's mix inputs. The brake and flaps move at a limited rate
+// towards their selections, the ailerons are split into left and right parts,
+// and the throttle output is selected.
+static void glider_inputs(int16_t* in, int16_t* pwManual)
+{
 	static int16_t brakeSelectedTarget;   //resulting brake selection after checking switch/slider, throttle and flight modes, no brake == 0, full brake trottle == 1700
 	static int32_t brakeSelectedStep=0;
 #if (FLAPS_INPUT_CHANNEL != 0 )
@@ -202,6 +313,9 @@ void servoMix(void)
 #endif
 	static int16_t flapsSelectedStep=0;
 	static int16_t autopilotThrottleSelected=0;	//used for elevator trim in motorclimb
+	int16_t aileronInput;
+	int32_t temp;
+	int32_t throttleSteps;
 
 	// Apply boosts to elevator and rudder if in a controlled mode
 	// It does not matter whether the radio is on or not
@@ -286,121 +400,50 @@ void servoMix(void)
 	flapsSelectedStep = 0;
 #endif //FLAPS_INPUT_CHANNEL
 	aileronInput = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
+	aileronInput = aileronInput - SERVOCENTER;
 
-	//Calculate ailInLeftPartFlapsNotSpeed, ailInRightPartFlapsNotSpeed, ailInLeftPartFlapsSpeed and ailInRightPartFlapsSpeed
+	//Split the aileron into left and right parts, with the flaps set to speed (no adverse yaw compensation) or not (adverse yaw compensation)
 	//only one can be >0 at a time
-	//aileron left or right, with autopilotFlaps set to speed (no adverse yaw compensation) or not (adverse yaw compensation)
-
-	aileronInput = aileronInput - SERVOCENTER;
-	ailInLeftPartFlapsNotSpeed=0;
-	ailInRightPartFlapsNotSpeed=0;
-	ailInLeftPartFlapsSpeed=0;
-	ailInRightPartFlapsSpeed=0;
+	in[MIX_AILERON] = aileronInput;
+	in[MIX_AILERON_LEFT] = 0;
+	in[MIX_AILERON_RIGHT] = 0;
+	in[MIX_AILERON_LEFT_SPEED] = 0;
+	in[MIX_AILERON_RIGHT_SPEED] = 0;
 	if ( flapsSelectedStep < 500 ) //normal speed slected
 	{
 		if ( aileronInput > 0 )
 		{
-			ailInRightPartFlapsNotSpeed=aileronInput;
+			in[MIX_AILERON_RIGHT] = aileronInput;
 		}
 		else
 		{
-			ailInLeftPartFlapsNotSpeed=-aileronInput;
+			in[MIX_AILERON_LEFT] = -aileronInput;
 		}
 	}
 	else //speed
 	{
 		if ( aileronInput > 0 )
 		{
-			ailInRightPartFlapsSpeed=aileronInput;
+			in[MIX_AILERON_RIGHT_SPEED] = aileronInput;
 		}
 		else
 		{
-			ailInLeftPartFlapsSpeed=-aileronInput;
+			in[MIX_AILERON_LEFT_SPEED] = -aileronInput;
 		}
 	}
-	mixerSteps = 0;
-	mixerSteps += (brakeSelectedStep * aileronLeftBrakeFactor)>>5;
-	if ( flapsSelectedStep > 0 ) //speed slected
-	{
-		mixerSteps += (flapsSelectedStep * aileronLeftFlapsPosFactor)>>5;
-	}
-	else
-	{
-		mixerSteps += (flapsSelectedStep * aileronLeftFlapsNegFactor)>>5;
-	}	
-	mixerSteps += (ailInRightPartFlapsNotSpeed * aileronLeftRpFlapsFactor)>>5; // integer*integer math, /32 to normal scale
-	mixerSteps += (ailInLeftPartFlapsNotSpeed * aileronLeftLpFlapsFactor)>>5;
-	mixerSteps += (ailInRightPartFlapsSpeed * aileronLeftRpSpeedFlapsFactor)>>5;
-	mixerSteps += (ailInLeftPartFlapsSpeed * aileronLeftLpSpeedFlapsFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(AILERON_LEFT_OFFSET_REVERSED,AILERON_LEFT_OUTPUT_OFFSET);//boolean and integer, add offset in correct direction
-	mixerSteps = REVERSE_IF_NEEDED(AILERON_LEFT_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[AILERON_LEFT_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-
-#if (FLAP_LEFT_OUTPUT_CHANNEL != 0 )
-	mixerSteps = 0;
-	mixerSteps += (brakeSelectedStep * flapLeftBrakeFactor)>>5;
-	if ( flapsSelectedStep > 0 ) //speed slected
-	{
-		mixerSteps += (flapsSelectedStep * flapLeftFlapsPosFactor)>>5;
-	}
-	else
-	{
-		mixerSteps += (flapsSelectedStep * flapLeftFlapsNegFactor)>>5;
-	}	
-	mixerSteps += (ailInRightPartFlapsNotSpeed * flapLeftRpFlapsFactor)>>5;// integer*integer math, /32 to normal scale
-	mixerSteps += (ailInLeftPartFlapsNotSpeed * flapLeftLpFlapsFactor)>>5;
-	mixerSteps += (ailInRightPartFlapsSpeed * flapLeftRpSpeedFlapsFactor)>>5;
-	mixerSteps += (ailInLeftPartFlapsSpeed * flapLeftLpSpeedFlapsFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(FLAP_LEFT_OFFSET_REVERSED,FLAP_LEFT_OUTPUT_OFFSET);//boolean and integer, add offset in correct direction
-	mixerSteps = REVERSE_IF_NEEDED(FLAP_LEFT_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[FLAP_LEFT_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-#endif
-#if (FLAP_RIGHT_OUTPUT_CHANNEL != 0 )
-	mixerSteps = 0;
-	mixerSteps += (brakeSelectedStep * flapRightBrakeFactor)>>5;
 	if ( flapsSelectedStep > 0 ) //speed slected
 	{
-		mixerSteps += (flapsSelectedStep * flapLeftFlapsPosFactor)>>5;
+		in[MIX_FLAPS_POS] = flapsSelectedStep;
+		in[MIX_FLAPS_NEG] = 0;
 	}
 	else
 	{
-		mixerSteps += (flapsSelectedStep * flapLeftFlapsNegFactor)>>5;
-	}	
-	mixerSteps += (ailInRightPartFlapsNotSpeed * flapRightRpFlapsFactor)>>5;// integer*integer math, /32 to normal scale
-	mixerSteps += (ailInLeftPartFlapsNotSpeed * flapRightLpFlapsFactor)>>5;	
-	mixerSteps += (ailInRightPartFlapsSpeed * flapRightRpSpeedFlapsFactor)>>5;	
-	mixerSteps += (ailInLeftPartFlapsSpeed * flapRightLpSpeedFlapsFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(FLAP_RIGHT_OFFSET_REVERSED,FLAP_RIGHT_OUTPUT_OFFSET);//boolean and integer, add offset in correct direction
-	mixerSteps = REVERSE_IF_NEEDED(FLAP_RIGHT_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[FLAP_RIGHT_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-#endif
-
-	mixerSteps = 0;
-	mixerSteps += (brakeSelectedStep * aileronRightBrakeFactor)>>5;
-	if ( flapsSelectedStep > 0 ) //speed slected
-	{
-		mixerSteps += (flapsSelectedStep * aileronRightFlapsPosFactor)>>5;
+		in[MIX_FLAPS_POS] = 0;
+		in[MIX_FLAPS_NEG] = flapsSelectedStep;
 	}
-	else
-	{
-		mixerSteps += (flapsSelectedStep * aileronRightFlapsNegFactor)>>5;
-	}	
-	mixerSteps += (ailInRightPartFlapsNotSpeed * aileronRightRpFlapsFactor)>>5;// integer*integer math, /32 to normal scale
-	mixerSteps += (ailInLeftPartFlapsNotSpeed * aileronRightLpFlapsFactor)>>5;
-	mixerSteps += (ailInRightPartFlapsSpeed * aileronRightRpSpeedFlapsFactor)>>5;
-	mixerSteps += (ailInLeftPartFlapsSpeed * aileronRightLpSpeedFlapsFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(AILERON_RIGHT_OFFSET_REVERSED,AILERON_RIGHT_OUTPUT_OFFSET);//boolean and integer, add offset in correct direction
-	mixerSteps = REVERSE_IF_NEEDED(AILERON_RIGHT_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[AILERON_RIGHT_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-
+	in[MIX_BRAKE] = brakeSelectedStep;
 
 #if (THROTTLE_INPUT_CHANNEL != 0 )
-	mixerSteps = 0;
-
 	if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
 	{
 		udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
@@ -419,7 +462,7 @@ void servoMix(void)
 		else
 		{
 			throttleSteps = temp - SERVOMIN;
-			throttleSteps = (throttleSteps * throttleFactor)>>5;
+			throttleSteps = (throttleSteps * MIX_GAIN(THROTTLE_FACTOR))>>5;
 			autopilotThrottleSelected = throttleSteps;// 0 = 0, full = 2000
 			throttleSteps += SERVOMIN;
 			temp = (signed int)throttleSteps;
@@ -427,191 +470,121 @@ void servoMix(void)
 		}
 	}
 #endif  //THROTTLE_INPUT_CHANNEL
+	in[MIX_MOTOR] = autopilotThrottleSelected;
 
-	temp = pwManual[RUDDER_INPUT_CHANNEL] + REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
-	mixerSteps = temp - SERVOCENTER;
-	mixerSteps += (aileronInput * rudderFromAileronFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(RUDDER_OFFSET_REVERSED,RUDDER_OUTPUT_OFFSET);
-	mixerSteps += (mixerSteps * rudderFactor)>>5;
-	mixerSteps = REVERSE_IF_NEEDED(RUDDER_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-
-	temp = pwManual[ELEVATOR_INPUT_CHANNEL] + REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
-	mixerSteps = temp - SERVOCENTER;
-	mixerSteps += (brakeSelectedStep * elevatorBrakeFactor)>>5;
-	mixerSteps += (autopilotThrottleSelected * elevatorThrottleFactor)>>5;
-	mixerSteps += REVERSE_IF_NEEDED(ELEVATOR_OFFSET_REVERSED,ELEVATOR_OUTPUT_OFFSET);
-	mixerSteps = REVERSE_IF_NEEDED(ELEVATOR_DIR_REVERSED, mixerSteps);
-	mixerSteps += SERVOCENTER;
-	udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
-
-#if (BRAKE_OUTPUT_CHANNEL != 0 )
-	//Brake control or logging
-	mixerSteps = brakeSelectedStep;
-	mixerSteps += SERVOMIN;
-	udb_pwOut[BRAKE_OUTPUT_CHANNEL] = udb_servo_pulsesat( mixerSteps );
-#endif
-
-#if (FLAPS_OUTPUT_CHANNEL != 0 )
-	//Flaps control or logging
-	mixerSteps = flapsSelectedStep;
-	mixerSteps += SERVOMIN;
-	udb_pwOut[FLAPS_OUTPUT_CHANNEL] = udb_servo_pulsesat( mixerSteps );
-#endif
-
-	}
+	in[MIX_ELEVATOR_STICK] = pwManual[ELEVATOR_INPUT_CHANNEL] - SERVOCENTER;
+	in[MIX_RUDDER_STICK] = pwManual[RUDDER_INPUT_CHANNEL] - SERVOCENTER;
+}
 #endif // AIRFRAME_GLIDER
 
+#ifdef USE_MIX_TABLE
+static void mix_table(int16_t* pwManual)
+{
+	int16_t in[MIX_INPUTS];
+	const struct mixOutputDef* mix;
+	int32_t sum;
+	int16_t centre;
+	int16_t i;
+	int16_t j;
+
+	in[MIX_ROLL] = roll_control;
+	in[MIX_PITCH] = pitch_control;
+	in[MIX_YAW] = yaw_control;
+	in[MIX_THROTTLE] = throttle_control;
+	in[MIX_WAGGLE] = waggle;
 
-	// V-Tail airplane airframe
-	// Mix roll_control and waggle into ailerons
-	// Mix pitch_control and yaw_control into both elevator and rudder
-#if (AIRFRAME_TYPE == AIRFRAME_VTAIL)
+#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
+	glider_inputs(in, pwManual);
+#else
+	// unmix the sticks, this produces zeros while the radio is off
+	for (i = 0; i < 4; i++)
 	{
-	int16_t rudderInput;
-	int16_t elevatorInput;
-	int16_t pitchInput;
-	int16_t yawInput;
-	int16_t pitchCommand;
-	int16_t yawCommand;
-		int32_t vtail_yaw_control;
-
-	// Unmix the vtail
-	rudderInput  = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, (pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]));
-	elevatorInput = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, (pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]));
-	pitchInput = ((rudderInput+elevatorInput)>>1);
-	yawInput = ((-rudderInput+elevatorInput)>>1);
+		const struct mixStickDef* stick = &stickTable[i];
 
-	if (state_flags._.pitch_feedback)
-	{
-		// Apply boost in FBW or navigate mode
-		pitchCommand = ((elevatorbgain + 8) * pitchInput) >> 3;
-		yawCommand   = ((rudderbgain + 8)   * yawInput)   >> 3;
-		// in fly by wire or navigate mode, manual input is accounted for in the turn control
-		pwManual[AILERON_INPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL];
+		sum = (int32_t)stick->gain[0] * (pwManual[stick->channel[0]] - udb_pwTrim[stick->channel[0]]) +
+		      (int32_t)stick->gain[1] * (pwManual[stick->channel[1]] - udb_pwTrim[stick->channel[1]]);
+		in[MIX_ROLL_STICK + i] = (int16_t)(sum >> MIX_SHIFT);
 	}
-	else
+#if (MIX_STABILIZED_STICKS == 1)
+	// It does not matter whether the radio is on or not
+	if (state_flags._.pitch_feedback)
 	{
-		pitchCommand = pitchInput;
-		yawCommand = yawInput;
+		in[MIX_ROLL_STICK] = 0;
+		in[MIX_PITCH_STICK] = ((elevatorbgain + 8) * (int32_t)in[MIX_PITCH_STICK]) >> 3;
+		in[MIX_YAW_STICK] = ((rudderbgain + 8) * (int32_t)in[MIX_YAW_STICK]) >> 3;
 	}
-	
-	vtail_yaw_control = REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, yaw_control);
-
-	// In fly by wire mode, ailerons are controlled indirectly by helical turn control
-	temp = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
-	udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-	//	Reverse the polarity of the secondary aileron if necessary
-	udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, udb_pwOut[AILERON_OUTPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]);
-
-	temp = udb_pwTrim[ELEVATOR_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitchCommand + pitch_control + yawCommand + vtail_yaw_control);
-	udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+#endif
+#if (AIRFRAME_TYPE == AIRFRAME_HELI)
+	in[MIX_HALF_ROLL] = roll_control / 2;
+	in[MIX_HALF_PITCH] = pitch_control / 2;
+#endif
+#endif // AIRFRAME_GLIDER
 
-	temp = udb_pwTrim[RUDDER_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, pitchCommand + pitch_control - yawCommand - vtail_yaw_control);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+	for (i = 0, mix = mixTable; i < (int16_t)NUM_MIX_OUTPUTS; i++, mix++)
+	{
+		if (mix->flags & MIX_SERVO_CENTRE)
+			centre = SERVOCENTER;
+		else if (mix->flags & MIX_INPUT_CENTRE)
+			centre = pwManual[mix->trim];
+		else
+			centre = udb_pwTrim[mix->trim];
 
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
+		if (mix->flags & MIX_FOLLOW)
 		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
+			sum = udb_pwOut[(mix - 1)->output] - centre;
 		}
 		else
 		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+			// each product is scaled on its own, as the glider factors always were
+			sum = mix->offset;
+			for (j = 0; j < MIX_INPUTS; j++)
+			{
+				sum += ((int32_t)mix->gain[j] * in[j]) >> MIX_SHIFT;
+			}
+		}
+		if (mix->flags & MIX_SCALED)
+		{
+			sum += (sum * mix->scale) >> MIX_SHIFT;
+		}
+		if (mix->flags & MIX_REVERSED)
+		{
+			sum = -sum;
 		}
-	}
-#endif // AIRFRAME_VTAIL
-
-	// Delta-Wing airplane airframe
-	// Mix roll_control, pitch_control, and waggle into aileron and elevator
-	// Mix rudder_control into  rudder
-#if (AIRFRAME_TYPE == AIRFRAME_DELTA)
-	{
-	int16_t aileronInput;
-	int16_t elevatorInput;
-	int16_t pitchInput;
-	int16_t rollInput;
-	int16_t pitchCommand;
-	int16_t rollCommand;
-	int32_t delta_roll_control;
-	// unmix the inputs, note this will produce zeros during radio off
-	aileronInput  = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, (pwManual[AILERON_INPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]));
-	elevatorInput = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, (pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]));
-	pitchInput = (elevatorInput+aileronInput)>>1;
-	rollInput = (elevatorInput-aileronInput)>>1;
-
-	if (state_flags._.pitch_feedback)
-	{
-		pitchCommand = ((elevatorbgain + 8) * pitchInput ) >> 3;
-		pwManual[RUDDER_INPUT_CHANNEL] += ((pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]) * rudderbgain) >> 3;
-		rollCommand = 0;
-	}
-	else
-	{
-		pitchCommand = pitchInput;
-		rollCommand = rollInput;
-	}
-	delta_roll_control = REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, roll_control);
-
-	temp = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, -rollCommand -delta_roll_control + pitchCommand + pitch_control - waggle);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-	temp = udb_pwTrim[ELEVATOR_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, rollCommand + delta_roll_control + pitchCommand + pitch_control + waggle);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
 
-		temp = pwManual[RUDDER_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] =  udb_servo_pulsesat(temp);
-		
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
+		if ((mix->flags & MIX_THROTTLE_CUT) && pwManual[mix->trim] == 0)
 		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
+			udb_pwOut[mix->output] = 0;
+		}
+		else if (mix->flags & MIX_UNSATURATED)
+		{
+			udb_pwOut[mix->output] = centre + sum;
 		}
 		else
 		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+			udb_pwOut[mix->output] = udb_servo_pulsesat(centre + sum);
 		}
 	}
-#endif // AIRFRAME_DELTA
-
-	// Helicopter airframe
-	// Mix half of roll_control and half of pitch_control into aileron channels
-	// Mix full pitch_control into elevator
-	// Ignore waggle for now
-#if (AIRFRAME_TYPE == AIRFRAME_HELI)
-		temp = pwManual[AILERON_INPUT_CHANNEL] +
-			REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control/2 + pitch_control/2);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+}
+#endif // USE_MIX_TABLE
 
-		temp = pwManual[ELEVATOR_INPUT_CHANNEL] +
-		    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+void servoMix(void)
+{
+	int32_t temp;
+	int16_t pwManual[NUM_INPUTS+1];
 
-		temp = pwManual[AILERON_SECONDARY_OUTPUT_CHANNEL] + 
-			REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, -roll_control/2 + pitch_control/2);
-		udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = temp;
+	// If radio is off, use udb_pwTrim values instead of the udb_pwIn values
+	for (temp = 0; temp <= NUM_INPUTS; temp++)
+	{
+		if (udb_flags._.radio_on)
+			pwManual[temp] = udb_pwIn[temp];
+		else
+			pwManual[temp] = udb_pwTrim[temp];
+	}
 
-		temp = pwManual[RUDDER_INPUT_CHANNEL] /*+ REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control)*/;
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
 
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
-		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		}
-#endif // AIRFRAME_HELI
+#ifdef USE_MIX_TABLE
+	mix_table(pwManual);
+#endif
 
 		udb_pwOut[PASSTHROUGH_A_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_A_INPUT_CHANNEL]);
 		udb_pwOut[PASSTHROUGH_B_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_B_INPUT_CHANNEL]);
@@ -33,6 +33,9 @@
 #include "flightplan_waypoints.h"
 #include "airspeedCntrl.h"
 #include "cameraCntrl.h"
+#include "profile.h"
+#include "gainSchedule.h"
+#include "geofence.h"
 #include "../libUDB/heartbeat.h"
 #include "../libUDB/servoOut.h"
 #include "../libUDB/osd.h"
@@ -81,29 +84,36 @@ void servoPrepare_init(void) // initialize the PWM
 #endif
 }
 
-static void flight_controller(void)
+static void flight_control_frame(void)
 {
-	if (udb_pulse_counter % (HEARTBEAT_HZ/40) == 0)
-	{
-		flight_mode_switch_2pos_poll(); // we always want this called at 40Hz
-	
+	flight_mode_switch_2pos_poll(); // we always want this called at 40Hz
+
 #if (DEADRECKONING == 1)
-		navigate_process_flightplan();
+	navigate_process_flightplan();
+	PROFILE(PROFILE_GEOFENCE, geofence_update());
 #endif
 #if (ALTITUDE_GAINS_VARIABLE == 1)
-        airspeedCntrl();
+	airspeedCntrl();
 #endif // ALTITUDE_GAINS_VARIABLE
-		updateBehavior();
-		wind_gain = wind_gain_adjustment();
-		helicalTurnCntrl();
-		rollCntrl();
-		yawCntrl();
-		altitudeCntrl();
-		pitchCntrl();
-		servoMix();
-		cameraCntrl();
-		cameraServoMix();
-		updateTriggerAction();
+	updateBehavior();
+	wind_gain = wind_gain_adjustment();
+	gainSchedule();
+	PROFILE(PROFILE_HELICAL_TURN, helicalTurnCntrl());
+	PROFILE(PROFILE_ROLL, rollCntrl());
+	PROFILE(PROFILE_YAW, yawCntrl());
+	PROFILE(PROFILE_ALTITUDE, altitudeCntrl());
+	PROFILE(PROFILE_PITCH, pitchCntrl());
+	PROFILE(PROFILE_SERVO_MIX, servoMix());
+	cameraCntrl();
+	cameraServoMix();
+	updateTriggerAction();
+}
+
+static void flight_controller(void)
+{
+	if (udb_pulse_counter % (HEARTBEAT_HZ/40) == 0)
+	{
+		PROFILE(PROFILE_FRAME, flight_control_frame());
 	}
 }
 
@@ -25,6 +25,7 @@
 #include "config.h"
 #include "states.h"
 #include "altitudeCntrl.h"
+#include "geofence.h"
 #include "../libDCM/deadReckoning.h"
 #include "../libDCM/gpsParseCommon.h"
 
@@ -67,6 +68,24 @@ static void cat_delayS(void);
 
 static void ent_returnS(void);
 
+#if (USE_GEOFENCE == 1)
+// A geofence breach returns the plane to launch, and holds it in that state
+// until the mode switch is moved, in the same way as FAILSAFE_HOLD.
+static boolean geofence_returnS(void)
+{
+	if (dcm_flags._.nav_capable && geofence_take_rtl_request())
+	{
+		DPRINT("geofence breach calling ent_returnS()\r\n");
+		ent_returnS();
+		state_flags._.rtl_hold = 1;
+		return true;
+	}
+	return false;
+}
+#else
+#define geofence_returnS() false
+#endif // USE_GEOFENCE
+
 //	Implementation of state machine.
 //	Examine the state of the radio and GPS and supervisory channel to decide how to control the plane.
 
@@ -452,6 +471,10 @@ static void cat_delayS(void)
 
 static void manualS(void)
 {
+	if (geofence_returnS())
+	{
+		return;
+	}
 	if (udb_flags._.radio_on)
 	{
 #ifdef CATAPULT_LAUNCH_ENABLE
@@ -480,6 +503,10 @@ static void manualS(void)
 
 static void stabilizedS(void)
 {
+	if (geofence_returnS())
+	{
+		return;
+	}
 	if (udb_flags._.radio_on)
 	{
 #ifdef CATAPULT_LAUNCH_ENABLE
@@ -506,6 +533,10 @@ static void waypointS(void)
 {
 	udb_led_toggle(LED_RED);
 
+	if (geofence_returnS())
+	{
+		return;
+	}
 	if (udb_flags._.radio_on)
 	{
 		if (flight_mode_switch_manual())
@@ -19,6 +19,9 @@
 // along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
 
 
+#ifndef STATES_H
+#define STATES_H
+
 struct state_flags_bits {
 	uint16_t unused                     : 4;
 	uint16_t save_origin                : 1;
@@ -42,3 +45,5 @@ extern int16_t waggle;
 //extern uint8_t counter;
 
 void init_states(void);
+
+#endif // STATES_H
@@ -32,6 +32,7 @@
 #include "altitudeCntrl.h"
 #include "helicalTurnCntrl.h"
 #include "servoPrepare.h"
+#include "ring_buffer.h"
 #if (USE_TELELOG == 1)
 #include "telemetry_log.h"
 #endif
@@ -61,12 +62,13 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 // Serial Output Format (Can be SERIAL_NONE, SERIAL_DEBUG, SERIAL_ARDUSTATION, SERIAL_UDB,
-// SERIAL_UDB_EXTRA, SERIAL_CAM_TRACK, SERIAL_OSD_REMZIBI, or SERIAL_UDB_MAG)
+// SERIAL_UDB_EXTRA, SERIAL_UDB_BINARY, SERIAL_CAM_TRACK, SERIAL_OSD_REMZIBI, or SERIAL_UDB_MAG)
 // This determines the format of the output sent out the spare serial port.
 // Note that SERIAL_OSD_REMZIBI only works with a ublox GPS.
 // SERIAL_UDB_EXTRA will add additional telemetry fields to those of SERIAL_UDB.
 // SERIAL_UDB_EXTRA can be used with the OpenLog without characters being dropped.
 // SERIAL_UDB_EXTRA may result in dropped characters if used with the XBEE wireless transmitter.
+// SERIAL_UDB_BINARY sends the same content as SERIAL_UDB_EXTRA in compact, CRC checked binary frames.
 // SERIAL_CAM_TRACK is used to output location data to a 2nd UDB, which will target its camera at this plane.
 // SERIAL_UDB_MAG outputs the automatically calculated offsets and raw magnetometer data.
 
@@ -120,10 +122,14 @@ static uint8_t fp_checksum;
 static void (*sio_parse)(uint8_t inchar) = &sio_newMsg;
 
 
-#define SERIAL_BUFFER_SIZE 500
-static char serial_buffer[SERIAL_BUFFER_SIZE+1];
-static int16_t sb_index = 0;
-static int16_t end_index = 0;
+#define SERIAL_BUFFER_SIZE 1024
+#define SERIAL_LINE_MAX    200  // longest text formatted by a single serial_output()
+#define SERIAL_LINE_ROOM   640  // room in the ring needed to start sending a line
+static uint8_t serial_buffer[SERIAL_BUFFER_SIZE];
+static ring_t serial_ring;      // output is formatted in place, then sent from here
+static boolean serial_reserved_in_ring;
+static boolean serial_line_open = false;    // the last serial_output() did not end its line
+static boolean serial_line_sent;            // the open line is being sent, not only logged
 
 int16_t udb_serial_callback_get_byte_to_send(void);
 void udb_serial_callback_received_byte(uint8_t rxchar);
@@ -143,6 +149,9 @@ void telemetry_init(void)
 	udb_init_USART(&udb_serial_callback_get_byte_to_send, &udb_serial_callback_received_byte);
 #endif
 	udb_serial_set_rate(SERIAL_BAUDRATE);
+
+	ring_init(&serial_ring, serial_buffer, sizeof(serial_buffer));
+	ring_attach(&serial_ring, RING_READER_TX, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -395,85 +404,93 @@ static void sio_fbdl_data(unsigned char inchar)
 // Output Serial Data
 //
 
+// Reserve room for a record in the output ring. If the link is backed up
+// the record is formatted straight into the telemetry log instead, so that
+// it is at least logged.
+static uint8_t* serial_reserve(uint16_t len)
+{
+	uint8_t* p = ring_reserve(&serial_ring, len);
+
+	serial_reserved_in_ring = (p != NULL);
+#if (USE_TELELOG == 1)
+	if (p == NULL)
+	{
+		p = log_reserve(len);
+	}
+#endif
+	return p;
+}
+
+// Send the first len bytes of the last reservation, and log them
+static void serial_commit(const uint8_t* data, uint16_t len)
+{
 #if (USE_TELELOG == 1)
-#define MIN(a,b) (((a)<(b))?(a):(b))
-#define MAX(a,b) (((a)>(b))?(a):(b))
+	if (!serial_reserved_in_ring)
+	{
+		log_commit(len);
+		return;
+	}
+	log_append(data, len);
+#endif
+	ring_commit(&serial_ring, len);
+	udb_serial_start_sending_data();
+}
 
+// Format this text straight into the output ring, from where it is sent,
+// and copy it to the log.
+//
+// A line may be built from many calls, so whether it is sent is decided once,
+// at its start: the ring must then have SERIAL_LINE_ROOM bytes free. That only
+// grows while the rest of the line is formatted, so every part of a line of
+// up to SERIAL_LINE_ROOM - SERIAL_LINE_MAX bytes then fits. Otherwise the line
+// is dropped whole, and counted once in serial_ring.overflows, though it is
+// still logged if there is a log. A line ends with a format ending in '\n'.
 static void serial_output(const char* format, ...)
 {
+	char* line = NULL;
 	int16_t len;
-	int16_t start_index;
-	int16_t remaining;
-	char telebuf[200];
-
 	va_list arglist;
-	va_start(arglist, format);
-
-	len = vsnprintf(telebuf, sizeof(telebuf), format, arglist);
 
-//	static int maxlen = 0;
-//	if (len > maxlen) {
-//		maxlen = len;
-//		DPRINT("maxlen %u\r\n", maxlen);
-//	}
+	if (!serial_line_open)
+	{
+		serial_line_sent = ring_has_room(&serial_ring, SERIAL_LINE_ROOM);
+		if (!serial_line_sent)
+		{
+			serial_ring.overflows++;
+		}
+	}
+	serial_line_open = (format[strlen(format) - 1] != '\n');
 
-	start_index = end_index;
-	remaining = (SERIAL_BUFFER_SIZE - start_index);
-	if (remaining < len) {
-		DPRINT("SERBUF discarding %u bytes\r\n", len - remaining);
+	if (serial_line_sent)
+	{
+		line = (char*)serial_reserve(SERIAL_LINE_MAX);
+		// only a line longer than allowed for can fail to fit part way
+		serial_line_sent = serial_reserved_in_ring;
 	}
-	if (remaining > 1)
+#if (USE_TELELOG == 1)
+	else
 	{
-		strncpy((char*)(&serial_buffer[start_index]), telebuf, MIN(remaining, len));
-		end_index = start_index + MIN(remaining, len);
-		serial_buffer[end_index] = '\0';
+		line = (char*)log_reserve(SERIAL_LINE_MAX);
+		serial_reserved_in_ring = false;
 	}
-	if (sb_index == 0)
+#endif
+	if (line == NULL)
 	{
-		udb_serial_start_sending_data();
+		return;
 	}
-	log_telemetry(telebuf, len);
-
-	va_end(arglist);
-}
-#else
-// add this text to the output buffer
-static void serial_output(const char* format, ...)
-{
-	int16_t start_index;
-	int16_t remaining;
-	va_list arglist;
-
 	va_start(arglist, format);
-
-	start_index = end_index;
-	remaining = SERIAL_BUFFER_SIZE - start_index;
-
-	if (remaining > 1)
+	len = vsnprintf(line, SERIAL_LINE_MAX, format, arglist);
+	va_end(arglist);
+	if (len > SERIAL_LINE_MAX - 1) len = SERIAL_LINE_MAX - 1; // truncated
+	if (len > 0)
 	{
-		udb_serial_stop_sending_data();
-		int16_t wrote = vsnprintf((char*)(&serial_buffer[start_index]), (size_t)remaining, format, arglist);
-		end_index = start_index + wrote;
-		udb_serial_start_sending_data();
+		serial_commit((const uint8_t*)line, len);
 	}
-	va_end(arglist);
 }
-#endif // USE_TELELOG
 
 int16_t udb_serial_callback_get_byte_to_send(void)
 {
-	uint8_t txchar = serial_buffer[ sb_index++ ];
-
-	if (txchar)
-	{
-		return txchar;
-	}
-	else
-	{
-		sb_index = 0;
-		end_index = 0;
-	}
-	return -1;
+	return ring_get(&serial_ring, RING_READER_TX);
 }
 
 static int16_t telemetry_counter = 15;
@@ -569,70 +586,138 @@ void telemetry_output_8hz(void)
 	}
 }
 
-#elif (SERIAL_OUTPUT_FORMAT == SERIAL_UDB_EXTRA)
+#elif (SERIAL_OUTPUT_FORMAT == SERIAL_UDB_EXTRA || SERIAL_OUTPUT_FORMAT == SERIAL_UDB_BINARY)
 
-void telemetry_output_8hz(void)
+#if (SERIAL_OUTPUT_FORMAT == SERIAL_UDB_BINARY)
+#include "telemetry_binary.h"
+#include "../MAVLink/include/checksum.h"
+
+#define SUE_BIN_KEYFRAME_INTERVAL   20  // F2A records between position keyframes (5 seconds)
+
+#define SUE_BIN_FRAME_MAX (SUE_BIN_HEADER_LEN + 255 + SUE_BIN_CRC_LEN)
+
+// Frames are built in place in the output ring, payload directly behind the header
+static uint8_t* sue_bin_frame;
+static uint8_t sue_bin_seq = 0;
+
+static char sue_bin_text[200];
+static int16_t sue_bin_text_len = 0;
+
+// Reserve room for the largest frame, returning where its payload goes
+static uint8_t* sue_bin_begin(void)
 {
-	int16_t i;
-	static int toggle = 0;
-	static boolean f13_print_prepare = false;
-	// F2: SERIAL_UDB_EXTRA format is printed out every other time, although it is being called at 8Hz, this
-	//     version will output at 4Hz.
-	static int16_t pwIn_save[NUM_INPUTS + 1];
-	static int16_t pwOut_save[NUM_OUTPUTS + 1];
-	
-	switch (telemetry_counter)
+	sue_bin_frame = serial_reserve(SUE_BIN_FRAME_MAX);
+	return sue_bin_frame ? &sue_bin_frame[SUE_BIN_HEADER_LEN] : NULL;
+}
+
+// Complete the header and CRC around a payload of len bytes, and send the frame
+static void sue_bin_send(uint8_t id, uint8_t len)
+{
+	uint16_t crc;
+
+	sue_bin_frame[0] = SUE_BIN_SYNC1;
+	sue_bin_frame[1] = SUE_BIN_SYNC2;
+	sue_bin_frame[2] = len;
+	sue_bin_frame[3] = SUE_BIN_SCHEMA_VERSION;
+	sue_bin_frame[4] = sue_bin_seq++;
+	sue_bin_frame[5] = id;
+	crc = crc_calculate(&sue_bin_frame[2], (uint16_t)(SUE_BIN_HEADER_LEN - 2 + len));
+	sue_bin_frame[SUE_BIN_HEADER_LEN + len] = (uint8_t)crc;
+	sue_bin_frame[SUE_BIN_HEADER_LEN + len + 1] = (uint8_t)(crc >> 8);
+	serial_commit(sue_bin_frame, SUE_BIN_HEADER_LEN + len + SUE_BIN_CRC_LEN);
+}
+
+// Pack record m of the given type as the payload of a new frame and send it,
+// or drop it if the output ring is full
+#define sue_bin_record(id, pack, m) \
+	do { \
+		uint8_t* payload = sue_bin_begin(); \
+		if (payload) sue_bin_send(id, pack(payload, m)); \
+	} while (0)
+
+// Collect the text of a low rate record, sending it as one TEXT frame when the line is complete
+static void sue_bin_text_output(const char* format, ...)
+{
+	sue_bin_text_t m;
+	int16_t remaining = sizeof(sue_bin_text) - sue_bin_text_len;
+	int16_t len;
+	va_list arglist;
+
+	va_start(arglist, format);
+	len = vsnprintf(&sue_bin_text[sue_bin_text_len], (size_t)remaining, format, arglist);
+	va_end(arglist);
+	if (len > remaining - 1) len = remaining - 1; // truncated
+	if (len > 0) sue_bin_text_len += len;
+
+	if (sue_bin_text_len && sue_bin_text[sue_bin_text_len - 1] == '\n')
+	{
+		m.text = (const uint8_t*)sue_bin_text;
+		m.text_count = (uint8_t)sue_bin_text_len;
+		sue_bin_record(SUE_BIN_ID_TEXT, sue_bin_pack_text, &m);
+		sue_bin_text_len = 0;
+	}
+}
+#define sue_output sue_bin_text_output
+#else
+#define sue_output serial_output
+#endif // SERIAL_UDB_BINARY
+
+// The low rate records, one of which is sent each time through until
+// telemetry_counter reaches zero.
+static void serial_udb_extra_static(int16_t record)
+{
+	switch (record)
 	{
 		case 15:
-			serial_output("F22:Sensors=%i,%i,%i,%i,%i,%i\r\n",
+			sue_output("F22:Sensors=%i,%i,%i,%i,%i,%i\r\n",
 				UDB_XACCEL.value, UDB_YACCEL.value,
 				UDB_ZACCEL.value + (Z_GRAVITY_SIGN ((int16_t)(2*GRAVITY))),
 				udb_xrate.value, udb_yrate.value, udb_zrate.value);
 			break;
 		case 14: 
-			serial_output("F21:Offsets=%i,%i,%i,%i,%i,%i\r\n",
+			sue_output("F21:Offsets=%i,%i,%i,%i,%i,%i\r\n",
 				UDB_XACCEL.offset, UDB_YACCEL.offset, UDB_ZACCEL.offset,
 				udb_xrate.offset, udb_yrate.offset, udb_zrate.offset);
 			break;
 		case 13:
-			serial_output("F15:IDA=");
-			serial_output(ID_VEHICLE_MODEL_NAME);
-			serial_output(":IDB=");
-			serial_output(ID_VEHICLE_REGISTRATION);
-			serial_output(":\r\n");
+			sue_output("F15:IDA=");
+			sue_output(ID_VEHICLE_MODEL_NAME);
+			sue_output(":IDB=");
+			sue_output(ID_VEHICLE_REGISTRATION);
+			sue_output(":\r\n");
 			break;
 		case 12:
-			serial_output("F16:IDC=");
-			serial_output(ID_LEAD_PILOT);
-			serial_output(":IDD=");
-			serial_output(ID_DIY_DRONES_URL);
-			serial_output(":\r\n");
+			sue_output("F16:IDC=");
+			sue_output(ID_LEAD_PILOT);
+			sue_output(":IDD=");
+			sue_output(ID_DIY_DRONES_URL);
+			sue_output(":\r\n");
 			break;
         case 11:
 #if ((FLIGHT_ANALYZER_TO_USE_NEUTUAL_DEFLECTION_VALUES == 1) && (AIRFRAME_TYPE == AIRFRAME_DELTA))
-            serial_output("F24:AIL=%i:ELEV=%i:\r\n",AILERON_OUTPUT_CHANNEL_NEUTRAL_DEFLECTION,ELEVATOR_OUTPUT_CHANNEL_NEUTRAL_DEFLECTION);
+            sue_output("F24:AIL=%i:ELEV=%i:\r\n",AILERON_OUTPUT_CHANNEL_NEUTRAL_DEFLECTION,ELEVATOR_OUTPUT_CHANNEL_NEUTRAL_DEFLECTION);
 #endif
             break;
 		case 10:
-			serial_output("F17:FD_FWD=%5.3f:TR_NAV=%5.3f:TR_FBW=%5.3f:\r\n",
+			sue_output("F17:FD_FWD=%5.3f:TR_NAV=%5.3f:TR_FBW=%5.3f:\r\n",
 			    turns.FeedForward, turns.TurnRateNav, turns.TurnRateFBW);
 			break;
 		case 9:
-			serial_output("F18:AOA_NRM=%5.3f:AOA_INV=%5.3f:EL_TRIM_NRM=%5.3f:EL_TRIM_INV=%5.3f:CRUISE_SPD=%5.3f:\r\n",
+			sue_output("F18:AOA_NRM=%5.3f:AOA_INV=%5.3f:EL_TRIM_NRM=%5.3f:EL_TRIM_INV=%5.3f:CRUISE_SPD=%5.3f:\r\n",
 			    turns.AngleOfAttackNormal, turns.AngleOfAttackInverted, turns.ElevatorTrimNormal,
 			    turns.ElevatorTrimInverted, turns.RefSpeed);
 			break;
 		case 8:
-			serial_output("F19:INPUTS:AIL=%i,%i:ELEV=%i,%i:THROT=%i,%i:RUDD=%i,%i:\r\n",
+			sue_output("F19:INPUTS:AIL=%i,%i:ELEV=%i,%i:THROT=%i,%i:RUDD=%i,%i:\r\n",
 			    AILERON_INPUT_CHANNEL, AILERON_CHANNEL_REVERSED, ELEVATOR_INPUT_CHANNEL,ELEVATOR_CHANNEL_REVERSED,
 			    THROTTLE_INPUT_CHANNEL, THROTTLE_CHANNEL_REVERSED, RUDDER_INPUT_CHANNEL,RUDDER_CHANNEL_REVERSED );
 			break;
         case 7:
-            serial_output("F25:OUTPUTS:AIL=%i:ELEV=%i:THROT=%i:RUDD=%i:\r\n",
+            sue_output("F25:OUTPUTS:AIL=%i:ELEV=%i:THROT=%i:RUDD=%i:\r\n",
 			    AILERON_OUTPUT_CHANNEL, ELEVATOR_OUTPUT_CHANNEL,THROTTLE_OUTPUT_CHANNEL, RUDDER_OUTPUT_CHANNEL);
             break;
 		case 6:
-			serial_output("F14:WIND_EST=%i:GPS_TYPE=%i:DR=%i:BOARD_TYPE=%i:AIRFRAME=%i:"
+			sue_output("F14:WIND_EST=%i:GPS_TYPE=%i:DR=%i:BOARD_TYPE=%i:AIRFRAME=%i:"
 			              "RCON=0x%X:TRAP_FLAGS=0x%X:TRAP_SOURCE=0x%lX:ALARMS=%i:"
 			              "CLOCK=%i:FP=%d:\r\n",
 			    WIND_ESTIMATION, GPS_TYPE, DEADRECKONING, BOARD_TYPE, AIRFRAME_TYPE,
@@ -640,27 +725,271 @@ void telemetry_output_8hz(void)
 			    CLOCK_CONFIG, FLIGHT_PLAN_TYPE);
 			break;
 		case 5:
-			serial_output("F4:R_STAB_A=%i:R_STAB_RD=%i:P_STAB=%i:Y_STAB_R=%i:Y_STAB_A=%i:AIL_NAV=%i:RUD_NAV=%i:AH_STAB=%i:AH_WP=%i:RACE=%i:\r\n",
+			sue_output("F4:R_STAB_A=%i:R_STAB_RD=%i:P_STAB=%i:Y_STAB_R=%i:Y_STAB_A=%i:AIL_NAV=%i:RUD_NAV=%i:AH_STAB=%i:AH_WP=%i:RACE=%i:\r\n",
 			    settings._.RollStabilizaionAilerons, settings._.RollStabilizationRudder, settings._.PitchStabilization, settings._.YawStabilizationRudder, settings._.YawStabilizationAileron,
 			    settings._.AileronNavigation, settings._.RudderNavigation, settings._.AltitudeholdStabilized, settings._.AltitudeholdWaypoint, settings._.RacingMode);
 			break;
 		case 4:
-			serial_output("F5:YAWKP_A=%5.3f:YAWKD_A=%5.3f:ROLLKP=%5.3f:ROLLKD=%5.3f:A_BOOST=%5.3f:A_BOOST=NULL\r\n",
+			sue_output("F5:YAWKP_A=%5.3f:YAWKD_A=%5.3f:ROLLKP=%5.3f:ROLLKD=%5.3f:A_BOOST=%5.3f:A_BOOST=NULL\r\n",
 			    gains.YawKPAileron, gains.YawKDAileron, gains.RollKP, gains.RollKD);
 			break;
 		case 3:
-			serial_output("F6:P_GAIN=%5.3f:P_KD=%5.3f:RUD_E_MIX=NULL:ROL_E_MIX=NULL:E_BOOST=%3.1f:\r\n",
+			sue_output("F6:P_GAIN=%5.3f:P_KD=%5.3f:RUD_E_MIX=NULL:ROL_E_MIX=NULL:E_BOOST=%3.1f:\r\n",
 			    gains.Pitchgain, gains.PitchKD, gains.ElevatorBoost);
 			break;
 		case 2:
-			serial_output("F7:Y_KP_R=%5.4f:Y_KD_R=%5.3f:RLKP_RUD=%5.3f:RLKD_RUD=%5.3f:RUD_BOOST=%5.3f:RTL_PITCH_DN=%5.3f:\r\n",
+			sue_output("F7:Y_KP_R=%5.4f:Y_KD_R=%5.3f:RLKP_RUD=%5.3f:RLKD_RUD=%5.3f:RUD_BOOST=%5.3f:RTL_PITCH_DN=%5.3f:\r\n",
 			    gains.YawKPRudder, gains.YawKDRudder, gains.RollKPRudder, gains.RollKDRudder, gains.RudderBoost, gains.RtlPitchDown);
 			break;
 		case 1:
-			serial_output("F8:H_MAX=%6.1f:H_MIN=%6.1f:MIN_THR=%3.2f:MAX_THR=%3.2f:PITCH_MIN_THR=%4.1f:PITCH_MAX_THR=%4.1f:PITCH_ZERO_THR=%4.1f:\r\n",
+			sue_output("F8:H_MAX=%6.1f:H_MIN=%6.1f:MIN_THR=%3.2f:MAX_THR=%3.2f:PITCH_MIN_THR=%4.1f:PITCH_MAX_THR=%4.1f:PITCH_ZERO_THR=%4.1f:\r\n",
 			    altit.HeightTargetMax, altit.HeightTargetMin, altit.AltHoldThrottleMin, altit.AltHoldThrottleMax,
 			    altit.AltHoldPitchMin, altit.AltHoldPitchMax, altit.AltHoldPitchHigh);
 			break;
+		default:
+			break;
+	}
+}
+
+#if (SERIAL_OUTPUT_FORMAT == SERIAL_UDB_BINARY)
+
+static int16_t pwIn_save[NUM_INPUTS + 1];
+static int16_t pwOut_save[NUM_OUTPUTS + 1];
+
+// Positions in F2A are sent as 16 bit offsets from the last keyframe. A new
+// keyframe is sent periodically, and as soon as an offset would overflow.
+static uint8_t sue_bin_kseq = 0;
+static uint8_t sue_bin_key_age = SUE_BIN_KEYFRAME_INTERVAL;
+static int32_t sue_bin_key_lat;
+static int32_t sue_bin_key_lon;
+static int32_t sue_bin_key_alt;
+static int32_t sue_bin_f2_tow;     // pairs F2B with the F2A sent before it
+
+static boolean fits_int16(int32_t value)
+{
+	return (value >= -32768 && value <= 32767);
+}
+
+static void sue_bin_output_f2a(void)
+{
+	sue_bin_f2a_t m;
+	int16_t i;
+
+	if (sue_bin_key_age >= SUE_BIN_KEYFRAME_INTERVAL ||
+	    !fits_int16(lat_gps.WW - sue_bin_key_lat) ||
+	    !fits_int16(lon_gps.WW - sue_bin_key_lon) ||
+	    !fits_int16(alt_sl_gps.WW - sue_bin_key_alt))
+	{
+		sue_bin_key_t k;
+
+		sue_bin_key_lat = lat_gps.WW;
+		sue_bin_key_lon = lon_gps.WW;
+		sue_bin_key_alt = alt_sl_gps.WW;
+		sue_bin_key_age = 0;
+		k.tow = tow.WW;
+		k.kseq = ++sue_bin_kseq;
+		k.lat = sue_bin_key_lat;
+		k.lon = sue_bin_key_lon;
+		k.alt = sue_bin_key_alt;
+		sue_bin_record(SUE_BIN_ID_KEY, sue_bin_pack_key, &k);
+	}
+	sue_bin_key_age++;
+
+	sue_bin_f2_tow = tow.WW;
+	m.tow = sue_bin_f2_tow;
+	m.status = (udb_flags._.radio_on << 2) | (dcm_flags._.nav_capable << 1) | state_flags._.GPS_steering;
+	m.kseq = sue_bin_kseq;
+	m.dlat = (int16_t)(lat_gps.WW - sue_bin_key_lat);
+	m.dlon = (int16_t)(lon_gps.WW - sue_bin_key_lon);
+	m.dalt = (int16_t)(alt_sl_gps.WW - sue_bin_key_alt);
+	m.wp = (uint8_t)waypointIndex;
+	for (i = 0; i < 9; i++)
+	{
+		m.rmat[i] = rmat[i];
+	}
+	m.cog = cog_gps.BB;
+	m.sog = sog_gps.BB;
+	m.cpu = udb_cpu_load();
+	m.airspeed = air_speed_3DIMU;
+	for (i = 0; i < 3; i++)
+	{
+		m.wind[i] = estimatedWind[i];
+#if (MAG_YAW_DRIFT == 1)
+		m.mag[i] = magFieldEarth[i];
+#else
+		m.mag[i] = 0;
+#endif // MAG_YAW_DRIFT
+	}
+	m.svs = svs;
+	m.hdop = hdop;
+	sue_bin_record(SUE_BIN_ID_F2A, sue_bin_pack_f2a, &m);
+}
+
+static void sue_bin_output_f2b(void)
+{
+	sue_bin_f2b_t m;
+	vect3_16t goal;
+
+	navigate_get_goal(&goal);
+	m.tow = sue_bin_f2_tow;
+	m.pwin = &pwIn_save[1];
+	m.pwin_count = NUM_INPUTS;
+	m.pwout = &pwOut_save[1];
+	m.pwout_count = NUM_OUTPUTS;
+	m.imu_loc[0] = IMUlocationx._.W1;
+	m.imu_loc[1] = IMUlocationy._.W1;
+	m.imu_loc[2] = IMUlocationz._.W1;
+	m.loc_err[0] = locationErrorEarth[0];
+	m.loc_err[1] = locationErrorEarth[1];
+	m.loc_err[2] = locationErrorEarth[2];
+	m.flags = state_flags.WW;
+	m.osc_fails = osc_fail_count;
+	m.imu_vel[0] = IMUvelocityx._.W1;
+	m.imu_vel[1] = IMUvelocityy._.W1;
+	m.imu_vel[2] = IMUvelocityz._.W1;
+	m.goal[0] = goal.x;
+	m.goal[1] = goal.y;
+	m.goal[2] = goal.z;
+	m.aero[0] = aero_force[0];
+	m.aero[1] = aero_force[1];
+	m.aero[2] = aero_force[2];
+#if (USE_BAROMETER_ALTITUDE == 1)
+	m.barom_temp = get_barometer_temperature();
+	m.barom_press = get_barometer_pressure();
+	m.barom_alt = get_barometer_altitude();
+#else
+	m.barom_temp = 0;
+	m.barom_press = 0;
+	m.barom_alt = 0;
+#endif
+#if (ANALOG_VOLTAGE_INPUT_CHANNEL != CHANNEL_UNUSED)
+	m.bat_volt = battery_voltage._.W1;
+#else
+	m.bat_volt = 0;
+#endif
+#if (ANALOG_CURRENT_INPUT_CHANNEL != CHANNEL_UNUSED)
+	m.bat_amp = battery_current._.W1;
+	m.bat_mah = battery_mAh_used._.W1;
+#else
+	m.bat_amp = 0;
+	m.bat_mah = 0;
+#endif
+	m.desired_height = desiredHeight;
+#if (RECORD_FREE_STACK_SPACE == 1)
+	extern uint16_t maxstack;
+	m.stack_free = (int16_t)(4096-maxstack);
+#else
+	m.stack_free = 0;
+#endif // RECORD_FREE_STACK_SPACE
+	sue_bin_record(SUE_BIN_ID_F2B, sue_bin_pack_f2b, &m);
+}
+
+static void sue_bin_output_f23(void)
+{
+	sue_bin_f23_t m;
+	int16_t i;
+
+	m.gps_errors = gps_parse_errors;
+	m.vdop = vdop;
+	for (i = 0; i < 3; i++)
+	{
+		m.rate_err[i] = rotationRateError[i];
+		m.tilt_err[i] = tiltError[i];
+		m.des_rate[i] = desiredRotationRateRadians[i];
+		m.omega_accum[i] = omegaAccum[i];
+	}
+	m.des_turn_rate = desiredTurnRateRadians;
+	m.elev_trim = elevatorLoadingTrim;
+	sue_bin_record(SUE_BIN_ID_F23, sue_bin_pack_f23, &m);
+}
+
+static void sue_bin_output_origin(void)
+{
+	sue_bin_f13_t origin;
+	sue_bin_f20_t trims;
+
+	origin.week = week_no.BB;
+	origin.lat = lat_origin.WW;
+	origin.lon = lon_origin.WW;
+	origin.alt = alt_origin.WW;
+	sue_bin_record(SUE_BIN_ID_F13, sue_bin_pack_f13, &origin);
+
+	trims.trim = (const int16_t*)&udb_pwTrim[1];
+	trims.trim_count = NUM_INPUTS;
+	sue_bin_record(SUE_BIN_ID_F20, sue_bin_pack_f20, &trims);
+}
+
+void telemetry_output_8hz(void)
+{
+	static boolean toggle = false;
+	int16_t i;
+
+	if (telemetry_counter)
+	{
+		serial_udb_extra_static(telemetry_counter);
+		telemetry_counter--;
+	}
+	else
+	{
+		// As with SERIAL_UDB_EXTRA, the F2 content is split over two passes, giving 4Hz
+		toggle = !toggle;
+		if (toggle)
+		{
+			sue_bin_output_f2a();
+
+			// Approximate time passing between each telemetry record, even though
+			// we may not have new GPS time data each time through.
+			if (tow.WW > 0) tow.WW += 250;
+
+			for (i = 0; i <= NUM_INPUTS; i++)
+				pwIn_save[i] = udb_pwIn[i];
+			for (i = 0; i <= NUM_OUTPUTS; i++)
+				pwOut_save[i] = udb_pwOut[i];
+		}
+		else
+		{
+			sue_bin_output_f2b();
+			sue_bin_output_f23();
+			if (state_flags._.f13_print_req == 1)
+			{
+				sue_bin_output_origin();
+				state_flags._.f13_print_req = 0;
+			}
+		}
+	}
+}
+
+#else // SERIAL_UDB_EXTRA
+
+void telemetry_output_8hz(void)
+{
+	int16_t i;
+	static int toggle = 0;
+	static boolean f13_print_prepare = false;
+	// F2: SERIAL_UDB_EXTRA format is printed out every other time, although it is being called at 8Hz, this
+	//     version will output at 4Hz.
+	static int16_t pwIn_save[NUM_INPUTS + 1];
+	static int16_t pwOut_save[NUM_OUTPUTS + 1];
+	
+	switch (telemetry_counter)
+	{
+		case 15:
+		case 14:
+		case 13:
+		case 12:
+		case 11:
+		case 10:
+		case 9:
+		case 8:
+		case 7:
+		case 6:
+		case 5:
+		case 4:
+		case 3:
+		case 2:
+		case 1:
+			serial_udb_extra_static(telemetry_counter);
+			break;
 		default:
 		{
 			// F2 below means "Format Revision 2: and is used by a Telemetry parser to invoke the right pattern matching
@@ -791,11 +1120,10 @@ void telemetry_output_8hz(void)
 	{
 		telemetry_counter--;
 	}
-#if (USE_TELELOG == 1)
-	log_swapbuf();
-#endif
 }
 
+#endif // SERIAL_UDB_BINARY
+
 #elif (SERIAL_OUTPUT_FORMAT == SERIAL_OSD_REMZIBI)
 
 #warning SERIAL_OSD_REMZIBI undergoing merge to trunk
@@ -919,6 +1247,11 @@ void telemetry_output_8hz(void)
 	checksum += ((union intbb)(IMUlocationx._.W1))._.B0 + ((union intbb)(IMUlocationx._.W1))._.B1;
 	checksum += ((union intbb)(IMUlocationy._.W1))._.B0 + ((union intbb)(IMUlocationy._.W1))._.B1;
 	checksum += ((union intbb)(IMUlocationz._.W1))._.B0 + ((union intbb)(IMUlocationz._.W1))._.B1;
+#if (CAM_TRACK_SEND_VELOCITY == 1)
+	checksum += ((union intbb)(IMUvelocityx._.W1))._.B0 + ((union intbb)(IMUvelocityx._.W1))._.B1;
+	checksum += ((union intbb)(IMUvelocityy._.W1))._.B0 + ((union intbb)(IMUvelocityy._.W1))._.B1;
+	checksum += ((union intbb)(IMUvelocityz._.W1))._.B0 + ((union intbb)(IMUvelocityz._.W1))._.B1;
+#endif
 
 	// Send location as TXXXXYYYYZZZZ*CC, at 8Hz
 	// Where T marks this as a camera Tracking message
@@ -927,10 +1260,19 @@ void telemetry_output_8hz(void)
 	// ZZZZ is the relative Z location in meters as a HEX value
 	// And *CC is an asterisk followed by the checksum byte in HEX.
 	// The checksum is just the sum of the previous 6 bytes % 256.
+	// With CAM_TRACK_SEND_VELOCITY, the velocity follows the location, as TXXXXYYYYZZZZUUUUVVVVWWWW*CC
+	// where UUUU, VVVV and WWWW are the X, Y and Z velocity in cm/sec, and the checksum is of all 12 bytes.
 
+#if (CAM_TRACK_SEND_VELOCITY == 1)
+	serial_output("T%04X%04X%04X%04X%04X%04X*%02X\r\n",
+	    IMUlocationx._.W1, IMUlocationy._.W1, IMUlocationz._.W1,
+	    IMUvelocityx._.W1, IMUvelocityy._.W1, IMUvelocityz._.W1,
+	    checksum);
+#else
 	serial_output("T%04X%04X%04X*%02X\r\n",
 	    IMUlocationx._.W1, IMUlocationy._.W1, IMUlocationz._.W1,
 	    checksum);
+#endif
 }
 #endif //(SERIAL_OUTPUT_FORMAT == SERIAL_DEBUG)
 
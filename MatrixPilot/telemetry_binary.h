@@ -0,0 +1,253 @@
+// This file is part of MatrixPilot.
+//
+// GENERATED by Tools/flight_analyzer/sue_binary_gen.py from sue_binary.xml
+// DO NOT EDIT - edit the schema and regenerate instead.
+
+#ifndef TELEMETRY_BINARY_H
+#define TELEMETRY_BINARY_H
+
+#define SUE_BIN_SYNC1              0xA5
+#define SUE_BIN_SYNC2              0x5E
+#define SUE_BIN_SCHEMA_VERSION     1
+#define SUE_BIN_HEADER_LEN         6
+#define SUE_BIN_CRC_LEN            2
+
+#define SUE_BIN_ID_KEY              1
+#define SUE_BIN_ID_F2A              2
+#define SUE_BIN_ID_F2B              3
+#define SUE_BIN_ID_F23              4
+#define SUE_BIN_ID_F13              5
+#define SUE_BIN_ID_F20              6
+#define SUE_BIN_ID_TEXT             127
+
+static inline uint8_t* sue_bin_put16(uint8_t* p, uint16_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	return p + 2;
+}
+
+static inline uint8_t* sue_bin_put32(uint8_t* p, uint32_t v)
+{
+	p = sue_bin_put16(p, (uint16_t)v);
+	return sue_bin_put16(p, (uint16_t)(v >> 16));
+}
+
+// Position keyframe. F2A deltas are relative to the last keyframe.
+typedef struct sue_bin_key {
+	uint32_t tow;
+	uint8_t kseq;
+	int32_t lat;
+	int32_t lon;
+	int32_t alt;
+} sue_bin_key_t;
+
+#define SUE_BIN_KEY_LEN 17
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_key(uint8_t* buf, const sue_bin_key_t* m)
+{
+	uint8_t* p = buf;
+
+	p = sue_bin_put32(p, (uint32_t)m->tow);
+	*p++ = (uint8_t)m->kseq;
+	p = sue_bin_put32(p, (uint32_t)m->lat);
+	p = sue_bin_put32(p, (uint32_t)m->lon);
+	p = sue_bin_put32(p, (uint32_t)m->alt);
+	return (uint8_t)(p - buf);
+}
+
+// Fast changing part of the F2 record.
+typedef struct sue_bin_f2a {
+	uint32_t tow;
+	uint8_t status;
+	uint8_t kseq;
+	int16_t dlat;
+	int16_t dlon;
+	int16_t dalt;
+	uint8_t wp;
+	int16_t rmat[9];
+	uint16_t cog;
+	int16_t sog;
+	uint8_t cpu;
+	uint16_t airspeed;
+	int16_t wind[3];
+	int16_t mag[3];
+	uint8_t svs;
+	uint8_t hdop;
+} sue_bin_f2a_t;
+
+#define SUE_BIN_F2A_LEN 52
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_f2a(uint8_t* buf, const sue_bin_f2a_t* m)
+{
+	uint8_t* p = buf;
+	uint8_t i;
+
+	p = sue_bin_put32(p, (uint32_t)m->tow);
+	*p++ = (uint8_t)m->status;
+	*p++ = (uint8_t)m->kseq;
+	p = sue_bin_put16(p, (uint16_t)m->dlat);
+	p = sue_bin_put16(p, (uint16_t)m->dlon);
+	p = sue_bin_put16(p, (uint16_t)m->dalt);
+	*p++ = (uint8_t)m->wp;
+	for (i = 0; i < 9; i++) p = sue_bin_put16(p, (uint16_t)m->rmat[i]);
+	p = sue_bin_put16(p, (uint16_t)m->cog);
+	p = sue_bin_put16(p, (uint16_t)m->sog);
+	*p++ = (uint8_t)m->cpu;
+	p = sue_bin_put16(p, (uint16_t)m->airspeed);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->wind[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->mag[i]);
+	*p++ = (uint8_t)m->svs;
+	*p++ = (uint8_t)m->hdop;
+	return (uint8_t)(p - buf);
+}
+
+// Slow changing part of the F2 record.
+typedef struct sue_bin_f2b {
+	uint32_t tow;
+	const int16_t* pwin;
+	uint8_t pwin_count;
+	const int16_t* pwout;
+	uint8_t pwout_count;
+	int16_t imu_loc[3];
+	int16_t loc_err[3];
+	uint16_t flags;
+	uint16_t osc_fails;
+	int16_t imu_vel[3];
+	int16_t goal[3];
+	int16_t aero[3];
+	int16_t barom_temp;
+	int32_t barom_press;
+	int32_t barom_alt;
+	int16_t bat_volt;
+	int16_t bat_amp;
+	int16_t bat_mah;
+	int16_t desired_height;
+	int16_t stack_free;
+} sue_bin_f2b_t;
+
+#define SUE_BIN_F2B_FIXED_LEN 60 // plus variable length arrays
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_f2b(uint8_t* buf, const sue_bin_f2b_t* m)
+{
+	uint8_t* p = buf;
+	uint8_t i;
+
+	p = sue_bin_put32(p, (uint32_t)m->tow);
+	*p++ = m->pwin_count;
+	for (i = 0; i < m->pwin_count; i++) p = sue_bin_put16(p, (uint16_t)m->pwin[i]);
+	*p++ = m->pwout_count;
+	for (i = 0; i < m->pwout_count; i++) p = sue_bin_put16(p, (uint16_t)m->pwout[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->imu_loc[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->loc_err[i]);
+	p = sue_bin_put16(p, (uint16_t)m->flags);
+	p = sue_bin_put16(p, (uint16_t)m->osc_fails);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->imu_vel[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->goal[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->aero[i]);
+	p = sue_bin_put16(p, (uint16_t)m->barom_temp);
+	p = sue_bin_put32(p, (uint32_t)m->barom_press);
+	p = sue_bin_put32(p, (uint32_t)m->barom_alt);
+	p = sue_bin_put16(p, (uint16_t)m->bat_volt);
+	p = sue_bin_put16(p, (uint16_t)m->bat_amp);
+	p = sue_bin_put16(p, (uint16_t)m->bat_mah);
+	p = sue_bin_put16(p, (uint16_t)m->desired_height);
+	p = sue_bin_put16(p, (uint16_t)m->stack_free);
+	return (uint8_t)(p - buf);
+}
+
+// Control loop internals.
+typedef struct sue_bin_f23 {
+	uint16_t gps_errors;
+	uint8_t vdop;
+	int16_t rate_err[3];
+	int16_t tilt_err[3];
+	int16_t des_rate[3];
+	int16_t omega_accum[3];
+	int16_t des_turn_rate;
+	int16_t elev_trim;
+} sue_bin_f23_t;
+
+#define SUE_BIN_F23_LEN 31
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_f23(uint8_t* buf, const sue_bin_f23_t* m)
+{
+	uint8_t* p = buf;
+	uint8_t i;
+
+	p = sue_bin_put16(p, (uint16_t)m->gps_errors);
+	*p++ = (uint8_t)m->vdop;
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->rate_err[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->tilt_err[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->des_rate[i]);
+	for (i = 0; i < 3; i++) p = sue_bin_put16(p, (uint16_t)m->omega_accum[i]);
+	p = sue_bin_put16(p, (uint16_t)m->des_turn_rate);
+	p = sue_bin_put16(p, (uint16_t)m->elev_trim);
+	return (uint8_t)(p - buf);
+}
+
+// Origin, sent once the origin has been captured.
+typedef struct sue_bin_f13 {
+	int16_t week;
+	int32_t lat;
+	int32_t lon;
+	int32_t alt;
+} sue_bin_f13_t;
+
+#define SUE_BIN_F13_LEN 14
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_f13(uint8_t* buf, const sue_bin_f13_t* m)
+{
+	uint8_t* p = buf;
+
+	p = sue_bin_put16(p, (uint16_t)m->week);
+	p = sue_bin_put32(p, (uint32_t)m->lat);
+	p = sue_bin_put32(p, (uint32_t)m->lon);
+	p = sue_bin_put32(p, (uint32_t)m->alt);
+	return (uint8_t)(p - buf);
+}
+
+// Radio trim values, sent with F13.
+typedef struct sue_bin_f20 {
+	const int16_t* trim;
+	uint8_t trim_count;
+} sue_bin_f20_t;
+
+#define SUE_BIN_F20_FIXED_LEN 1 // plus variable length arrays
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_f20(uint8_t* buf, const sue_bin_f20_t* m)
+{
+	uint8_t* p = buf;
+	uint8_t i;
+
+	*p++ = m->trim_count;
+	for (i = 0; i < m->trim_count; i++) p = sue_bin_put16(p, (uint16_t)m->trim[i]);
+	return (uint8_t)(p - buf);
+}
+
+// Low rate configuration records (F4-F8, F14-F22, F24, F25) in their ASCII form.
+typedef struct sue_bin_text {
+	const uint8_t* text;
+	uint8_t text_count;
+} sue_bin_text_t;
+
+#define SUE_BIN_TEXT_FIXED_LEN 1 // plus variable length arrays
+
+// Pack into buf, returning the payload length
+static inline uint8_t sue_bin_pack_text(uint8_t* buf, const sue_bin_text_t* m)
+{
+	uint8_t* p = buf;
+	uint8_t i;
+
+	*p++ = m->text_count;
+	for (i = 0; i < m->text_count; i++) *p++ = (uint8_t)m->text[i];
+	return (uint8_t)(p - buf);
+}
+
+#endif // TELEMETRY_BINARY_H
@@ -23,6 +23,8 @@
 #include "../libUDB/heartbeat.h"
 #include "telemetry.h"
 #include "telemetry_log.h"
+#include "log_index.h"
+#include "../libFlashFS/filesys.h"
 #if (WIN == 1 || NIX == 1 || PX4 == 1)
 #include <stdio.h>
 #include "../Tools/MatrixPilot-SIL/SIL-filesystem.h"
@@ -44,84 +46,146 @@ extern boolean inflight_state(void);
 #define LOGFILE_ENABLE_PIN PORTAbits.RA6  // DIG2
 #endif
 
-#define MIN(a,b) (((a)<(b))?(a):(b))
-#define MAX(a,b) (((a)>(b))?(a):(b))
+// The log has its own queue of TELELOG_BLOCKS blocks, so that the SD card
+// stalling does not hold up the telemetry link, nor a slow link the log.
+// Telemetry output reserves room for each record in the block being filled
+// at interrupt level, and telemetry_log() writes out each completed block
+// at background priority as a single sector sized write. The producer only
+// writes log_block_in and the consumer only log_block_out, so neither side
+// needs to disable interrupts.
+//
+// Each block starts with a header carrying a sequence number, the time the
+// block was started, and the loss counters, so that gaps can be found and
+// accounted for when the log is read back (see Tools/flight_analyzer/telelog.py).
+// Records are never split between blocks, the unused end of a block is zero.
+
+#define LOG_BLOCK_SIZE      512     // a whole sector
+#define LOG_BLOCK_SYNC1     0xA5
+#define LOG_BLOCK_SYNC2     0x4C
+#define LOG_BLOCK_VERSION   1
+
+typedef struct log_block_header {
+	uint8_t  sync1;
+	uint8_t  sync2;
+	uint8_t  version;
+	uint8_t  high_water;            // the most blocks ever waiting to be written
+	uint16_t seq;                   // block number, from 0 when the log was opened
+	uint16_t length;                // bytes of telemetry following the header
+	uint32_t time;                  // milliseconds since startup, when the block was started
+	uint32_t dropped;               // total bytes dropped since the log was opened
+} log_block_header_t;
+
+#define LOG_BLOCK_DATA      (LOG_BLOCK_SIZE - sizeof(log_block_header_t))
 
-#define LOGBUF_BUFFER_SIZE 512
+typedef struct log_block {
+	log_block_header_t header;
+	uint8_t data[LOG_BLOCK_DATA];
+} log_block_t;
+
+static log_block_t log_blocks[TELELOG_BLOCKS];
+static volatile uint8_t log_block_in = 0;   // the block being filled
+static volatile uint8_t log_block_out = 0;  // the next block to be written to file
+static volatile boolean log_accepting = false;
+static uint16_t log_fill = 0;               // bytes used in the block being filled
+static uint16_t log_seq = 0;
+static uint32_t log_dropped = 0;
+static uint8_t log_high_water = 0;
+static uint32_t log_size = 0;               // bytes written to the log file
 
-static char logbuf1[LOGBUF_BUFFER_SIZE+1];  // TODO: added 1 byte until buffer overflow confirmed good
-static char logbuf2[LOGBUF_BUFFER_SIZE+1];  // TODO: added 1 byte until buffer overflow confirmed good
-static volatile int lb1_end_index = 0;
-static volatile int lb2_end_index = 0;
-static volatile int lb_in_use = 1;
 static char logfile_name[13];
 static FILE* fsp = NULL;
 
 
-static int16_t log_append(char* logbuf, int index, const char* data, int len)
+// milliseconds since startup, kept from the heartbeat counter, which wraps.
+// Only called by the producer, which runs at least every few seconds.
+static uint32_t log_time(void)
 {
-	int16_t end_index = 0;
-	int16_t remaining = LOGBUF_BUFFER_SIZE - index;
+	static uint16_t last = 0;
+	static uint32_t ticks = 0;
+	uint16_t now = udb_heartbeat_counter;
 
-	if (remaining < len) {
-//		printf("LOGBUF discarding %u bytes\r\n", len - remaining);
-	}
-	if (remaining > 1)
-	{
-//		printf("start_index %u, remaining %u, len %u min %u\r\n", start_index, remaining, len, MIN(remaining, len));
-		strncpy((char*)(&logbuf[index]), data, MIN(remaining, len));
-		end_index = index + MIN(remaining, len);
-		logbuf[end_index] = '\0';
+	ticks += (uint16_t)(now - last);
+	last = now;
+	return ticks * (1000 / HEARTBEAT_HZ);
+}
 
-	}
-	return end_index;
+static void log_block_start(void)
+{
+	log_block_t* b = &log_blocks[log_block_in];
+
+	memset(b, 0, sizeof(log_block_t));
+	b->header.sync1 = LOG_BLOCK_SYNC1;
+	b->header.sync2 = LOG_BLOCK_SYNC2;
+	b->header.version = LOG_BLOCK_VERSION;
+	b->header.seq = log_seq++;
+	log_fill = 0;
 }
 
-// called from telemetry module at interrupt level to buffer new log data
-void log_telemetry(const char* data, int len)
+// hand the block being filled over to telemetry_log(), and start the next
+static boolean log_publish(void)
 {
-	if (lb_in_use == 1)
-	{
-		lb1_end_index = log_append(logbuf1, lb1_end_index, data, len);
-	}
-	else
+	log_block_t* b = &log_blocks[log_block_in];
+	uint8_t next = (log_block_in + 1) % TELELOG_BLOCKS;
+	uint8_t queued;
+
+	if (next == log_block_out)
 	{
-		lb2_end_index = log_append(logbuf2, lb2_end_index, data, len);
+		return false;   // every other block is still waiting to be written
 	}
+	queued = (next + TELELOG_BLOCKS - log_block_out) % TELELOG_BLOCKS;
+	if (queued > log_high_water) log_high_water = queued;
+	b->header.length = log_fill;
+	b->header.dropped = log_dropped;
+	b->header.high_water = log_high_water;
+	log_block_in = next;
+	log_block_start();
+	return true;
 }
 
-// called from telemetry module at interrrupt level to manage the log data buffers
-void log_swapbuf(void)
+uint8_t* log_reserve(uint16_t len)
 {
-	if (lb_in_use == 1)
+	uint32_t now = log_time();
+
+	if (!log_accepting)
 	{
-		lb_in_use = 2;
+		return NULL;
 	}
-	else
+	if (len > LOG_BLOCK_DATA || (log_fill + len > LOG_BLOCK_DATA && !log_publish()))
+	{
+		log_dropped += len;
+		return NULL;
+	}
+	if (log_fill == 0)
 	{
-		lb_in_use = 1;
+		log_blocks[log_block_in].header.time = now;
 	}
+	return &log_blocks[log_block_in].data[log_fill];
 }
 
-static int fs_nextlog(char* filename)
+void log_commit(uint16_t len)
 {
-	FILE* fp;
-	int i;
+	log_fill += len;
+}
+
+void log_append(const uint8_t* data, uint16_t len)
+{
+	uint8_t* p = log_reserve(len);
 
-	for (i = 0; i < 99; i++)
+	if (p)
 	{
-		sprintf(filename, "log%02u.txt", i);
-		fp = fopen(filename, "r");
-		if (fp != NULL)
-		{
-			fclose(fp);
-		}
-		else
-		{
-			return 1;
-		}
+		memcpy(p, data, len);
+		log_commit(len);
 	}
-	return 0;
+}
+
+uint32_t log_dropped_bytes(void)
+{
+	return log_dropped;
+}
+
+uint8_t log_queue_high_water(void)
+{
+	return log_high_water;
 }
 
 static void log_open(void)
@@ -131,15 +195,19 @@ static void log_open(void)
 	if (log_error) return;
 
 	log_close();            // just in case the calling code is dumb..
-	if (!fs_nextlog(logfile_name))
-	{
-		strcpy(logfile_name, "fp_log.txt");
-	}
+	strcpy(logfile_name, log_index_next_name());
 	fsp = fopen(logfile_name, "a");
 	if (fsp != NULL)
 	{
-		lb1_end_index = 0;  // empty the logfile ping-pong buffers
-		lb2_end_index = 0;
+		log_index_opened();
+		log_size = 0;
+		log_block_in = 0;
+		log_block_out = 0;
+		log_seq = 0;
+		log_dropped = 0;
+		log_high_water = 0;
+		log_block_start();
+		log_accepting = true;
 		telemetry_restart();// signal telemetry to send startup data again
 		printf("%s opened\r\n", logfile_name);
 	}
@@ -150,16 +218,46 @@ static void log_open(void)
 	}
 }
 
-// this may be called at interrupt or background level
+static void log_write_queued(FILE* fp)
+{
+	while (log_block_out != log_block_in)
+	{
+		log_size += fwrite(&log_blocks[log_block_out], 1, LOG_BLOCK_SIZE, fp);
+		log_block_out = (log_block_out + 1) % TELELOG_BLOCKS;
+	}
+}
+
+// This must only be called at background level, as the consumer. The
+// producers all run at interrupt level, so none can be part way through a
+// record while this runs, and once log_accepting is clear they add no more.
+// That leaves the block being filled free to be published from here.
 void log_close(void)
 {
 	FILE* fp = fsp;   // make a copy of our file pointer
 
 	if (fsp)
 	{
+		log_accepting = false;
 		fsp = NULL;     // close the door to any further writes
+		log_write_queued(fp);
+		if (log_fill)
+		{
+			// the queue has just been emptied, so there is room for the last block
+			if (log_publish())
+			{
+				log_write_queued(fp);
+			}
+			else
+			{
+				log_dropped += log_fill;
+			}
+		}
 		fclose(fp);   // and close up the file
-		printf("%s closed\r\n", logfile_name);
+		log_index_closed(log_size);
+		filesys_flush();    // write back the sectors cached since the log was opened
+		printf("%s closed, %lu bytes dropped, queue high water %u/%u blocks, %lu KB free for logs\r\n",
+		       logfile_name, (unsigned long)log_dropped, log_high_water, TELELOG_BLOCKS,
+		       (unsigned long)(log_index_free_bytes() / 1024));
 	}
 }
 
@@ -200,26 +298,29 @@ static void log_write(const char* str, int len)
 			DPRINT("ERROR: fwrite\r\n");
 			log_close();
 		}
+		else
+		{
+			log_size += len;
+		}
 	}
 }
 
-// called from mainloop at background priority to write buffered telemetry log data to log file
+// called from mainloop at background priority to write completed log blocks to the log file
 void telemetry_log(void)
 {
-	if (lb_in_use == 1)
+	static boolean indexed = false;
+
+	if (!indexed)   // on the first pass of the main loop, long before take off
 	{
-		if (lb2_end_index)
-		{
-			log_write(logbuf2, lb2_end_index);
-			lb2_end_index = 0;
-		}
+		log_index_init();
+		indexed = true;
 	}
-	else
+	while (fsp && log_block_out != log_block_in)
 	{
-		if (lb1_end_index)
+		log_write((const char*)&log_blocks[log_block_out], LOG_BLOCK_SIZE);
+		if (fsp)        // unless the write failed, and the log was closed
 		{
-			log_write(logbuf1, lb1_end_index);
-			lb1_end_index = 0;
+			log_block_out = (log_block_out + 1) % TELELOG_BLOCKS;
 		}
 	}
 	log_check();
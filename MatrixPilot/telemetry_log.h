@@ -19,9 +19,25 @@
 // along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
 
 
+#ifndef TELELOG_BLOCKS
+#define TELELOG_BLOCKS 4
+#endif
+
+// Write out what is queued and close the log. Only call at background level.
 void log_close(void);
-void log_swapbuf(void);
-void log_telemetry(const char* data, int len);
+
+// Called by telemetry output, at interrupt level, to reserve room for a record
+// of len bytes in the log queue, which is filled in place and then committed.
+// Returns NULL while no log is open, or if the queue is full, in which case the
+// record is counted as dropped. log_append() copies a record formatted elsewhere.
+uint8_t* log_reserve(uint16_t len);
+void log_commit(uint16_t len);
+void log_append(const uint8_t* data, uint16_t len);
+
+// bytes dropped as the queue was full, and the most blocks ever waiting to
+// be written to file, since the log was opened
+uint32_t log_dropped_bytes(void);
+uint8_t log_queue_high_water(void);
 
 // called from mainloop to write telemetry log data to flash
 void telemetry_log(void);
@@ -26,6 +26,8 @@
 #include "config.h"
 #include "states.h"
 #include "helicalTurnCntrl.h"
+#include "gainSchedule.h"
+#include "pidCntrl.h"
 #include "../libDCM/rmat.h"
 
 #include "gain_variables.h"
@@ -73,11 +75,13 @@ void yawCntrl(void)
 	}
 }
 
+// As in rollCntrl.c, the yaw rate damping is truncated on its own
 void normalYawCntrl(void)
 {
-	union longww rollStabilization;
-	union longww gyroYawFeedback;
-	union longww yawStabilization;
+	struct pidGains k = { 0, 0, 0 };
+	int16_t rollStabilization;
+	int16_t gyroYawFeedback;
+	int16_t yawStabilization;
 	int16_t ail_rud_mix;
 
 #ifdef TestGains
@@ -87,20 +91,21 @@ void normalYawCntrl(void)
 
 	if (settings._.YawStabilizationRudder && state_flags._.pitch_feedback)
 	{
-		gyroYawFeedback.WW   = - __builtin_mulsu(rotationRateError[2], yawkdrud);
-		yawStabilization.WW  = - __builtin_mulsu(tiltError[2], yawkprud);  // yaw orientation error in body frame
-		yawStabilization.WW +=   __builtin_mulsu(desiredRotationRateRadians[2], yawkpfdfwd); // feed forward term
+		k.kp  = scheduled_gain(yawkprud, GAIN_YAW);
+		k.kff = scheduled_gain(yawkpfdfwd, GAIN_YAW);
+		gyroYawFeedback  = cntrl_gain_neg(rotationRateError[2], scheduled_gain(yawkdrud, GAIN_YAW));
+		yawStabilization = pid_terms_neg(&k, tiltError[2], 0, desiredRotationRateRadians[2]); // yaw orientation error in body frame, and feed forward
 	}
 	else
 	{
-		gyroYawFeedback.WW = 0;
-		yawStabilization.WW = 0;
+		gyroYawFeedback = 0;
+		yawStabilization = 0;
 	}
 
-	rollStabilization.WW = 0; // default case is no roll rudder stabilization
+	rollStabilization = 0; // default case is no roll rudder stabilization
 	if (settings._.RollStabilizationRudder && state_flags._.pitch_feedback)
 	{
-		rollStabilization.WW = - __builtin_mulsu(tiltError[1], rollkprud); // this works right side up or upside down
+		rollStabilization = cntrl_gain_neg(tiltError[1], scheduled_gain(rollkprud, GAIN_YAW)); // this works right side up or upside down
 	}
 
 	if (state_flags._.pitch_feedback)
@@ -114,31 +119,29 @@ void normalYawCntrl(void)
 		ail_rud_mix = 0;
 	}
 
-	yaw_control = (int32_t)gyroYawFeedback._.W1 
-	            + (int32_t)rollStabilization._.W1 
-	            + (int32_t)yawStabilization._.W1 
-	            + ail_rud_mix;
+	yaw_control = cntrl_saturate((int32_t)gyroYawFeedback + rollStabilization + yawStabilization + ail_rud_mix,
+	                             CNTRL_MIN, CNTRL_MAX);
 	// Servo reversing is handled in servoMix.c
 }
 
 void hoverYawCntrl(void)
 {
-	union longww yawAccum;
-	union longww gyroYawFeedback;
+	int16_t yawStabilization;
+	int16_t gyroYawFeedback;
 	int16_t yawInput;
 	int16_t manualYawOffset;
 
 	if (state_flags._.pitch_feedback)
 	{
-		gyroYawFeedback.WW = __builtin_mulus(hoveryawkd, omegaAccum[2]);
+		gyroYawFeedback = cntrl_gain(omegaAccum[2], hoveryawkd);
 		yawInput = (udb_flags._.radio_on == 1) ? REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, udb_pwIn[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]) : 0;
 		manualYawOffset = yawInput * (int16_t)(RMAX/2000);
-		yawAccum.WW = __builtin_mulsu(rmat[6] + HOVERYOFFSET + manualYawOffset, hoveryawkp);
+		yawStabilization = cntrl_gain(rmat[6] + HOVERYOFFSET + manualYawOffset, hoveryawkp);
 	}
 	else
 	{
-		gyroYawFeedback.WW = 0;
-		yawAccum.WW = 0;
+		gyroYawFeedback = 0;
+		yawStabilization = 0;
 	}
-	yaw_control = (int32_t)yawAccum._.W1 - (int32_t)gyroYawFeedback._.W1;
+	yaw_control = cntrl_sub(yawStabilization, gyroYawFeedback);
 }
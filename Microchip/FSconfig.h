@@ -147,8 +147,8 @@
 
 #define MDD_MediaInitialize     MDD_AT45D_MediaInitialize
 #define MDD_MediaDetect         MDD_AT45D_MediaDetect
-#define MDD_SectorRead          MDD_AT45D_SectorRead
-#define MDD_SectorWrite         MDD_AT45D_SectorWrite
+#define MDD_MEDIA_SectorRead    MDD_AT45D_SectorRead
+#define MDD_MEDIA_SectorWrite   MDD_AT45D_SectorWrite
 #define MDD_InitIO              MDD_AT45D_InitIO
 #define MDD_ShutdownMedia       MDD_AT45D_ShutdownMedia
 #define MDD_WriteProtectState   MDD_AT45D_WriteProtectState
@@ -218,8 +218,8 @@
 
 #define MDD_MediaInitialize     MDD_EEPROM_MediaInitialize
 #define MDD_MediaDetect         MDD_EEPROM_MediaDetect
-#define MDD_SectorRead          MDD_EEPROM_SectorRead
-#define MDD_SectorWrite         MDD_EEPROM_SectorWrite
+#define MDD_MEDIA_SectorRead    MDD_EEPROM_SectorRead
+#define MDD_MEDIA_SectorWrite   MDD_EEPROM_SectorWrite
 #define MDD_InitIO              MDD_EEPROM_InitIO
 #define MDD_ShutdownMedia       MDD_EEPROM_ShutdownMedia
 #define MDD_WriteProtectState   MDD_EEPROM_WriteProtectState
@@ -235,4 +235,36 @@
 
 #endif
 
+// --------------------------------------------------------------------------
+// Sector cache
+// --------------------------------------------------------------------------
+// The number of 512 byte sectors kept by the write-back sector cache between
+// the file system and the AT45D or EEPROM media (libFlashFS/sector_cache.c),
+// zero to go straight to the media. Changed sectors reach the media when
+// flushed with filesys_flush(), as each log is closed, and as every other file
+// written is closed or removed through filesys_fclose() and filesys_remove().
+// Tools/SectorCacheBench measures the effect of the size on the sectors read
+// and written.
+
+#ifndef MDD_SECTOR_CACHE_SECTORS
+#ifdef USE_SD_INTERFACE_WITH_SPI
+#define MDD_SECTOR_CACHE_SECTORS 0
+#else
+#define MDD_SECTOR_CACHE_SECTORS 2
+#endif
+#endif
+
+#ifndef USE_SD_INTERFACE_WITH_SPI
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+#include "../libFlashFS/sector_cache.h"
+#define MDD_SectorRead          sector_cache_read
+#define MDD_SectorWrite         sector_cache_write
+#define MDD_SectorWriteThrough  sector_cache_write_through
+#else
+#define MDD_SectorRead          MDD_MEDIA_SectorRead
+#define MDD_SectorWrite         MDD_MEDIA_SectorWrite
+#define MDD_SectorWriteThrough  MDD_MEDIA_SectorWrite
+#endif
+#endif // USE_SD_INTERFACE_WITH_SPI
+
 #endif // _FSCONFIG_H_
@@ -0,0 +1,388 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// A host benchmark of aiming the camera at a moving target.
+//
+// The real MatrixPilot/cameraCntrl.c is built into this program, with
+// CAM_TARGET_PREDICTION set by the Makefile, and run at the 40Hz control rate
+// in waypoint mode. The target sends its location on the serial port as
+// SERIAL_CAM_TRACK does, at 8Hz, in whole meters, and CAM_TARGET_LATENCY late.
+// The plane flies along a path at 100m, banked as it turns, and its rmat and
+// gyros are worked out from the path. The camera servos follow their pulses
+// with a first order lag of CAM_SERVO_LATENCY, and their limits are not
+// applied.
+//
+// Each flight is scored by the angle between where the camera points and
+// where the target is, after the first 2 seconds, and by how many arctangents
+// (rect_to_polar16) cameraCntrl() takes a frame.
+//
+// Usage: cam_bench [-p] [-t]
+//   -p    the target sends only its location, not its velocity
+//   -t    time compute_camera_view() and cameraCntrl() instead, in nanoseconds per frame on this host
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "defines.h"
+#include "../libDCM/mathlibNAV.h"
+
+// The arctangents are counted, as they take most of the time of a solution on the dsPIC
+static uint32_t arctangents = 0;
+
+int16_t counted_rect_to_polar16(struct relative2D* xy)
+{
+	arctangents++;
+	return rect_to_polar16(xy);
+}
+#define rect_to_polar16 counted_rect_to_polar16
+
+#include "cameraCntrl.c"
+
+#define CNTRL_HZ        40
+#define DT              (1.0 / CNTRL_HZ)
+#define TRACK_HZ        8
+#define SETTLE_TIME     2.0
+#define FLIGHT_TIME     60.0
+#define HEIGHT          100.0
+#define GRAVITY_MPS2    9.81
+#define TIMED_FRAMES    100000
+#define TIMED_REPEATS   21
+
+// The parts of MatrixPilot the camera control uses
+fractional rmat[9];
+fractional omegagyro[3];
+union longww IMUlocationx, IMUlocationy, IMUlocationz;
+union longww IMUvelocityx, IMUvelocityy, IMUvelocityz;
+struct relative3D GPSlocation;
+union state_flags_int state_flags;
+int16_t udb_pwIn[NUM_INPUTS + 1];
+
+static boolean position_only = false;
+
+int16_t FindFirstBitFromLeft(int16_t input)
+{
+	int16_t bit;
+
+	for (bit = 15; bit >= 0; bit--)
+	{
+		if (input & (1 << bit)) return 16 - bit;
+	}
+	return 0;
+}
+
+// A path, in meters East and North, at a time in seconds
+struct path {
+	const char* name;
+	void (*plane)(double t, double p[2]);
+	void (*target)(double t, double p[2]);
+};
+
+// Circling a parked car at 120m and 16m/s
+static void orbit_plane(double t, double p[2])
+{
+	p[0] = 120.0 * sin(t * 16.0 / 120.0);
+	p[1] = 120.0 * cos(t * 16.0 / 120.0);
+}
+
+static void parked_target(double t, double p[2])
+{
+	p[0] = 0;
+	p[1] = 0;
+}
+
+// Circling a car driving North at 10m/s
+static void follow_plane(double t, double p[2])
+{
+	p[0] = 150.0 * sin(t * 20.0 / 150.0);
+	p[1] = 150.0 * cos(t * 20.0 / 150.0) + 10.0 * t;
+}
+
+static void driving_target(double t, double p[2])
+{
+	p[0] = 0;
+	p[1] = 10.0 * t;
+}
+
+// Weaving North at 15m/s, reversing the bank every 10 seconds, beside a car driving North
+// at 15m/s, 150m to the East
+static void weave_plane(double t, double p[2])
+{
+	p[0] = 60.0 * sin(t * 3.1416 / 10.0);
+	p[1] = 15.0 * t;
+}
+
+static void beside_target(double t, double p[2])
+{
+	p[0] = 150.0;
+	p[1] = 15.0 * t + 50.0;
+}
+
+static const struct path paths[] = {
+	{ "orbit",  orbit_plane,  parked_target   },
+	{ "follow", follow_plane, driving_target  },
+	{ "weave",  weave_plane,  beside_target   },
+};
+
+// The axes of the plane, West, North and Down, in the columns of R, as rmat
+static void attitude(const struct path* path, double t, double R[3][3], double v[2])
+{
+	double a[2], b[2], c[2];
+	double heading, turn_rate, speed, bank;
+	double f[3], l[3], x[3], z[3];
+	const double h = 0.01;
+	int16_t i;
+
+	path->plane(t - h, a);
+	path->plane(t, b);
+	path->plane(t + h, c);
+	v[0] = (c[0] - a[0]) / (2 * h);
+	v[1] = (c[1] - a[1]) / (2 * h);
+	speed = sqrt(v[0] * v[0] + v[1] * v[1]);
+	heading = atan2(v[0], v[1]);    // clockwise from North
+	turn_rate = atan2((b[0] - a[0]) * (c[1] - b[1]) - (b[1] - a[1]) * (c[0] - b[0]),
+	                  (b[0] - a[0]) * (c[0] - b[0]) + (b[1] - a[1]) * (c[1] - b[1])) / -h;
+	bank = atan(speed * turn_rate / GRAVITY_MPS2);
+
+	f[0] = -sin(heading); f[1] = cos(heading); f[2] = 0;
+	l[0] =  cos(heading); l[1] = sin(heading); l[2] = 0;
+	for (i = 0; i < 3; i++)
+	{
+		x[i] = cos(bank) * l[i] - sin(bank) * (i == 2);
+	}
+	z[0] = x[1] * f[2] - x[2] * f[1];
+	z[1] = x[2] * f[0] - x[0] * f[2];
+	z[2] = x[0] * f[1] - x[1] * f[0];
+	for (i = 0; i < 3; i++)
+	{
+		R[i][0] = x[i];
+		R[i][1] = f[i];
+		R[i][2] = z[i];
+	}
+}
+
+static int16_t clip16(double x)
+{
+	if (x > 32767) return 32767;
+	if (x < -32768) return -32768;
+	return (int16_t)floor(x + 0.5);
+}
+
+// Set rmat, the gyros, and the location and velocity of the plane
+static void set_plane(const struct path* path, double t, double p[2])
+{
+	double R[3][3], before[3][3], after[3][3], v[2];
+	double omega[3];
+	int16_t i, j, k;
+
+	attitude(path, t, R, v);
+	attitude(path, t - DT / 2, before, v);
+	attitude(path, t + DT / 2, after, v);
+	attitude(path, t, R, v);
+	path->plane(t, p);
+
+	// rmat.c turns rmat by R = R * (I + [omega]x) for the gyros
+	for (i = 0; i < 3; i++)
+	{
+		for (j = 0; j < 3; j++)
+		{
+			rmat[i * 3 + j] = clip16(R[i][j] * RMAX);
+		}
+	}
+	for (i = 0; i < 3; i++)
+	{
+		double d[3];
+		for (j = 0; j < 3; j++)
+		{
+			d[j] = 0;
+			for (k = 0; k < 3; k++)
+			{
+				d[j] += R[k][i] * (after[k][j] - before[k][j]) / DT;
+			}
+		}
+		if (i == 2) omega[0] = d[1];
+		if (i == 0) omega[1] = d[2];
+		if (i == 1) omega[2] = d[0];
+	}
+	for (i = 0; i < 3; i++)
+	{
+		omegagyro[i] = clip16(omega[i] * RMAX / (3.0 * SCALEGYRO));
+	}
+	IMUlocationx.WW = (int32_t)(p[0] * 65536.0);
+	IMUlocationy.WW = (int32_t)(p[1] * 65536.0);
+	IMUlocationz.WW = (int32_t)(HEIGHT * 65536.0);
+	IMUvelocityx.WW = (int32_t)(v[0] * 100.0 * 65536.0);
+	IMUvelocityy.WW = (int32_t)(v[1] * 100.0 * 65536.0);
+	IMUvelocityz.WW = 0;
+}
+
+// Send the target's location, and its velocity, as the serial port receives them
+static void send_target(const struct path* path, double t)
+{
+	double a[2], c[2];
+	int16_t words[6];
+	int16_t i, count;
+
+	path->target(t, a);
+	words[0] = clip16(a[0]);
+	words[1] = clip16(a[1]);
+	words[2] = 0;
+	path->target(t - 0.05, a);
+	path->target(t + 0.05, c);
+	words[3] = clip16((c[0] - a[0]) * 1000.0);
+	words[4] = clip16((c[1] - a[1]) * 1000.0);
+	words[5] = 0;
+	count = position_only ? 3 : 6;
+
+	camera_live_begin();
+	for (i = 0; i < count; i++)
+	{
+		camera_live_received_byte((uint16_t)words[i] >> 8);
+		camera_live_received_byte(words[i] & 0xFF);
+	}
+	camera_live_commit();
+}
+
+// The direction of the camera, in the plane's reference, from its servo pulses
+static void camera_direction(double pitch_pwm, double yaw_pwm, double u[3])
+{
+	double pitch = (pitch_pwm + pitch_offset_centred_pwm) / pitch_servo_high_ratio * 2 * M_PI;
+	double yaw   = (yaw_pwm   + yaw_offset_centred_pwm  ) / yaw_servo_high_ratio   * 2 * M_PI;
+
+	u[0] = -cos(pitch) * sin(yaw);
+	u[1] =  cos(pitch) * cos(yaw);
+	u[2] =  sin(pitch);
+}
+
+static void fly(const struct path* path)
+{
+	double p[2], target[2], g[3], b[3], u[3];
+	double R[3][3], v[2];
+	double pitch_pwm = -pitch_offset_centred_pwm, yaw_pwm = -yaw_offset_centred_pwm;
+	double t, error, sum = 0, worst = 0, next_track = 0;
+	double lag = 1.0 - exp(-DT / CAM_SERVO_LATENCY);
+	int32_t frame, scored = 0;
+	int16_t i, j;
+
+	camera_live_commit_values((struct relative3D){ 0, 0, 0 });
+	arctangents = 0;
+	for (frame = 0; frame < FLIGHT_TIME * CNTRL_HZ; frame++)
+	{
+		t = frame * DT;
+		if (t >= next_track)
+		{
+			send_target(path, t - CAM_TARGET_LATENCY);
+			next_track += 1.0 / TRACK_HZ;
+		}
+		set_plane(path, t, p);
+		compute_camera_view();
+		cameraCntrl();
+
+		pitch_pwm += (cam_pitch_servo_pwm_delta - pitch_pwm) * lag;
+		yaw_pwm   += (cam_yaw_servo_pwm_delta   - yaw_pwm)   * lag;
+
+		// the angle between the camera and the target, from the plane
+		path->target(t, target);
+		attitude(path, t, R, v);
+		g[0] = -(target[0] - p[0]);
+		g[1] =  (target[1] - p[1]);
+		g[2] =  HEIGHT;
+		for (i = 0; i < 3; i++)
+		{
+			b[i] = 0;
+			for (j = 0; j < 3; j++)
+			{
+				b[i] += R[j][i] * g[j];
+			}
+		}
+		camera_direction(pitch_pwm, yaw_pwm, u);
+		error = acos((u[0] * b[0] + u[1] * b[1] + u[2] * b[2]) /
+		             sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2])) * 180.0 / M_PI;
+		if (t >= SETTLE_TIME)
+		{
+			sum += error * error;
+			if (error > worst) worst = error;
+			scored++;
+		}
+	}
+	printf("  %-8s %6.2f deg rms %6.2f deg max %6.2f arctangents/frame\n",
+	       path->name, sqrt(sum / scored), worst, (double)arctangents / frame);
+}
+
+static double elapsed_ns(struct timespec* start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+	return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+// The fastest of several runs is taken, as the least disturbed by anything else on the host
+static void time_frames(const struct path* path)
+{
+	struct timespec start;
+	double p[2], ns, best = 0;
+	int32_t frame;
+	int16_t repeat;
+
+	camera_live_commit_values((struct relative3D){ 0, 0, 0 });
+	set_plane(path, 10.0, p);
+	for (repeat = 0; repeat < TIMED_REPEATS; repeat++)
+	{
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		for (frame = 0; frame < TIMED_FRAMES; frame++)
+		{
+			compute_camera_view();
+			cameraCntrl();
+		}
+		ns = elapsed_ns(&start) / TIMED_FRAMES;
+		if (repeat == 0 || ns < best) best = ns;
+	}
+	printf("  %-8s %6.2f ns\n", path->name, best);
+}
+
+int main(int argc, char** argv)
+{
+	boolean timing = false;
+	int16_t i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-p") == 0) position_only = true;
+		else if (strcmp(argv[i], "-t") == 0) timing = true;
+		else
+		{
+			fprintf(stderr, "usage: cam_bench [-p] [-t]\n");
+			return 1;
+		}
+	}
+	state_flags._.GPS_steering = 1;     // waypoint mode
+	state_flags._.pitch_feedback = 1;
+
+	printf("CAM_TARGET_PREDICTION %i%s\n", CAM_TARGET_PREDICTION, position_only ? ", location only" : "");
+	for (i = 0; i < (int16_t)(sizeof(paths) / sizeof(paths[0])); i++)
+	{
+		if (timing) time_frames(&paths[i]);
+		else fly(&paths[i]);
+	}
+	return 0;
+}
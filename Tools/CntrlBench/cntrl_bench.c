@@ -0,0 +1,615 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// A host test and benchmark of the roll, pitch, yaw, altitude and air speed
+// control loops.
+//
+// The real controller sources are built into this program, with
+// ALTITUDE_GAINS_VARIABLE set by the Makefile, and run at the 40Hz control
+// rate. A simple model of the aircraft closes the loops for a set of steps:
+// in roll, pitch and yaw, in a coordinated turn, in altitude and in air
+// speed, and while hovering. The response is printed every 10th step, and a
+// checksum of every output of every step is printed at the end of each one.
+// Last come the same loops with random inputs, flags and flight modes.
+//
+// responses_0.txt and responses_1.txt are the output of this program with the
+// control loops as they were before they used pidCntrl.h, so any change in
+// the arithmetic of the loops shows up as a difference from them.
+//
+// Usage: cntrl_bench [-t]
+//   -t    time the control loops instead, in nanoseconds per call on this host,
+//         and count the hardware divides in each call
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "defines.h"
+
+// The hardware divides in the loops are counted, as each takes 18 cycles on
+// the dsPIC, which the times on this host do not show.
+static uint32_t divides = 0;
+#define __builtin_divsd(num, den) (divides++, __builtin_divsd(num, den))
+
+#include "rollCntrl.c"
+#include "pitchCntrl.c"
+#include "yawCntrl.c"
+#include "airspeedCntrl.c"
+#include "altitudeCntrl.c"
+#include "altitudeCntrlVariable.c"
+
+#define CNTRL_HZ        40
+#define DT              (1.0 / CNTRL_HZ)
+#define PRINT_EVERY     10
+#define TIMED_CALLS     1000000
+#define TIMED_REPEATS   21
+#define FUZZ_STEPS      20000
+
+// The parts of MatrixPilot the control loops use
+int16_t tiltError[3];
+int16_t desiredRotationRateRadians[3];
+int16_t rotationRateError[3];
+fractional omegaAccum[3];
+fractional omegagyro[3];
+fractional rmat[9];
+union longww IMUlocationx, IMUlocationy, IMUlocationz;
+union longww IMUvelocityx, IMUvelocityy, IMUvelocityz;
+int16_t estimatedWind[3];
+int16_t forward_ground_speed;
+uint16_t air_speed_3DIMU;
+int16_t tofinish_line;
+uint16_t yawkprud;
+int16_t pitch_control;
+int16_t roll_control;
+int16_t yaw_control;
+int16_t throttle_control;
+int16_t udb_pwIn[NUM_INPUTS + 1];
+int16_t udb_pwTrim[NUM_INPUTS + 1];
+union udb_fbts_byte udb_flags;
+union state_flags_int state_flags;
+union bfbts_word desired_behavior;
+int16_t current_orientation;
+union settings_word settings;
+struct gains_variables gains;
+struct turns_variables turns;
+struct altit_variables altit;
+struct hover_variables hover;
+
+static boolean hover_ok;
+static boolean inverted_ok;
+static int16_t nav_height;
+static int16_t nav_deflection;
+
+int16_t FindFirstBitFromLeft(int16_t input)
+{
+	int16_t bit;
+
+	for (bit = 15; bit >= 0; bit--)
+	{
+		if (input & (1 << bit)) return 16 - bit;
+	}
+	return 0;
+}
+
+boolean canStabilizeHover(void)
+{
+	return hover_ok;
+}
+
+boolean canStabilizeInverted(void)
+{
+	return inverted_ok;
+}
+
+int16_t navigate_desired_height(void)
+{
+	return nav_height;
+}
+
+int16_t navigate_determine_deflection(char navType)
+{
+	return nav_deflection;
+}
+
+int16_t udb_servo_pulsesat(int32_t pw)
+{
+	if (pw > SERVOMAX) pw = SERVOMAX;
+	if (pw < SERVOMIN) pw = SERVOMIN;
+	return (int16_t)pw;
+}
+
+#if (USE_SONAR_INPUT != 0)
+void calculate_sonar_height_above_ground(void)
+{
+}
+#endif
+
+#if (GAIN_SCHEDULING == 1)
+uint16_t scheduled_gain(uint16_t gain, gain_loop_t loop)
+{
+	return gain;
+}
+#endif
+
+static void set_gains(void)
+{
+	gains.YawKPAileron          = YAWKP_AILERON;
+	gains.YawKDAileron          = YAWKD_AILERON;
+	gains.RollKP                = ROLLKP;
+	gains.RollKD                = ROLLKD;
+	gains.Pitchgain             = PITCHGAIN;
+	gains.PitchKD               = PITCHKD;
+	gains.YawKPRudder           = YAWKP_RUDDER;
+	gains.YawKDRudder           = YAWKD_RUDDER;
+	gains.RollKPRudder          = ROLLKP_RUDDER;
+	gains.RollKDRudder          = ROLLKD_RUDDER;
+	gains.RtlPitchDown          = RTL_PITCH_DOWN;
+	turns.FeedForward           = FEED_FORWARD;
+	hover.HoverRollKP           = HOVER_ROLLKP;
+	hover.HoverRollKD           = HOVER_ROLLKD;
+	hover.HoverPitchGain        = HOVER_PITCHGAIN;
+	hover.HoverPitchKD          = HOVER_PITCHKD;
+	hover.HoverPitchOffset      = HOVER_PITCH_OFFSET;
+	hover.HoverYawKP            = HOVER_YAWKP;
+	hover.HoverYawKD            = HOVER_YAWKD;
+	hover.HoverYawOffset        = HOVER_YAW_OFFSET;
+	hover.HoverPitchTowardsWP   = HOVER_PITCH_TOWARDS_WP;
+	hover.HoverNavMaxPitchRadius = HOVER_NAV_MAX_PITCH_RADIUS;
+	altit.DesiredSpeed          = DESIRED_SPEED;
+	altit.HeightMargin          = HEIGHT_MARGIN;
+	altit.HeightTargetMax       = HEIGHT_TARGET_MAX;
+	altit.HeightTargetMin       = HEIGHT_TARGET_MIN;
+	altit.AltHoldThrottleMin    = ALT_HOLD_THROTTLE_MIN;
+	altit.AltHoldThrottleMax    = ALT_HOLD_THROTTLE_MAX;
+	altit.AltHoldPitchMin       = ALT_HOLD_PITCH_MIN;
+	altit.AltHoldPitchMax       = ALT_HOLD_PITCH_MAX;
+	altit.AltHoldPitchHigh      = ALT_HOLD_PITCH_HIGH;
+	yawkprud = (uint16_t)(YAWKP_RUDDER*RMAX);
+
+	init_rollCntrl();
+	init_pitchCntrl();
+	init_yawCntrl();
+	init_airspeedCntrl();
+	init_altitudeCntrl();
+	init_altitudeCntrlVariable();
+}
+
+// The aircraft: attitude errors and rates about the three axes, and the
+// height and air speed, driven by the control outputs
+static double angle[3], rate[3], target[3], targetRate[3];
+static double height, climb, airSpeed, pitchAngle;
+
+// The sense in which each of pitch, roll and yaw control turns the aircraft
+static const double controlSense[3] = { -1.0, 1.0, 1.0 };
+
+static int16_t clip16(double x)
+{
+	if (x > 32767.0) return 32767;
+	if (x < -32767.0) return -32767;
+	return (int16_t)floor(x + 0.5);
+}
+
+static void reset_aircraft(void)
+{
+	memset(angle, 0, sizeof(angle));
+	memset(rate, 0, sizeof(rate));
+	memset(target, 0, sizeof(target));
+	memset(targetRate, 0, sizeof(targetRate));
+	height = 200.0;
+	climb = 0.0;
+	airSpeed = DESIRED_SPEED;
+	pitchAngle = 0.0;
+
+	hover_ok = false;
+	inverted_ok = false;
+	nav_height = (int16_t)height;
+	nav_deflection = 0;
+	current_orientation = F_NORMAL;
+	desired_behavior.W = 0;
+	state_flags.WW = 0;
+	state_flags._.pitch_feedback = 1;
+	state_flags._.altitude_hold_throttle = 1;
+	state_flags._.altitude_hold_pitch = 1;
+	state_flags._.GPS_steering = 1;
+	settings.W = 0;
+	settings._.RollStabilizaionAilerons = 1;
+	settings._.RollStabilizationRudder = 1;
+	settings._.PitchStabilization = 1;
+	settings._.YawStabilizationRudder = 1;
+	settings._.YawStabilizationAileron = 1;
+	settings._.AileronNavigation = 1;
+	settings._.AltitudeholdStabilized = AH_FULL;
+	udb_flags._.radio_on = 1;
+	memset(udb_pwIn, 0, sizeof(udb_pwIn));
+	memset(udb_pwTrim, 0, sizeof(udb_pwTrim));
+	udb_pwIn[THROTTLE_INPUT_CHANNEL] = 3600;
+	udb_pwTrim[THROTTLE_INPUT_CHANNEL] = 2000;
+	udb_pwIn[AILERON_INPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] = 3000;
+	udb_pwIn[ELEVATOR_INPUT_CHANNEL] = udb_pwTrim[ELEVATOR_INPUT_CHANNEL] = 3000;
+	udb_pwIn[RUDDER_INPUT_CHANNEL] = udb_pwTrim[RUDDER_INPUT_CHANNEL] = 3000;
+	tofinish_line = 100;
+	memset(rmat, 0, sizeof(rmat));
+	rmat[0] = rmat[4] = rmat[8] = RMAX;
+	memset(estimatedWind, 0, sizeof(estimatedWind));
+	throttleFiltered.WW = 0;
+	throttleFiltered._.W1 = udb_pwIn[THROTTLE_INPUT_CHANNEL];
+	filterManual = false;
+	pitchAltitudeAdjust = 0;
+#if (ALTITUDE_GAINS_VARIABLE == 1)
+	airspeedError = 0;
+	airspeed_error_integral.WW = 0;
+#endif
+	set_gains();
+}
+
+// What the DCM and the helical turn controller would hand the control loops
+static void sense_aircraft(void)
+{
+	int16_t axis;
+	double groundSpeed = airSpeed * cos(pitchAngle);
+
+	for (axis = 0; axis < 3; axis++)
+	{
+		tiltError[axis] = clip16(sin(angle[axis] - target[axis]) * RMAX);
+		desiredRotationRateRadians[axis] = clip16(targetRate[axis] * RMAX / 16.0);
+		rotationRateError[axis] = clip16((rate[axis] - targetRate[axis]) * RADPERSEC);
+		omegaAccum[axis] = clip16(rate[axis] * RADPERSEC);
+		omegagyro[axis] = omegaAccum[axis];
+	}
+	rmat[6] = clip16(sin(angle[2]) * RMAX);
+	rmat[7] = clip16(-sin(angle[1]) * RMAX);
+	rmat[8] = clip16(cos(angle[0]) * cos(angle[1]) * RMAX);
+	IMUlocationz.WW = (int32_t)(height * 65536.0);
+	IMUvelocityx.WW = (int32_t)(groundSpeed * 100.0 * 65536.0);
+	IMUvelocityy.WW = 0;
+	IMUvelocityz.WW = (int32_t)(climb * 100.0 * 65536.0);
+	forward_ground_speed = clip16(groundSpeed * 100.0);
+	air_speed_3DIMU = (uint16_t)(airSpeed * 100.0);
+}
+
+// Each axis turns at a rate set by its control, with a lag. The throttle and
+// pitch adjustment of the altitude loop set the climb and the air speed.
+static void fly_aircraft(void)
+{
+	int16_t axis;
+	int16_t control[3];
+	double thrust;
+
+	control[0] = pitch_control;
+	control[1] = roll_control;
+	control[2] = yaw_control;
+	for (axis = 0; axis < 3; axis++)
+	{
+		double commanded = controlSense[axis] * 3.0 * control[axis] / SERVORANGE;
+		rate[axis] += (commanded - rate[axis]) * DT / 0.15;
+		angle[axis] += rate[axis] * DT;
+		target[axis] += targetRate[axis] * DT;
+	}
+	pitchAngle += (pitchAltitudeAdjust / (double)RMAX - pitchAngle) * DT / 0.5;
+	thrust = (udb_pwTrim[THROTTLE_INPUT_CHANNEL] + throttle_control - 2000) / 2000.0;
+	airSpeed += (8.0 * thrust - 9.81 * sin(pitchAngle) - 0.004 * airSpeed * airSpeed) * DT;
+	climb = airSpeed * sin(pitchAngle);
+	height += climb * DT;
+}
+
+static uint32_t checksum;
+
+static void add_to_checksum(int32_t value)
+{
+	int16_t i;
+
+	for (i = 0; i < 4; i++)
+	{
+		checksum = (checksum ^ (uint8_t)(value >> (8 * i))) * 16777619u;
+	}
+}
+
+static void run_control_loops(void)
+{
+#if (ALTITUDE_GAINS_VARIABLE == 1)
+	airspeedCntrl();
+#endif
+	rollCntrl();
+	pitchCntrl();
+	yawCntrl();
+	altitudeCntrl();
+
+	add_to_checksum(roll_control);
+	add_to_checksum(pitch_control);
+	add_to_checksum(yaw_control);
+	add_to_checksum(throttle_control);
+	add_to_checksum(pitchAltitudeAdjust);
+	add_to_checksum(desiredHeight);
+	add_to_checksum(throttleFiltered.WW);
+#if (ALTITUDE_GAINS_VARIABLE == 1)
+	add_to_checksum(airspeedError);
+	add_to_checksum(airspeed_error_integral.WW);
+#endif
+}
+
+typedef void (*scenario_setup)(int32_t step);
+
+static void step_roll(int32_t step)     { target[1] = 0.5; }
+static void step_pitch(int32_t step)    { target[0] = 0.2; }
+static void step_yaw(int32_t step)      { target[2] = 0.1; }
+static void step_turn(int32_t step)     { targetRate[1] = 0.1; targetRate[2] = 0.3; targetRate[0] = 0.05; }
+static void step_climb(int32_t step)    { nav_height = 260; }
+static void step_descend(int32_t step)  { nav_height = 120; }
+
+static void step_hover(int32_t step)
+{
+	hover_ok = true;
+	current_orientation = F_HOVER;
+	desired_behavior._.hover = 1;
+	target[0] = 0.3;
+	nav_deflection = (step < 80) ? 500 : -500;
+	tofinish_line = 100 - step / 4;
+}
+
+static void step_land(int32_t step)
+{
+	desired_behavior._.land = 1;
+	nav_height = 150;
+}
+
+static void step_stabilised(int32_t step)
+{
+	state_flags._.GPS_steering = 0;
+	udb_pwIn[THROTTLE_INPUT_CHANNEL] = 2000 + 20 * step;
+	if (udb_pwIn[THROTTLE_INPUT_CHANNEL] > 4000) udb_pwIn[THROTTLE_INPUT_CHANNEL] = 4000;
+}
+
+static void step_inverted(int32_t step)
+{
+	inverted_ok = true;
+	desired_behavior._.inverted = 1;
+	current_orientation = F_INVERTED;
+	target[1] = -0.4;
+	udb_pwIn[AILERON_INPUT_CHANNEL] = 3200;
+}
+
+static struct {
+	const char* name;
+	scenario_setup setup;
+	int32_t steps;
+} scenarios[] = {
+	{ "roll step",      step_roll,          120 },
+	{ "pitch step",     step_pitch,         120 },
+	{ "yaw step",       step_yaw,           120 },
+	{ "turn",           step_turn,          160 },
+	{ "climb",          step_climb,         800 },
+	{ "descend",        step_descend,       800 },
+	{ "hover",          step_hover,         160 },
+	{ "land",           step_land,          400 },
+	{ "stabilised",     step_stabilised,    200 },
+	{ "inverted",       step_inverted,      120 },
+};
+
+static void run_scenario(int16_t s)
+{
+	int32_t step;
+
+	reset_aircraft();
+	checksum = 2166136261u;
+	printf("%s\n", scenarios[s].name);
+	printf("  step   roll  pitch    yaw  throttle  pitchadj  height\n");
+	for (step = 0; step < scenarios[s].steps; step++)
+	{
+		scenarios[s].setup(step);
+		sense_aircraft();
+		run_control_loops();
+		if (step % PRINT_EVERY == 0)
+		{
+			printf("  %4li %6i %6i %6i %9i %9i %7.1f\n", (long)step,
+			       roll_control, pitch_control, yaw_control, throttle_control, pitchAltitudeAdjust, height);
+		}
+		fly_aircraft();
+	}
+	printf("  checksum %08lx\n\n", (unsigned long)checksum);
+}
+
+// Random inputs within the ranges the control loops see in flight
+static int16_t random_range(int16_t range)
+{
+	return (int16_t)((rand() % (2 * range + 1)) - range);
+}
+
+static void random_inputs(void)
+{
+	int16_t axis;
+
+	for (axis = 0; axis < 3; axis++)
+	{
+		tiltError[axis] = random_range(RMAX);
+		desiredRotationRateRadians[axis] = random_range(RMAX / 2);
+		rotationRateError[axis] = random_range(20000);
+		omegaAccum[axis] = random_range(20000);
+		omegagyro[axis] = random_range(20000);
+	}
+	// Now and then the most negative value, which the loops must not negate
+	if (rand() % 16 == 0)
+	{
+		axis = (int16_t)(rand() % 3);
+		tiltError[axis] = -32767 - 1;
+		desiredRotationRateRadians[axis] = -32767 - 1;
+		rotationRateError[axis] = -32767 - 1;
+		omegaAccum[axis] = -32767 - 1;
+	}
+	for (axis = 0; axis < 9; axis++)
+	{
+		rmat[axis] = random_range(RMAX);
+	}
+	IMUlocationz.WW = (int32_t)random_range(600) << 16 | (rand() & 0xFFFF);
+	IMUvelocityx.WW = (int32_t)random_range(4000) << 16;
+	IMUvelocityy.WW = (int32_t)random_range(4000) << 16;
+	IMUvelocityz.WW = (int32_t)random_range(1000) << 16;
+	estimatedWind[0] = random_range(1000);
+	estimatedWind[1] = random_range(1000);
+	forward_ground_speed = random_range(4000);
+	air_speed_3DIMU = (uint16_t)(rand() % 5000);
+	udb_pwIn[THROTTLE_INPUT_CHANNEL] = 2000 + rand() % 2001;
+	udb_pwIn[AILERON_INPUT_CHANNEL] = 2000 + rand() % 2001;
+	udb_pwIn[ELEVATOR_INPUT_CHANNEL] = 2000 + rand() % 2001;
+	udb_pwIn[RUDDER_INPUT_CHANNEL] = 2000 + rand() % 2001;
+	tofinish_line = (int16_t)(rand() % 200);
+	nav_height = (int16_t)(rand() % 600);
+	nav_deflection = random_range(2000);
+	hover_ok = rand() & 1;
+	inverted_ok = rand() & 1;
+	current_orientation = rand() % 3 ? F_NORMAL : ((rand() & 1) ? F_INVERTED : F_HOVER);
+	desired_behavior.W = (int16_t)rand();
+	state_flags.WW = (int16_t)rand();
+	settings.W = (int16_t)rand();
+	udb_flags._.radio_on = (rand() % 8) != 0;
+
+	// now and then, a change to the altitude parameters, as over MAVLink
+	switch (rand() % 1000)
+	{
+		case 0: height_margin = (int16_t)(10 + rand() % 60); break;
+		case 1: alt_hold_throttle_max = (fractional)(RMAX / 2 + rand() % (RMAX / 2)); break;
+		case 2: alt_hold_throttle_min = (fractional)(rand() % (RMAX / 2)); break;
+		case 3: alt_hold_pitch_max = (int16_t)(rand() % 30); break;
+		case 4: alt_hold_pitch_min = (int16_t)(-(rand() % 30)); break;
+		case 5: alt_hold_pitch_high = (int16_t)(rand() % 61 - 30); break;
+		case 6: height_target_max = (int16_t)(300 + rand() % 300); break;
+		case 7: height_target_min = (int16_t)(rand() % 300); break;
+		default: break;
+	}
+}
+
+static void run_random(void)
+{
+	int32_t step;
+
+	reset_aircraft();
+	srand(1);
+	checksum = 2166136261u;
+	for (step = 0; step < FUZZ_STEPS; step++)
+	{
+		random_inputs();
+		run_control_loops();
+	}
+	printf("random inputs, %li steps\n", (long)FUZZ_STEPS);
+	printf("  checksum %08lx\n", (unsigned long)checksum);
+}
+
+static double elapsed_ns(struct timespec* start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+	return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+// Each loop is timed over a table of random inputs, with its flags set for
+// normal flight so that the whole of the loop is run. The fastest of several
+// runs is taken, as the least disturbed by anything else on the host.
+static void time_loop(const char* name, void (*loop)(void))
+{
+	static struct {
+		int16_t tilt[3], desired[3], rate[3], omega[3], throttle;
+		int32_t height;
+	} inputs[256];
+	struct timespec start;
+	int32_t call;
+	int16_t i, axis;
+	int16_t repeat;
+	double ns, best = 0;
+
+	reset_aircraft();
+	srand(2);
+	for (i = 0; i < 256; i++)
+	{
+		for (axis = 0; axis < 3; axis++)
+		{
+			inputs[i].tilt[axis] = random_range(RMAX / 4);
+			inputs[i].desired[axis] = random_range(RMAX / 8);
+			inputs[i].rate[axis] = random_range(8000);
+			inputs[i].omega[axis] = random_range(8000);
+		}
+		inputs[i].throttle = 2400 + rand() % 1601;
+		inputs[i].height = (int32_t)(150 + rand() % 200) << 16;
+	}
+	divides = 0;
+	for (repeat = 0; repeat < TIMED_REPEATS; repeat++)
+	{
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+		for (call = 0; call < TIMED_CALLS; call++)
+		{
+			i = call & 255;
+			memcpy(tiltError, inputs[i].tilt, sizeof(tiltError));
+			memcpy(desiredRotationRateRadians, inputs[i].desired, sizeof(desiredRotationRateRadians));
+			memcpy(rotationRateError, inputs[i].rate, sizeof(rotationRateError));
+			memcpy(omegaAccum, inputs[i].omega, sizeof(inputs[i].omega));
+			udb_pwIn[THROTTLE_INPUT_CHANNEL] = inputs[i].throttle;
+			IMUlocationz.WW = inputs[i].height;
+			loop();
+		}
+		ns = elapsed_ns(&start) / TIMED_CALLS;
+		if (repeat == 0 || ns < best) best = ns;
+	}
+	printf("  %-16s %6.2f ns %6.2f divides\n", name, best, (double)divides / (TIMED_REPEATS * TIMED_CALLS));
+}
+
+static void all_loops(void)
+{
+#if (ALTITUDE_GAINS_VARIABLE == 1)
+	airspeedCntrl();
+#endif
+	rollCntrl();
+	pitchCntrl();
+	yawCntrl();
+	altitudeCntrl();
+}
+
+static void run_timing(void)
+{
+	printf("ALTITUDE_GAINS_VARIABLE %i, per call:\n", ALTITUDE_GAINS_VARIABLE);
+	time_loop("rollCntrl", rollCntrl);
+	time_loop("pitchCntrl", pitchCntrl);
+	time_loop("yawCntrl", yawCntrl);
+#if (ALTITUDE_GAINS_VARIABLE == 1)
+	time_loop("airspeedCntrl", airspeedCntrl);
+#endif
+	time_loop("altitudeCntrl", altitudeCntrl);
+	time_loop("all", all_loops);
+}
+
+int main(int argc, char** argv)
+{
+	int16_t s;
+
+	if (argc > 1 && strcmp(argv[1], "-t") == 0)
+	{
+		run_timing();
+		return 0;
+	}
+	printf("ALTITUDE_GAINS_VARIABLE %i\n\n", ALTITUDE_GAINS_VARIABLE);
+	for (s = 0; s < (int16_t)(sizeof(scenarios) / sizeof(scenarios[0])); s++)
+	{
+		run_scenario(s);
+	}
+	run_random();
+	return 0;
+}
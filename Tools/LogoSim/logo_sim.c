@@ -0,0 +1,475 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// A host simulator and checker for LOGO flight plans.
+//
+// The real interpreter, MatrixPilot/flightplan-logo.c, is built into this
+// program together with the flight plan (flightplan-logo.h) and options.h of
+// a configuration, and driven at the 40Hz navigation rate by a simple
+// kinematic aircraft: constant air speed, a limited turn rate and climb rate,
+// and no wind. The navigation it is given stands in for navigate.c, with
+// the distance to the finish line of each leg worked out the same way.
+// This runs a plan many thousands of times faster than real time.
+//
+// Before running, both instruction sets are checked for unbalanced blocks,
+// calls to undefined subroutines and IFs without an END. While running, it
+// records the turtle's path, the depth of the LOGO stack, the number of
+// instructions run for each update, and runs of updates which reach
+// MAX_INSTRUCTIONS_PER_CYCLE without reaching a FLY, which is how a loop
+// without a FLY in it shows up in the air.
+//
+// Usage: logo_sim [-r] [-t seconds] [-s speed] [-o lat,lon] [-c channel=pwm]
+//                 [-p path.csv] [-k track.csv]
+//   -r    run the RTL instructions rather than the main flight plan
+//   -t    seconds to simulate (default 3600)
+//   -s    air speed in m/s (default 12)
+//   -o    origin for absolute positions (default FIXED_ORIGIN_LOCATION)
+//   -c    value of a radio input channel, for IFs on XX_INPUT_CHANNEL
+//   -p    write each goal the turtle sets to a CSV file
+//   -k    write the aircraft's track, once a second, to a CSV file
+//
+// The exit status is 1 if any problem was found. See the Makefile for
+// building with another flight plan, e.g. one saved from the UDB Logo Editor.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "../../MatrixPilot/flightplan-logo.c"
+
+#define NAV_HZ          40
+#define TURN_RATE       25.0    // degrees per second
+#define CLIMB_RATE      2.0     // meters per second
+#define STUCK_SECONDS   10      // runs of updates without a FLY reported as not terminating
+
+#ifndef HEIGHT_MARGIN
+#define HEIGHT_MARGIN   10
+#endif
+
+// The parts of MatrixPilot the interpreter uses
+union longww IMUlocationx, IMUlocationy, IMUlocationz;
+union longww IMUvelocityz;
+fractional rmat[9];
+int16_t estimatedWind[3];
+uint16_t ground_velocity_magnitudeXY;
+uint16_t air_speed_magnitudeXY;
+int16_t tofinish_line;
+int16_t waypointIndex;
+int16_t udb_pwIn[NUM_INPUTS+1];
+union bfbts_word desired_behavior;
+struct altit_variables altit;
+int16_t desiredSpeed;   // 10ths of meters per second, set by SET_SPEED
+
+// The aircraft
+static double planeX, planeY, planeZ;   // meters from the origin, East, North and up
+static double planeHeading;             // degrees clockwise from North
+static double planeSpeed = 12.0;        // meters per second
+
+// The goal, as set by the interpreter
+static double goalFromX, goalFromY;
+static double goalX, goalY;
+static int16_t goalHeight;
+
+static int32_t originLon, originLat;
+#ifdef FIXED_ORIGIN_LOCATION
+static const struct { int32_t lon; int32_t lat; float alt; } fixedOrigin = FIXED_ORIGIN_LOCATION;
+#endif
+
+static FILE* pathFile = NULL;
+static double simTime;
+static int32_t goalCount;
+static double pathLength;
+static double minX, maxX, minY, maxY, minZ, maxZ;
+static int16_t lastTurtleX, lastTurtleY, lastTurtleZ;
+
+int16_t FindFirstBitFromLeft(int16_t input)
+{
+	int16_t bit;
+
+	for (bit = 15; bit >= 0; bit--)
+	{
+		if (input & (1 << bit)) return 16 - bit;
+	}
+	return 0;
+}
+
+void setBehavior(int16_t newBehavior)
+{
+	desired_behavior.W = newBehavior;
+}
+
+void set_camera_view(struct relative3D current_view)
+{
+}
+
+struct relative3D dcm_absolute_to_relative(struct waypoint3D absolute)
+{
+	struct relative3D rel;
+	double metersPerUnit = 0.0111319;   // 1e-7 degrees of latitude
+
+	rel.x = (int16_t)((absolute.x - originLon) * metersPerUnit * cos(originLat * 1e-7 * M_PI / 180.0));
+	rel.y = (int16_t)((absolute.y - originLat) * metersPerUnit);
+	rel.z = absolute.z;
+	return rel;
+}
+
+#ifdef USE_EXTENDED_NAV
+void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+#else
+void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+#endif
+{
+	double leg;
+
+	goalFromX = fromPoint.x;
+	goalFromY = fromPoint.y;
+	goalX = toPoint.x;
+	goalY = toPoint.y;
+	goalHeight = toPoint.z;
+
+	goalCount++;
+	leg = sqrt((goalX - lastTurtleX) * (goalX - lastTurtleX) + (goalY - lastTurtleY) * (goalY - lastTurtleY));
+	pathLength += leg;
+	lastTurtleX = toPoint.x;
+	lastTurtleY = toPoint.y;
+	lastTurtleZ = toPoint.z;
+	if (toPoint.x < minX) minX = toPoint.x;
+	if (toPoint.x > maxX) maxX = toPoint.x;
+	if (toPoint.y < minY) minY = toPoint.y;
+	if (toPoint.y > maxY) maxY = toPoint.y;
+	if (toPoint.z < minZ) minZ = toPoint.z;
+	if (toPoint.z > maxZ) maxZ = toPoint.z;
+
+	if (pathFile)
+	{
+		fprintf(pathFile, "%.2f,%i,%i,%i,%i\n", simTime, flightplan_logo_index_get(), toPoint.x, toPoint.y, toPoint.z);
+	}
+}
+
+void navigate_set_goal_height(int16_t z)
+{
+	goalHeight = z;
+}
+
+int16_t navigate_get_goal(vect3_16t* _goal)
+{
+	if (_goal != NULL)
+	{
+		_goal->x = (int16_t)goalX;
+		_goal->y = (int16_t)goalY;
+		_goal->z = goalHeight;
+	}
+	return goalHeight;
+}
+
+// As navigate.c, the distance to the line through the goal at right angles to the leg
+void navigate_compute_bearing_to_goal(void)
+{
+	double legX = goalX - goalFromX;
+	double legY = goalY - goalFromY;
+	double legLength = sqrt(legX * legX + legY * legY);
+	double toGoalX = goalX - planeX;
+	double toGoalY = goalY - planeY;
+
+	if (legLength < 1.0)
+	{
+		tofinish_line = (int16_t)sqrt(toGoalX * toGoalX + toGoalY * toGoalY);
+	}
+	else
+	{
+		tofinish_line = (int16_t)((toGoalX * legX + toGoalY * legY) / legLength);
+	}
+}
+
+static void set_plane_state(void)
+{
+	double headingRad = planeHeading * M_PI / 180.0;
+
+	IMUlocationx.WW = (int32_t)(planeX * 65536.0);
+	IMUlocationy.WW = (int32_t)(planeY * 65536.0);
+	IMUlocationz.WW = (int32_t)(planeZ * 65536.0);
+	rmat[1] = (fractional)(-sin(headingRad) * RMAX);
+	rmat[4] = (fractional)(cos(headingRad) * RMAX);
+	ground_velocity_magnitudeXY = (uint16_t)(planeSpeed * 100.0);
+	air_speed_magnitudeXY = (uint16_t)(planeSpeed * 100.0);
+}
+
+static void fly(double dt)
+{
+	double bearing = atan2(goalX - planeX, goalY - planeY) * 180.0 / M_PI;
+	double turn = bearing - planeHeading;
+	double climb = goalHeight - planeZ;
+
+	while (turn > 180.0) turn -= 360.0;
+	while (turn < -180.0) turn += 360.0;
+	if (turn > TURN_RATE * dt) turn = TURN_RATE * dt;
+	if (turn < -TURN_RATE * dt) turn = -TURN_RATE * dt;
+	planeHeading += turn;
+	if (planeHeading < 0.0) planeHeading += 360.0;
+	if (planeHeading >= 360.0) planeHeading -= 360.0;
+
+	if (climb > CLIMB_RATE * dt) climb = CLIMB_RATE * dt;
+	if (climb < -CLIMB_RATE * dt) climb = -CLIMB_RATE * dt;
+	planeZ += climb;
+
+#if (SPEED_CONTROL == 1)
+	planeSpeed = desiredSpeed / 10.0;
+#endif
+	if (!desired_behavior._.altitude)
+	{
+		planeX += planeSpeed * sin(planeHeading * M_PI / 180.0) * dt;
+		planeY += planeSpeed * cos(planeHeading * M_PI / 180.0) * dt;
+	}
+	set_plane_state();
+}
+
+static const char* setName(int16_t set)
+{
+	return (set == 1) ? "rtlInstructions" : "instructions";
+}
+
+// Check the blocks of an instruction set balance, and every call has a subroutine
+static int16_t check_instruction_set(int16_t set)
+{
+	int16_t errors = 0;
+	int16_t depth = 0;
+	boolean inSubroutine = false;
+	boolean seenSubroutine = false;
+	int16_t i;
+
+	if (set == 1)
+	{
+		currentInstructionSet = (struct logoInstructionDef*)rtlInstructions;
+		numInstructionsInCurrentSet = NUM_RTL_INSTRUCTIONS;
+	}
+	else
+	{
+		currentInstructionSet = (struct logoInstructionDef*)instructions;
+		numInstructionsInCurrentSet = NUM_INSTRUCTIONS;
+	}
+	compile_jump_targets();
+	if (!jumpTargetsValid)
+	{
+		printf("%s: blocks are nested more than %i deep\n", setName(set), LOGO_STACK_DEPTH * 2);
+		errors++;
+	}
+
+	for (i = 0; i < numInstructionsInCurrentSet; i++)
+	{
+		struct logoInstructionDef* instr = &currentInstructionSet[i];
+
+		if (instr->cmd == 1 && instr->subcmd == 2) // TO
+		{
+			if (depth > 0 || inSubroutine)
+			{
+				printf("%s[%i]: TO (%i) before the END of the block or subroutine above it\n", setName(set), i, instr->arg);
+				errors++;
+			}
+			else if (!seenSubroutine && i > 0 && !(currentInstructionSet[i-1].cmd == 1 && currentInstructionSet[i-1].subcmd == 1))
+			{
+				printf("%s[%i]: the main program runs on into TO (%i), it needs an END\n", setName(set), i, instr->arg);
+				errors++;
+			}
+			inSubroutine = true;
+			seenSubroutine = true;
+			depth = 0;
+		}
+		else if (instr->cmd == 1 && instr->subcmd == 1) // END
+		{
+			if (depth > 0) depth--;
+			else if (inSubroutine) inSubroutine = false;
+			else if (seenSubroutine)
+			{
+				printf("%s[%i]: END without a block or subroutine\n", setName(set), i);
+				errors++;
+			}
+		}
+		else if ((instr->cmd == 1 && instr->subcmd == 0) || (instr->cmd >= 14 && instr->cmd <= 19)) // REPEAT, IF
+		{
+			depth++;
+			if (instr->cmd != 1 && jumpTargetsValid && jumpTargets[i] == 0)
+			{
+				printf("%s[%i]: IF without an END\n", setName(set), i);
+				errors++;
+			}
+		}
+		else if (instr->cmd == 2 || instr->cmd == 10 || (instr->cmd == 12 && instr->subcmd == 1 && !instr->use_param))
+		{
+			uint8_t sub = (instr->cmd == 12) ? instr->arg : instr->subcmd;
+
+			if (sub != 0 && jumpTargetsValid && jumpTargets[i] == -1)
+			{
+				printf("%s[%i]: call of undefined subroutine %i\n", setName(set), i, sub);
+				errors++;
+			}
+		}
+	}
+	if (depth > 0 || inSubroutine)
+	{
+		printf("%s: missing END at the end of the %s\n", setName(set), inSubroutine ? "last subroutine" : "main program");
+		errors++;
+	}
+	return errors;
+}
+
+int main(int argc, char** argv)
+{
+	int16_t flightplan = 0;
+	double seconds = 3600.0;
+	FILE* trackFile = NULL;
+	int32_t steps;
+	int32_t step;
+	int32_t updates = 0;
+	int32_t updatesRunning = 0;
+	int32_t updatesAtLimit = 0;
+	int32_t stuckRun = 0;
+	int32_t longestStuckRun = 0;
+	int16_t stuckIndex = 0;
+	int32_t totalInstructions = 0;
+	int16_t maxInstructions = 0;
+	int16_t maxStack = 0;
+	int16_t errors = 0;
+	clock_t start;
+	double elapsed;
+	int i;
+
+	for (i = 0; i < NUM_INPUTS+1; i++) udb_pwIn[i] = 3000;
+#ifdef FIXED_ORIGIN_LOCATION
+	originLon = fixedOrigin.lon;
+	originLat = fixedOrigin.lat;
+#endif
+
+	for (i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-r") == 0) flightplan = 1;
+		else if (strcmp(argv[i], "-t") == 0 && i+1 < argc) seconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0 && i+1 < argc) planeSpeed = atof(argv[++i]);
+		else if (strcmp(argv[i], "-o") == 0 && i+1 < argc)
+		{
+			double lat, lon;
+			if (sscanf(argv[++i], "%lf,%lf", &lat, &lon) != 2) goto usage;
+			originLat = (int32_t)(lat * 1e7);
+			originLon = (int32_t)(lon * 1e7);
+		}
+		else if (strcmp(argv[i], "-c") == 0 && i+1 < argc)
+		{
+			int channel, pwm;
+			if (sscanf(argv[++i], "%i=%i", &channel, &pwm) != 2 || channel < 1 || channel > NUM_INPUTS) goto usage;
+			udb_pwIn[channel] = pwm;
+		}
+		else if (strcmp(argv[i], "-p") == 0 && i+1 < argc)
+		{
+			if ((pathFile = fopen(argv[++i], "w")) == NULL) { perror(argv[i]); return 1; }
+			fprintf(pathFile, "time,index,x,y,z\n");
+		}
+		else if (strcmp(argv[i], "-k") == 0 && i+1 < argc)
+		{
+			if ((trackFile = fopen(argv[++i], "w")) == NULL) { perror(argv[i]); return 1; }
+			fprintf(trackFile, "time,x,y,z,heading,tofinish_line,index\n");
+		}
+		else goto usage;
+	}
+
+	errors += check_instruction_set(0);
+	errors += check_instruction_set(1);
+
+	altit.HeightMargin = HEIGHT_MARGIN;
+	desiredSpeed = (int16_t)(planeSpeed * 10.0);
+	set_plane_state();
+	start = clock();
+
+	flightplan_logo_begin(flightplan);
+	steps = (int32_t)(seconds * NAV_HZ);
+	for (step = 0; step < steps; step++)
+	{
+		simTime = (double)step / NAV_HZ;
+		fly(1.0 / NAV_HZ);
+		navigate_compute_bearing_to_goal();
+
+		instructionsProcessed = 0;
+		flightplan_logo_update();
+		updates++;
+
+		if (instructionsProcessed > 0)
+		{
+			updatesRunning++;
+			totalInstructions += instructionsProcessed;
+		}
+		if (instructionsProcessed > maxInstructions) maxInstructions = instructionsProcessed;
+		if (logoStackIndex > maxStack) maxStack = logoStackIndex;
+		if (instructionsProcessed >= MAX_INSTRUCTIONS_PER_CYCLE)
+		{
+			updatesAtLimit++;
+			if (++stuckRun > longestStuckRun)
+			{
+				longestStuckRun = stuckRun;
+				stuckIndex = instructionIndex;
+			}
+		}
+		else
+		{
+			stuckRun = 0;
+		}
+
+		if (trackFile && (step % NAV_HZ) == 0)
+		{
+			fprintf(trackFile, "%.0f,%.1f,%.1f,%.1f,%.0f,%i,%i\n", simTime, planeX, planeY, planeZ,
+			        planeHeading, tofinish_line, flightplan_logo_index_get());
+		}
+	}
+	elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%s: %.0f s simulated in %.3f s (%.0f times real time)\n", setName(flightplan),
+	       seconds, elapsed, elapsed > 0 ? seconds / elapsed : 0.0);
+	printf("path: %li goals, %.0f m, x %.0f to %.0f m, y %.0f to %.0f m, z %.0f to %.0f m\n",
+	       (long)goalCount, pathLength, minX, maxX, minY, maxY, minZ, maxZ);
+	printf("instructions per update: %.1f mean, %i max, %li of %li updates reached the limit of %i\n",
+	       updatesRunning ? (double)totalInstructions / updatesRunning : 0.0, maxInstructions,
+	       (long)updatesAtLimit, (long)updates, MAX_INSTRUCTIONS_PER_CYCLE);
+	printf("stack depth: %i max, of %i\n", maxStack, LOGO_STACK_DEPTH - 1);
+
+	if (maxStack >= LOGO_STACK_DEPTH - 1)
+	{
+		printf("the LOGO stack was full, so REPEATs, IFs and DOs beyond it were ignored\n");
+		errors++;
+	}
+	if (longestStuckRun >= STUCK_SECONDS * NAV_HZ)
+	{
+		printf("no FLY for %.1f s, around instruction %i: a loop which does not fly does not terminate\n",
+		       (double)longestStuckRun / NAV_HZ, stuckIndex);
+		errors++;
+	}
+	if (goalCount == 0)
+	{
+		printf("the turtle never set a goal\n");
+		errors++;
+	}
+
+	if (pathFile) fclose(pathFile);
+	if (trackFile) fclose(trackFile);
+	return errors ? 1 : 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-r] [-t seconds] [-s speed] [-o lat,lon] [-c channel=pwm] [-p path.csv] [-k track.csv]\n", argv[0]);
+	return 1;
+}
@@ -0,0 +1,225 @@
+#!/usr/bin/env python
+#  This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation,  version 3 of the License, or
+#    (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""MAVLink FTP client for the MatrixPilot file server (MAVLINK_FTP in options_mavlink.h)
+
+   Usage: python mavftp.py [--master=udpin:127.0.0.1:14550] [--baudrate=57600] command [args]
+
+   Commands:
+     list                   list the files on the aircraft
+     get remote [local]     download a file, using burst reads
+     put local [remote]     upload a file
+     crc remote             compare the CRC32 of a file on the aircraft with a local copy
+     rm remote              remove a file
+
+   The default master is the MatrixPilot SIL telemetry port, so the whole
+   transfer path can be tested on the desktop against MatrixPilot-SIL.
+"""
+
+from __future__ import print_function
+import os
+import sys
+import time
+import struct
+from optparse import OptionParser
+
+here = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(here, "mavlink"))
+os.environ["MAVLINK_DIALECT"] = "matrixpilot"
+from pymavlink import mavutil
+
+OP_NONE, OP_TERMINATE, OP_RESET, OP_LIST, OP_OPEN_RO, OP_READ, OP_CREATE, OP_WRITE, \
+    OP_REMOVE, OP_MKDIR, OP_RMDIR, OP_OPEN_WO, OP_TRUNCATE, OP_RENAME, OP_CRC32, OP_BURST_READ = range(16)
+OP_ACK = 128
+OP_NAK = 129
+
+ERRORS = ["None", "Fail", "FailErrno", "InvalidDataSize", "InvalidSession", "NoSessionsAvailable",
+          "EOF", "UnknownCommand", "FileExists", "FileProtected", "FileNotFound"]
+ERR_EOF = 6
+
+HEADER = struct.Struct("<HBBBBBBI")
+PAYLOAD_LEN = 251
+DATA_MAX = PAYLOAD_LEN - HEADER.size
+
+def crc32(data, value=0):
+    """CRC-32 as calculated by the server: polynomial 0xEDB88320 without inversion"""
+    for b in bytearray(data):
+        value ^= b
+        for i in range(8):
+            value = (value >> 1) ^ (0xEDB88320 if value & 1 else 0)
+    return value
+
+class reply:
+    def __init__(self, payload):
+        p = bytearray(payload)
+        (self.seq, self.session, self.opcode, self.size, self.req_opcode,
+         self.burst_complete, pad, self.offset) = HEADER.unpack(bytes(p[:HEADER.size]))
+        self.data = p[HEADER.size:HEADER.size + self.size]
+        self.error = self.data[0] if self.opcode == OP_NAK and self.size else 0
+
+class FTPError(Exception):
+    pass
+
+class ftp_client:
+    def __init__(self, master, baudrate, timeout=1.0, retries=5):
+        self.mav = mavutil.mavlink_connection(master, baud=baudrate, dialect="matrixpilot")
+        self.timeout = timeout
+        self.retries = retries
+        self.seq = 0
+        print("Waiting for heartbeat from %s" % master)
+        self.mav.wait_heartbeat()
+        print("Connected to system %u" % self.mav.target_system)
+
+    def send(self, opcode, session=0, offset=0, data=b"", size=None):
+        data = bytearray(data)
+        self.seq = (self.seq + 1) & 0xffff
+        payload = bytearray(HEADER.pack(self.seq, session, opcode, len(data) if size is None else size,
+                                        0, 0, 0, offset)) + data
+        payload += bytearray(PAYLOAD_LEN - len(payload))
+        self.mav.mav.file_transfer_protocol_send(0, self.mav.target_system, self.mav.target_component, list(payload))
+
+    def receive(self, timeout):
+        m = self.mav.recv_match(type="FILE_TRANSFER_PROTOCOL", blocking=True, timeout=timeout)
+        return reply(m.payload) if m is not None else None
+
+    def request(self, opcode, session=0, offset=0, data=b"", size=None):
+        """Send a request and wait for its reply, repeating it if the reply is lost"""
+        for attempt in range(self.retries):
+            self.send(opcode, session, offset, data, size)
+            seq = self.seq
+            deadline = time.time() + self.timeout
+            while time.time() < deadline:
+                r = self.receive(deadline - time.time())
+                if r is not None and r.seq == ((seq + 1) & 0xffff) and r.req_opcode == opcode:
+                    return r
+            self.seq = (seq - 1) & 0xffff   # repeat with the same sequence number
+        raise FTPError("no reply to opcode %u" % opcode)
+
+    def check(self, r):
+        if r.opcode == OP_NAK:
+            raise FTPError(ERRORS[r.error] if r.error < len(ERRORS) else "error %u" % r.error)
+        return r
+
+    def list(self):
+        entries = []
+        while True:
+            r = self.request(OP_LIST, offset=len(entries), data=b"/\0")
+            if r.opcode == OP_NAK and r.error == ERR_EOF:
+                return entries
+            self.check(r)
+            for e in bytes(r.data).split(b"\0"):
+                if e:
+                    entries.append(e.decode("latin-1"))
+
+    def get(self, remote, local):
+        r = self.check(self.request(OP_OPEN_RO, data=remote.encode("latin-1") + b"\0"))
+        session = r.session
+        size = struct.unpack("<I", bytes(r.data[:4]))[0]
+        blocks = {}
+        start = time.time()
+        received = 0
+        offset = 0
+        try:
+            # Burst reads from the first missing byte, until the whole file has arrived
+            while received < size:
+                self.send(OP_BURST_READ, session, offset, size=DATA_MAX)
+                while True:
+                    r = self.receive(self.timeout)
+                    if r is None:
+                        break   # the rest of the burst is lost
+                    if r.req_opcode != OP_BURST_READ or r.session != session:
+                        continue
+                    if r.opcode == OP_ACK and r.offset not in blocks:
+                        blocks[r.offset] = r.data
+                        received += len(r.data)
+                        sys.stdout.write("\r%u/%u bytes" % (received, size))
+                        sys.stdout.flush()
+                    if r.burst_complete or r.opcode == OP_NAK:
+                        break
+                # find the first gap, and fill it with single reads if it is not at the end
+                offset = 0
+                while offset in blocks:
+                    offset += len(blocks[offset])
+                while offset < size and received < size:
+                    nxt = min([o for o in blocks if o > offset] + [size])
+                    if nxt == size:
+                        break
+                    r = self.check(self.request(OP_READ, session, offset, size=min(DATA_MAX, nxt - offset)))
+                    blocks[offset] = r.data
+                    received += len(r.data)
+                    while offset in blocks:
+                        offset += len(blocks[offset])
+        finally:
+            self.request(OP_TERMINATE, session)
+        elapsed = time.time() - start
+        data = bytearray()
+        for o in sorted(blocks):
+            data += blocks[o]
+        open(local, "wb").write(bytes(data[:size]))
+        print("\r%s: %u bytes in %.1f seconds, %.0f bytes/second" %
+              (remote, size, elapsed, size / elapsed if elapsed > 0 else 0))
+
+    def put(self, local, remote):
+        data = bytearray(open(local, "rb").read())
+        r = self.check(self.request(OP_CREATE, data=remote.encode("latin-1") + b"\0"))
+        session = r.session
+        start = time.time()
+        try:
+            for offset in range(0, len(data), DATA_MAX):
+                self.check(self.request(OP_WRITE, session, offset, data[offset:offset + DATA_MAX]))
+                sys.stdout.write("\r%u/%u bytes" % (min(offset + DATA_MAX, len(data)), len(data)))
+                sys.stdout.flush()
+        finally:
+            self.request(OP_TERMINATE, session)
+        print("\r%s: %u bytes in %.1f seconds" % (remote, len(data), time.time() - start))
+
+    def crc(self, remote):
+        r = self.check(self.request(OP_CRC32, data=remote.encode("latin-1") + b"\0"))
+        return struct.unpack("<I", bytes(r.data[:4]))[0]
+
+    def remove(self, remote):
+        self.check(self.request(OP_REMOVE, data=remote.encode("latin-1") + b"\0"))
+
+if __name__ == "__main__":
+    parser = OptionParser(usage=__doc__)
+    parser.add_option("--master", default="udpin:127.0.0.1:14550", help="MAVLink connection")
+    parser.add_option("--baudrate", type="int", default=57600, help="serial baud rate")
+    (opts, args) = parser.parse_args()
+    if len(args) < 1:
+        print(__doc__)
+        sys.exit(1)
+    ftp = ftp_client(opts.master, opts.baudrate)
+    cmd = args[0]
+    try:
+        if cmd == "list":
+            for e in ftp.list():
+                print(e[1:].replace("\t", "\t\t") + ("/" if e[0] == "D" else ""))
+        elif cmd == "get":
+            ftp.get(args[1], args[2] if len(args) > 2 else os.path.basename(args[1]))
+        elif cmd == "put":
+            ftp.put(args[1], args[2] if len(args) > 2 else os.path.basename(args[1]))
+        elif cmd == "crc":
+            value = ftp.crc(args[1])
+            print("%s: %08x" % (args[1], value))
+            if os.path.exists(os.path.basename(args[1])):
+                local = crc32(open(os.path.basename(args[1]), "rb").read())
+                print("local copy: %08x %s" % (local, "matches" if local == value else "DIFFERS"))
+        elif cmd == "rm":
+            ftp.remove(args[1])
+        else:
+            print(__doc__)
+            sys.exit(1)
+    except FTPError as e:
+        print("\n%s: %s" % (cmd, e))
+        sys.exit(1)
@@ -2301,6 +2301,9 @@ MAVLINK_MSG_ID_FLEXIFUNCTION_DIRECTORY = 155
 MAVLINK_MSG_ID_FLEXIFUNCTION_DIRECTORY_ACK = 156
 MAVLINK_MSG_ID_FLEXIFUNCTION_COMMAND = 157
 MAVLINK_MSG_ID_FLEXIFUNCTION_COMMAND_ACK = 158
+MAVLINK_MSG_ID_FENCE_POINT = 160
+MAVLINK_MSG_ID_FENCE_FETCH_POINT = 161
+MAVLINK_MSG_ID_FENCE_STATUS = 162
 MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F2_A = 170
 MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F2_B = 171
 MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F4 = 172
@@ -2668,6 +2671,87 @@ class MAVLink_flexifunction_command_ack_message(MAVLink_message):
         def pack(self, mav, force_mavlink1=False):
                 return MAVLink_message.pack(self, mav, 208, struct.pack('<HH', self.command_type, self.result), force_mavlink1=force_mavlink1)
 
+class MAVLink_fence_point_message(MAVLink_message):
+        '''
+        A fence point. Used to set a point when from GCS -> MAV. Also
+        used to return a point from MAV -> GCS
+        '''
+        id = MAVLINK_MSG_ID_FENCE_POINT
+        name = 'FENCE_POINT'
+        fieldnames = ['target_system', 'target_component', 'idx', 'count', 'lat', 'lng']
+        ordered_fieldnames = [ 'lat', 'lng', 'target_system', 'target_component', 'idx', 'count' ]
+        format = '<ffBBBB'
+        native_format = bytearray('<ffBBBB', 'ascii')
+        orders = [2, 3, 4, 5, 0, 1]
+        lengths = [1, 1, 1, 1, 1, 1]
+        array_lengths = [0, 0, 0, 0, 0, 0]
+        crc_extra = 78
+
+        def __init__(self, target_system, target_component, idx, count, lat, lng):
+                MAVLink_message.__init__(self, MAVLink_fence_point_message.id, MAVLink_fence_point_message.name)
+                self._fieldnames = MAVLink_fence_point_message.fieldnames
+                self.target_system = target_system
+                self.target_component = target_component
+                self.idx = idx
+                self.count = count
+                self.lat = lat
+                self.lng = lng
+
+        def pack(self, mav, force_mavlink1=False):
+                return MAVLink_message.pack(self, mav, 78, struct.pack('<ffBBBB', self.lat, self.lng, self.target_system, self.target_component, self.idx, self.count), force_mavlink1=force_mavlink1)
+
+class MAVLink_fence_fetch_point_message(MAVLink_message):
+        '''
+        Request a current fence point from MAV
+        '''
+        id = MAVLINK_MSG_ID_FENCE_FETCH_POINT
+        name = 'FENCE_FETCH_POINT'
+        fieldnames = ['target_system', 'target_component', 'idx']
+        ordered_fieldnames = [ 'target_system', 'target_component', 'idx' ]
+        format = '<BBB'
+        native_format = bytearray('<BBB', 'ascii')
+        orders = [0, 1, 2]
+        lengths = [1, 1, 1]
+        array_lengths = [0, 0, 0]
+        crc_extra = 68
+
+        def __init__(self, target_system, target_component, idx):
+                MAVLink_message.__init__(self, MAVLink_fence_fetch_point_message.id, MAVLink_fence_fetch_point_message.name)
+                self._fieldnames = MAVLink_fence_fetch_point_message.fieldnames
+                self.target_system = target_system
+                self.target_component = target_component
+                self.idx = idx
+
+        def pack(self, mav, force_mavlink1=False):
+                return MAVLink_message.pack(self, mav, 68, struct.pack('<BBB', self.target_system, self.target_component, self.idx), force_mavlink1=force_mavlink1)
+
+class MAVLink_fence_status_message(MAVLink_message):
+        '''
+        Status of geo-fencing. Sent in extended status stream when
+        fencing enabled
+        '''
+        id = MAVLINK_MSG_ID_FENCE_STATUS
+        name = 'FENCE_STATUS'
+        fieldnames = ['breach_status', 'breach_count', 'breach_type', 'breach_time']
+        ordered_fieldnames = [ 'breach_time', 'breach_count', 'breach_status', 'breach_type' ]
+        format = '<IHBB'
+        native_format = bytearray('<IHBB', 'ascii')
+        orders = [2, 1, 3, 0]
+        lengths = [1, 1, 1, 1]
+        array_lengths = [0, 0, 0, 0]
+        crc_extra = 189
+
+        def __init__(self, breach_status, breach_count, breach_type, breach_time):
+                MAVLink_message.__init__(self, MAVLink_fence_status_message.id, MAVLink_fence_status_message.name)
+                self._fieldnames = MAVLink_fence_status_message.fieldnames
+                self.breach_status = breach_status
+                self.breach_count = breach_count
+                self.breach_type = breach_type
+                self.breach_time = breach_time
+
+        def pack(self, mav, force_mavlink1=False):
+                return MAVLink_message.pack(self, mav, 189, struct.pack('<IHBB', self.breach_time, self.breach_count, self.breach_status, self.breach_type), force_mavlink1=force_mavlink1)
+
 class MAVLink_serial_udb_extra_f2_a_message(MAVLink_message):
         '''
         Backwards compatible MAVLink version of SERIAL_UDB_EXTRA - F2:
@@ -7497,6 +7581,9 @@ mavlink_map = {
         MAVLINK_MSG_ID_FLEXIFUNCTION_DIRECTORY_ACK : MAVLink_flexifunction_directory_ack_message,
         MAVLINK_MSG_ID_FLEXIFUNCTION_COMMAND : MAVLink_flexifunction_command_message,
         MAVLINK_MSG_ID_FLEXIFUNCTION_COMMAND_ACK : MAVLink_flexifunction_command_ack_message,
+        MAVLINK_MSG_ID_FENCE_POINT : MAVLink_fence_point_message,
+        MAVLINK_MSG_ID_FENCE_FETCH_POINT : MAVLink_fence_fetch_point_message,
+        MAVLINK_MSG_ID_FENCE_STATUS : MAVLink_fence_status_message,
         MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F2_A : MAVLink_serial_udb_extra_f2_a_message,
         MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F2_B : MAVLink_serial_udb_extra_f2_b_message,
         MAVLINK_MSG_ID_SERIAL_UDB_EXTRA_F4 : MAVLink_serial_udb_extra_f4_message,
@@ -8240,6 +8327,84 @@ class MAVLink(object):
                 '''
                 return self.send(self.flexifunction_command_ack_encode(command_type, result), force_mavlink1=force_mavlink1)
 
+        def fence_point_encode(self, target_system, target_component, idx, count, lat, lng):
+                '''
+                A fence point. Used to set a point when from GCS -> MAV. Also used to
+                return a point from MAV -> GCS
+
+                target_system             : System ID (uint8_t)
+                target_component          : Component ID (uint8_t)
+                idx                       : point index (first point is 1, 0 is for return point) (uint8_t)
+                count                     : total number of points (for sanity checking) (uint8_t)
+                lat                       : Latitude of point (float)
+                lng                       : Longitude of point (float)
+
+                '''
+                return MAVLink_fence_point_message(target_system, target_component, idx, count, lat, lng)
+
+        def fence_point_send(self, target_system, target_component, idx, count, lat, lng, force_mavlink1=False):
+                '''
+                A fence point. Used to set a point when from GCS -> MAV. Also used to
+                return a point from MAV -> GCS
+
+                target_system             : System ID (uint8_t)
+                target_component          : Component ID (uint8_t)
+                idx                       : point index (first point is 1, 0 is for return point) (uint8_t)
+                count                     : total number of points (for sanity checking) (uint8_t)
+                lat                       : Latitude of point (float)
+                lng                       : Longitude of point (float)
+
+                '''
+                return self.send(self.fence_point_encode(target_system, target_component, idx, count, lat, lng), force_mavlink1=force_mavlink1)
+
+        def fence_fetch_point_encode(self, target_system, target_component, idx):
+                '''
+                Request a current fence point from MAV
+
+                target_system             : System ID (uint8_t)
+                target_component          : Component ID (uint8_t)
+                idx                       : point index (first point is 1, 0 is for return point) (uint8_t)
+
+                '''
+                return MAVLink_fence_fetch_point_message(target_system, target_component, idx)
+
+        def fence_fetch_point_send(self, target_system, target_component, idx, force_mavlink1=False):
+                '''
+                Request a current fence point from MAV
+
+                target_system             : System ID (uint8_t)
+                target_component          : Component ID (uint8_t)
+                idx                       : point index (first point is 1, 0 is for return point) (uint8_t)
+
+                '''
+                return self.send(self.fence_fetch_point_encode(target_system, target_component, idx), force_mavlink1=force_mavlink1)
+
+        def fence_status_encode(self, breach_status, breach_count, breach_type, breach_time):
+                '''
+                Status of geo-fencing. Sent in extended status stream when fencing
+                enabled
+
+                breach_status             : 0 if currently inside fence, 1 if outside (uint8_t)
+                breach_count              : number of fence breaches (uint16_t)
+                breach_type               : last breach type (see FENCE_BREACH_* enum) (uint8_t)
+                breach_time               : time of last breach in milliseconds since boot (uint32_t)
+
+                '''
+                return MAVLink_fence_status_message(breach_status, breach_count, breach_type, breach_time)
+
+        def fence_status_send(self, breach_status, breach_count, breach_type, breach_time, force_mavlink1=False):
+                '''
+                Status of geo-fencing. Sent in extended status stream when fencing
+                enabled
+
+                breach_status             : 0 if currently inside fence, 1 if outside (uint8_t)
+                breach_count              : number of fence breaches (uint16_t)
+                breach_type               : last breach type (see FENCE_BREACH_* enum) (uint8_t)
+                breach_time               : time of last breach in milliseconds since boot (uint32_t)
+
+                '''
+                return self.send(self.fence_status_encode(breach_status, breach_count, breach_type, breach_time), force_mavlink1=force_mavlink1)
+
         def serial_udb_extra_f2_a_encode(self, sue_time, sue_status, sue_latitude, sue_longitude, sue_altitude, sue_waypoint_index, sue_rmat0, sue_rmat1, sue_rmat2, sue_rmat3, sue_rmat4, sue_rmat5, sue_rmat6, sue_rmat7, sue_rmat8, sue_cog, sue_sog, sue_cpu_load, sue_air_speed_3DIMU, sue_estimated_wind_0, sue_estimated_wind_1, sue_estimated_wind_2, sue_magFieldEarth0, sue_magFieldEarth1, sue_magFieldEarth2, sue_svs, sue_hdop):
                 '''
                 Backwards compatible MAVLink version of SERIAL_UDB_EXTRA - F2: Format
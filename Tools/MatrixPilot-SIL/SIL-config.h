@@ -34,3 +34,8 @@
 #define SILSIM_TELEMETRY_HOST               "127.0.0.1"
 #define SILSIM_SERIAL_RC_INPUT_DEVICE       ""          // i.e. "COM4" or "/dev/cu.usbserial-A600dP4v", or "" to disable
 #define SILSIM_SERIAL_RC_INPUT_BAUD         38400
+
+// File holding the image of the simulated EEPROM. The SILSIM_EEPROM_FILE
+// environment variable overrides this, so that SIL runs in parallel can each
+// have their own image.
+#define SILSIM_EEPROM_FILE                  "EEPROM.bin"
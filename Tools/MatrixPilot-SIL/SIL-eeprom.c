@@ -9,79 +9,188 @@
 #if (WIN == 1 || NIX == 1)
 
 #include "../../libUDB/libUDB.h"
+#include "SIL-config.h"
+#include "SIL-eeprom.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#if (NIX == 1)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
-#define EEPROMFilePath "EEPROM.bin"
 #define EE_PAGE_SIZE   32
 #define EE_PAGE_COUNT  1024
 #define EE_DATA_SIZE   (EE_PAGE_SIZE * EE_PAGE_COUNT)
 
-uint8_t EEPROMbuffer[EE_DATA_SIZE];
-boolean EEPROMloaded = 0;
-boolean EEPROMdirty = 0;
+// On *nix the image is the file itself, mapped into memory, so it survives a
+// crash of the simulation. On Windows the image is read into memory, and the
+// pages which have changed are written back to the file.
+static uint8_t* EEPROMbuffer = NULL;
+static uint8_t EEPROMmemory[EE_DATA_SIZE];
+#if (WIN == 1)
+static FILE* EEPROMfile = NULL;
+#endif
+static boolean EEPROMloaded = 0;
 
-void loadEEPROMFileIfNeeded(void)
+// One bit for each page written since the last flush. Reads never dirty a page.
+static uint8_t EEPROMdirty[EE_PAGE_COUNT / 8];
+static boolean EEPROManyDirty = 0;
+
+static const char* EEPROMFilePath(void)
 {
-	long n;
-	FILE* fp;
+	const char* path = getenv("SILSIM_EEPROM_FILE");
+
+	return (path != NULL && *path != '\0') ? path : SILSIM_EEPROM_FILE;
+}
 
+static void loadEEPROMFileIfNeeded(void)
+{
 	if (EEPROMloaded) return;
-	
 	EEPROMloaded = 1;
-	fp = fopen(EEPROMFilePath, "r");
-	if (!fp) {
-		memset(EEPROMbuffer, 0, EE_DATA_SIZE);
+	EEPROMbuffer = EEPROMmemory;
+
+#if (NIX == 1)
+	struct stat st;
+	void* image;
+	int fd = open(EEPROMFilePath(), O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0) {
 		return;
 	}
-	n = fread(EEPROMbuffer, EE_PAGE_SIZE, EE_PAGE_COUNT, fp);
-	fclose(fp);
-	if (n < EE_PAGE_COUNT) {
-		memset(EEPROMbuffer, 0, EE_DATA_SIZE);
+	// An image of the wrong size is cleared
+	if (fstat(fd, &st) != 0 || st.st_size != EE_DATA_SIZE) {
+		if (ftruncate(fd, 0) != 0 || ftruncate(fd, EE_DATA_SIZE) != 0) {
+			close(fd);
+			return;
+		}
+	}
+	image = mmap(NULL, EE_DATA_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);  // the mapping keeps the file open
+	if (image != MAP_FAILED) {
+		EEPROMbuffer = (uint8_t*)image;
+	}
+#else
+	EEPROMfile = fopen(EEPROMFilePath(), "r+b");
+	if (!EEPROMfile) {
+		EEPROMfile = fopen(EEPROMFilePath(), "w+b");
+	}
+	if (!EEPROMfile || fread(EEPROMmemory, EE_PAGE_SIZE, EE_PAGE_COUNT, EEPROMfile) < EE_PAGE_COUNT) {
+		// Write the whole image on the first flush
+		memset(EEPROMmemory, 0, EE_DATA_SIZE);
+		memset(EEPROMdirty, 0xFF, sizeof(EEPROMdirty));
+		EEPROManyDirty = 1;
 	}
+#endif
 }
 
-void writeEEPROMFileIfNeeded(void)
+// Limit an access to the end of the image, returning the number of bytes
+static uint16_t eeprom_limit(uint16_t address, uint16_t numbytes)
 {
-	FILE* fp;
+	if (address >= EE_DATA_SIZE) return 0;
+	if (numbytes > EE_DATA_SIZE - address) return EE_DATA_SIZE - address;
+	return numbytes;
+}
 
-	if (!EEPROMdirty) return;
-	
-	fp = fopen(EEPROMFilePath, "w");
-	if (!fp) {
-		return;
+static void eeprom_mark_dirty(uint16_t address, uint16_t numbytes)
+{
+	uint16_t page;
+
+	if (numbytes == 0) return;
+	for (page = address / EE_PAGE_SIZE; page <= (address + numbytes - 1) / EE_PAGE_SIZE; page++) {
+		EEPROMdirty[page / 8] |= 1 << (page % 8);
 	}
-	fwrite(EEPROMbuffer, EE_PAGE_SIZE, EE_PAGE_COUNT, fp);
-	fclose(fp);
-	EEPROMdirty = 0;
+	EEPROManyDirty = 1;
+}
+
+static void eeprom_write_back(uint16_t address, uint16_t numbytes, boolean sync)
+{
+#if (NIX == 1)
+	if (EEPROMbuffer != EEPROMmemory) {
+		// msync needs addresses aligned to the system page size
+		uintptr_t pagemask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+		uintptr_t start = (uintptr_t)(EEPROMbuffer + address) & ~pagemask;
+		uintptr_t end = (uintptr_t)(EEPROMbuffer + address + numbytes);
+
+		msync((void*)start, end - start, sync ? MS_SYNC : MS_ASYNC);
+	}
+#else
+	if (EEPROMfile) {
+		fseek(EEPROMfile, address, SEEK_SET);
+		fwrite(EEPROMbuffer + address, 1, numbytes, EEPROMfile);
+	}
+#endif
+}
+
+// Write back each run of pages written since the last flush
+static void eeprom_flush(boolean sync)
+{
+	uint16_t page = 0;
+	uint16_t first;
+
+	if (!EEPROManyDirty) return;
+	EEPROManyDirty = 0;
+
+	while (page < EE_PAGE_COUNT) {
+		if (!(EEPROMdirty[page / 8] & (1 << (page % 8)))) {
+			page++;
+			continue;
+		}
+		first = page;
+		while (page < EE_PAGE_COUNT && (EEPROMdirty[page / 8] & (1 << (page % 8)))) {
+			EEPROMdirty[page / 8] &= ~(1 << (page % 8));
+			page++;
+		}
+		eeprom_write_back(first * EE_PAGE_SIZE, (page - first) * EE_PAGE_SIZE, sync);
+	}
+#if (WIN == 1)
+	if (EEPROMfile) {
+		fflush(EEPROMfile);
+	}
+#endif
+}
+
+void writeEEPROMFileIfNeeded(void)
+{
+	eeprom_flush(false);
+}
+
+void eeprom_sync(void)
+{
+	eeprom_flush(true);
 }
 
 void eeprom_ByteWrite(uint16_t address, uint8_t data)
 {
 	loadEEPROMFileIfNeeded();
+	if (eeprom_limit(address, 1) == 0) return;
 	EEPROMbuffer[address] = data;
-	EEPROMdirty = 1;
+	eeprom_mark_dirty(address, 1);
 }
 
 void eeprom_ByteRead(uint16_t address, uint8_t *data)
 {
 	loadEEPROMFileIfNeeded();
+	if (eeprom_limit(address, 1) == 0) return;
 	*data = EEPROMbuffer[address];
-	EEPROMdirty = 1;
 }
 
 void eeprom_PageWrite(uint16_t address, uint8_t *data, uint8_t numbytes)
 {
+	uint16_t count;
+
 	loadEEPROMFileIfNeeded();
-	memcpy(EEPROMbuffer+address, data, numbytes);
-	EEPROMdirty = 1;
+	count = eeprom_limit(address, numbytes);
+	memcpy(EEPROMbuffer+address, data, count);
+	eeprom_mark_dirty(address, count);
 }
 
 void eeprom_SequentialRead(uint16_t address, uint8_t *data, uint16_t numbytes)
 {
 	loadEEPROMFileIfNeeded();
-	memcpy(data, EEPROMbuffer+address, numbytes);
-	EEPROMdirty = 1;
+	memcpy(data, EEPROMbuffer+address, eeprom_limit(address, numbytes));
 }
 
 #endif // (WIN == 1 || NIX == 1)
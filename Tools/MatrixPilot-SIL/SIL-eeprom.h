@@ -9,6 +9,10 @@
 #ifndef MatrixPilot_SIL_SIL_eeprom_h
 #define MatrixPilot_SIL_SIL_eeprom_h
 
+// Write back the pages of the EEPROM image changed since the last call
 void writeEEPROMFileIfNeeded(void);
 
+// As writeEEPROMFileIfNeeded, but returns once the changed pages are in the file
+void eeprom_sync(void);
+
 #endif
@@ -21,5 +21,18 @@ int filesys_init(void)
 	return 1;
 }
 
+// host files need no flushing beyond their own fclose()
+void filesys_flush(void)
+{
+}
+
+void filesys_service(void)
+{
+}
+
+void filesys_stats(void)
+{
+}
+
 
 #endif // (WIN == 1 || NIX == 1)
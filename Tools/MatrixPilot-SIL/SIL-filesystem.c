@@ -12,8 +12,14 @@
 #include "../../libUDB/libUDB.h"
 #include "../../libUDB/heartbeat.h"
 #include "SIL-filesystem.h"
-
-#if 0
+#include <string.h>
+#include <sys/stat.h>
+#if (WIN == 1)
+#include <io.h>
+#else
+#include <dirent.h>
+#include <fnmatch.h>
+#endif
 
 int FSInit(void)
 {
@@ -22,8 +28,11 @@ int FSInit(void)
 
 FSFILE* FSfopen(const char* fileName, const char* mode)
 {
-//	printf("opening logfile %s\r\n", fileName);
-	return fopen(fileName, mode);
+	char host_mode[4];
+
+	// always binary, as MDD does no line ending translation
+	snprintf(host_mode, sizeof(host_mode), "%c%sb", mode[0], strchr(mode, '+') ? "+" : "");
+	return fopen(fileName, host_mode);
 }
 
 int FSfclose(FSFILE* fo)
@@ -31,13 +40,146 @@ int FSfclose(FSFILE* fo)
 	return fclose(fo);
 }
 
+size_t FSfread(void* ptr, size_t size, size_t n, FSFILE* stream)
+{
+	return fread(ptr, size, n, stream);
+}
+
 size_t FSfwrite(const void* data_to_write, size_t size, size_t n, FSFILE* stream)
 {
 	return fwrite(data_to_write, size, n, stream);
 }
 
+int FSfseek(FSFILE* stream, long offset, int whence)
+{
+	return fseek(stream, offset, whence);
+}
+
+long FSftell(FSFILE* fo)
+{
+	return ftell(fo);
+}
+
+int FSremove(const char* fileName)
+{
+	return remove(fileName);
+}
+
+#if (WIN == 1)
+
+static int sil_find_result(SearchRec* rec, struct _finddata_t* fd)
+{
+	strncpy(rec->filename, fd->name, sizeof(rec->filename) - 1);
+	rec->filename[sizeof(rec->filename) - 1] = '\0';
+	rec->attributes = (fd->attrib & _A_SUBDIR) ? ATTR_DIRECTORY : ATTR_ARCHIVE;
+	rec->filesize = fd->size;
+	return 0;
+}
+
+static intptr_t sil_find_handle = -1;   // the search still open, if there is one
+
+void FindClose(SearchRec* rec)
+{
+	if ((intptr_t)rec->handle != -1 && (intptr_t)rec->handle == sil_find_handle)
+	{
+		_findclose(sil_find_handle);
+		sil_find_handle = -1;
+	}
+	rec->handle = (void*)-1;
+}
+
+int FindFirst(const char* fileName, unsigned int attr, SearchRec* rec)
+{
+	struct _finddata_t fd;
+	intptr_t h;
+
+	// one search at a time, as with FSIO, so close any left unfinished
+	if (sil_find_handle != -1)
+	{
+		_findclose(sil_find_handle);
+	}
+	h = _findfirst(fileName, &fd);
+	sil_find_handle = h;
+	rec->searchattr = attr;
+	rec->handle = (void*)h;
+	if (h == -1)
+	{
+		return -1;
+	}
+	return sil_find_result(rec, &fd);
+}
+
+int FindNext(SearchRec* rec)
+{
+	struct _finddata_t fd;
+
+	if ((intptr_t)rec->handle == -1 || (intptr_t)rec->handle != sil_find_handle ||
+	    _findnext((intptr_t)rec->handle, &fd) != 0)
+	{
+		FindClose(rec);
+		return -1;
+	}
+	return sil_find_result(rec, &fd);
+}
+
 #else
 
-#endif // 0
+static char sil_find_pattern[64];
+static DIR* sil_find_dir = NULL;        // the search still open, if there is one
+
+void FindClose(SearchRec* rec)
+{
+	if (rec->handle != NULL && rec->handle == sil_find_dir)
+	{
+		closedir(sil_find_dir);
+		sil_find_dir = NULL;
+	}
+	rec->handle = NULL;
+}
+
+int FindNext(SearchRec* rec)
+{
+	struct dirent* de;
+	struct stat st;
+
+	if (rec->handle == NULL || rec->handle != sil_find_dir)
+	{
+		rec->handle = NULL;
+		return -1;
+	}
+	while ((de = readdir((DIR*)rec->handle)) != NULL)
+	{
+		if (de->d_name[0] == '.' || fnmatch(sil_find_pattern, de->d_name, 0) != 0)
+		{
+			continue;
+		}
+		if (stat(de->d_name, &st) != 0 || strlen(de->d_name) >= sizeof(rec->filename))
+		{
+			continue;
+		}
+		strcpy(rec->filename, de->d_name);
+		rec->attributes = S_ISDIR(st.st_mode) ? ATTR_DIRECTORY : ATTR_ARCHIVE;
+		rec->filesize = (unsigned long)st.st_size;
+		return 0;
+	}
+	FindClose(rec);
+	return -1;
+}
+
+int FindFirst(const char* fileName, unsigned int attr, SearchRec* rec)
+{
+	// one search at a time, as with FSIO, so close any left unfinished
+	if (sil_find_dir != NULL)
+	{
+		closedir(sil_find_dir);
+	}
+	// "*.*" means every file to FAT, but only those with a '.' in their name to fnmatch
+	strncpy(sil_find_pattern, strcmp(fileName, "*.*") ? fileName : "*", sizeof(sil_find_pattern) - 1);
+	rec->searchattr = attr;
+	rec->handle = sil_find_dir = opendir(".");
+	return FindNext(rec);
+}
+
+#endif // WIN
 
 #endif // (WIN == 1 || NIX == 1)
@@ -19,18 +19,50 @@
 // along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
 
 
-#include <stdio.h>
+#ifndef SIL_FILESYSTEM_H
+#define SIL_FILESYSTEM_H
+
+// A stand in for the subset of the Microchip MDD file system API (FSIO.h)
+// used by MatrixPilot, implemented on the host's files in the current directory.
 
-//typedef struct
-//{
-//	int foo;
-//} FSFILE;
+#include <stdio.h>
 
 #define FSFILE FILE
 
+#define FS_APPEND       "ab"
+#define FS_WRITE        "wb"
+#define FS_READ         "rb"
+#define FS_READPLUS     "r+b"
+
+#define ATTR_READ_ONLY  0x01
+#define ATTR_HIDDEN     0x02
+#define ATTR_SYSTEM     0x04
+#define ATTR_VOLUME     0x08
+#define ATTR_DIRECTORY  0x10
+#define ATTR_ARCHIVE    0x20
+#define ATTR_MASK       0x3f
+
+// host file names need not be 8.3
+typedef struct
+{
+	char            filename[64];
+	unsigned char   attributes;
+	unsigned long   filesize;
+	void*           handle;         // host directory search handle (internal use only)
+	unsigned int    searchattr;
+} SearchRec;
+
 int FSInit(void);
 FSFILE* FSfopen(const char* fileName, const char* mode);
 int FSfclose(FSFILE* fo);
+size_t FSfread(void* ptr, size_t size, size_t n, FSFILE* stream);
 size_t FSfwrite(const void* data_to_write, size_t size, size_t n, FSFILE* stream);
+int FSfseek(FSFILE* stream, long offset, int whence);
+long FSftell(FSFILE* fo);
+int FSremove(const char* fileName);
+int FindFirst(const char* fileName, unsigned int attr, SearchRec* rec);
+int FindNext(SearchRec* rec);
+// End a search before FindNext() has reached the end of the files
+void FindClose(SearchRec* rec);
 
-
+#endif // SIL_FILESYSTEM_H
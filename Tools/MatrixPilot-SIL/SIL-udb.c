@@ -74,6 +74,7 @@ inline int gettimeofday(struct timeval* p, void* tz /* IGNORED */)
 #else
 
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #endif // WIN
@@ -274,6 +275,33 @@ uint8_t udb_cpu_load(void)
 	return 5; // sounds reasonable for a fake cpu%
 }
 
+// Microseconds from a monotonic clock, so that code timings are not upset
+// when the system time is adjusted.
+uint16_t udb_timer_ticks(void)
+{
+#ifdef WIN
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER count;
+
+	if (frequency.QuadPart == 0)
+	{
+		QueryPerformanceFrequency(&frequency);
+	}
+	QueryPerformanceCounter(&count);
+	return (uint16_t)((count.QuadPart * 1000000LL) / frequency.QuadPart);
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint16_t)(ts.tv_sec * 1000000L + ts.tv_nsec / 1000);
+#endif // WIN
+}
+
+uint16_t udb_timer_ticks_per_ms(void)
+{
+	return 1000;
+}
+
 int16_t udb_servo_pulsesat(int32_t pw)
 {
 	if (pw > SERVOMAX) pw = SERVOMAX;
@@ -324,6 +352,7 @@ void sil_reset(void)
 #endif
 
 	sil_ui_will_reset();
+	eeprom_sync();
 
 	if (gpsSocket)       UDBSocket_close(gpsSocket);
 	if (telemetrySocket) UDBSocket_close(telemetrySocket);
@@ -8,10 +8,14 @@ MP_OBJECTS = \
 ../../MatrixPilot/config_tests.o \
 ../../MatrixPilot/data_services.o \
 ../../MatrixPilot/data_storage.o \
+../../MatrixPilot/data_storage_log.o \
 ../../MatrixPilot/euler_angles.o \
 ../../MatrixPilot/flightplan.o \
+../../MatrixPilot/MAVFence.o \
+../../MatrixPilot/geofence.o \
 ../../MatrixPilot/flightplan-logo.o \
 ../../MatrixPilot/flightplan-waypoints.o \
+../../MatrixPilot/gainSchedule.o \
 ../../MatrixPilot/helicalTurnCntrl.o \
 ../../MatrixPilot/main.o \
 ../../MatrixPilot/MAVFlexiFunctions.o \
@@ -26,6 +30,7 @@ MP_OBJECTS = \
 ../../MatrixPilot/nv_memory_table.o \
 ../../MatrixPilot/parameter_table.o \
 ../../MatrixPilot/pitchCntrl.o \
+../../MatrixPilot/profile.o \
 ../../MatrixPilot/rollCntrl.o \
 ../../MatrixPilot/servoMix.o \
 ../../MatrixPilot/servoPrepare.o \
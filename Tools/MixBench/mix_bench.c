@@ -0,0 +1,261 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// A host check of the mix table in MatrixPilot/servoMix.c against the hand
+// written mix it replaced, kept in servo_mix_ref.c.
+//
+// Both are built into this program with the same options, see options.h, with
+// the airframe and reversing options set by the Makefile. Each frame gives
+// both the same random radio inputs, trims, controls, waggle, flags and, for
+// the glider, brake and flap selections, and every output of the table must
+// equal the output of the reference exactly. The controls go past the servo
+// range at times, so that the saturation is checked too.
+//
+// Usage: mix_bench [-t]
+//   -t    also time servoMix() and the reference, in nanoseconds per frame on this host
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "defines.h"
+#include "servoMix.h"
+#include "config.h"
+#include "states.h"
+
+#define FRAMES          1000000
+#define TIMED_FRAMES    1000
+#define TIMED_REPEATS   1000
+
+void ref_servoMix_init(void);
+void ref_servoMix(void);
+
+int16_t roll_control;
+int16_t pitch_control;
+int16_t yaw_control;
+int16_t throttle_control;
+int16_t waggle;
+
+int16_t udb_pwIn[NUM_INPUTS+1];
+int16_t udb_pwTrim[NUM_INPUTS+1];
+int16_t udb_pwOut[NUM_OUTPUTS+1];
+union udb_fbts_byte udb_flags;
+union state_flags_int state_flags;
+struct gains_variables gains;
+
+int16_t cam_pitch_servo_pwm_delta;
+int16_t cam_yaw_servo_pwm_delta;
+
+static int16_t overspeedBrake;
+static int16_t autopilotBrake;
+static int16_t flapsSelected;
+
+int16_t udb_servo_pulsesat(int32_t pw)
+{
+	if (pw > SERVOMAX) pw = SERVOMAX;
+	if (pw < SERVOMIN) pw = SERVOMIN;
+	return (int16_t)pw;
+}
+
+int32_t cam_pitchServoLimit(int32_t pwm_pulse)
+{
+	return pwm_pulse;
+}
+
+int32_t cam_yawServoLimit(int32_t pwm_pulse)
+{
+	return pwm_pulse;
+}
+
+int16_t get_overspeedBrake(void)
+{
+	return overspeedBrake;
+}
+
+int16_t get_autopilotBrake(void)
+{
+	return autopilotBrake;
+}
+
+int16_t get_flapsSelected(void)
+{
+	return flapsSelected;
+}
+
+struct frame {
+	int16_t pwIn[NUM_INPUTS+1];
+	int16_t pwTrim[NUM_INPUTS+1];
+	int16_t control[4];
+	int16_t waggle;
+	int16_t overspeedBrake;
+	int16_t autopilotBrake;
+	int16_t flapsSelected;
+	uint8_t radio_on;
+	uint8_t pitch_feedback;
+};
+
+static int16_t random_range(int16_t min, int16_t max)
+{
+	return min + (int16_t)(rand() % (max - min + 1));
+}
+
+static void make_frame(struct frame* f)
+{
+	int16_t i;
+
+	for (i = 0; i <= NUM_INPUTS; i++)
+	{
+		f->pwIn[i] = random_range(1900, 4100);
+		f->pwTrim[i] = random_range(2600, 3400);
+	}
+	// a throttle with no signal
+	if (rand() % 20 == 0)
+	{
+		f->pwIn[THROTTLE_INPUT_CHANNEL] = 0;
+	}
+	for (i = 0; i < 4; i++)
+	{
+		// past the servo range at times
+		f->control[i] = (rand() % 10 == 0) ? random_range(-3000, 3000) : random_range(-1000, 1000);
+	}
+	f->waggle = (rand() % 4 == 0) ? random_range(-400, 400) : 0;
+	f->overspeedBrake = (rand() % 8 == 0) ? random_range(0, 2000) : 0;
+	f->autopilotBrake = random_range(-200, 2000);
+	// the flaps are selected for a while, and move towards it
+	if (rand() % 200 == 0)
+	{
+		flapsSelected = random_range(-1000, 1000);
+	}
+	f->flapsSelected = flapsSelected;
+	f->radio_on = (rand() % 4 != 0);
+	f->pitch_feedback = (rand() % 2 == 0);
+}
+
+static void set_frame(const struct frame* f)
+{
+	memcpy(udb_pwIn, f->pwIn, sizeof(udb_pwIn));
+	memcpy(udb_pwTrim, f->pwTrim, sizeof(udb_pwTrim));
+	roll_control = f->control[0];
+	pitch_control = f->control[1];
+	yaw_control = f->control[2];
+	throttle_control = f->control[3];
+	waggle = f->waggle;
+	overspeedBrake = f->overspeedBrake;
+	autopilotBrake = f->autopilotBrake;
+	flapsSelected = f->flapsSelected;
+	udb_flags._.radio_on = f->radio_on;
+	state_flags._.pitch_feedback = f->pitch_feedback;
+}
+
+static int check(void)
+{
+	struct frame f;
+	int16_t ref[NUM_OUTPUTS+1];
+	long n;
+	int16_t i;
+
+	srand(1);
+	for (n = 0; n < FRAMES; n++)
+	{
+		make_frame(&f);
+
+		set_frame(&f);
+		memset(udb_pwOut, 0xff, sizeof(udb_pwOut));
+		ref_servoMix();
+		memcpy(ref, udb_pwOut, sizeof(ref));
+
+		set_frame(&f);
+		memset(udb_pwOut, 0xff, sizeof(udb_pwOut));
+		servoMix();
+
+		for (i = 0; i <= NUM_OUTPUTS; i++)
+		{
+			if (udb_pwOut[i] != ref[i])
+			{
+				printf("airframe %i reversed 0x%02x: frame %li output %i is %i, the reference is %i\n",
+				       AIRFRAME_TYPE, MIX_BENCH_REVERSED, n, i, udb_pwOut[i], ref[i]);
+				return 1;
+			}
+		}
+	}
+	printf("airframe %i reversed 0x%02x: %i frames, every output equal\n",
+	       AIRFRAME_TYPE, MIX_BENCH_REVERSED, FRAMES);
+	return 0;
+}
+
+static double time_mix(void (*mix)(void), const struct frame* frames)
+{
+	struct timespec start, stop;
+	int r;
+	int n;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < TIMED_REPEATS; r++)
+	{
+		for (n = 0; n < TIMED_FRAMES; n++)
+		{
+			set_frame(&frames[n]);
+			mix();
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_nsec - start.tv_nsec)) /
+	       ((double)TIMED_REPEATS * TIMED_FRAMES);
+}
+
+static void timing(void)
+{
+	static struct frame frames[TIMED_FRAMES];
+	double ref_ns;
+	double table_ns;
+	int n;
+
+	srand(2);
+	for (n = 0; n < TIMED_FRAMES; n++)
+	{
+		make_frame(&frames[n]);
+	}
+	time_mix(ref_servoMix, frames);
+	ref_ns = time_mix(ref_servoMix, frames);
+	table_ns = time_mix(servoMix, frames);
+	printf("airframe %i reversed 0x%02x: reference %.1f ns, table %.1f ns a frame\n",
+	       AIRFRAME_TYPE, MIX_BENCH_REVERSED, ref_ns, table_ns);
+}
+
+int main(int argc, char** argv)
+{
+	gains.ElevatorBoost = 0.5;
+	gains.RudderBoost = 1.0;
+	ref_servoMix_init();
+	servoMix_init();
+
+	if (check() != 0)
+	{
+		return 1;
+	}
+	if (argc > 1 && strcmp(argv[1], "-t") == 0)
+	{
+		timing();
+	}
+	return 0;
+}
@@ -0,0 +1,90 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The options of mix_bench.c, found before the options of any Config on the
+// include path. These are the Cessna options, with AIRFRAME_TYPE and the
+// reversing options set by the Makefile, and with every mixed output given a
+// channel of its own, so that each can be compared.
+//
+// MIX_BENCH_REVERSED holds the reversing options as bits:
+//   1   AILERON_CHANNEL_REVERSED
+//   2   AILERON_SECONDARY_CHANNEL_REVERSED
+//   4   ELEVATOR_CHANNEL_REVERSED
+//   8   RUDDER_CHANNEL_REVERSED
+//   16  THROTTLE_CHANNEL_REVERSED
+//   32  ELEVON_VTAIL_SURFACES_REVERSED
+//   64  every glider surface *_DIR_REVERSED, see options_servo_mix.h
+//   128 every glider surface *_OFFSET_REVERSED
+
+#include "../../Config/Cessna/options.h"
+
+#ifndef MIX_BENCH_REVERSED
+#define MIX_BENCH_REVERSED                  0
+#endif
+
+#undef NUM_INPUTS
+#undef NUM_OUTPUTS
+#define NUM_INPUTS                          8
+#define NUM_OUTPUTS                         10
+
+#undef AILERON_SECONDARY_OUTPUT_CHANNEL
+#undef AILERON_LEFT_OUTPUT_CHANNEL
+#undef FLAP_LEFT_OUTPUT_CHANNEL
+#undef FLAP_RIGHT_OUTPUT_CHANNEL
+#undef AILERON_RIGHT_OUTPUT_CHANNEL
+#undef BRAKE_OUTPUT_CHANNEL
+#undef FLAPS_OUTPUT_CHANNEL
+#undef BRAKE_THR_SEL_INPUT_CHANNEL
+#undef FLAPS_INPUT_CHANNEL
+#if (AIRFRAME_TYPE == 6) // AIRFRAME_GLIDER, which is defined after the options
+#define AILERON_LEFT_OUTPUT_CHANNEL         CHANNEL_1
+#define AILERON_RIGHT_OUTPUT_CHANNEL        CHANNEL_5
+#define FLAP_LEFT_OUTPUT_CHANNEL            CHANNEL_6
+#define FLAP_RIGHT_OUTPUT_CHANNEL           CHANNEL_7
+#define BRAKE_OUTPUT_CHANNEL                CHANNEL_9
+#define FLAPS_OUTPUT_CHANNEL                CHANNEL_10
+#define BRAKE_THR_SEL_INPUT_CHANNEL         CHANNEL_6
+#define FLAPS_INPUT_CHANNEL                 CHANNEL_7
+#define AILERON_SECONDARY_OUTPUT_CHANNEL    CHANNEL_UNUSED
+#else
+#define AILERON_LEFT_OUTPUT_CHANNEL         CHANNEL_UNUSED
+#define AILERON_RIGHT_OUTPUT_CHANNEL        CHANNEL_UNUSED
+#define FLAP_LEFT_OUTPUT_CHANNEL            CHANNEL_UNUSED
+#define FLAP_RIGHT_OUTPUT_CHANNEL           CHANNEL_UNUSED
+#define BRAKE_OUTPUT_CHANNEL                CHANNEL_UNUSED
+#define FLAPS_OUTPUT_CHANNEL                CHANNEL_UNUSED
+#define BRAKE_THR_SEL_INPUT_CHANNEL         CHANNEL_UNUSED
+#define FLAPS_INPUT_CHANNEL                 CHANNEL_UNUSED
+#define AILERON_SECONDARY_OUTPUT_CHANNEL    CHANNEL_5
+#endif
+
+#undef AILERON_CHANNEL_REVERSED
+#undef AILERON_SECONDARY_CHANNEL_REVERSED
+#undef ELEVATOR_CHANNEL_REVERSED
+#undef RUDDER_CHANNEL_REVERSED
+#undef THROTTLE_CHANNEL_REVERSED
+#undef ELEVON_VTAIL_SURFACES_REVERSED
+#define AILERON_CHANNEL_REVERSED            ((MIX_BENCH_REVERSED & 1) != 0)
+#define AILERON_SECONDARY_CHANNEL_REVERSED  ((MIX_BENCH_REVERSED & 2) != 0)
+#define ELEVATOR_CHANNEL_REVERSED           ((MIX_BENCH_REVERSED & 4) != 0)
+#define RUDDER_CHANNEL_REVERSED             ((MIX_BENCH_REVERSED & 8) != 0)
+#define THROTTLE_CHANNEL_REVERSED           ((MIX_BENCH_REVERSED & 16) != 0)
+#define ELEVON_VTAIL_SURFACES_REVERSED      ((MIX_BENCH_REVERSED & 32) != 0)
@@ -0,0 +1,75 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+// The servo mix options of mix_bench.c, found before those of the Config on
+// the include path, with the glider surfaces reversed as MIX_BENCH_REVERSED
+// sets in options.h.
+
+#ifndef _MIX_BENCH_SERVOMIX_OPTIONS_H_
+#define _MIX_BENCH_SERVOMIX_OPTIONS_H_
+
+// The glider factors, with the elevator mixed from the throttle, the rudder
+// throw reduced and offsets on the rudder and elevator, so that every factor
+// of the mix is used
+#include "../../Config/options_servo_mix.h"
+
+#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
+#undef ELEVATOR_THROTTLE_FACTOR
+#undef RUDDER_FACTOR
+#undef RUDDER_OUTPUT_OFFSET
+#undef ELEVATOR_OUTPUT_OFFSET
+#define ELEVATOR_THROTTLE_FACTOR            -0.25
+#define RUDDER_FACTOR                       -0.30
+#define RUDDER_OUTPUT_OFFSET                40
+#define ELEVATOR_OUTPUT_OFFSET              -60
+
+#if (MIX_BENCH_REVERSED & 64)
+#undef AILERON_LEFT_DIR_REVERSED
+#undef FLAP_LEFT_DIR_REVERSED
+#undef FLAP_RIGHT_DIR_REVERSED
+#undef AILERON_RIGHT_DIR_REVERSED
+#undef ELEVATOR_DIR_REVERSED
+#undef RUDDER_DIR_REVERSED
+#define AILERON_LEFT_DIR_REVERSED           1
+#define FLAP_LEFT_DIR_REVERSED              1
+#define FLAP_RIGHT_DIR_REVERSED             1
+#define AILERON_RIGHT_DIR_REVERSED          1
+#define ELEVATOR_DIR_REVERSED               1
+#define RUDDER_DIR_REVERSED                 1
+#endif
+
+#if (MIX_BENCH_REVERSED & 128)
+#undef AILERON_LEFT_OFFSET_REVERSED
+#undef FLAP_LEFT_OFFSET_REVERSED
+#undef FLAP_RIGHT_OFFSET_REVERSED
+#undef AILERON_RIGHT_OFFSET_REVERSED
+#undef ELEVATOR_OFFSET_REVERSED
+#undef RUDDER_OFFSET_REVERSED
+#define AILERON_LEFT_OFFSET_REVERSED        1
+#define FLAP_LEFT_OFFSET_REVERSED           1
+#define FLAP_RIGHT_OFFSET_REVERSED          1
+#define AILERON_RIGHT_OFFSET_REVERSED       1
+#define ELEVATOR_OFFSET_REVERSED            1
+#define RUDDER_OFFSET_REVERSED              1
+#endif
+#endif // AIRFRAME_GLIDER
+
+#endif // _MIX_BENCH_SERVOMIX_OPTIONS_H_
@@ -0,0 +1,52 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#ifndef _FSCONFIG_H_
+#define _FSCONFIG_H_
+
+// Stands in for Microchip/FSconfig.h, so that libFlashFS/sector_cache.c can
+// be built on the host, with the media simulated by sector_cache_bench.c.
+
+#include "GenericTypeDefs.h"
+
+#define MEDIA_SECTOR_SIZE       512
+
+#ifndef MDD_SECTOR_CACHE_SECTORS
+#define MDD_SECTOR_CACHE_SECTORS 4
+#endif
+
+BYTE bench_SectorRead(DWORD sector_addr, BYTE* buffer);
+BYTE bench_SectorWrite(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero);
+
+#define MDD_MEDIA_SectorRead    bench_SectorRead
+#define MDD_MEDIA_SectorWrite   bench_SectorWrite
+
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+#include "sector_cache.h"
+#define MDD_SectorRead          sector_cache_read
+#define MDD_SectorWrite         sector_cache_write
+#else
+#define MDD_SectorRead          MDD_MEDIA_SectorRead
+#define MDD_SectorWrite         MDD_MEDIA_SectorWrite
+#endif
+
+#endif // _FSCONFIG_H_
@@ -0,0 +1,324 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// A host benchmark of the sector cache in libFlashFS/sector_cache.c.
+//
+// The sector accesses the MDD file system (FSIO.c) makes while MatrixPilot
+// logs telemetry are replayed through MDD_SectorRead and MDD_SectorWrite,
+// as mapped by FSconfig.h for the build, onto an image file written through
+// the SIL file system shim (Tools/MatrixPilot-SIL/SIL-filesystem.c). The
+// media operations are counted, and timed with the sector read and write
+// times of the 24LC256 and AT45D, and the image is checked against what the
+// file system wrote once the cache has been flushed.
+//
+// The replay follows FSIO.c: each sector, other than the first of a newly
+// allocated cluster, is read into its one data buffer before being written,
+// and read again if another file has used the buffer meanwhile. It keeps one
+// FAT sector, written to both FAT copies when another is needed. Each log
+// starts with the log index being read and rewritten and the log file
+// created. While it is written, a ground station downloads the previous log
+// over MAVLink FTP, at the rate it is written, and lists the directory every
+// LIST_INTERVAL blocks. The log is closed as by log_close().
+//
+// See the Makefile, "make run" builds and runs it with several cache sizes.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FSconfig.h"
+#include "SIL-filesystem.h"
+
+#define IMAGE_FILE      "sector_cache_bench.img"
+#define IMAGE_SECTORS   8192
+
+// volume layout, much as FSformat() lays out a FAT16 volume of this size
+#define BOOT_SECTOR     0
+#define FAT_SECTOR      1
+#define FAT_SECTORS     32          // 256 clusters per FAT sector
+#define FAT_COPIES      2
+#define ROOT_SECTOR     (FAT_SECTOR + (FAT_COPIES * FAT_SECTORS))
+#define ROOT_SECTORS    4           // 64 directory entries
+#define DATA_SECTOR     (ROOT_SECTOR + ROOT_SECTORS)
+#define CLUSTER_SECTORS 4
+
+#define LOGS            5
+#define LOG_BLOCKS      600         // one minute of telemetry at 5 KB/s
+#define LIST_INTERVAL   50
+#define INDEX_SECTOR    DATA_SECTOR // logindex.dat takes the first cluster
+
+// sector read and write times in microseconds, for the 24LC256 at 400kHz
+// (eight page writes, each with a 5ms write cycle) and the AT45DB161D
+// (a buffer transfer at 10MHz, and a typical page erase and program)
+#define EEPROM_READ_US  11600
+#define EEPROM_WRITE_US 52000
+#define AT45D_READ_US   450
+#define AT45D_WRITE_US  17500
+
+static FSFILE* image;
+static BYTE expected[IMAGE_SECTORS][MEDIA_SECTOR_SIZE]; // as written by the file system
+static unsigned long media_reads = 0;
+static unsigned long media_writes = 0;
+
+static DWORD fat_buffer_sector = 0xFFFFFFFF;    // FSIO's gFATBuffer
+static BYTE fat_buffer_dirty = FALSE;
+static BYTE buffer[MEDIA_SECTOR_SIZE];          // FSIO's gDataBuffer
+static BYTE fat_buffer[MEDIA_SECTOR_SIZE];
+static DWORD next_cluster = 1;                  // logindex.dat has cluster 0
+static DWORD first_cluster[LOGS];
+static enum { THE_LOG, OTHER_FILE } buffer_owner = OTHER_FILE;
+static unsigned int pattern = 0;
+
+BYTE bench_SectorRead(DWORD sector_addr, BYTE* buf)
+{
+	media_reads++;
+	if (FSfseek(image, (long)sector_addr * MEDIA_SECTOR_SIZE, SEEK_SET) != 0 ||
+	    FSfread(buf, 1, MEDIA_SECTOR_SIZE, image) != MEDIA_SECTOR_SIZE)
+	{
+		return FALSE;
+	}
+	return TRUE;
+}
+
+BYTE bench_SectorWrite(DWORD sector_addr, BYTE* buf, BYTE allowWriteToZero)
+{
+	media_writes++;
+	if (sector_addr == 0 && !allowWriteToZero)
+	{
+		return FALSE;
+	}
+	if (FSfseek(image, (long)sector_addr * MEDIA_SECTOR_SIZE, SEEK_SET) != 0 ||
+	    FSfwrite(buf, 1, MEDIA_SECTOR_SIZE, image) != MEDIA_SECTOR_SIZE)
+	{
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void fs_read(DWORD sector, BYTE* buf)
+{
+	if (!MDD_SectorRead(sector, buf))
+	{
+		printf("read of sector %lu failed\n", (unsigned long)sector);
+		exit(1);
+	}
+}
+
+// change the sector, as the file system would, and write it
+static void fs_write(DWORD sector, BYTE* buf)
+{
+	int i;
+
+	for (i = 0; i < 16; i++)
+	{
+		buf[(pattern * 7 + i) % MEDIA_SECTOR_SIZE] = (BYTE)(pattern + i);
+	}
+	pattern++;
+	memcpy(expected[sector], buf, MEDIA_SECTOR_SIZE);
+	if (!MDD_SectorWrite(sector, buf, FALSE))
+	{
+		printf("write of sector %lu failed\n", (unsigned long)sector);
+		exit(1);
+	}
+}
+
+static void fat_flush(void)
+{
+	int copy;
+
+	if (fat_buffer_dirty)
+	{
+		for (copy = 0; copy < FAT_COPIES; copy++)
+		{
+			fs_write(fat_buffer_sector + (copy * FAT_SECTORS), fat_buffer);
+		}
+		fat_buffer_dirty = FALSE;
+	}
+}
+
+// the FAT sector holding a cluster, to follow a chain or to allocate it
+static void fat_access(DWORD cluster, BYTE allocate)
+{
+	DWORD sector = FAT_SECTOR + (cluster / 256);
+
+	if (sector != fat_buffer_sector)
+	{
+		fat_flush();
+		fs_read(sector, fat_buffer);
+		fat_buffer_sector = sector;
+	}
+	if (allocate)
+	{
+		fat_buffer_dirty = TRUE;
+	}
+}
+
+static void dir_search(int sectors)
+{
+	int i;
+
+	for (i = 0; i < sectors; i++)
+	{
+		fs_read(ROOT_SECTOR + i, buffer);
+	}
+	buffer_owner = OTHER_FILE;
+}
+
+static void dir_update(int entry)
+{
+	fs_read(ROOT_SECTOR + (entry / 16), buffer);
+	fs_write(ROOT_SECTOR + (entry / 16), buffer);
+	buffer_owner = OTHER_FILE;
+}
+
+static void log_index_save(void)
+{
+	dir_search(1);
+	fs_read(INDEX_SECTOR, buffer);
+	fs_write(INDEX_SECTOR, buffer);
+	dir_update(0);
+}
+
+// MAVLink FTP reading one sector of an earlier log
+static void download_sector(DWORD first_cluster, int block)
+{
+	if ((block % CLUSTER_SECTORS) == 0)
+	{
+		fat_access(first_cluster + (block / CLUSTER_SECTORS), FALSE);
+	}
+	fs_read(DATA_SECTOR + (first_cluster * CLUSTER_SECTORS) + block, buffer);
+	buffer_owner = OTHER_FILE;
+}
+
+static void log_file(int log)
+{
+	DWORD sector = 0;
+	int block;
+
+	log_index_save();                       // log_index_opened(), via log_index_init()
+	dir_search(ROOT_SECTORS);               // FSfopen() making sure it is a new name
+	dir_update(log + 1);
+	first_cluster[log] = next_cluster;
+	for (block = 0; block < LOG_BLOCKS; block++)
+	{
+		if (buffer_owner != THE_LOG && block != 0)
+		{
+			fs_read(sector, buffer);        // FSfwrite() reloads the full sector first
+		}
+		if ((block % CLUSTER_SECTORS) == 0)
+		{
+			// a new cluster is not read, FILEallocate_new_cluster()
+			fat_access(next_cluster, TRUE);
+			sector = DATA_SECTOR + (next_cluster * CLUSTER_SECTORS);
+			next_cluster++;
+		}
+		else
+		{
+			sector++;
+			fs_read(sector, buffer);
+		}
+		fs_write(sector, buffer);
+		buffer_owner = THE_LOG;
+		if (log > 0)
+		{
+			download_sector(first_cluster[log - 1], block);
+		}
+		if ((block % LIST_INTERVAL) == LIST_INTERVAL - 1)
+		{
+			dir_search(ROOT_SECTORS);       // a MAVLink FTP directory listing
+		}
+	}
+	fat_flush();                            // FSfclose()
+	dir_update(log + 1);
+	log_index_save();                       // log_index_closed()
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+	sector_cache_flush();                   // filesys_flush()
+#endif
+}
+
+static int check_image(void)
+{
+	BYTE sector[MEDIA_SECTOR_SIZE];
+	int errors = 0;
+	int i;
+
+	for (i = 0; i < IMAGE_SECTORS; i++)
+	{
+		if (!bench_SectorRead(i, sector) || memcmp(sector, expected[i], MEDIA_SECTOR_SIZE) != 0)
+		{
+			errors++;
+		}
+	}
+	return errors;
+}
+
+int main(int argc, char** argv)
+{
+	static BYTE blank[MEDIA_SECTOR_SIZE];
+	unsigned long reads, writes;
+	clock_t start;
+	double host_ms;
+	int errors;
+	int i;
+
+	image = FSfopen(IMAGE_FILE, FS_WRITE);
+	for (i = 0; image != NULL && i < IMAGE_SECTORS; i++)
+	{
+		FSfwrite(blank, 1, MEDIA_SECTOR_SIZE, image);
+	}
+	if (image == NULL || FSfclose(image) != 0 || (image = FSfopen(IMAGE_FILE, FS_READPLUS)) == NULL)
+	{
+		printf("can not create %s\n", IMAGE_FILE);
+		return 1;
+	}
+
+	start = clock();
+	fs_read(BOOT_SECTOR, buffer);           // FSInit()
+	dir_search(ROOT_SECTORS);
+	for (i = 0; i < LOGS; i++)
+	{
+		log_file(i);
+	}
+	host_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+	reads = media_reads;
+	writes = media_writes;
+
+	errors = check_image();
+	FSfclose(image);
+	FSremove(IMAGE_FILE);
+
+	printf("%2u sectors: %6lu reads %6lu writes, 24LC256 %6.1fs, AT45D %5.1fs, host %6.1fms%s\n",
+	       MDD_SECTOR_CACHE_SECTORS, reads, writes,
+	       (reads * (double)EEPROM_READ_US + writes * (double)EEPROM_WRITE_US) / 1e6,
+	       (reads * (double)AT45D_READ_US + writes * (double)AT45D_WRITE_US) / 1e6,
+	       host_ms, errors ? "" : ", image correct");
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+	printf("            ");
+	sector_cache_print_stats();
+#endif
+	if (errors)
+	{
+		printf("%d sectors differ from what the file system wrote\n", errors);
+		return 1;
+	}
+	return 0;
+}
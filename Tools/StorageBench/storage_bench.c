@@ -0,0 +1,312 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// A host replay of random saves, with random power cuts, against the log
+// structured data storage in MatrixPilot/data_storage_log.c.
+//
+// The 24LC256 is emulated in ram, and each NV memory request completes, with
+// its callback, before the storage service runs again, as udb_background
+// would call it. A power cut stops a write part way through, anywhere in its
+// data or header, and the storage is restarted from its startup scan, as after
+// a reset. After each cut the areas are checked against what was saved:
+//  - an area which existed before the cut must still exist,
+//  - its data must be either what was saved before, or what was being saved.
+// Every area is also checked at regular intervals, and after restarts without
+// a power cut. Each save has a layout signature made from its first byte, which
+// must be read back with the data.
+//
+// The writes to each 64 byte page of the device are counted, to show how
+// evenly they are spread.
+//
+// See the Makefile, "make run" builds and runs it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "../../MatrixPilot/data_storage_log.c"
+
+#define NV_MEMORY_SIZE  0x8000
+#define NV_PAGE_SIZE    64
+#define NV_PAGES        (NV_MEMORY_SIZE / NV_PAGE_SIZE)
+
+#define SAVES           200000
+#define CUT_CHANCE      50      // one save in this many has a power cut
+#define CUT_BYTES       400     // a cut comes within this many bytes written
+#define RESTART_EVERY   997     // restart without a power cut
+#define CHECK_EVERY     101
+#define SERVICE_LIMIT   100000
+
+#define AREAS           10
+#define LAYOUT(data)    (0x100 | (data)[0])
+#define MAX_AREA_SIZE   256
+
+static const uint16_t area_sizes[AREAS] = {20, 40, 48, 49, 100, 200, 256, 12, 70, 130};
+
+static uint8_t nv_memory[NV_MEMORY_SIZE];
+static unsigned long page_writes[NV_PAGES];
+static NVMemory_callbackFunc nv_callback = NULL;
+static boolean nv_busy = false;
+static long cut_after = -1;     // bytes still to be written before a power cut
+static jmp_buf power_cut;
+
+static void (*event_callback)(void) = NULL;
+static boolean event_pending = false;
+
+static uint8_t saved[AREAS][MAX_AREA_SIZE]; // as last saved
+static boolean created[AREAS];
+static boolean has_data[AREAS];
+
+static boolean request_done;
+static boolean request_success;
+
+
+static void fail(const char* message, int area)
+{
+	printf("FAILED: %s, area %i\n", message, area);
+	exit(1);
+}
+
+uint16_t register_event(void (*event_callback_in)(void))
+{
+	event_callback = event_callback_in;
+	return 0;
+}
+
+void trigger_event(uint16_t hEvent)
+{
+	event_pending = true;
+}
+
+boolean udb_nv_memory_read(uint8_t* rdBuffer, uint16_t address, uint16_t rdSize, NVMemory_callbackFunc pCallback)
+{
+	if (nv_busy) return false;
+	if ((uint32_t)address + rdSize > NV_MEMORY_SIZE) fail("read beyond the device", -1);
+	memcpy(rdBuffer, &nv_memory[address], rdSize);
+	nv_callback = pCallback;
+	nv_busy = true;
+	return true;
+}
+
+boolean udb_nv_memory_write(uint8_t* wrBuffer, uint16_t address, uint16_t wrSize, NVMemory_callbackFunc pCallback)
+{
+	uint16_t index;
+
+	if (nv_busy) return false;
+	if ((uint32_t)address + wrSize > NV_MEMORY_SIZE) fail("write beyond the device", -1);
+	for (index = 0; index < wrSize; index++)
+	{
+		if (cut_after == 0) longjmp(power_cut, 1);
+		if (cut_after > 0) cut_after--;
+		if (index == 0 || ((address + index) % NV_PAGE_SIZE) == 0)
+		{
+			page_writes[(address + index) / NV_PAGE_SIZE]++;
+		}
+		nv_memory[address + index] = wrBuffer[index];
+	}
+	nv_callback = pCallback;
+	nv_busy = true;
+	return true;
+}
+
+// Complete NV memory requests and run the storage service until it is idle
+static void run_service(void)
+{
+	long count;
+
+	for (count = 0; count < SERVICE_LIMIT; count++)
+	{
+		if (nv_busy)
+		{
+			nv_busy = false;
+			nv_callback(true);
+		}
+		else if (event_pending)
+		{
+			event_pending = false;
+			event_callback();
+		}
+		else
+		{
+			return;
+		}
+	}
+	fail("storage service did not finish", -1);
+}
+
+static void request_callback(boolean success)
+{
+	request_done = true;
+	request_success = success;
+}
+
+static void restart(void)
+{
+	nv_busy = false;
+	event_pending = false;
+	data_storage_status = DATA_STORAGE_STATUS_START;
+	data_storage_init();
+	storage_service_trigger();
+	run_service();
+	if (!storage_services_started()) fail("startup scan did not finish", -1);
+}
+
+static boolean read_area(int area, uint8_t* data)
+{
+	uint16_t layout;
+
+	request_done = false;
+	if (!storage_read_layout(area, data, area_sizes[area], &layout, &request_callback)) fail("read refused", area);
+	run_service();
+	if (!request_done) fail("read not completed", area);
+	if (request_success && layout != LAYOUT(data)) fail("layout corrupted", area);
+	return request_success;
+}
+
+static void check_areas(void)
+{
+	uint8_t data[MAX_AREA_SIZE];
+	int area;
+
+	for (area = 0; area < AREAS; area++)
+	{
+		if (storage_check_area_exists(area, area_sizes[area], DATA_STORAGE_CHECKSUM_STRUCT) != created[area])
+		{
+			fail(created[area] ? "area lost" : "area appeared", area);
+		}
+		if (created[area])
+		{
+			if (read_area(area, data) != has_data[area]) fail("data lost", area);
+			if (has_data[area] && memcmp(data, saved[area], area_sizes[area]) != 0) fail("data corrupted", area);
+		}
+	}
+}
+
+// After a power cut during a request on an area, accept either its state
+// before the request or after it
+static void check_after_cut(int area, boolean writing, const uint8_t* writing_data)
+{
+	uint8_t data[MAX_AREA_SIZE];
+
+	if (!storage_check_area_exists(area, area_sizes[area], DATA_STORAGE_CHECKSUM_STRUCT))
+	{
+		if (created[area]) fail("area lost in power cut", area);
+		return;
+	}
+	created[area] = true;
+	if (read_area(area, data))
+	{
+		if (!(has_data[area] && memcmp(data, saved[area], area_sizes[area]) == 0) &&
+		    !(writing && memcmp(data, writing_data, area_sizes[area]) == 0))
+		{
+			fail("data corrupted in power cut", area);
+		}
+		memcpy(saved[area], data, area_sizes[area]);
+		has_data[area] = true;
+	}
+	else
+	{
+		if (has_data[area] && writing) fail("data lost in power cut", area);
+		has_data[area] = false;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint8_t data[MAX_AREA_SIZE];
+	unsigned long min_writes = ~0UL, max_writes = 0, total_writes = 0;
+	long saves = 0, cuts = 0;
+	long iteration;
+	int area, operation, index;
+
+	srand(argc > 1 ? atoi(argv[1]) : 1);
+	memset(nv_memory, 0xFF, sizeof(nv_memory));
+	restart();
+	check_areas();
+
+	for (iteration = 0; iteration < SAVES; iteration++)
+	{
+		area = rand() % AREAS;
+		operation = rand() % 10;    // 0-1 create, 2-8 write, 9 clear
+		if (!created[area]) operation = 0;
+		for (index = 0; index < area_sizes[area]; index++)
+		{
+			data[index] = rand();
+		}
+		if (rand() % CUT_CHANCE == 0)
+		{
+			cut_after = rand() % CUT_BYTES;
+		}
+
+		if (setjmp(power_cut))
+		{
+			cut_after = -1;
+			cuts++;
+			restart();
+			check_after_cut(area, operation >= 2 && operation <= 8, data);
+			check_areas();
+			continue;
+		}
+
+		request_done = false;
+		if (operation < 2)
+		{
+			if (!storage_create_area(area, area_sizes[area], DATA_STORAGE_CHECKSUM_STRUCT, &request_callback)) fail("create refused", area);
+			run_service();
+			if (!request_done || !request_success) fail("create failed", area);
+			created[area] = true;
+			has_data[area] = false;
+		}
+		else if (operation < 9)
+		{
+			if (!storage_write_layout(area, data, area_sizes[area], LAYOUT(data), &request_callback)) fail("write refused", area);
+			run_service();
+			if (!request_done || !request_success) fail("write failed", area);
+			memcpy(saved[area], data, area_sizes[area]);
+			has_data[area] = true;
+			saves++;
+		}
+		else
+		{
+			if (!storage_clear_area(area, &request_callback)) fail("clear refused", area);
+			run_service();
+			if (!request_done || !request_success) fail("clear failed", area);
+			has_data[area] = false;
+		}
+		cut_after = -1;
+
+		if (iteration % RESTART_EVERY == 0) restart();
+		if (iteration % CHECK_EVERY == 0) check_areas();
+	}
+	check_areas();
+
+	for (index = 0; index < NV_PAGES; index++)
+	{
+		if (page_writes[index] < min_writes) min_writes = page_writes[index];
+		if (page_writes[index] > max_writes) max_writes = page_writes[index];
+		total_writes += page_writes[index];
+	}
+	printf("%li saves, %li power cuts, no area lost\n", saves, cuts);
+	printf("page writes: min %lu, mean %lu, max %lu\n", min_writes, total_writes / NV_PAGES, max_writes);
+	return 0;
+}
@@ -0,0 +1,445 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// A host benchmark of switching between the legs of waypoint flight plans.
+//
+// The real MatrixPilot/navigate.c and flightplan-waypoints.c are built into
+// this program, with TURN_ANTICIPATION set by the Makefile, and fly survey
+// missions saved from a ground station (QGC WPL files, as uploaded over
+// MAVLink) at the 40Hz navigation rate. The aircraft flies at a constant air
+// speed through a steady wind, and turns at the rate navigate_determine_deflection()
+// asks for, as helicalTurnCntrl() would, with a lag for rolling in and out.
+// The wind estimate is the true wind.
+//
+// Every mission is flown as the closed circuit MatrixPilot flies, once in
+// each of a set of winds. Each corner is scored by its overshoot, the
+// furthest the aircraft gets to the outside of the track of the next leg
+// before the leg after that begins, and each circuit by its time.
+//
+// Usage: turn_bench [-s speed] [-w speed] [-l lag] [-n laps] [-x] [-k track.csv] mission.waypoints ...
+//   -s    air speed in m/s (default 15)
+//   -w    wind speed in m/s, flown from 8 directions as well as calm (default 6)
+//   -l    time constant of rolling into a turn, in seconds (default 0.5)
+//   -n    circuits to fly, after the first (default 2)
+//   -x    cross track the legs (F_CROSS_TRACK), missions uploaded over MAVLink do not
+//   -k    write the aircraft's track to a CSV file, 4 times a second
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../../MatrixPilot/defines.h"
+#undef DPRINT
+#define DPRINT(args, ...)           // quieten the waypoint changes
+
+#include "../../MatrixPilot/navigate.c"
+#include "../../MatrixPilot/flightplan-waypoints.c"
+
+#define NAV_HZ          40
+#define WINDS           9
+#define MAX_CORNERS     MAX_WAYPOINTS
+
+// The parts of MatrixPilot the navigation uses
+union longww IMUlocationx, IMUlocationy, IMUlocationz;
+union longww IMUvelocityx, IMUvelocityy, IMUvelocityz;
+union longww IMUintegralAccelerationx, IMUintegralAccelerationy, IMUintegralAccelerationz;
+fractional rmat[9];
+int16_t estimatedWind[3];
+int16_t forward_ground_speed;
+uint16_t air_speed_3DIMU;
+uint16_t air_speed_magnitudeXY;
+int8_t calculated_heading;
+struct relative3D GPSlocation;
+volatile union longbbbb lat_gps, lon_gps, alt_sl_gps;
+int16_t waypointIndex;
+union state_flags_int state_flags;
+union bfbts_word desired_behavior;
+int16_t current_orientation;
+struct gains_variables gains;
+struct turns_variables turns;
+struct altit_variables altit;
+
+static int32_t originLon, originLat;
+
+// The aircraft
+static double planeX, planeY;           // meters from the origin, East and North
+static double planeHeading;             // radians anticlockwise from East
+static double planeTurnRate;            // radians per second anticlockwise
+static double airSpeed = 15.0;          // meters per second
+static double windX, windY;
+static double rollLag = 0.5;
+
+// The corners of the circuit being flown
+static int16_t legCount;
+static double wpX[MAX_WAYPOINTS], wpY[MAX_WAYPOINTS];
+static double overshoot[MAX_CORNERS];
+
+int16_t FindFirstBitFromLeft(int16_t input)
+{
+	int16_t bit;
+
+	for (bit = 15; bit >= 0; bit--)
+	{
+		if (input & (1 << bit)) return 16 - bit;
+	}
+	return 0;
+}
+
+void setBehavior(int16_t newBehavior)
+{
+	desired_behavior.W = newBehavior;
+}
+
+void set_camera_view(struct relative3D current_view)
+{
+}
+
+void compute_camera_view(void)
+{
+}
+
+void flightplan_update(void)
+{
+}
+
+void dcm_set_origin_location(int32_t o_lon, int32_t o_lat, int32_t o_alt)
+{
+}
+
+boolean use_fixed_origin(void)
+{
+	return false;
+}
+
+vect3_32t get_fixed_origin(void)
+{
+	vect3_32t origin = { 0, 0, 0 };
+	return origin;
+}
+
+void geofence_origin_changed(void)
+{
+}
+
+boolean gps_nav_valid(void)
+{
+	return true;
+}
+
+#if (GAIN_SCHEDULING == 1)
+uint16_t scheduled_gain(uint16_t gain, gain_loop_t loop)
+{
+	return gain;
+}
+#endif
+
+#if (USE_MAVLINK == 1)
+void mavlink_waypoint_reached(int16_t waypoint)
+{
+}
+
+void mavlink_waypoint_changed(int16_t waypoint)
+{
+}
+#endif
+
+vect3_32t dcm_rel2abs(vect3_32t rel)
+{
+	return rel;
+}
+
+static void to_relative(int32_t lon, int32_t lat, double* x, double* y)
+{
+	double metersPerUnit = 0.0111319;   // 1e-7 degrees of latitude
+
+	*x = (lon - originLon) * metersPerUnit * cos(originLat * 1e-7 * M_PI / 180.0);
+	*y = (lat - originLat) * metersPerUnit;
+}
+
+struct relative3D dcm_absolute_to_relative(struct waypoint3D absolute)
+{
+	struct relative3D rel;
+	double x, y;
+
+	to_relative(absolute.x, absolute.y, &x, &y);
+	rel.x = (int16_t)floor(x + 0.5);
+	rel.y = (int16_t)floor(y + 0.5);
+	rel.z = absolute.z;
+	return rel;
+}
+
+#ifdef USE_EXTENDED_NAV
+struct relative3D_32 dcm_absolute_to_relative_32(struct waypoint3D absolute)
+{
+	struct relative3D_32 rel;
+	double x, y;
+
+	to_relative(absolute.x, absolute.y, &x, &y);
+	rel.x = (int32_t)floor(x + 0.5);
+	rel.y = (int32_t)floor(y + 0.5);
+	rel.z = absolute.z;
+	return rel;
+}
+#endif // USE_EXTENDED_NAV
+
+static void set_plane_state(void)
+{
+	double groundX = airSpeed * cos(planeHeading) + windX;
+	double groundY = airSpeed * sin(planeHeading) + windY;
+
+	IMUlocationx.WW = (int32_t)(planeX * 65536.0);
+	IMUlocationy.WW = (int32_t)(planeY * 65536.0);
+	IMUvelocityx.WW = (int32_t)(groundX * 100.0 * 65536.0);
+	IMUvelocityy.WW = (int32_t)(groundY * 100.0 * 65536.0);
+	IMUintegralAccelerationx = IMUvelocityx;
+	IMUintegralAccelerationy = IMUvelocityy;
+	GPSlocation.x = (int16_t)planeX;
+	GPSlocation.y = (int16_t)planeY;
+	estimatedWind[0] = (int16_t)(windX * 100.0);
+	estimatedWind[1] = (int16_t)(windY * 100.0);
+	forward_ground_speed = (int16_t)(sqrt(groundX * groundX + groundY * groundY) * 100.0);
+	air_speed_3DIMU = (uint16_t)(airSpeed * 100.0);
+	air_speed_magnitudeXY = air_speed_3DIMU;
+	rmat[1] = (fractional)(-cos(planeHeading) * RMAX);
+	rmat[4] = (fractional)(sin(planeHeading) * RMAX);
+}
+
+// The turn rate asked for, as in helicalTurnCntrl(), limited to 4g
+static void fly(double dt)
+{
+	double turnRate = -navigate_determine_deflection('t') / (RMAX / 2.0);
+	double limit = 4.0 * 9.81 / airSpeed;
+
+	if (turnRate > limit) turnRate = limit;
+	if (turnRate < -limit) turnRate = -limit;
+	planeTurnRate += (turnRate - planeTurnRate) * dt / (rollLag + dt);
+	planeHeading += planeTurnRate * dt;
+	planeX += (airSpeed * cos(planeHeading) + windX) * dt;
+	planeY += (airSpeed * sin(planeHeading) + windY) * dt;
+	set_plane_state();
+}
+
+// How far the aircraft is to the outside of the turn onto the leg ending at
+// corner, measured from the track of that leg
+static double outside_of_leg(int16_t corner)
+{
+	int16_t from = (corner + legCount - 1) % legCount;
+	int16_t before = (corner + legCount - 2) % legCount;
+	double legX = wpX[corner] - wpX[from];
+	double legY = wpY[corner] - wpY[from];
+	double length = sqrt(legX * legX + legY * legY);
+	double turn = (wpX[from] - wpX[before]) * legY - (wpY[from] - wpY[before]) * legX;
+	double left = (legX * (planeY - wpY[from]) - legY * (planeX - wpX[from])) / length;
+
+	return (turn > 0) ? -left : left;
+}
+
+static int16_t load_mission(const char* filename, int16_t flags)
+{
+	char line[256];
+	FILE* f;
+	int16_t count = 0;
+	struct waypoint3D wp[MAX_WAYPOINTS];
+	int16_t i;
+
+	if ((f = fopen(filename, "r")) == NULL)
+	{
+		perror(filename);
+		return 0;
+	}
+	if (fgets(line, sizeof(line), f) == NULL || strncmp(line, "QGC WPL", 7) != 0)
+	{
+		printf("%s: not a QGC WPL mission\n", filename);
+		fclose(f);
+		return 0;
+	}
+	while (fgets(line, sizeof(line), f) != NULL)
+	{
+		int index, current, frame, command;
+		double p1, p2, p3, p4, lat, lon, alt;
+
+		if (sscanf(line, "%i %i %i %i %lf %lf %lf %lf %lf %lf %lf",
+		           &index, &current, &frame, &command, &p1, &p2, &p3, &p4, &lat, &lon, &alt) != 11)
+		{
+			continue;
+		}
+		if (index == 0)
+		{
+			originLat = (int32_t)(lat * 1e7);
+			originLon = (int32_t)(lon * 1e7);
+		}
+		else if (command == 16 && count < MAX_WAYPOINTS)   // MAV_CMD_NAV_WAYPOINT
+		{
+			wp[count].x = (int32_t)(lon * 1e7);
+			wp[count].y = (int32_t)(lat * 1e7);
+			wp[count].z = (int16_t)alt;
+			count++;
+		}
+	}
+	fclose(f);
+
+	// uploaded as MAVMission.c does
+	if (count < 3 || !flightplan_shadow_begin(count))
+	{
+		printf("%s: %i waypoints, this needs 3 to %i\n", filename, count, MAX_WAYPOINTS);
+		return 0;
+	}
+	for (i = 0; i < count; i++)
+	{
+		flightplan_shadow_set(i, wp[i], flags);
+		to_relative(wp[i].x, wp[i].y, &wpX[i], &wpY[i]);
+	}
+	flightplan_shadow_commit();
+	flightplan_shadow_swap();         // as the navigation does in its next frame
+	legCount = count;
+	return count;
+}
+
+struct result {
+	double lapTime;
+	double meanOvershoot;
+	double maxOvershoot;
+};
+
+// Fly the circuit from the first waypoint, in line with the first leg, for
+// one circuit to settle and then laps more
+static struct result fly_mission(int16_t laps, FILE* track)
+{
+	struct result r;
+	int16_t leg;
+	int16_t lap = 0;
+	int32_t step = 0;
+	int32_t lapStart = 0;
+	int32_t corners = 0;
+	double total = 0.0;
+	int16_t i;
+
+	memset(&r, 0, sizeof(r));
+	planeX = wpX[0];
+	planeY = wpY[0];
+	planeHeading = atan2(wpY[1] - wpY[0], wpX[1] - wpX[0]);
+	planeTurnRate = 0.0;
+	set_plane_state();
+	set_waypoint(1);
+	leg = 1;
+	for (i = 0; i < legCount; i++) overshoot[i] = 0.0;
+
+	while (lap <= laps && step < (int32_t)NAV_HZ * 3600)
+	{
+		fly(1.0 / NAV_HZ);
+		navigate_compute_bearing_to_goal();
+		flightplan_waypoints_update();
+		step++;
+
+		if (waypointIndex != leg)
+		{
+			// a corner is over when the leg after it begins
+			if (lap > 0)
+			{
+				total += overshoot[leg];
+				if (overshoot[leg] > r.maxOvershoot) r.maxOvershoot = overshoot[leg];
+				corners++;
+			}
+			leg = waypointIndex;
+			overshoot[leg] = 0.0;
+			if (leg == 1)
+			{
+				if (lap == 0) lapStart = step;
+				lap++;
+			}
+		}
+		if (outside_of_leg(leg) > overshoot[leg]) overshoot[leg] = outside_of_leg(leg);
+		if (track && (step % (NAV_HZ / 4)) == 0)
+		{
+			fprintf(track, "%.2f,%.1f,%.1f,%i,%i\n", (double)step / NAV_HZ, planeX, planeY, waypointIndex, tofinish_line);
+		}
+	}
+	r.lapTime = (laps > 0) ? (double)(step - lapStart) / NAV_HZ / laps : 0.0;
+	r.meanOvershoot = corners ? total / corners : 0.0;
+	return r;
+}
+
+int main(int argc, char** argv)
+{
+	double windSpeed = 6.0;
+	int16_t laps = 2;
+	int16_t flags = F_ABSOLUTE;
+	FILE* track = NULL;
+	double sumLap = 0.0, sumMean = 0.0, worst = 0.0;
+	int32_t runs = 0;
+	int i, w;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++)
+	{
+		if (strcmp(argv[i], "-s") == 0 && i+1 < argc) airSpeed = atof(argv[++i]);
+		else if (strcmp(argv[i], "-w") == 0 && i+1 < argc) windSpeed = atof(argv[++i]);
+		else if (strcmp(argv[i], "-l") == 0 && i+1 < argc) rollLag = atof(argv[++i]);
+		else if (strcmp(argv[i], "-n") == 0 && i+1 < argc) laps = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-x") == 0) flags |= F_CROSS_TRACK;
+		else if (strcmp(argv[i], "-k") == 0 && i+1 < argc)
+		{
+			if ((track = fopen(argv[++i], "w")) == NULL) { perror(argv[i]); return 1; }
+			fprintf(track, "time,x,y,index,tofinish_line\n");
+		}
+		else goto usage;
+	}
+	if (i >= argc || laps < 1) goto usage;
+
+	turns.TurnRateNav = TURN_RATE_NAV;
+	init_navigation();
+	state_flags._.GPS_steering = 1;
+
+	printf("TURN_ANTICIPATION %i, air speed %.1f m/s, TURN_RATE_NAV %.0f deg/s, wind %.1f m/s%s\n",
+	       TURN_ANTICIPATION, airSpeed, (double)TURN_RATE_NAV, windSpeed,
+	       (flags & F_CROSS_TRACK) ? ", cross tracking" : "");
+	printf("%-28s %-6s %10s %14s %14s\n", "mission", "wind", "circuit s", "mean over m", "max over m");
+	for (; i < argc; i++)
+	{
+		if (load_mission(argv[i], flags) == 0) return 1;
+		for (w = 0; w < WINDS; w++)
+		{
+			struct result r;
+			char wind[8];
+			const char* name = strrchr(argv[i], '/') ? strrchr(argv[i], '/') + 1 : argv[i];
+
+			// calm, and then from each of 8 directions, clockwise from North
+			windX = (w == 0) ? 0.0 : -windSpeed * sin((w - 1) * M_PI / 4.0);
+			windY = (w == 0) ? 0.0 : -windSpeed * cos((w - 1) * M_PI / 4.0);
+			if (w == 0) strcpy(wind, "calm");
+			else sprintf(wind, "%03i", (w - 1) * 45);
+			r = fly_mission(laps, (w == 0) ? track : NULL);
+			printf("%-28s %-6s %10.1f %14.1f %14.1f\n", name, wind, r.lapTime, r.meanOvershoot, r.maxOvershoot);
+			sumLap += r.lapTime;
+			sumMean += r.meanOvershoot;
+			if (r.maxOvershoot > worst) worst = r.maxOvershoot;
+			runs++;
+		}
+	}
+	printf("%-28s %-6s %10.1f %14.1f %14.1f\n", "all", "", sumLap / runs, sumMean / runs, worst);
+	if (track) fclose(track);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-s speed] [-w speed] [-l lag] [-n laps] [-x] [-k track.csv] mission.waypoints ...\n", argv[0]);
+	return 1;
+}
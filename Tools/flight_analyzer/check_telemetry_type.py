@@ -17,6 +17,8 @@ import re
 import sys
 import os
 import array, struct
+import sue_binary
+import telelog
 
 
 try:
@@ -34,6 +36,7 @@ def check_type_of_telemetry_file(filename):
        MAVLINK 1.0 RAW
        MAVLINK 1.0 TIMESTAMPS
        MAVLINK UNKNOWN
+       SUE BINARY
        ASCII
        UNKNOWN"""
 
@@ -50,12 +53,31 @@ def check_type_of_telemetry_file(filename):
     # If all messages back to back with some same space (timestamp), then timestamp file.
     # if No valid MAVLink messages, examine as ASCII. If pure ascii then return Ascii.
     mybuffer = fd.read(1000)
+    if telelog.parse_header(mybuffer, 0) is not None :
+        # An on-board telemetry log (USE_TELELOG). Check the telemetry in its blocks.
+        fd.seek(0)
+        mybuffer = "".join([b.data for b in telelog.blocks_from_bytes(fd.read(4 * telelog.BLOCK_SIZE))])[:1000]
     bytes = array.array('B')
     if isinstance(mybuffer, array.array):
         bytes.extend(mybuffer)
     else:
         bytes.fromstring(mybuffer)
 
+    # SERIAL_UDB_BINARY frames have their own start marker and CRC
+    number_of_valid_sue_binary_frames = 0
+    parsing_index = 0
+    while parsing_index < (len(bytes) - 8) :
+        if bytes[parsing_index] == sue_binary.SYNC1 and bytes[parsing_index + 1] == sue_binary.SYNC2 :
+            end = parsing_index + 6 + bytes[parsing_index + 2]
+            if (end + 2 <= len(bytes)) and \
+               (sue_binary.x25crc(bytes[parsing_index + 2:end]) == bytes[end] + (bytes[end + 1] * 256)) :
+                number_of_valid_sue_binary_frames += 1
+                parsing_index = end + 2
+                continue
+        parsing_index += 1
+    if number_of_valid_sue_binary_frames >= 2 :
+        return "SUE BINARY"
+
     # Find out if this buffer has valid MAVLink packets
     number_of_valid_mavlink_packets = 0
     mavlink_parser_states = ['looking_for_start_char','found_start_char','valid_mav_packet' \
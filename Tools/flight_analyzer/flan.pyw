@@ -18,6 +18,8 @@ from Tkinter import *
 from tkMessageBox import *
 from zipfile import ZipFile,ZIP_DEFLATED
 from check_telemetry_type import check_type_of_telemetry_file
+from sue_binary import write_sue_binary_to_serial_udb_extra
+from telelog import is_telelog_file, unpack_telelog
 import tkFileDialog
 import datetime
 import subprocess 
@@ -2141,6 +2143,11 @@ def create_log_book(options) :
        options.telemetry_type == "SERIAL_MAVLINK_TIMESTAMPS":
         print "processing telemetry as binary file for MAVLink"
         t = raw_mavlink_telemetry_file(options.telemetry_filename, options.telemetry_type)
+    elif options.telemetry_type == "SERIAL_UDB_BINARY":
+        serial_udb_extra_filename = re.sub("[bB][iI][nN]$","txt",options.telemetry_filename)
+        print "Converting SERIAL_UDB_BINARY to", os.path.basename(serial_udb_extra_filename)
+        write_sue_binary_to_serial_udb_extra(options.telemetry_filename, serial_udb_extra_filename)
+        t = ascii_telemetry_file(serial_udb_extra_filename)
     else : # Expect a legacy Ascii telemetry file
         t = ascii_telemetry_file(options.telemetry_filename)
 
@@ -2808,6 +2815,14 @@ def process_telemetry():
        
     saveObject( "flan_config",options) # save user selected options to a file
 
+    # On-board telemetry logs (USE_TELELOG) are written in blocks, which
+    # are first unpacked into the telemetry stream that they hold.
+    if (options.telemetry_selector == 1) and is_telelog_file(options.telemetry_filename):
+        name, dot, ext = options.telemetry_filename.rpartition(".")
+        unpacked_filename = name + "_unpacked." + ext
+        print "Unpacking on-board telemetry log to", os.path.basename(unpacked_filename)
+        unpack_telelog(options.telemetry_filename, unpacked_filename)
+        options.telemetry_filename = unpacked_filename
 
     
     #################################################################
@@ -2864,6 +2879,8 @@ class  flan_frame(Frame) : # A window frame for the Flight Analyzer
             self.telemetry_type = "SERIAL_MAVLINK_TIMESTAMPS"
         elif re.match(".*\.[rR][aA][wW]$",self.telemetry_filename):
             self.telemetry_type = "SERIAL_MAVLINK_RAW"
+        elif re.match(".*\.[bB][iI][nN]$",self.telemetry_filename):
+            self.telemetry_type = "SERIAL_UDB_BINARY"
         else :
             print "Unkown type of telemetry selected - Error"
         
@@ -3019,12 +3036,12 @@ class  flan_frame(Frame) : # A window frame for the Flight Analyzer
         if self.telemetry_filename == "None" :
             return
         else :
-            self.GE_filename = re.sub("\.[tTlLrR][xXoOaA][tTgGwW]$",".kmz",self.telemetry_filename)
+            self.GE_filename = re.sub("\.([tTlLrR][xXoOaA][tTgGwW]|[bB][iI][nN])$",".kmz",self.telemetry_filename)
             self.GE_FileShown.destroy()
             cropped = self.crop_filename(self.GE_filename)
             self.GE_FileShown = Label(self,text = cropped, anchor = W)
             self.GE_FileShown.grid(row = 6, column = 3, sticky = W)
-            self.CSV_filename = re.sub("\.[tTlLrR][xXoOaA][tTgGwW]$",".csv",self.telemetry_filename)
+            self.CSV_filename = re.sub("\.([tTlLrR][xXoOaA][tTgGwW]|[bB][iI][nN])$",".csv",self.telemetry_filename)
             self.CSV_FileShown.destroy()
             cropped = self.crop_filename(self.CSV_filename)
             self.CSV_FileShown = Label(self,text = cropped, anchor = W)
@@ -3059,12 +3076,12 @@ class  flan_frame(Frame) : # A window frame for the Flight Analyzer
         else: self.telemetry_filename = tkFileDialog.askopenfilename(parent=self,
                     title='Choose a telemetry file')
         if self.telemetry_filename != "":
-              match = re.match(".*\.[tTlLrR][xXoOaA][tTgGwW]$",self.telemetry_filename) # match a .txt file
+              match = re.match(".*\.([tTlLrR][xXoOaA][tTgGwW]|[bB][iI][nN])$",self.telemetry_filename) # match a .txt file
               if match :
                   self.set_output_filenames_telemetry()
               else:
-                  showinfo(title='Telemetry files end in .txt .log or .raw (upper of lower case)',  \
-                           message='Telemetry files end in .txt .log or .raw (upper or lower case)')
+                  showinfo(title='Telemetry files end in .txt .log .raw or .bin (upper of lower case)',  \
+                           message='Telemetry files end in .txt .log .raw or .bin (upper or lower case)')
                   self.telemetry_filename = old_filename
         else:
             self.telemetry_filename = old_filename
@@ -3082,6 +3099,9 @@ class  flan_frame(Frame) : # A window frame for the Flight Analyzer
         elif re.match(".*\.[rR][aA][wW]$",self.telemetry_filename):
             self.telemetry_type = "SERIAL_MAVLINK_RAW"
             print "Telemetry is expected to be raw SERIAL_MAVLINK"
+        elif re.match(".*\.[bB][iI][nN]$",self.telemetry_filename):
+            self.telemetry_type = "SERIAL_UDB_BINARY"
+            print "Telemetry is expected to be SERIAL_UDB_BINARY"
         else :
             print "Unknown type of telemetry selected - Error"
         file_type = check_type_of_telemetry_file(self.telemetry_filename)
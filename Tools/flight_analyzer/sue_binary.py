@@ -0,0 +1,189 @@
+#  This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation,  version 3 of the License, or
+#    (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Decode SERIAL_UDB_BINARY telemetry, and convert it to SERIAL_UDB_EXTRA ascii.
+
+   The record layouts come from sue_binary_schema.py, which is generated
+   from sue_binary.xml by sue_binary_gen.py.
+
+   Usage: python sue_binary.py telemetry.bin [telemetry.txt]
+"""
+
+import sys
+import struct
+import array
+
+import sue_binary_schema as schema
+
+SYNC1 = 0xA5
+SYNC2 = 0x5E
+HEADER_LEN = 6
+CRC_LEN = 2
+
+def x25crc(data):
+    """CRC-16/X.25 as used by MAVLink, over a sequence of byte values"""
+    crc = 0xffff
+    for b in data:
+        tmp = b ^ (crc & 0xff)
+        tmp = (tmp ^ (tmp << 4)) & 0xff
+        crc = ((crc >> 8) ^ (tmp << 8) ^ (tmp << 3) ^ (tmp >> 4)) & 0xffff
+    return crc
+
+def to_bytes(a):
+    return a.tobytes() if hasattr(a, "tobytes") else a.tostring()
+
+class sue_binary_record:
+    """One decoded record. Fields are attributes named as in sue_binary.xml"""
+    def __init__(self, name, seq):
+        self.name = name
+        self.seq = seq
+
+def unpack_payload(record_id, payload):
+    """Unpack a payload into a list of (field name, value) pairs"""
+    name, fields = schema.RECORDS[record_id]
+    values = []
+    pos = 0
+    for field, fmt, count, delta in fields:
+        if count is None:
+            count = payload[pos]
+            pos += 1
+            is_array = True
+        else:
+            is_array = (count > 1)
+        size = struct.calcsize("<" + fmt) * count
+        if pos + size > len(payload):
+            raise ValueError("record %s is too short" % name)
+        v = struct.unpack("<%i%s" % (count, fmt), to_bytes(payload[pos:pos + size]))
+        pos += size
+        values.append((field, list(v) if is_array else v[0]))
+    return values
+
+class sue_binary_file:
+    """Iterate over the valid records of a SERIAL_UDB_BINARY file.
+       Positions in F2A records are rebuilt from the last keyframe, and
+       F2A records which refer to a lost keyframe are dropped."""
+    def __init__(self, filename):
+        f = open(filename, "rb")
+        self.data = array.array('B')
+        if hasattr(self.data, "frombytes"):
+            self.data.frombytes(f.read())
+        else:
+            self.data.fromstring(f.read())
+        f.close()
+        self.pos = 0
+        self.key = None
+        self.crc_errors = 0
+        self.version_errors = 0
+        self.lost_keyframes = 0
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        return self.next()
+
+    def next(self):
+        data = self.data
+        while self.pos + HEADER_LEN + CRC_LEN <= len(data):
+            if data[self.pos] != SYNC1 or data[self.pos + 1] != SYNC2:
+                self.pos += 1
+                continue
+            length = data[self.pos + 2]
+            end = self.pos + HEADER_LEN + length
+            if end + CRC_LEN > len(data):
+                break
+            crc = data[end] + (data[end + 1] << 8)
+            if x25crc(data[self.pos + 2:end]) != crc:
+                self.crc_errors += 1
+                self.pos += 1
+                continue
+            version = data[self.pos + 3]
+            seq = data[self.pos + 4]
+            record_id = data[self.pos + 5]
+            payload = data[self.pos + HEADER_LEN:end]
+            self.pos = end + CRC_LEN
+            if version != schema.SCHEMA_VERSION or record_id not in schema.RECORDS:
+                self.version_errors += 1
+                continue
+            record = sue_binary_record(schema.RECORDS[record_id][0], seq)
+            for field, value in unpack_payload(record_id, payload):
+                setattr(record, field, value)
+            if record.name == "KEY":
+                self.key = record
+            elif record.name == "F2A":
+                if self.key is None or self.key.kseq != record.kseq:
+                    self.lost_keyframes += 1
+                    continue
+                for field, fmt, count, delta in schema.RECORDS[record_id][1]:
+                    if delta is not None:
+                        setattr(record, delta, getattr(self.key, delta) + getattr(record, field))
+            return record
+        raise StopIteration
+
+def bstr(status):
+    """SERIAL_UDB_EXTRA prints the status as radio_on, nav_capable, GPS_steering"""
+    return "%d%d%d" % ((status >> 2) & 1, (status >> 1) & 1, status & 1)
+
+def write_sue_binary_to_serial_udb_extra(telemetry_filename, serial_udb_extra_filename):
+    """Convert a SERIAL_UDB_BINARY file into the ascii SERIAL_UDB_EXTRA format"""
+    try:
+        f = open(serial_udb_extra_filename, 'w')
+    except:
+        print("Error while trying to open: " + serial_udb_extra_filename)
+        return False
+    t = sue_binary_file(telemetry_filename)
+    f.write("\r\n") # The first line of MatrixPilot telemetry is blank
+    f2a = None
+    for r in t:
+        if r.name == "TEXT":
+            f.write("".join(chr(c) for c in r.text))
+        elif r.name == "F2A":
+            f2a = r
+        elif r.name == "F2B" and f2a is not None and f2a.tow == r.tow:
+            line = "F2:T%li:S%s:N%li:E%li:A%li:W%i:a%i:b%i:c%i:d%i:e%i:f%i:g%i:h%i:i%i:" \
+                   "c%u:s%i:cpu%u:as%u:wvx%i:wvy%i:wvz%i:ma%i:mb%i:mc%i:svs%i:hd%i:" % \
+                   ((f2a.tow, bstr(f2a.status), f2a.lat, f2a.lon, f2a.alt, f2a.wp) +
+                    tuple(f2a.rmat) + (f2a.cog, f2a.sog, f2a.cpu, f2a.airspeed) +
+                    tuple(f2a.wind) + tuple(f2a.mag) + (f2a.svs, f2a.hdop))
+            for i, v in enumerate(r.pwin):
+                line += "p%ii%i:" % (i + 1, v)
+            for i, v in enumerate(r.pwout):
+                line += "p%io%i:" % (i + 1, v)
+            line += "imx%i:imy%i:imz%i:lex%i:ley%i:lez%i:fgs%X:ofc%i:tx%i:ty%i:tz%i:G%d,%d,%d:AF%i,%i,%i:" % \
+                    (tuple(r.imu_loc) + tuple(r.loc_err) + (r.flags, r.osc_fails) +
+                     tuple(r.imu_vel) + tuple(r.goal) + tuple(r.aero))
+            line += "tmp%i:prs%li:alt%li:" % (r.barom_temp, r.barom_press, r.barom_alt)
+            line += "bmv%i:mA%i:mAh%i:DH%i:stk%d:\r\n" % \
+                    (r.bat_volt, r.bat_amp, r.bat_mah, r.desired_height, r.stack_free)
+            f.write(line)
+            f2a = None
+        elif r.name == "F23":
+            f.write("F23:G%i:V%i:RE%d,%d,%d:TE%d,%d,%d:DR%d,%d,%d:OM%d,%d,%d:DT%d:EL%d:\r\n" %
+                    ((r.gps_errors, r.vdop) + tuple(r.rate_err) + tuple(r.tilt_err) +
+                     tuple(r.des_rate) + tuple(r.omega_accum) + (r.des_turn_rate, r.elev_trim)))
+        elif r.name == "F13":
+            f.write("F13:week%i:origN%li:origE%li:origA%li:\r\n" % (r.week, r.lat, r.lon, r.alt))
+        elif r.name == "F20":
+            f.write("F20:NUM_IN=%i:TRIM=%s:\r\n" % (len(r.trim), "".join("%i," % v for v in r.trim)))
+    f.close()
+    if t.crc_errors or t.lost_keyframes or t.version_errors:
+        print("SERIAL_UDB_BINARY: %i CRC errors, %i records lost with their keyframe, %i unknown records" %
+              (t.crc_errors, t.lost_keyframes, t.version_errors))
+    return True
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    out = sys.argv[2] if len(sys.argv) > 2 else sys.argv[1].rsplit(".", 1)[0] + ".txt"
+    write_sue_binary_to_serial_udb_extra(sys.argv[1], out)
@@ -0,0 +1,177 @@
+#!/usr/bin/env python
+#  This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation,  version 3 of the License, or
+#    (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Generate the SERIAL_UDB_BINARY encoder and decoder from sue_binary.xml
+
+   Writes:
+     ../../MatrixPilot/telemetry_binary.h  - record structs and pack functions
+     sue_binary_schema.py                  - record table used by sue_binary.py
+"""
+
+from __future__ import print_function
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+here = os.path.dirname(os.path.abspath(__file__))
+xml_file = os.path.join(here, "sue_binary.xml")
+c_file = os.path.join(here, "..", "..", "MatrixPilot", "telemetry_binary.h")
+py_file = os.path.join(here, "sue_binary_schema.py")
+
+c_types = { "i8" : "int8_t",  "u8" : "uint8_t",
+           "i16" : "int16_t", "u16" : "uint16_t",
+           "i32" : "int32_t", "u32" : "uint32_t" }
+py_types = { "i8" : "b", "u8" : "B", "i16" : "h", "u16" : "H", "i32" : "i", "u32" : "I" }
+sizes = { "i8" : 1, "u8" : 1, "i16" : 2, "u16" : 2, "i32" : 4, "u32" : 4 }
+
+def parse_type(t):
+    """Split 'i16[3]' into ('i16', 3), 'i16[]' into ('i16', None) and 'u8' into ('u8', 1)"""
+    m = re.match(r"^(\w+)(\[(\d*)\])?$", t)
+    if not m or m.group(1) not in c_types:
+        print("Error: unknown field type", t)
+        sys.exit(1)
+    if m.group(2) is None:
+        return (m.group(1), 1)
+    if m.group(3) == "":
+        return (m.group(1), None)
+    return (m.group(1), int(m.group(3)))
+
+def load_schema():
+    root = ET.parse(xml_file).getroot()
+    version = int(root.get("version"))
+    records = []
+    for r in root.findall("record"):
+        fields = []
+        for f in r.findall("field"):
+            base, count = parse_type(f.get("type"))
+            fields.append({ "name" : f.get("name"), "base" : base, "count" : count,
+                            "delta" : f.get("delta"), "scale" : f.get("scale"),
+                            "unit" : f.get("unit") })
+        records.append({ "id" : int(r.get("id")), "name" : r.get("name"),
+                         "text" : r.get("text", ""), "fields" : fields })
+    return version, records
+
+def max_len(rec):
+    n = 0
+    for f in rec["fields"]:
+        if f["count"] is None:
+            n += 1
+        else:
+            n += sizes[f["base"]] * f["count"]
+    return n
+
+def write_c(version, records):
+    o = []
+    o.append("// This file is part of MatrixPilot.")
+    o.append("//")
+    o.append("// GENERATED by Tools/flight_analyzer/sue_binary_gen.py from sue_binary.xml")
+    o.append("// DO NOT EDIT - edit the schema and regenerate instead.")
+    o.append("")
+    o.append("#ifndef TELEMETRY_BINARY_H")
+    o.append("#define TELEMETRY_BINARY_H")
+    o.append("")
+    o.append("#define SUE_BIN_SYNC1              0xA5")
+    o.append("#define SUE_BIN_SYNC2              0x5E")
+    o.append("#define SUE_BIN_SCHEMA_VERSION     %i" % version)
+    o.append("#define SUE_BIN_HEADER_LEN         6")
+    o.append("#define SUE_BIN_CRC_LEN            2")
+    o.append("")
+    for r in records:
+        o.append("#define SUE_BIN_ID_%-16s %i" % (r["name"], r["id"]))
+    o.append("")
+    o.append("static inline uint8_t* sue_bin_put16(uint8_t* p, uint16_t v)")
+    o.append("{")
+    o.append("\tp[0] = (uint8_t)v;")
+    o.append("\tp[1] = (uint8_t)(v >> 8);")
+    o.append("\treturn p + 2;")
+    o.append("}")
+    o.append("")
+    o.append("static inline uint8_t* sue_bin_put32(uint8_t* p, uint32_t v)")
+    o.append("{")
+    o.append("\tp = sue_bin_put16(p, (uint16_t)v);")
+    o.append("\treturn sue_bin_put16(p, (uint16_t)(v >> 16));")
+    o.append("}")
+    for r in records:
+        name = r["name"].lower()
+        o.append("")
+        o.append("// %s" % r["text"])
+        o.append("typedef struct sue_bin_%s {" % name)
+        for f in r["fields"]:
+            ct = c_types[f["base"]]
+            if f["count"] is None:
+                o.append("\tconst %s* %s;" % (ct, f["name"]))
+                o.append("\tuint8_t %s_count;" % f["name"])
+            elif f["count"] > 1:
+                o.append("\t%s %s[%i];" % (ct, f["name"], f["count"]))
+            else:
+                o.append("\t%s %s;" % (ct, f["name"]))
+        o.append("} sue_bin_%s_t;" % name)
+        o.append("")
+        o.append("#define SUE_BIN_%s_FIXED_LEN %i // plus variable length arrays" % (r["name"], max_len(r))
+                 if any(f["count"] is None for f in r["fields"])
+                 else "#define SUE_BIN_%s_LEN %i" % (r["name"], max_len(r)))
+        o.append("")
+        o.append("// Pack into buf, returning the payload length")
+        o.append("static inline uint8_t sue_bin_pack_%s(uint8_t* buf, const sue_bin_%s_t* m)" % (name, name))
+        o.append("{")
+        o.append("\tuint8_t* p = buf;")
+        if any(f["count"] != 1 for f in r["fields"]):
+            o.append("\tuint8_t i;")
+        o.append("")
+        for f in r["fields"]:
+            size = sizes[f["base"]]
+            def put(expr):
+                if size == 1:
+                    return "*p++ = (uint8_t)%s;" % expr
+                return "p = sue_bin_put%i(p, (uint%i_t)%s);" % (size * 8, size * 8, expr)
+            if f["count"] is None:
+                o.append("\t*p++ = m->%s_count;" % f["name"])
+                o.append("\tfor (i = 0; i < m->%s_count; i++) %s" % (f["name"], put("m->%s[i]" % f["name"])))
+            elif f["count"] > 1:
+                o.append("\tfor (i = 0; i < %i; i++) %s" % (f["count"], put("m->%s[i]" % f["name"])))
+            else:
+                o.append("\t" + put("m->%s" % f["name"]))
+        o.append("\treturn (uint8_t)(p - buf);")
+        o.append("}")
+    o.append("")
+    o.append("#endif // TELEMETRY_BINARY_H")
+    open(c_file, "w").write("\n".join(o) + "\n")
+
+def write_py(version, records):
+    o = []
+    o.append("# GENERATED by sue_binary_gen.py from sue_binary.xml")
+    o.append("# DO NOT EDIT - edit the schema and regenerate instead.")
+    o.append("")
+    o.append("SCHEMA_VERSION = %i" % version)
+    o.append("")
+    o.append("# record id : (name, [(field, struct format, count or None if variable, delta of)])")
+    o.append("RECORDS = {")
+    for r in records:
+        o.append("    %i : (\"%s\", [" % (r["id"], r["name"]))
+        for f in r["fields"]:
+            o.append("        (\"%s\", \"%s\", %s, %s)," % (f["name"], py_types[f["base"]],
+                     "None" if f["count"] is None else f["count"],
+                     "None" if f["delta"] is None else "\"%s\"" % f["delta"]))
+        o.append("    ]),")
+    o.append("}")
+    o.append("")
+    o.append("RECORD_IDS = dict((v[0], k) for k, v in RECORDS.items())")
+    open(py_file, "w").write("\n".join(o) + "\n")
+
+if __name__ == "__main__":
+    version, records = load_schema()
+    write_c(version, records)
+    write_py(version, records)
+    print("Generated schema version", version, "with", len(records), "records")
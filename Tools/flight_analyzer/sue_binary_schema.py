@@ -0,0 +1,77 @@
+# GENERATED by sue_binary_gen.py from sue_binary.xml
+# DO NOT EDIT - edit the schema and regenerate instead.
+
+SCHEMA_VERSION = 1
+
+# record id : (name, [(field, struct format, count or None if variable, delta of)])
+RECORDS = {
+    1 : ("KEY", [
+        ("tow", "I", 1, None),
+        ("kseq", "B", 1, None),
+        ("lat", "i", 1, None),
+        ("lon", "i", 1, None),
+        ("alt", "i", 1, None),
+    ]),
+    2 : ("F2A", [
+        ("tow", "I", 1, None),
+        ("status", "B", 1, None),
+        ("kseq", "B", 1, None),
+        ("dlat", "h", 1, "lat"),
+        ("dlon", "h", 1, "lon"),
+        ("dalt", "h", 1, "alt"),
+        ("wp", "B", 1, None),
+        ("rmat", "h", 9, None),
+        ("cog", "H", 1, None),
+        ("sog", "h", 1, None),
+        ("cpu", "B", 1, None),
+        ("airspeed", "H", 1, None),
+        ("wind", "h", 3, None),
+        ("mag", "h", 3, None),
+        ("svs", "B", 1, None),
+        ("hdop", "B", 1, None),
+    ]),
+    3 : ("F2B", [
+        ("tow", "I", 1, None),
+        ("pwin", "h", None, None),
+        ("pwout", "h", None, None),
+        ("imu_loc", "h", 3, None),
+        ("loc_err", "h", 3, None),
+        ("flags", "H", 1, None),
+        ("osc_fails", "H", 1, None),
+        ("imu_vel", "h", 3, None),
+        ("goal", "h", 3, None),
+        ("aero", "h", 3, None),
+        ("barom_temp", "h", 1, None),
+        ("barom_press", "i", 1, None),
+        ("barom_alt", "i", 1, None),
+        ("bat_volt", "h", 1, None),
+        ("bat_amp", "h", 1, None),
+        ("bat_mah", "h", 1, None),
+        ("desired_height", "h", 1, None),
+        ("stack_free", "h", 1, None),
+    ]),
+    4 : ("F23", [
+        ("gps_errors", "H", 1, None),
+        ("vdop", "B", 1, None),
+        ("rate_err", "h", 3, None),
+        ("tilt_err", "h", 3, None),
+        ("des_rate", "h", 3, None),
+        ("omega_accum", "h", 3, None),
+        ("des_turn_rate", "h", 1, None),
+        ("elev_trim", "h", 1, None),
+    ]),
+    5 : ("F13", [
+        ("week", "h", 1, None),
+        ("lat", "i", 1, None),
+        ("lon", "i", 1, None),
+        ("alt", "i", 1, None),
+    ]),
+    6 : ("F20", [
+        ("trim", "h", None, None),
+    ]),
+    127 : ("TEXT", [
+        ("text", "B", None, None),
+    ]),
+}
+
+RECORD_IDS = dict((v[0], k) for k, v in RECORDS.items())
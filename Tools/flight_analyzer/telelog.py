@@ -0,0 +1,108 @@
+#  This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation,  version 3 of the License, or
+#    (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Unpack an on-board telemetry log (USE_TELELOG) into the telemetry stream it holds.
+
+   The log is written in 512 byte blocks, each starting with a 16 byte header:
+     0xA5 0x4C <version> <high_water> <seq:u16> <length:u16> <time:u32> <dropped:u32>
+   followed by <length> bytes of telemetry, and zero padding. All fields are
+   little endian. seq counts blocks from 0, time is in milliseconds since
+   startup, dropped is the total number of bytes the aircraft had to drop as
+   the log queue was full, and high_water is the most blocks ever queued.
+
+   Usage: python telelog.py log00000.txt [unpacked.txt]
+"""
+
+import sys
+import struct
+
+BLOCK_SIZE = 512
+SYNC1 = 0xA5
+SYNC2 = 0x4C
+VERSION = 1
+HEADER = struct.Struct("<BBBBHHII")
+
+class telelog_block:
+    def __init__(self, header, data):
+        (sync1, sync2, self.version, self.high_water, self.seq,
+         self.length, self.time, self.dropped) = header
+        self.data = data
+
+def parse_header(data, pos):
+    """Return the header at pos, or None if there is not a valid one there"""
+    if pos + HEADER.size > len(data):
+        return None
+    h = HEADER.unpack(data[pos:pos + HEADER.size])
+    if h[0] != SYNC1 or h[1] != SYNC2 or h[2] != VERSION or h[5] > BLOCK_SIZE - HEADER.size:
+        return None
+    return h
+
+def is_telelog_file(filename):
+    """True if the file starts with a telemetry log block"""
+    try:
+        f = open(filename, "rb")
+    except IOError:
+        return False
+    data = f.read(HEADER.size)
+    f.close()
+    return parse_header(data, 0) is not None
+
+def blocks_from_bytes(data):
+    """Return the valid blocks in the contents of a log, skipping over any damaged ones"""
+    blocks = []
+    pos = 0
+    while pos + HEADER.size <= len(data):
+        h = parse_header(data, pos)
+        if h is None:
+            pos += 1    # resynchronise on the next block header
+            continue
+        start = pos + HEADER.size
+        blocks.append(telelog_block(h, data[start:start + h[5]]))
+        pos += BLOCK_SIZE
+    return blocks
+
+def read_blocks(filename):
+    f = open(filename, "rb")
+    data = f.read()
+    f.close()
+    return blocks_from_bytes(data)
+
+def unpack_telelog(telelog_filename, out_filename):
+    """Write the telemetry held in a log to out_filename, and report any losses"""
+    blocks = read_blocks(telelog_filename)
+    out = open(out_filename, "wb")
+    missing = 0
+    previous = None
+    for b in blocks:
+        if previous is not None and b.seq != ((previous.seq + 1) & 0xffff):
+            missing += (b.seq - previous.seq - 1) & 0xffff
+        out.write(b.data)
+        previous = b
+    out.close()
+    if blocks:
+        last = blocks[-1]
+        print("%s: %u blocks, %.1f seconds, %u blocks missing, %u bytes dropped on board, queue high water %u blocks" %
+              (telelog_filename, len(blocks), (last.time - blocks[0].time) / 1000.0,
+               missing, last.dropped, last.high_water))
+    return blocks
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    if len(sys.argv) > 2:
+        out = sys.argv[2]
+    else:
+        name, dot, ext = sys.argv[1].rpartition(".")
+        out = (name + "_unpacked." + ext) if dot else sys.argv[1] + "_unpacked"
+    unpack_telelog(sys.argv[1], out)
@@ -7,7 +7,7 @@ Copyright Matthew Coleman 2012
 Released under GNU GPL version 3 or later
 '''
 
-import os, sys, glob, re
+import os, sys, glob, re, binascii
 
 import SubParameterDatabase as ParameterDB
 
@@ -69,7 +69,7 @@ class ParameterTableGenerator():
         tableFile = open(self.filePath + path, "w")
         tableFile.write("// pyparam generated file - DO NOT EDIT\r\n\r\n")
         tableFile.write('#include "defines.h"\r\n')
-        tableFile.write('#include "mavlink_options.h"\r\n\r\n')
+        tableFile.write('#include "options_mavlink.h"\r\n\r\n')
 #        tableFile.write('#if(SERIAL_OUTPUT_FORMAT == SERIAL_MAVLINK) \r\n\r\n')
         tableFile.write('#if (SILSIM == ' + str(which) + ' && USE_MAVLINK == 1)\r\n\r\n')
         tableFile.write('#include "parameter_table.h"\r\n')
@@ -138,7 +138,7 @@ class ParameterTableGenerator():
         tableFile.write("// static initialisation of named union member variables\r\n")
         tableFile.write('#ifdef _MSC_VER\r\n\r\n')
         tableFile.write('#include "defines.h" \r\n')
-        tableFile.write('#include "mavlink_options.h"\r\n\r\n')
+        tableFile.write('#include "options_mavlink.h"\r\n\r\n')
         tableFile.write('#if (USE_MAVLINK == 1)\r\n\r\n')
         tableFile.write('#include "parameter_table.h"\r\n')
         tableFile.write('#include "data_storage.h"\r\n')
@@ -164,14 +164,52 @@ class ParameterTableGenerator():
         tableFile.close()
 
 
+    # Signature of the layout of a storage area, which changes whenever a
+    # parameter is added, removed, reordered or changes type. It is saved with
+    # the area, and 0 is kept for areas saved before signatures were.
+    def layoutSignature( self, paramBlock ):
+        layout = ""
+        for parameter in paramBlock.get_parameters().get_parameter():
+            layout += parameter.get_parameterName() + ":" + parameter.get_udb_param_type() + ":" + parameter.get_variable_name() + ";"
+        return binascii.crc_hqx(layout.encode("ascii"), 0xFFFF) or 1
+
     def writeStorageTable( self ):
         tableFile = open(self.filePath + "../../MatrixPilot/nv_memory_table.c", "w")
         tableFile.write("// pyparam generated file - DO NOT EDIT\r\n\r\n\r\n")
+        tableFile.write('#include "defines.h"\r\n')
         tableFile.write('#include "parameter_table.h"\r\n')
         tableFile.write('#include "data_services.h"\r\n\r\n')
         tableFile.write('#if(USE_NV_MEMORY == 1)\r\n\r\n')
         dataTypes = self.ParamDBMain.get_udbTypes().get_udbType()
         paramBlocks = self.ParamDBMain.get_parameterBlocks().get_parameterBlock()
+        for paramBlock in paramBlocks:
+            if(paramBlock.get_in_mavlink_parameters() == True):
+                externs = paramBlock.get_externs()
+                if(externs):
+                    for extern in externs.get_externString():
+                        tableFile.write('extern ' + extern + ';\r\n')
+                includes = paramBlock.get_includes()
+                if(includes):
+                    for include in includes.get_includeString():
+                        tableFile.write('#include "' + include + '"\r\n')
+        tableFile.write('\r\n')
+        # Items of every storage area in the order they are stored, which is
+        # the order of mavlink_parameters_list, so block_start_index indexes both
+        tableFile.write('const data_services_item data_services_items[] = {\r\n')
+        for paramBlock in paramBlocks:
+            if(paramBlock.get_in_mavlink_parameters() == True):
+                for parameter in paramBlock.get_parameters().get_parameter():
+                    tableFile.write('\t{ (uint8_t*)&' + parameter.get_variable_name() + ', sizeof(' + parameter.get_variable_name() + ') },\r\n')
+                tableFile.write('\r\n')
+        tableFile.write("};\r\n\r\n")
+        # Size of each storage area, as a constant expression
+        for paramBlock in paramBlocks:
+            if(paramBlock.get_in_mavlink_parameters() == True):
+                tableFile.write('#define STORAGE_SIZE_' + paramBlock.get_storage_area() + ' ( \\\r\n')
+                sizes = []
+                for parameter in paramBlock.get_parameters().get_parameter():
+                    sizes.append('\tsizeof(' + parameter.get_variable_name() + ')')
+                tableFile.write(' + \\\r\n'.join(sizes) + ')\r\n\r\n')
         param_index = 0;
         # Sizes of parameter blocks  
         paramBlockSizes = []
@@ -188,9 +226,10 @@ class ParameterTableGenerator():
                     tableFile.write("STORAGE_FLAG_" + serialisationFlag)
                     first = False
                 if(paramBlock.get_load_callback() != "NULL"):
-                    tableFile.write( ", &" + paramBlock.get_load_callback() + ' },\r\n')
+                    tableFile.write( ", &" + paramBlock.get_load_callback())
                 else:
-                    tableFile.write( ", NULL },\r\n")
+                    tableFile.write( ", NULL")
+                tableFile.write(", STORAGE_SIZE_" + paramBlock.get_storage_area() + ", 0x%04X },\r\n" % self.layoutSignature(paramBlock))
                 param_index = end_index
         tableFile.write("};\r\n\r\n\r\n")    
         tableFile.write("const uint16_t mavlink_parameter_block_count = sizeof(mavlink_parameter_blocks) / sizeof(mavlink_parameter_block);\r\n\r\n")
@@ -190,9 +190,22 @@ void PageErase(uint16_t PageAdr)
 ///////////////////////////////////////////////////////////////////////////////
 #ifndef USE_AT45D_DMA
 
+// Sectors are written through the AT45D's two SRAM buffers in turn, so that
+// each sector is written into one buffer while the page before it is still
+// being programmed from the other. Programming is started without waiting
+// for it to finish, so anything else first waits for the device to be ready.
+
+static uint8_t fill_buffer = 1;         // the AT45D buffer the next sector goes to
+
+static void WaitReady(void)
+{
+	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
+}
+
 static void BufferToPage(uint8_t BufferNo, uint16_t PageAdr)
 {
 //	printf("BufferToPage(BufferNo %u, PageAdr %u)\r\n", BufferNo, PageAdr);
+	WaitReady();                        // for the page programmed from the other buffer
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -205,12 +218,12 @@ static void BufferToPage(uint8_t BufferNo, uint16_t PageAdr)
 	DF_SPI_RW((uint8_t)(PageAdr << (PAGE_BITS - 8)));  //lower part of page address
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_reset();                         // initiate flash page programming
-	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
 }
 
 static void PageToBuffer(uint16_t PageAdr, uint8_t BufferNo)
 {
 //	printf("PageToBuffer(PageAdr %u, BufferNo %u)\r\n", PageAdr, BufferNo);
+	WaitReady();                        // for any page still being programmed
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -285,8 +298,19 @@ void ReadSector(uint16_t sector, uint8_t* buffer)
 
 void WriteSector(uint16_t sector, uint8_t* buffer)
 {
-	BufferWriteStr(2, 0, 512, buffer);  // write 512 bytes to beginning (offset 0) of AT45D internal buffer 2
-	BufferToPage(2, sector);            // transfer AT45D internal buffer 2 into AT45D internal page 'sector'  
+	BufferWriteStr(fill_buffer, 0, 512, buffer);    // write 512 bytes to beginning (offset 0) of the AT45D internal buffer not being programmed
+	BufferToPage(fill_buffer, sector);  // transfer that buffer into AT45D internal page 'sector'
+	fill_buffer = (fill_buffer == 1) ? 2 : 1;
+}
+
+void AT45D_Flush(void)
+{
+	WaitReady();
+}
+
+// Every page program is started by WriteSector() itself
+void AT45D_Service(void)
+{
 }
 
 #endif // !USE_AT45D_DMA
@@ -31,6 +31,14 @@ void AT45D_FormatFS(void);
 void ReadSector(uint16_t sector, uint8_t* buffer);
 void WriteSector(uint16_t sector, uint8_t* buffer);
 
+// WriteSector() returns while the page is still being programmed, this
+// returns once every sector written has been programmed into flash
+void AT45D_Flush(void);
+
+// Called from the main loop, through filesys_service(), to start programming
+// the last sector written once the device is free
+void AT45D_Service(void);
+
 // configuration for the Atmel AT45DB321D device
 #define PAGE_BITS 10
 #define PAGE_SIZE 528
@@ -184,12 +184,22 @@ void DumpRxData(void)
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+// Sectors are written through the AT45D's two SRAM buffers in turn. Each
+// sector is DMA'd into one buffer while the page written before it is being
+// programmed from the other, and its own page program is only started by
+// the next access, once that has finished. So WriteSector() returns as soon
+// as the DMA has been started, and sequential writes go at the rate pages
+// can be programmed, rather than that plus the time to fill the buffer.
+
+static uint8_t fill_buffer = 1;         // the AT45D buffer the next sector goes to
+static int16_t program_pending = 0;     // a buffer has been filled but not programmed
+static uint8_t program_buffer;
+static uint16_t program_page;
+
 //#define SPI_VERBOSE
 
-static int AT45D_WriteSector(uint16_t sector)
+static void AT45D_WaitReady(void)
 {
-//	printf("AT45D_WriteSector(%u)\r\n", sector);
-
 #ifdef SPI_VERBOSE
 	while (IsBusy) {
 		printf(".");
@@ -198,10 +208,10 @@ static int AT45D_WriteSector(uint16_t sector)
 
 	while (SPI2STATbits.SPIRBF) {
 		int result = SPI2BUF;           // dummy read of the SPIBUF register to clear the SPIRBF flag
-		printf("AT45D_WriteSector discarding %x\r\n", result);
+		printf("AT45D_WaitReady discarding %x\r\n", result);
 	}
 	if (SPI2STATbits.SPIROV) {
-		printf("AT45D_WriteSector SPI2STAT = %x\r\n", SPI2STAT);
+		printf("AT45D_WaitReady SPI2STAT = %x\r\n", SPI2STAT);
 		SPI2STATbits.SPIROV = 0;
 	}
 	while (!(ReadDFStatus() & 0x80)) {
@@ -211,19 +221,46 @@ static int AT45D_WriteSector(uint16_t sector)
 	while (IsBusy);
 	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
 #endif
+}
+
+// program the page waiting in an AT45D buffer, once the previous page is done
+static void AT45D_StartProgram(void)
+{
+	if (program_pending)
+	{
+		AT45D_WaitReady();
+		DF_reset();                     // reset dataflash command decoder
+		if (program_buffer == 1)
+			DF_SPI_RW(Buf1ToFlashWE);   // buffer 1 to flash with erase op-code
+		else
+			DF_SPI_RW(Buf2ToFlashWE);   // buffer 2 to flash with erase op-code
+		DF_SPI_RW((uint8_t)(program_page >> (16 - PAGE_BITS))); // upper part of page address
+		DF_SPI_RW((uint8_t)(program_page << (PAGE_BITS - 8)));  // lower part of page address
+		DF_SPI_RW(0x00);                // don't cares
+		DF_reset();                     // initiate flash page programming
+		program_pending = 0;
+	}
+}
+
+// A buffer write is allowed while the other buffer is being programmed,
+// so this only waits for the DMA of the previous sector.
+static int AT45D_FillBuffer(uint8_t buffer_no)
+{
+	while (IsBusy);
 
 	IsBusy = 1;
 	DF_reset();                         // reset dataflash command decoder
-	DF_SPI_RW(FlashProgBuf1);           // buffer 1 to flash with erase op-code
-	DF_SPI_RW((uint8_t)(sector >> (16 - PAGE_BITS))); // upper part of page address
-	DF_SPI_RW((uint8_t)(sector << (PAGE_BITS - 8)));  // lower part of page address
-//	DF_SPI_RW(0x00);                    // don't cares
+	if (buffer_no == 1)
+		DF_SPI_RW(Buf1Write);           // buffer 1 write op-code
+	else
+		DF_SPI_RW(Buf2Write);           // buffer 2 write op-code
+	DF_SPI_RW(0x00);                    // don't cares
+	DF_SPI_RW(0x00);                    // upper part of internal buffer address
 
 	DMA1CONbits.NULLW = 0;
 	DMA1CONbits.CHEN = 1;               // enable DMA Channel
 	DMA2CONbits.CHEN = 1;               // enable DMA Channel
-	SPI2BUF = 0;                        // start the DMA transaction with the don't care byte
-//	DMA2REQbits.FORCE = 1;
+	SPI2BUF = 0;                        // start the DMA transaction with the lower part of the buffer address
 	return 1;
 }
 
@@ -231,27 +268,8 @@ static int AT45D_ReadSector(uint16_t sector)
 {
 //	printf("AT45D_ReadSector(%u)\r\n", sector);
 
-#ifdef SPI_VERBOSE
-	while (IsBusy) {
-		printf(".");
-	}
-	printf("\r\n");
-
-	while (SPI2STATbits.SPIRBF) {
-		int result = SPI2BUF;           // dummy read of the SPIBUF register to clear the SPIRBF flag
-		printf("AT45D_ReadSector discarding %x\r\n", result);
-	}
-	if (SPI2STATbits.SPIROV) {
-		printf("AT45D_ReadSector SPI2STAT = %x\r\n", SPI2STAT);
-		SPI2STATbits.SPIROV = 0;
-	}
-	while (!(ReadDFStatus() & 0x80)) {
-		printf("#");
-	}
-#else
-	while (IsBusy);
-	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
-#endif
+	AT45D_StartProgram();               // a page still in a buffer may be the one wanted
+	AT45D_WaitReady();
 
 	IsBusy = 1;
 	DF_reset();                         // reset dataflash command decoder
@@ -326,8 +344,30 @@ void ReadSector(uint16_t sector, uint8_t* buffer)
 void WriteSector(uint16_t sector, uint8_t* buffer)
 {
 //printf("ws %u\r\n", sector);
-	AT45D_PutBuffer(buffer);
-	AT45D_WriteSector(sector);
+	AT45D_PutBuffer(buffer);            // waits for the previous buffer to be filled
+	AT45D_StartProgram();               // and starts programming it
+	AT45D_FillBuffer(fill_buffer);
+	program_buffer = fill_buffer;
+	program_page = sector;
+	program_pending = 1;
+	fill_buffer = (fill_buffer == 1) ? 2 : 1;
+}
+
+void AT45D_Flush(void)
+{
+	AT45D_StartProgram();
+	AT45D_WaitReady();
+}
+
+// The last sector written would otherwise wait in its buffer for the next
+// access, so it is programmed as soon as it has been DMA'd and the device
+// has finished the page before it.
+void AT45D_Service(void)
+{
+	if (program_pending && !IsBusy && (ReadDFStatus() & 0x80))
+	{
+		AT45D_StartProgram();
+	}
 }
 
 #endif // USE_AT45D_DMA
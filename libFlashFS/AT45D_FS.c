@@ -154,6 +154,7 @@ void AT45D_FormatFS(void)
 	for (i = (MDD_AT45D_FLASH_NUM_FAT_SECTORS+1+1); i < ((MDD_AT45D_FLASH_NUM_FAT_SECTORS+1) + MDD_AT45D_FLASH_NUM_ROOT_DIRECTORY_SECTORS); i++) {
 		WriteSector(i, buf);
 	}
+	AT45D_Flush();
 	printf("AT45D_FormatFS() complete\r\n");
 }
 
@@ -21,195 +21,517 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "FSconfig.h"
-#include "EEPROM.h"
 #include "../libUDB/libUDB.h"
 #include "../libUDB/I2C.h"
 #include "../libUDB/eeprom_udb4.h"
+#include "EEPROM.h"
 
 
 #ifdef USE_EEPROM_FLASH
 
+#if 1
+
+// Sector reads and writes for the MDD file system are queued, and carried out
+// by a state machine driven from the I2C1 completion callbacks, rather than
+// spinning until each 64 byte page has been transferred and programmed.
+//
+// A write is copied into one of EEPROM_WRITE_SECTORS sector buffers, and
+// returns at once. The buffers also hold the sectors most recently written,
+// so a sector written again while it is held is merged into its buffer, and
+// only the pages which changed are written again; the file system rewrites
+// the same FAT and directory sectors over and over. Each page write is
+// followed by the 24LC256's write cycle of up to 5ms, during which it does
+// not acknowledge its address. The callback keeps polling for that acknowledge,
+// and starts the next transfer as soon as it is seen, without any further
+// help from the background. If the part has still not acknowledged after
+// EEPROM_MAX_POLLS polls, well past its write cycle, the rest of the sector is
+// dropped, and its write fails through its callback.
+//
+// A read of a sector held in a buffer is copied from it, otherwise the whole
+// sector is read in a single sequential transfer. Reads go ahead of writes.
+//
+// Each page has a version, raised by the background each time the page is
+// changed, and a programmed version, set by the state machine when it starts
+// writing the page, so a page is dirty while the two differ, and neither side
+// needs to disable interrupts. If the bus is taken by another I2C1 user just
+// as a transfer or a poll is due, it is started again by eeprom_service(),
+// which every access through the file system calls, and which the main loop
+// calls through filesys_service(), so that nothing is left queued.
+
+#define MCP24LC256_COMMAND      0xA0
+#define EEPROM_PAGE_SIZE        64
+#define EEPROM_SECTOR_SIZE      512
+#define EEPROM_PAGES            (EEPROM_SECTOR_SIZE / EEPROM_PAGE_SIZE)
+#define EEPROM_NO_SECTOR        0xFFFF
+#define EEPROM_NO_ENTRY         0xFF
+#define EEPROM_TIMEOUT          500000
+#define EEPROM_MAX_POLLS        200     // each poll takes about 50us at 200kHz, 5ms is 100
+
 enum MCP24LC256_STATES
 {
 	MCP24LC256_STATE_STOPPED,
 	MCP24LC256_STATE_READING,
 	MCP24LC256_STATE_WRITING,
 	MCP24LC256_STATE_WAITING_WRITE,
-	MCP24LC256_STATE_FAILED_TRX,
 };
 
-#define MCP24LC256_COMMAND 0xA0
-static uint8_t commandData[4] = {0x00, 0x00}; 
-static uint16_t MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+typedef struct eeprom_sector {
+	volatile uint16_t sector;               // EEPROM_NO_SECTOR if unused
+	uint16_t stamp;                         // when last queued, oldest is written first
+	volatile uint8_t version[EEPROM_PAGES];     // written by the background
+	volatile uint8_t programmed[EEPROM_PAGES];  // written by the state machine
+	EEPROM_callbackFunc volatile callback;  // called once the sector has been written
+	uint8_t data[EEPROM_SECTOR_SIZE];
+} eeprom_sector_t;
+
+static eeprom_sector_t eeprom_sectors[EEPROM_WRITE_SECTORS];
+static uint16_t eeprom_stamp = 0;
+
+static uint8_t commandData[2];
+static volatile uint16_t MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+static volatile uint8_t eeprom_active = EEPROM_NO_ENTRY;   // sector buffer being written
+static uint8_t eeprom_page;                                 // and its page
+static volatile boolean eeprom_poll_stalled = false;        // a poll could not be started
+static uint16_t eeprom_polls;                               // polls not acknowledged
+
+static volatile boolean read_pending = false;
+static volatile boolean read_ok;
+static uint16_t read_sector;
+static uint8_t* read_buffer;
+static EEPROM_callbackFunc read_callback;
+
+static uint32_t eeprom_pages_written = 0;
+static uint32_t eeprom_pages_merged = 0;    // unchanged pages which were not written again
+
+static void MCP24LC256_callback(boolean I2CtrxOK);
 
 void PageErase(uint16_t PageAdr)
 {
 }
 
-//typedef void (*I2C_callbackFunc)(boolean);
-static void MCP24LC256_callback(boolean I2CtrxOK)
+static void eeprom_command(uint16_t sector, uint8_t page)
 {
-//	printf("MCP24LC256_callback(%s)\r\n", I2CtrxOK ? "true" : "false");
+	uint16_t address = (sector * EEPROM_SECTOR_SIZE) + (page * EEPROM_PAGE_SIZE);
 
-	if (I2CtrxOK == false)
+	commandData[0] = (uint8_t)(address >> 8);
+	commandData[1] = (uint8_t)(address & 0xFF);
+}
+
+// the dirty page of the least recently queued sector, if there is one
+static boolean eeprom_next_dirty(uint8_t* entry, uint8_t* page)
+{
+	eeprom_sector_t* e;
+	uint8_t i, p;
+	boolean found = false;
+
+	for (i = 0; i < EEPROM_WRITE_SECTORS; i++)
 	{
-		printf("MCP24LC256_STATE_FAILED_TRX\r\n");
-/*
-//		MCP24LC256_Timer = 0;
-		// If waiting for write ACK, continue to wait
-		if (MCP24LC256_state != MCP24LC256_STATE_WAITING_WRITE)
+		e = &eeprom_sectors[i];
+		if (e->sector == EEPROM_NO_SECTOR)
+		{
+			continue;
+		}
+		if (found && (int16_t)(e->stamp - eeprom_sectors[*entry].stamp) >= 0)
+		{
+			continue;
+		}
+		for (p = 0; p < EEPROM_PAGES; p++)
 		{
-			MCP24LC256_state = MCP24LC256_STATE_FAILED_TRX;
-			if (pcallerCallback != NULL) pcallerCallback(true);
-			pcallerCallback = NULL;
+			if (e->version[p] != e->programmed[p])
+			{
+				*entry = i;
+				*page = p;
+				found = true;
+				break;
+			}
 		}
- */
+	}
+	return found;
+}
+
+static boolean eeprom_sector_clean(const eeprom_sector_t* e)
+{
+	uint8_t p;
+
+	for (p = 0; p < EEPROM_PAGES; p++)
+	{
+		if (e->version[p] != e->programmed[p])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Start the next transfer, if there is one. Called from the I2C1 callback,
+// or by the background while the state machine is stopped. The state is set
+// before each transfer is started, as its callback may run before the call
+// to start it has returned.
+static void eeprom_next(void)
+{
+	eeprom_sector_t* e;
+	uint8_t entry, page;
+
+	if (read_pending)
+	{
+		eeprom_command(read_sector, 0);
+		MCP24LC256_state = MCP24LC256_STATE_READING;
+		if (I2C1_Read(MCP24LC256_COMMAND, commandData, 2, read_buffer, EEPROM_SECTOR_SIZE, &MCP24LC256_callback, 0) == false)
+		{
+			MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+		}
+		return;
+	}
+	if (!eeprom_next_dirty(&entry, &page))
+	{
+		MCP24LC256_state = MCP24LC256_STATE_STOPPED;
 		return;
 	}
+	e = &eeprom_sectors[entry];
+	e->programmed[page] = e->version[page];
+	eeprom_active = entry;
+	eeprom_page = page;
+	eeprom_command(e->sector, page);
+	MCP24LC256_state = MCP24LC256_STATE_WRITING;
+	if (I2C1_Write(MCP24LC256_COMMAND, commandData, 2, &e->data[page * EEPROM_PAGE_SIZE], EEPROM_PAGE_SIZE, &MCP24LC256_callback) == false)
+	{
+		e->programmed[page]--;      // still to be written
+		eeprom_active = EEPROM_NO_ENTRY;
+		MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+	}
+}
+
+// the page write cycle of the active sector has finished
+static void eeprom_page_done(void)
+{
+	eeprom_sector_t* e = &eeprom_sectors[eeprom_active];
+	EEPROM_callbackFunc callback = e->callback;
+
+	eeprom_pages_written++;
+	eeprom_active = EEPROM_NO_ENTRY;
+	if (callback != NULL && eeprom_sector_clean(e))
+	{
+		e->callback = NULL;
+		callback(true);
+	}
+}
+
+// The write cycle of the active page has not finished in time, so the part
+// is not answering. The rest of its sector is dropped, rather than retried
+// for ever, and the write fails.
+static void eeprom_write_failed(void)
+{
+	eeprom_sector_t* e = &eeprom_sectors[eeprom_active];
+	EEPROM_callbackFunc callback = e->callback;
+	uint8_t p;
+
+	for (p = 0; p < EEPROM_PAGES; p++)
+	{
+		e->programmed[p] = e->version[p];
+	}
+	eeprom_active = EEPROM_NO_ENTRY;
+	if (callback != NULL)
+	{
+		e->callback = NULL;
+		callback(false);
+	}
+}
+
+// Poll for the end of the write cycle, or leave it for eeprom_service() if
+// the bus is busy
+static void eeprom_poll(void)
+{
+	eeprom_poll_stalled = !I2C1_CheckAck(MCP24LC256_COMMAND, &MCP24LC256_callback);
+}
 
+static void MCP24LC256_callback(boolean I2CtrxOK)
+{
 	switch (MCP24LC256_state)
 	{
 		case MCP24LC256_STATE_READING:
-//			if (pcallerCallback != NULL) pcallerCallback(true);
-//			pcallerCallback = NULL;
-			MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+			read_ok = I2CtrxOK;
+			read_pending = false;
+			if (read_callback != NULL) read_callback(I2CtrxOK);
+			eeprom_next();
 			break;
 		case MCP24LC256_STATE_WRITING:
-//			MCP24LC256_Timer = 0;
+			if (I2CtrxOK == false)
+			{
+				printf("MCP24LC256_STATE_FAILED_TRX\r\n");
+				eeprom_sectors[eeprom_active].programmed[eeprom_page]--;
+				eeprom_active = EEPROM_NO_ENTRY;
+				MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+				break;
+			}
 			MCP24LC256_state = MCP24LC256_STATE_WAITING_WRITE;
+			eeprom_polls = 0;
+			eeprom_poll();
 			break;
 		case MCP24LC256_STATE_WAITING_WRITE:
-//			MCP24LC256_write_chunk();
-
-			MCP24LC256_state = MCP24LC256_STATE_STOPPED;
-
-			break;
-		case MCP24LC256_STATE_FAILED_TRX:
-			MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+			if (I2CtrxOK == false)
+			{
+				// still programming the page, so poll again
+				if (++eeprom_polls < EEPROM_MAX_POLLS)
+				{
+					eeprom_poll();
+					break;
+				}
+				printf("MCP24LC256_STATE_WRITE_TIMEOUT\r\n");
+				eeprom_write_failed();
+				eeprom_next();
+				break;
+			}
+			eeprom_page_done();
+			eeprom_next();
 			break;
 		default:
-			MCP24LC256_state = MCP24LC256_STATE_FAILED_TRX;
+			MCP24LC256_state = MCP24LC256_STATE_STOPPED;
 			break;
 	}
 }
 
+// Restart the state machine if it stopped with work queued, or could not
+// poll for the end of a write cycle, as the bus was busy. Only called at
+// background level. No callback is due in either case, so this can not race
+// with the state machine.
 void eeprom_service(void)
 {
 	switch (MCP24LC256_state)
 	{
-		case MCP24LC256_STATE_WAITING_WRITE:
-//		printf("eeprom_service() MCP24LC256_STATE_WAITING_WRITE\r\n");
-			I2C1_CheckAck(MCP24LC256_COMMAND, &MCP24LC256_callback);
+		case MCP24LC256_STATE_STOPPED:
+			eeprom_next();
 			break;
-		case MCP24LC256_STATE_FAILED_TRX:
-//		printf("eeprom_service() MCP24LC256_STATE_FAILED_TRX\r\n");
-			I2C1_CheckAck(MCP24LC256_COMMAND, &MCP24LC256_callback);
+		case MCP24LC256_STATE_WAITING_WRITE:
+			if (eeprom_poll_stalled)
+			{
+				eeprom_poll();
+			}
 			break;
 	}
 }
 
-#if 1
+static eeprom_sector_t* eeprom_find(uint16_t sector)
+{
+	uint8_t i;
+
+	for (i = 0; i < EEPROM_WRITE_SECTORS; i++)
+	{
+		if (eeprom_sectors[i].sector == sector)
+		{
+			return &eeprom_sectors[i];
+		}
+	}
+	return NULL;
+}
 
-int block(void)
+// A sector buffer which has been written, and is not being written, can be
+// reused; the one least recently queued is taken. The state machine never
+// starts on a clean buffer, so it can be changed without disabling interrupts.
+static eeprom_sector_t* eeprom_allocate(uint16_t sector)
 {
-	long timeout = 500000;
-//	unsigned long timeout = 0xffffffff;
-	while (MCP24LC256_state != MCP24LC256_STATE_STOPPED)
+	eeprom_sector_t* e;
+	eeprom_sector_t* oldest = NULL;
+	uint8_t i;
+
+	for (i = 0; i < EEPROM_WRITE_SECTORS; i++)
 	{
-//		eeprom_service();
-		if (!timeout--)
+		e = &eeprom_sectors[i];
+		if (e->sector == EEPROM_NO_SECTOR)
+		{
+			oldest = e;
+			break;
+		}
+		if (i != eeprom_active && e->callback == NULL && eeprom_sector_clean(e) &&
+		    (oldest == NULL || (int16_t)(e->stamp - oldest->stamp) < 0))
 		{
-			printf("timeout\r\n");
-			return 1;
-		} 
+			oldest = e;
+		}
 	}
-	return 0;
+	if (oldest != NULL)
+	{
+		oldest->sector = EEPROM_NO_SECTOR;
+		memset(oldest->data, 0xFF, EEPROM_SECTOR_SIZE);
+		oldest->sector = sector;
+	}
+	return oldest;
 }
 
-void ReadPage(uint16_t page, uint8_t* buffer)
+boolean EEPROM_QueueWrite(uint16_t sector, const uint8_t* buffer, EEPROM_callbackFunc callback)
 {
-//	int timeout = 50000;
-//	printf("ReadPage(%u, ...)\r\n", page);
+	eeprom_sector_t* e = eeprom_find(sector);
+	boolean fresh = false;
+	uint16_t offset;
+	uint8_t p;
 
-	commandData[1] = page * 64;
-	if (page > 3) commandData[0] |= 1;
+	if (e == NULL)
+	{
+		e = eeprom_allocate(sector);
+		fresh = true;
+	}
+	if (e == NULL || (callback != NULL && e->callback != NULL))
+	{
+		return false;
+	}
+	for (p = 0; p < EEPROM_PAGES; p++)
+	{
+		offset = p * EEPROM_PAGE_SIZE;
+		if (fresh || memcmp(&e->data[offset], &buffer[offset], EEPROM_PAGE_SIZE) != 0)
+		{
+			memcpy(&e->data[offset], &buffer[offset], EEPROM_PAGE_SIZE);
+			e->version[p]++;
+		}
+		else
+		{
+			eeprom_pages_merged++;
+		}
+	}
+	e->stamp = ++eeprom_stamp;
+	if (callback != NULL)
+	{
+		if (eeprom_sector_clean(e) && eeprom_active != (uint8_t)(e - eeprom_sectors))
+		{
+			callback(true);     // nothing changed
+		}
+		else
+		{
+			e->callback = callback;
+		}
+	}
+	eeprom_service();
+	return true;
+}
+
+boolean EEPROM_QueueRead(uint16_t sector, uint8_t* buffer, EEPROM_callbackFunc callback)
+{
+	eeprom_sector_t* e = eeprom_find(sector);
 
-	MCP24LC256_state = MCP24LC256_STATE_READING;
-//boolean I2C1_Read(uint8_t address, uint8_t* pcommandData, uint8_t commandDataSize, uint8_t* prxData, uint16_t rxSize, I2C_callbackFunc pCallback, uint16_t I2C_mode);
-	if (I2C1_Read(MCP24LC256_COMMAND, commandData, 2, buffer, 64, &MCP24LC256_callback, 0) == false)
+	if (e != NULL)
 	{
-		MCP24LC256_state = MCP24LC256_STATE_STOPPED;
-		printf("ReadPage(...) - ERROR\r\n");
+		memcpy(buffer, e->data, EEPROM_SECTOR_SIZE);
+		if (callback != NULL) callback(true);
+		return true;
 	}
-//	printf("ReadPage(...) - 1\r\n");
-	block();
-//	while (MCP24LC256_state != MCP24LC256_STATE_STOPPED) { if (!timeout--) { printf("timeout\r\n"); break; } }
-//	printf("ReadPage(...) - 2\r\n");
+	if (read_pending)
+	{
+		return false;
+	}
+	read_sector = sector;
+	read_buffer = buffer;
+	read_callback = callback;
+	read_ok = false;
+	read_pending = true;
+	eeprom_service();
+	return true;
 }
 
-static uint16_t last_sector = 0xFFFF;
+boolean EEPROM_Busy(void)
+{
+	uint8_t i;
 
-void ReadSector(uint16_t sector, uint8_t* buffer)
+	if (read_pending || eeprom_active != EEPROM_NO_ENTRY)
+	{
+		return true;
+	}
+	for (i = 0; i < EEPROM_WRITE_SECTORS; i++)
+	{
+		if (!eeprom_sector_clean(&eeprom_sectors[i]))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// The file system initialises the media each time it is mounted, so only
+// the buffers of sectors already written are let go. Those still waiting to
+// be written are kept.
+void EEPROM_Init(void)
 {
-	int page = 0;
+	eeprom_sector_t* e;
+	uint8_t i;
 
-	if (last_sector == sector) return;
+	for (i = 0; i < EEPROM_WRITE_SECTORS; i++)
+	{
+		e = &eeprom_sectors[i];
+		if (i != eeprom_active && e->callback == NULL && eeprom_sector_clean(e))
+		{
+			e->sector = EEPROM_NO_SECTOR;
+		}
+	}
+}
 
-last_sector = sector;
+// The MDD file system expects each sector read or write to be complete when
+// it returns, so these wait, but a write only until there is a free buffer.
 
-//	printf("ReadSector(%u, ...)\r\n", sector);
-//	while (MCP24LC256_state != MCP24LC256_STATE_STOPPED) {}
-	if (block())
+void EEPROM_Flush(void)
+{
+	long timeout = EEPROM_TIMEOUT;
+
+	while (EEPROM_Busy())
 	{
-		printf("ReadSector(...) failed\r\n");
-		return;
+		eeprom_service();
+		if (!timeout--)
+		{
+			printf("EEPROM_Flush() timeout\r\n");
+			return;
+		}
 	}
-//	commandData[0] = (uint8_t)(sector & 0xFF);
-	commandData[0] = (uint8_t)(sector << 1);
-	do {
-		ReadPage(page, buffer);		
-		buffer += 64;
-	} while (page++ < 7);
 }
 
-void WritePage(uint16_t page, uint8_t* buffer)
+void ReadSector(uint16_t sector, uint8_t* buffer)
 {
-//	int timeout = 50000;
-//	printf("WritePage(%u, ...)\r\n", page);
-	commandData[1] = page * 64;
-	if (page > 3) commandData[0] |= 1;
-	MCP24LC256_state = MCP24LC256_STATE_WRITING;
-	if (I2C1_Write(MCP24LC256_COMMAND, commandData, 2, buffer, 64, &MCP24LC256_callback) == false)
-//boolean I2C1_Write(uint8_t address, uint8_t* pcommandData, uint8_t commandDataSize, uint8_t* ptxData, uint16_t txSize, I2C_callbackFunc pCallback);
+	long timeout = EEPROM_TIMEOUT;
+
+	while (!EEPROM_QueueRead(sector, buffer, NULL))
 	{
-		MCP24LC256_state = MCP24LC256_STATE_STOPPED;
-		printf("WritePage(...) - ERROR\r\n");
+		eeprom_service();
+		if (!timeout--)
+		{
+			printf("ReadSector(%u) timeout\r\n", sector);
+			return;
+		}
+	}
+	if (eeprom_find(sector) != NULL)
+	{
+		return;     // copied from a sector buffer
+	}
+	while (read_pending)
+	{
+		eeprom_service();
+		if (!timeout--)
+		{
+			printf("ReadSector(%u) timeout\r\n", sector);
+			return;
+		}
+	}
+	if (!read_ok)
+	{
+		printf("ReadSector(%u) failed\r\n", sector);
 	}
-//	printf("WritePage(...) - 1\r\n");
-	block();
-//	printf("WritePage(...) - 2\r\n");
 }
 
 void WriteSector(uint16_t sector, uint8_t* buffer)
 {
-	// the 24LC256 device works with 64 byte pages
-	// therefore writing a 512 byte sector will be done as eight consecutive page writes
-	int page = 0;
-
-last_sector = 0xFFFF;
+	long timeout = EEPROM_TIMEOUT;
 
-//	printf("WriteSector(%u, ...)\r\n", sector);
-	if (block()) return;
-//	printf("WriteSector(...) - 2\r\n");
-//	commandData[0] = (uint8_t)(sector & 0xFF) << 1;
-	commandData[0] = (uint8_t)(sector << 1);
-	do {
-		WritePage(page, buffer);		
-		buffer += 64;
-	} while (page++ < 7);
+	while (!EEPROM_QueueWrite(sector, buffer, NULL))
+	{
+		eeprom_service();
+		if (!timeout--)
+		{
+			printf("WriteSector(%u) timeout\r\n", sector);
+			return;
+		}
+	}
 }
 
+void eeprom_stats(void)
+{
+	printf("EEPROM %lu pages written, %lu unchanged pages merged\r\n",
+	       (unsigned long)eeprom_pages_written, (unsigned long)eeprom_pages_merged);
+}
 
 #else
 
@@ -22,8 +22,35 @@
 #ifndef EEPROM_H
 #define EEPROM_H
 
+#include "../libUDB/libUDB.h"
 
+// sector buffers queued for writing to the 24LC256, which also hold the
+// sectors most recently written
+#ifndef EEPROM_WRITE_SECTORS
+#define EEPROM_WRITE_SECTORS 2
+#endif
+
+// called at interrupt level when a queued read or write has finished
+typedef void (*EEPROM_callbackFunc)(boolean);
+
+void EEPROM_Init(void);
 void EEPROM_FormatFS(void);
+
+// Queue a 512 byte sector to be read or written, with an optional callback.
+// A write is copied, so the buffer can be reused at once, while a read
+// buffer must be kept until the callback. Both return false if there is no
+// room in the queue. eeprom_service() restarts the queue if it has stalled,
+// and must be called regularly at background level, see filesys_service().
+// EEPROM_Flush() waits until every queued write has been written.
+boolean EEPROM_QueueRead(uint16_t sector, uint8_t* buffer, EEPROM_callbackFunc callback);
+boolean EEPROM_QueueWrite(uint16_t sector, const uint8_t* buffer, EEPROM_callbackFunc callback);
+boolean EEPROM_Busy(void);
+void EEPROM_Flush(void);
+void eeprom_service(void);
+void eeprom_stats(void);
+
+// for the MDD file system, these return once the sector has been read, or
+// queued to be written
 void ReadSector(uint16_t sector, uint8_t* buffer);
 void WriteSector(uint16_t sector, uint8_t* buffer);
 
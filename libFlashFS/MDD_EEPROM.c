@@ -104,6 +104,7 @@ BYTE MDD_EEPROM_InitIO(void)
  *****************************************************************************/
 MEDIA_INFORMATION * MDD_EEPROM_MediaInitialize(void)
 {
+	EEPROM_Init();
 	mediaInformation.validityFlags.bits.sectorSize = TRUE;
 //	mediaInformation.validityFlags.bits.maxLUN = TRUE;
 	mediaInformation.sectorSize = MEDIA_SECTOR_SIZE;
@@ -25,6 +25,7 @@
 #include "MDD-File-System/FSIO.h"
 #include "AT45D.h"
 #include "EEPROM.h"
+#include "sector_cache.h"
 
 
 void filesys_chkdsk(void)
@@ -99,6 +100,42 @@ void filesys_format(void)
 #else
 #warning No Mass Storage Device Format Function Defined
 #endif // USE_AT45D_FLASH
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+	sector_cache_invalidate();
+#endif
+}
+
+void filesys_flush(void)
+{
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+	sector_cache_flush();
+#endif
+#ifdef USE_AT45D_FLASH
+	AT45D_Flush();
+#elif defined USE_EEPROM_FLASH
+	EEPROM_Flush();
+#endif
+}
+
+void filesys_service(void)
+{
+#ifdef USE_AT45D_FLASH
+	AT45D_Service();
+#elif defined USE_EEPROM_FLASH
+	eeprom_service();
+#endif
+}
+
+void filesys_stats(void)
+{
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+	sector_cache_print_stats();
+#else
+	printf("no sector cache\r\n");
+#endif
+#ifdef USE_EEPROM_FLASH
+	eeprom_stats();
+#endif
 }
 
 int filesys_init(void)
@@ -154,6 +191,18 @@ void filesys_format(void)
 {
 }
 
+void filesys_flush(void)
+{
+}
+
+void filesys_service(void)
+{
+}
+
+void filesys_stats(void)
+{
+}
+
 int filesys_init(void)
 {
 	printf("filesys_init() - nothing to do on WIN32\r\n");
@@ -29,5 +29,22 @@ void filesys_format(void);
 void filesys_dir(char* arg);
 void filesys_cat(char* arg);
 
+// Write anything the file system has cached to the media, see sector_cache.h
+void filesys_flush(void);
+
+// Close a file which has been written, or remove one, and flush, so that the
+// FAT and directory sectors changed reach the media and survive a power loss.
+// Include FSIO.h or SIL-filesystem.h first.
+static inline int filesys_flushed(int result)
+{
+	filesys_flush();
+	return result;
+}
+#define filesys_fclose(fp)      filesys_flushed(FSfclose(fp))
+#define filesys_remove(name)    filesys_flushed(FSremove(name))
+// Called from the main loop, to finish media writes left queued
+void filesys_service(void);
+void filesys_stats(void);
+
 
 #endif // FILESYS_H
@@ -0,0 +1,240 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include "FSconfig.h"
+#include "sector_cache.h"
+
+#if (MDD_SECTOR_CACHE_SECTORS > 0)
+
+// The file system keeps one data sector and one FAT sector of its own, so
+// while a log is being written every other file access, a directory search
+// or a look at the FAT, forces those to be read from the media again, and
+// on the AT45D and 24LC256 a sector read or write takes milliseconds. Here
+// the most recently used sectors are kept, and changed ones are written back
+// when their line is reused for another sector, or when flushed.
+//
+// While a log is written, anything else using the file system takes its
+// one data buffer, and the log's last sector has to be read back again,
+// which is then found here.
+//
+// All access is from the background, as with the rest of the file system.
+
+#define NO_SECTOR 0xFFFFFFFF
+
+typedef struct sector_cache_line {
+	DWORD sector;               // NO_SECTOR if the line is unused
+	DWORD used;                 // when last accessed, the least recent is reused
+	BYTE dirty;                 // changed since it was read or written back
+	BYTE allowWriteToZero;      // as passed to the last write of the sector
+	BYTE data[MEDIA_SECTOR_SIZE];
+} sector_cache_line_t;
+
+static sector_cache_line_t lines[MDD_SECTOR_CACHE_SECTORS];
+static DWORD cache_clock = 0;
+static BYTE initialised = FALSE;
+static sector_cache_stats_t counters;
+
+static void sector_cache_init(void)
+{
+	int i;
+
+	for (i = 0; i < MDD_SECTOR_CACHE_SECTORS; i++)
+	{
+		lines[i].sector = NO_SECTOR;
+		lines[i].dirty = FALSE;
+	}
+	initialised = TRUE;
+}
+
+static sector_cache_line_t* sector_cache_find(DWORD sector_addr)
+{
+	int i;
+
+	if (!initialised)
+	{
+		sector_cache_init();
+	}
+	for (i = 0; i < MDD_SECTOR_CACHE_SECTORS; i++)
+	{
+		if (lines[i].sector == sector_addr)
+		{
+			lines[i].used = ++cache_clock;
+			return &lines[i];
+		}
+	}
+	return NULL;
+}
+
+static BYTE sector_cache_writeback(sector_cache_line_t* line)
+{
+	if (line->dirty)
+	{
+		if (!MDD_MEDIA_SectorWrite(line->sector, line->data, line->allowWriteToZero))
+		{
+			printf("sector_cache_writeback(%lu) failed\r\n", (unsigned long)line->sector);
+			return FALSE;
+		}
+		line->dirty = FALSE;
+		counters.writebacks++;
+	}
+	return TRUE;
+}
+
+// An unused line, or the least recently used one once it has been written
+// back. NULL if that failed, so the caller goes straight to the media.
+static sector_cache_line_t* sector_cache_replace(DWORD sector_addr)
+{
+	sector_cache_line_t* line = &lines[0];
+	int i;
+
+	for (i = 0; i < MDD_SECTOR_CACHE_SECTORS; i++)
+	{
+		if (lines[i].sector == NO_SECTOR)
+		{
+			line = &lines[i];
+			break;
+		}
+		if ((long)(lines[i].used - line->used) < 0)
+		{
+			line = &lines[i];
+		}
+	}
+	if (line->sector != NO_SECTOR && !sector_cache_writeback(line))
+	{
+		return NULL;
+	}
+	line->sector = sector_addr;
+	line->used = ++cache_clock;
+	return line;
+}
+
+BYTE sector_cache_read(DWORD sector_addr, BYTE* buffer)
+{
+	sector_cache_line_t* line = sector_cache_find(sector_addr);
+
+	if (line != NULL)
+	{
+		counters.hits++;
+		memcpy(buffer, line->data, MEDIA_SECTOR_SIZE);
+		return TRUE;
+	}
+	counters.misses++;
+	if (!MDD_MEDIA_SectorRead(sector_addr, buffer))
+	{
+		return FALSE;
+	}
+	line = sector_cache_replace(sector_addr);
+	if (line != NULL)
+	{
+		memcpy(line->data, buffer, MEDIA_SECTOR_SIZE);
+		line->dirty = FALSE;
+	}
+	return TRUE;
+}
+
+BYTE sector_cache_write(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero)
+{
+	sector_cache_line_t* line = sector_cache_find(sector_addr);
+
+	counters.writes++;
+	if (line == NULL)
+	{
+		line = sector_cache_replace(sector_addr);
+		if (line == NULL)
+		{
+			return MDD_MEDIA_SectorWrite(sector_addr, buffer, allowWriteToZero);
+		}
+	}
+	else if (line->dirty)
+	{
+		counters.absorbed++;
+	}
+	memcpy(line->data, buffer, MEDIA_SECTOR_SIZE);
+	line->allowWriteToZero = allowWriteToZero;
+	line->dirty = TRUE;
+	return TRUE;
+}
+
+BYTE sector_cache_write_through(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero)
+{
+	sector_cache_line_t* line = sector_cache_find(sector_addr);
+
+	if (line != NULL)
+	{
+		memcpy(line->data, buffer, MEDIA_SECTOR_SIZE);
+		line->dirty = FALSE;
+	}
+	return MDD_MEDIA_SectorWrite(sector_addr, buffer, allowWriteToZero);
+}
+
+// Changed sectors are written back in ascending order, as the file system
+// would have written a FAT before the one following it.
+BYTE sector_cache_flush(void)
+{
+	sector_cache_line_t* line;
+	BYTE result = TRUE;
+	int i;
+
+	do {
+		line = NULL;
+		for (i = 0; i < MDD_SECTOR_CACHE_SECTORS; i++)
+		{
+			if (lines[i].dirty && (line == NULL || lines[i].sector < line->sector))
+			{
+				line = &lines[i];
+			}
+		}
+		if (line != NULL && !sector_cache_writeback(line))
+		{
+			line->sector = NO_SECTOR;   // give up on it, rather than fail every flush
+			line->dirty = FALSE;
+			result = FALSE;
+		}
+	} while (line != NULL);
+	return result;
+}
+
+void sector_cache_invalidate(void)
+{
+	sector_cache_init();
+}
+
+void sector_cache_get_stats(sector_cache_stats_t* stats)
+{
+	*stats = counters;
+}
+
+void sector_cache_print_stats(void)
+{
+	DWORD reads = counters.hits + counters.misses;
+
+	printf("sector cache: %lu reads, %lu%% hits, %lu writes, %lu absorbed, %lu written back\r\n",
+	       (unsigned long)reads,
+	       (unsigned long)(reads ? (counters.hits * 100) / reads : 0),
+	       (unsigned long)counters.writes,
+	       (unsigned long)counters.absorbed,
+	       (unsigned long)counters.writebacks);
+}
+
+#endif // MDD_SECTOR_CACHE_SECTORS
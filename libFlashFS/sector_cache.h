@@ -0,0 +1,64 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2011 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#ifndef SECTOR_CACHE_H
+#define SECTOR_CACHE_H
+
+#include "GenericTypeDefs.h"
+#include "FSconfig.h"
+
+// A small write-back cache of whole sectors between the MDD file system and
+// the media driver. FSconfig.h points MDD_SectorRead and MDD_SectorWrite here
+// when MDD_SECTOR_CACHE_SECTORS is not zero, and the driver's own functions
+// become MDD_MEDIA_SectorRead and MDD_MEDIA_SectorWrite.
+//
+// Written sectors are only written to the media when their line is needed
+// for another sector, or by sector_cache_flush(), so anything which must
+// survive a power failure has to be flushed (see filesys_flush()).
+
+typedef struct sector_cache_stats {
+	DWORD hits;             // reads found in the cache
+	DWORD misses;           // reads from the media
+	DWORD writes;           // sector writes from the file system
+	DWORD absorbed;         // writes to a sector not yet written back
+	DWORD writebacks;       // sectors written to the media
+} sector_cache_stats_t;
+
+BYTE sector_cache_read(DWORD sector_addr, BYTE* buffer);
+BYTE sector_cache_write(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero);
+
+// For the USB mass storage class, which has no way to tell us when to flush.
+// The sector is written to the media at once, and any copy of it kept up to date.
+BYTE sector_cache_write_through(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero);
+
+// Write every changed sector to the media, returns FALSE if one failed
+BYTE sector_cache_flush(void);
+
+// Forget all the cached sectors, without writing them, after the media has
+// been changed underneath the file system, e.g. by AT45D_FormatFS()
+void sector_cache_invalidate(void);
+
+void sector_cache_get_stats(sector_cache_stats_t* stats);
+void sector_cache_print_stats(void);
+
+
+#endif // SECTOR_CACHE_H
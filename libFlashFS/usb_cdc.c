@@ -20,6 +20,7 @@
 
 #include "../libUDB/libUDB.h"
 #include "../libUDB/serialIO.h"
+#include "options_mavlink.h"
 
 #if (USE_USB == 1 && USE_CDC == 1)
 
@@ -27,6 +28,10 @@
 #include "USB/usb_function_cdc.h"
 #include "usb_cdc.h"
 
+#if (MAVLINK_USB_CHANNEL == 1)
+#include "../MatrixPilot/MAVLink.h"
+#endif
+
 void BlinkUSBStatus(void);
 
 char USB_In_Buffer[CDC_DATA_OUT_EP_SIZE];
@@ -77,6 +82,31 @@ void CDCTasks(void)
 		}
 	}
 
+#elif (MAVLINK_USB_CHANNEL == 1)
+	numBytesRead = getsUSBUSART(USB_In_Buffer, sizeof(USB_In_Buffer));
+	if (numBytesRead != 0)
+	{
+		int i = 0;
+		while (i < numBytesRead)
+		{
+			mavlink_chan_received_byte(MAVLINK_COMM_USB, USB_In_Buffer[i++]);
+		}
+	}
+
+	if (mUSBUSARTIsTxTrfReady())
+	{
+		int i = 0;
+		int txchar;
+		while ((i < sizeof(USB_Out_Buffer)) && ((txchar = mavlink_chan_get_byte_to_send(MAVLINK_COMM_USB)) != -1))
+		{
+			USB_Out_Buffer[i++] = txchar;
+		}
+		if (i > 0)
+		{
+			putUSBUSART(USB_Out_Buffer, i);
+		}
+	}
+
 #else
 	if (mUSBUSARTIsTxTrfReady())
 	{
@@ -57,9 +57,9 @@ LUN_FUNCTIONS LUN[MAX_LUN + 1] =
 		&MDD_AT45D_ReadCapacity,
 		&MDD_AT45D_ReadSectorSize,
 		&MDD_AT45D_MediaDetect,
-		&MDD_AT45D_SectorRead,
+		&MDD_SectorRead,            // through the sector cache, see FSconfig.h
 		&MDD_AT45D_WriteProtectState,
-		&MDD_AT45D_SectorWrite
+		&MDD_SectorWriteThrough
 	}
 };
 #elif defined USE_SD_INTERFACE_WITH_SPI
@@ -83,9 +83,9 @@ LUN_FUNCTIONS LUN[MAX_LUN + 1] =
 		&MDD_EEPROM_ReadCapacity,
 		&MDD_EEPROM_ReadSectorSize,
 		&MDD_EEPROM_MediaDetect,
-		&MDD_EEPROM_SectorRead,
+		&MDD_SectorRead,            // through the sector cache, see FSconfig.h
 		&MDD_EEPROM_WriteProtectState,
-		&MDD_EEPROM_SectorWrite
+		&MDD_SectorWriteThrough
 	}
 };
 #else
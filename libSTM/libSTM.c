@@ -97,6 +97,46 @@ uint8_t udb_cpu_load(void)
 	return 5; // sounds reasonable for a fake cpu%
 }
 
+// The cycle counter of the Cortex-M4 data watchpoint and trace unit, at the
+// core clock, shifted down so that its low 16 bits wrap no sooner than 16ms
+#define DEMCR                   (*(volatile uint32_t*)0xE000EDFC)
+#define DEMCR_TRCENA            (1UL << 24)
+#define DWT_CTRL                (*(volatile uint32_t*)0xE0001000)
+#define DWT_CTRL_CYCCNTENA      (1UL << 0)
+#define DWT_CYCCNT              (*(volatile uint32_t*)0xE0001004)
+#define TIMER_MAX_TICKS_PER_MS  4096    // 65536 ticks in 16ms
+
+extern uint32_t SystemCoreClock;        // core clock in Hz, from system_stm32f4xx.c
+
+static uint8_t timer_shift = 0;
+static uint16_t timer_ticks_per_ms = 0;
+
+static void init_timer(void)
+{
+	uint32_t ticks_per_ms = SystemCoreClock / 1000;
+
+	timer_shift = 0;
+	while ((ticks_per_ms >> timer_shift) > TIMER_MAX_TICKS_PER_MS)
+	{
+		timer_shift++;
+	}
+	timer_ticks_per_ms = (uint16_t)(ticks_per_ms >> timer_shift);
+
+	DEMCR |= DEMCR_TRCENA;
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+uint16_t udb_timer_ticks(void)
+{
+	return (uint16_t)(DWT_CYCCNT >> timer_shift);
+}
+
+uint16_t udb_timer_ticks_per_ms(void)
+{
+	return timer_ticks_per_ms;
+}
+
 int16_t udb_servo_pulsesat(int32_t pw)
 {
 	if (pw > SERVOMAX) pw = SERVOMAX;
@@ -243,6 +283,8 @@ void osd_spi_erase_chars(uint8_t n) {}
 void osd_spi_write_number(int32_t val, int8_t num_digits, int8_t decimal_places, int8_t num_flags, int8_t header, int8_t footer) {}
 
 void filesys_init(void) {}
+void filesys_service(void) {}
+void filesys_flush(void) {}
 
 //static jmp_buf default_jmp_buf;
 
@@ -272,6 +314,7 @@ void udb_init(void)
 {
 	udb_heartbeat_counter = 0;
 	udb_flags.B = 0;
+	init_timer();
 //	MPU6000_init16(&heartbeat);
 }
 
@@ -41,6 +41,26 @@ inline uint8_t udb_cpu_load(void)
 	return (uint8_t)(__builtin_muluu(cpu_timer, CPU_LOAD_PERCENT) >> 16);
 }
 
+// Timer 2 runs freely as the time base of the radio input capture (see radioIn.c)
+// It wraps after 32.8ms at 16 MIPS, 16.4ms at 32 MIPS and 65.5ms at 64 MIPS.
+#if (MIPS == 64)
+#define TIMER_TICKS_PER_MS (FCY/64000)  // prescaler = 64
+#elif (MIPS == 16 || MIPS == 32)
+#define TIMER_TICKS_PER_MS (FCY/8000)   // prescaler = 8
+#else
+#error Timer 2 would wrap sooner than 16ms, set a larger prescaler in radioIn.c
+#endif
+
+uint16_t udb_timer_ticks(void)
+{
+	return TMR2;
+}
+
+uint16_t udb_timer_ticks_per_ms(void)
+{
+	return TIMER_TICKS_PER_MS;
+}
+
 static inline void init_heartbeat(void)
 {
 //#ifdef USE_MPU_HEARTBEAT
@@ -175,6 +175,12 @@ void udb_background_trigger_pulse(background_callback callback);
 uint8_t udb_cpu_load(void);
 void cpu_load_calc(void);
 
+//! A free running timer, for timing sections of code. It wraps every 65536
+//! ticks, which is no sooner than 16ms, and counts udb_timer_ticks_per_ms()
+//! ticks each millisecond.
+uint16_t udb_timer_ticks(void);
+uint16_t udb_timer_ticks_per_ms(void);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Radio Inputs / Servo Outputs